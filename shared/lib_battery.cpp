@@ -1198,8 +1198,12 @@ lifetime_calendar_t * lifetime_calendar_t::clone(){ return new lifetime_calendar
 void lifetime_calendar_t::copy(lifetime_calendar_t * lifetime_calendar)
 {
 	_calendar_choice = lifetime_calendar->_calendar_choice;
+
+	// calendar table doesn't change
+	/*
 	_calendar_days = lifetime_calendar->_calendar_days;
 	_calendar_capacity = lifetime_calendar->_calendar_capacity;
+	*/
 	_day_age_of_battery = lifetime_calendar->_day_age_of_battery;
 	_dt_hour = lifetime_calendar->_dt_hour;
 	_dt_day = lifetime_calendar->_dt_day;
@@ -1325,12 +1329,14 @@ void thermal_t::copy(thermal_t * thermal)
 	_height = thermal->_height;
 	_Cp = thermal->_Cp;
 	_h = thermal->_h;
-	_T_room = thermal->_T_room;
 	_R = thermal->_R;
 	_A = thermal->_A;
 	_T_battery = thermal->_T_battery;
 	_capacity_percent = thermal->_capacity_percent;
 	_T_max = thermal->_T_max;
+
+	// room temperature holds every step of the first year, doesn't change and is slow to copy on each dispatch iteration
+	// _T_room = thermal->_T_room;
 }
 void thermal_t::replace_battery(size_t lifetimeIndex)
 { 
@@ -1061,8 +1061,7 @@ void dispatch_automatic_behind_the_meter_t::target_power(FILE*p, bool debug, dou
 	{
 		double_vec::const_iterator first = _P_target_input.begin() + idx;
 		double_vec::const_iterator last = _P_target_input.begin() + idx + _num_steps;
-		double_vec tmp(first, last);
-		_P_target_use = tmp;
+		_P_target_use.assign(first, last);
 		return;
 	}
 	// don't calculate if peak grid demand is less than a previous target in the month
@@ -1079,32 +1078,18 @@ void dispatch_automatic_behind_the_meter_t::target_power(FILE*p, bool debug, dou
 		if (debug)
 			fprintf(p, "Index\tRecharge_target\t charge_energy\n");
 
+		// Energy that can be charged while holding the grid at each sorted level [kWh]. Each level up adds its rise
+		// times the number of steps below it, so accumulate in one pass instead of re-summing the tail per level
 		double P_target = sorted_grid[0].Grid();
-		double P_target_min = 1e16;
-		double E_charge = 0.;
-		int index = (int)_num_steps - 1;
-		std::vector<double> E_charge_vec;
-		for (int jj = (int)_num_steps - 1; jj >= 0; jj--)
+		std::vector<double> E_charge_vec(_num_steps, 0.);
+		if (debug)
+			fprintf(p, "%zu: index\t%.3f\t %.3f\n", _num_steps - 1, sorted_grid[_num_steps - 1].Grid(), 0.);
+		for (int index = (int)_num_steps - 2; index >= 0; index--)
 		{
-			E_charge = 0.;
-			P_target_min = sorted_grid[index].Grid();
-
-			for (int ii = (int)_num_steps - 1; ii >= 0; ii--)
-			{
-				if (sorted_grid[ii].Grid() > P_target_min)
-					break;
-
-				E_charge += (P_target_min - sorted_grid[ii].Grid())*_dt_hour;
-			}
-			E_charge_vec.push_back(E_charge);
+			E_charge_vec[index] = E_charge_vec[index + 1] + (sorted_grid[index].Grid() - sorted_grid[index + 1].Grid())*(_num_steps - 1 - index)*_dt_hour;
 			if (debug)
-				fprintf(p, "%u: index\t%.3f\t %.3f\n", index, P_target_min, E_charge);
-			index--;
-
-			if (index < 0)
-				break;
+				fprintf(p, "%d: index\t%.3f\t %.3f\n", index, sorted_grid[index].Grid(), E_charge_vec[index]);
 		}
-		std::reverse(E_charge_vec.begin(), E_charge_vec.end());
 
 		// Calculate target power
 		std::vector<double> sorted_grid_diff;
@@ -47,10 +47,12 @@
 *  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************************************/
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <math.h>
+#include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -272,6 +274,208 @@ void solarpos(int year,int month,int day,int hour,double minute,double lat,doubl
 }
 
 
+/**
+* Calculate the effective sun position for a timestep, given the sun position at noon of the same day in sunn[].
+* Interpolates the time used for the sun position in timesteps containing sunrise or sunset, as described in irrad::calc().
+* On return sunn[] holds the solarpos() results at the effective time and tsp[] holds the effective hour, minute, and sun up flag.
+*/
+static void effective_sun_position(int year, int month, int day, int hour, double minute, double delt, double lat, double lng, double tz, double sunn[9], int tsp[3])
+{
+	double t_cur = hour + minute/60.0;
+
+	double t_sunrise = sunn[4];
+	double t_sunset = sunn[5];
+
+	// recall: if delt <= 0.0, do not interpolate sunrise and sunset hours, just use specified time stamp
+	if ( delt > 0
+		&& t_cur >= t_sunrise - delt/2.0
+		&& t_cur < t_sunrise + delt/2.0 )
+	{
+		// time step encompasses the sunrise
+		double t_calc = (t_sunrise + (t_cur+delt/2.0))/2.0; // midpoint of sunrise and end of timestep
+		int hr_calc = (int)t_calc;
+		double min_calc = (t_calc-hr_calc)*60.0;
+
+		tsp[0] = hr_calc;
+		tsp[1] = (int)min_calc;
+				
+		solarpos( year, month, day, hr_calc, min_calc, lat, lng, tz, sunn );
+
+		tsp[2] = 2;				
+	}
+	else if ( delt > 0
+		&& t_cur > t_sunset - delt/2.0
+		&& t_cur <= t_sunset + delt/2.0 )
+	{
+		// timestep encompasses the sunset
+		double t_calc = ( (t_cur-delt/2.0) + t_sunset )/2.0; // midpoint of beginning of timestep and sunset
+		int hr_calc = (int)t_calc;
+		double min_calc = (t_calc-hr_calc)*60.0;
+
+		tsp[0] = hr_calc;
+		tsp[1] = (int)min_calc;
+				
+		solarpos( year, month, day, hr_calc, min_calc, lat, lng, tz, sunn );
+
+		tsp[2] = 3;
+	}
+	else if (t_cur >= t_sunrise && t_cur <= t_sunset)
+	{
+		// timestep is not sunrise nor sunset, but sun is up  (calculate position at provided t_cur)			
+		tsp[0] = hour;
+		tsp[1] = (int)minute;
+		solarpos( year, month, day, hour, minute, lat, lng, tz, sunn );
+		tsp[2] = 1;
+	}
+	else
+	{	
+		// sun is down, assign sundown values
+		sunn[0] = -999*DTOR; //avoid returning a junk azimuth angle (return in radians)
+		sunn[1] = -999*DTOR; //avoid returning a junk zenith angle (return in radians)
+		sunn[2] = -999*DTOR; //avoid returning a junk elevation angle (return in radians)
+		tsp[0] = 0;
+		tsp[1] = 0;
+		tsp[2] = 0;
+	}
+}
+
+solarpos_table::solarpos_table(double lat, double lon, double tz, double delt_hr,
+	const std::vector<int> &year, const std::vector<int> &month, const std::vector<int> &day,
+	const std::vector<int> &hour, const std::vector<double> &minute)
+	: latitudeDegrees(lat), longitudeDegrees(lon), timezone(tz), delt(delt_hr),
+	years(year), months(month), days(day), hours(hour), minutes(minute)
+{
+	size_t n = years.size();
+	for (int k = 0; k < 9; k++)
+		sun[k].resize(n);
+	calcHour.resize(n);
+	calcMinute.resize(n);
+	sunup.resize(n);
+
+	double noon[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	double sunn[9];
+	int tsp[3];
+	for (size_t i = 0; i < n; i++)
+	{
+		// sunrise and sunset only change once per day
+		if (i == 0 || years[i] != years[i - 1] || months[i] != months[i - 1] || days[i] != days[i - 1])
+			solarpos(years[i], months[i], days[i], 12, 0.0, lat, lon, tz, noon);
+
+		for (int k = 0; k < 9; k++)
+			sunn[k] = noon[k];
+		effective_sun_position(years[i], months[i], days[i], hours[i], minutes[i], delt, lat, lon, tz, sunn, tsp);
+
+		for (int k = 0; k < 9; k++)
+			sun[k][i] = sunn[k];
+		calcHour[i] = tsp[0];
+		calcMinute[i] = tsp[1];
+		sunup[i] = tsp[2];
+	}
+}
+
+void solarpos_table::get(size_t index, double sunn[9], int sunPosition[3]) const
+{
+	for (int k = 0; k < 9; k++)
+		sunn[k] = sun[k][index];
+	sunPosition[0] = calcHour[index];
+	sunPosition[1] = calcMinute[index];
+	sunPosition[2] = sunup[index];
+}
+
+bool solarpos_table::matches(double lat, double lon, double tz, double delt_hr,
+	const std::vector<int> &year, const std::vector<int> &month, const std::vector<int> &day,
+	const std::vector<int> &hour, const std::vector<double> &minute) const
+{
+	return lat == latitudeDegrees && lon == longitudeDegrees && tz == timezone && delt_hr == delt
+		&& year == years && month == months && day == days && hour == hours && minute == minutes;
+}
+
+static std::mutex solarpos_table_lock;
+static size_t solarpos_table_computed = 0;
+
+std::shared_ptr<const solarpos_table> solarpos_table::shared(double lat, double lon, double tz, double delt_hr,
+	const std::vector<int> &year, const std::vector<int> &month, const std::vector<int> &day,
+	const std::vector<int> &hour, const std::vector<double> &minute)
+{
+	// keep the most recently used tables, one per location and timestep grid
+	static const size_t max_cached = 4;
+	static std::vector< std::shared_ptr<const solarpos_table> > cache;
+
+	std::lock_guard<std::mutex> lock(solarpos_table_lock);
+	for (size_t i = 0; i < cache.size(); i++)
+	{
+		if (cache[i]->matches(lat, lon, tz, delt_hr, year, month, day, hour, minute))
+		{
+			std::shared_ptr<const solarpos_table> table = cache[i];
+			cache.erase(cache.begin() + i);
+			cache.push_back(table);
+			return table;
+		}
+	}
+
+	std::shared_ptr<const solarpos_table> table(new solarpos_table(lat, lon, tz, delt_hr, year, month, day, hour, minute));
+	solarpos_table_computed++;
+	if (cache.size() >= max_cached)
+		cache.erase(cache.begin());
+	cache.push_back(table);
+	return table;
+}
+
+std::shared_ptr<const solarpos_table> solarpos_table::shared(weather_data_provider *wdprov, double delt_hr)
+{
+	weather_header hdr;
+	wdprov->header(&hdr);
+
+	size_t n = wdprov->nrecords();
+	std::vector<int> year(n), month(n), day(n), hour(n);
+	std::vector<double> minute(n);
+
+	weather_record wf;
+	size_t current = (size_t)wdprov->get_counter_value();
+	wdprov->rewind();
+	for (size_t i = 0; i < n && wdprov->read(&wf); i++)
+	{
+		year[i] = wf.year;
+		month[i] = wf.month;
+		day[i] = wf.day;
+		hour[i] = wf.hour;
+		minute[i] = wf.minute;
+	}
+	wdprov->rewind();
+	wdprov->set_counter_to(current);
+
+	return shared(hdr.lat, hdr.lon, hdr.tz, delt_hr, year, month, day, hour, minute);
+}
+
+size_t solarpos_table::compute_count()
+{
+	std::lock_guard<std::mutex> lock(solarpos_table_lock);
+	return solarpos_table_computed;
+}
+
+incidence_table::incidence_table(const solarpos_table &sun, int mode, double tilt, double sazm, double rlim, bool en_backtrack, double gcr)
+{
+	size_t n = sun.size();
+	for (int k = 0; k < 5; k++)
+		angle[k].assign(n, 0.0);
+
+	double ang[5];
+	for (size_t i = 0; i < n; i++)
+	{
+		if (sun.sunup[i] <= 0) continue;
+
+		incidence(mode, tilt, sazm, rlim, sun.sun[1][i], sun.sun[0][i], en_backtrack, gcr, ang);
+		for (int k = 0; k < 5; k++)
+			angle[k][i] = ang[k];
+	}
+}
+
+void incidence_table::get(size_t index, double surfaceAngles[5]) const
+{
+	for (int k = 0; k < 5; k++)
+		surfaceAngles[k] = angle[k][index];
+}
+
 void incidence(int mode,double tilt,double sazm,double rlim,double zen,double azm, bool en_backtrack, double gcr, double angle[5])
 {
 	// Azimuth angles are for N=0 or 2pi, E=pi/2, S=pi, and W=3pi/2.  8/13/98
@@ -865,6 +1069,9 @@ void irrad::setup()
 	planeOfArrayIrradianceRear[0] = planeOfArrayIrradianceRear[1] = planeOfArrayIrradianceRear[2] = diffuseIrradianceRear[0] = diffuseIrradianceRear[1] = diffuseIrradianceRear[2] = std::numeric_limits<double>::quiet_NaN();
 	timeStepSunPosition[0] = timeStepSunPosition[1] = timeStepSunPosition[2] = -999;
 	planeOfArrayIrradianceRearAverage = 0;
+	sunPositionTable = NULL;
+	surfaceAngleTable = NULL;
+	angleTableIndex = 0;
 
 	calculatedDirectNormal = directNormal;
 	calculatedDiffuseHorizontal = 0.0;
@@ -1001,6 +1208,10 @@ void irrad::set_time( int y, int m, int d, int h, double min, double delt_hr )
 	this->hour = h;
 	this->minute = min;
 	this->delt = delt_hr;
+
+	// precomputed angles only apply to the timestep they were set for
+	sunPositionTable = NULL;
+	surfaceAngleTable = NULL;
 }
 
 void irrad::set_location( double latDegrees, double longDegrees, double tz )
@@ -1066,6 +1277,13 @@ void irrad::set_sun_component(size_t index, double value)
 	}
 }
 
+void irrad::set_angle_tables(const solarpos_table *sunTable, const incidence_table *surfaceTable, size_t index)
+{
+	sunPositionTable = sunTable;
+	surfaceAngleTable = surfaceTable;
+	angleTableIndex = index;
+}
+
 int irrad::calc()
 {
 	int code = check();
@@ -1082,66 +1300,14 @@ int irrad::calc()
 	planeOfArrayIrradianceFront: result from sky model
 	diff: broken out diffuse components from sky model
 */	
-	double t_cur = hour + minute/60.0;
-
-	// calculate sunrise and sunset hours in local standard time for the current day
-	solarpos( year, month, day, 12, 0.0, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
-
-	double t_sunrise = sunAnglesRadians[4];
-	double t_sunset = sunAnglesRadians[5];
-
-	// recall: if delt <= 0.0, do not interpolate sunrise and sunset hours, just use specified time stamp
-	if ( delt > 0
-		&& t_cur >= t_sunrise - delt/2.0
-		&& t_cur < t_sunrise + delt/2.0 )
-	{
-		// time step encompasses the sunrise
-		double t_calc = (t_sunrise + (t_cur+delt/2.0))/2.0; // midpoint of sunrise and end of timestep
-		int hr_calc = (int)t_calc;
-		double min_calc = (t_calc-hr_calc)*60.0;
-
-		timeStepSunPosition[0] = hr_calc;
-		timeStepSunPosition[1] = (int)min_calc;
-				
-		solarpos( year, month, day, hr_calc, min_calc, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
-
-		timeStepSunPosition[2] = 2;				
-	}
-	else if ( delt > 0
-		&& t_cur > t_sunset - delt/2.0
-		&& t_cur <= t_sunset + delt/2.0 )
-	{
-		// timestep encompasses the sunset
-		double t_calc = ( (t_cur-delt/2.0) + t_sunset )/2.0; // midpoint of beginning of timestep and sunset
-		int hr_calc = (int)t_calc;
-		double min_calc = (t_calc-hr_calc)*60.0;
-
-		timeStepSunPosition[0] = hr_calc;
-		timeStepSunPosition[1] = (int)min_calc;
-				
-		solarpos( year, month, day, hr_calc, min_calc, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
-
-		timeStepSunPosition[2] = 3;
-	}
-	else if (t_cur >= t_sunrise && t_cur <= t_sunset)
-	{
-		// timestep is not sunrise nor sunset, but sun is up  (calculate position at provided t_cur)			
-		timeStepSunPosition[0] = hour;
-		timeStepSunPosition[1] = (int)minute;
-		solarpos( year, month, day, hour, minute, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
-		timeStepSunPosition[2] = 1;
-	}
+	if (sunPositionTable != NULL && angleTableIndex < sunPositionTable->size())
+		sunPositionTable->get( angleTableIndex, sunAnglesRadians, timeStepSunPosition );
 	else
-	{	
-		// sun is down, assign sundown values
-		sunAnglesRadians[0] = -999*DTOR; //avoid returning a junk azimuth angle (return in radians)
-		sunAnglesRadians[1] = -999*DTOR; //avoid returning a junk zenith angle (return in radians)
-		sunAnglesRadians[2] = -999*DTOR; //avoid returning a junk elevation angle (return in radians)
-		timeStepSunPosition[0] = 0;
-		timeStepSunPosition[1] = 0;
-		timeStepSunPosition[2] = 0;
+	{
+		// calculate sunrise and sunset hours in local standard time for the current day
+		solarpos( year, month, day, 12, 0.0, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians );
+		effective_sun_position( year, month, day, hour, minute, delt, latitudeDegrees, longitudeDegrees, timezone, sunAnglesRadians, timeStepSunPosition );
 	}
-
 			
 	planeOfArrayIrradianceFront[0]=planeOfArrayIrradianceFront[1]=planeOfArrayIrradianceFront[2] = 0;
 	diffuseIrradianceFront[0]=diffuseIrradianceFront[1]=diffuseIrradianceFront[2] = 0;
@@ -1151,7 +1317,10 @@ int irrad::calc()
 	if (timeStepSunPosition[2] > 0)
 	{				
 		// compute incidence angles onto fixed or tracking surface
-		incidence( trackingMode, tiltDegrees, surfaceAzimuthDegrees, rotationLimitDegrees, sunAnglesRadians[1], sunAnglesRadians[0], enableBacktrack, groundCoverageRatio, surfaceAnglesRadians );
+		if (surfaceAngleTable != NULL && angleTableIndex < surfaceAngleTable->size())
+			surfaceAngleTable->get( angleTableIndex, surfaceAnglesRadians );
+		else
+			incidence( trackingMode, tiltDegrees, surfaceAzimuthDegrees, rotationLimitDegrees, sunAnglesRadians[1], sunAnglesRadians[0], enableBacktrack, groundCoverageRatio, surfaceAnglesRadians );
 
 		if(radiationMode < irrad::POA_R){
 			double hextra = sunAnglesRadians[8];
@@ -1214,11 +1383,13 @@ int irrad::calc()
 
 }
 
-int irrad::calc_rear_side(double transmissionFactor, double bifaciality, double groundClearanceHeight, double slopeLength)
+int irrad::calc_rear_side(double transmissionFactor, double bifaciality, double groundClearanceHeight, double slopeLength, bifacial_workspace *workspace)
 {
 	// do irradiance calculations if sun is up
 	if (timeStepSunPosition[2] > 0)
 	{
+		bifacial_workspace localWorkspace;
+		bifacial_workspace &ws = (workspace != 0) ? *workspace : localWorkspace;
 
 		double tiltRadian = surfaceAnglesRadians[1];		// The tracked angle in radians
 
@@ -1235,35 +1406,64 @@ int irrad::calc_rear_side(double transmissionFactor, double bifaciality, double
 		double horizontalLength = slopeLength * cos(tiltRadian);
 
 		// Determine the factors for points on the ground from the leading edge of one row of PV panels to the edge of the next row of panels behind
-		std::vector<double> rearSkyConfigFactors, frontSkyConfigFactors;
-		this->getSkyConfigurationFactors(rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, rearSkyConfigFactors, frontSkyConfigFactors);
+		ws.update_geometry(*this, rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength);
 
 		// Determine if ground is shading from direct beam radio for points on the ground from leading edge of PV panels to leading edge of next row behind
 		double pvBackShadeFraction, pvFrontShadeFraction, maxShadow;
 		pvBackShadeFraction = pvFrontShadeFraction = maxShadow = 0;
-		std::vector<int> rearGroundShade, frontGroundShade;
-		this->getGroundShadeFactors(rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, sunAnglesRadians[0], sunAnglesRadians[2], rearGroundShade, frontGroundShade, maxShadow, pvBackShadeFraction, pvFrontShadeFraction);
+		this->getGroundShadeFactors(rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, sunAnglesRadians[0], sunAnglesRadians[2], ws.rearGroundShade, ws.frontGroundShade, maxShadow, pvBackShadeFraction, pvFrontShadeFraction);
 
 		// Get the rear ground GHI
-		std::vector<double> rearGroundGHI, frontGroundGHI;
-		this->getGroundGHI(transmissionFactor, rearSkyConfigFactors, frontSkyConfigFactors, rearGroundShade, frontGroundShade, rearGroundGHI, frontGroundGHI);
+		this->getGroundGHI(transmissionFactor, ws.rearSkyConfigFactors, ws.frontSkyConfigFactors, ws.rearGroundShade, ws.frontGroundShade, ws.rearGroundGHI, ws.frontGroundGHI);
 
 		// Calculate the irradiance on the front of the PV module (to get front reflected)
-		std::vector<double> frontIrradiancePerCellrow, frontReflected;
 		double frontAverageIrradiance = 0;
-		getFrontSurfaceIrradiances(pvFrontShadeFraction, rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, frontGroundGHI, frontIrradiancePerCellrow, frontAverageIrradiance, frontReflected);
+		getFrontSurfaceIrradiances(pvFrontShadeFraction, rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, ws.frontGroundGHI, ws.frontIrradiance, frontAverageIrradiance, ws.frontReflected);
 
 		// Calculate the irradiance on the back of the PV module
-		std::vector<double> rearIrradiancePerCellrow;
 		double rearAverageIrradiance = 0;
-		getBackSurfaceIrradiances(pvBackShadeFraction, rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, rearGroundGHI, frontGroundGHI, frontReflected, rearIrradiancePerCellrow, rearAverageIrradiance);
+		getBackSurfaceIrradiances(pvBackShadeFraction, rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, ws.rearGroundGHI, ws.frontGroundGHI, ws.frontReflected, ws.rearIrradiance, rearAverageIrradiance);
 		planeOfArrayIrradianceRearAverage = rearAverageIrradiance * bifaciality;
 	}
 	return true;
 }
 
+bifacial_workspace::bifacial_workspace()
+	: hasGeometry(false), skyConfigCount(0)
+{
+	for (size_t i = 0; i < 5; i++)
+		geometry[i] = 0;
+}
+
+void bifacial_workspace::update_geometry(irrad &irr, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength)
+{
+	double g[5] = { rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength };
+	if (hasGeometry && std::equal(g, g + 5, geometry))
+		return;
+
+	irr.getSkyConfigurationFactors(rowToRow, verticalHeight, clearanceGround, distanceBetweenRows, horizontalLength, rearSkyConfigFactors, frontSkyConfigFactors);
+	std::copy(g, g + 5, geometry);
+	hasGeometry = true;
+	skyConfigCount++;
+}
+
+// Fraction of a hemispherical view in the one degree arc from j to j+1 degrees, 0.5 * [cos(j) - cos(j+1)]
+struct arc_view_factors
+{
+	double factor[180];
+	arc_view_factors()
+	{
+		for (size_t j = 0; j < 180; j++)
+			factor[j] = 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR));
+	}
+};
+static const arc_view_factors arcViewFactors;
+
 void irrad::getSkyConfigurationFactors(double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, std::vector<double> & rearSkyConfigFactors, std::vector<double> & frontSkyConfigFactors)
 {
+	rearSkyConfigFactors.clear();
+	frontSkyConfigFactors.clear();
+
 	// Calculate sky configuration factors using 100 intervals
 	size_t intervals = 100;
 	double deltaInterval = static_cast<double>(rowToRow / intervals);
@@ -1327,6 +1527,9 @@ void irrad::getSkyConfigurationFactors(double rowToRow, double verticalHeight, d
 
 void irrad::getGroundShadeFactors(double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, double solarAzimuthRadians, double solarElevationRadians, std::vector<int> & rearGroundShade, std::vector<int> & frontGroundShade, double & maxShadow, double & pvBackSurfaceShadeFraction, double & pvFrontSurfaceShadeFraction)
 {
+	rearGroundShade.clear();
+	frontGroundShade.clear();
+
 	// calculate ground shade factors using 100 intervals
 	size_t intervals = 100;
 	double deltaInterval = static_cast<double>(rowToRow / intervals);
@@ -1447,8 +1650,11 @@ void irrad::getGroundShadeFactors(double rowToRow, double verticalHeight, double
 	maxShadow = fmax(shadingStart1, shadingEnd1);
 }
 
-void irrad::getGroundGHI(double transmissionFactor, std::vector<double> rearSkyConfigFactors, std::vector<double> frontSkyConfigFactors, std::vector<int> rearGroundShade, std::vector<int> frontGroundShade, std::vector<double> & rearGroundGHI, std::vector<double> & frontGroundGHI)
+void irrad::getGroundGHI(double transmissionFactor, const std::vector<double> & rearSkyConfigFactors, const std::vector<double> & frontSkyConfigFactors, const std::vector<int> & rearGroundShade, const std::vector<int> & frontGroundShade, std::vector<double> & rearGroundGHI, std::vector<double> & frontGroundGHI)
 {
+	rearGroundGHI.clear();
+	frontGroundGHI.clear();
+
 	// Calculate the diffuse components of irradiance
 	perez(0, calculatedDirectNormal, calculatedDiffuseHorizontal,albedo, sunAnglesRadians[1], 0.0, sunAnglesRadians[1], planeOfArrayIrradianceRear, diffuseIrradianceRear);
 	double incidentBeam = planeOfArrayIrradianceRear[0];
@@ -1483,8 +1689,11 @@ void irrad::getGroundGHI(double transmissionFactor, std::vector<double> rearSkyC
 	}
 }
 
-void irrad::getFrontSurfaceIrradiances(double pvFrontShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, std::vector<double> frontGroundGHI, std::vector<double> & frontIrradiance, double & frontAverageIrradiance, std::vector<double> & frontReflected)
+void irrad::getFrontSurfaceIrradiances(double pvFrontShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, const std::vector<double> & frontGroundGHI, std::vector<double> & frontIrradiance, double & frontAverageIrradiance, std::vector<double> & frontReflected)
 {
+	frontIrradiance.clear();
+	frontReflected.clear();
+
 	// front surface assumed to be glass
 	double n2 = 1.526;
 
@@ -1519,6 +1728,10 @@ void irrad::getFrontSurfaceIrradiances(double pvFrontShadeFraction, double rowTo
 	double PtopX = -distanceBetweenRows;			 // x value for point on top edge of PV module/panel of row in front of (in PV panel slope lengths)
 	double PtopY = verticalHeight + clearanceGround; // y value for point on top edge of PV module/panel of row in front of (in PV panel slope lengths)
 
+	// Direct and circumsolar irradiance components do not depend on the cell row
+	incidence(0, tiltRadians * RTOD, surfaceAzimuthRadians * RTOD, 45.0, solarZenithRadians, solarAzimuthRadians, this->enableBacktrack, this->groundCoverageRatio, surfaceAnglesRadians);
+	perez(0, calculatedDirectNormal, calculatedDiffuseHorizontal, albedo, surfaceAnglesRadians[0], surfaceAnglesRadians[1], solarZenithRadians, poa, diffc);
+
 	// Calculate diffuse and direct component irradiances for each cell row (assuming 6 rows)
 	size_t cellRows = 6;
 	for (size_t i = 0; i != cellRows; i++)
@@ -1540,13 +1753,13 @@ void irrad::getFrontSurfaceIrradiances(double pvFrontShadeFraction, double rowTo
 		// Add sky diffuse component and horizon brightening if present
 		for (size_t j = 0; j != iStopIso; j++)
 		{
-			frontIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1)*DTOR)) * MarionAOICorrectionFactorsGlass[j] * isotropicSkyDiffuse;
-			frontReflected[i] += 0.5 * (cos(j * DTOR) - cos((j + 1)*DTOR)) * isotropicSkyDiffuse * (1.0 - MarionAOICorrectionFactorsGlass[j] * (1.0 - reflectanceNormalIncidence));
+			frontIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j] * isotropicSkyDiffuse;
+			frontReflected[i] += arcViewFactors.factor[j] * isotropicSkyDiffuse * (1.0 - MarionAOICorrectionFactorsGlass[j] * (1.0 - reflectanceNormalIncidence));
 
 			if ((iStopIso - j) <= iHorBright)
 			{
-				frontIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * MarionAOICorrectionFactorsGlass[j] * horizonDiffuse / 0.052246; // 0.052246 = 0.5 * [cos(84) - cos(90)]
-				frontReflected[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * (horizonDiffuse / 0.052246) * (1.0 - MarionAOICorrectionFactorsGlass[j] * (1.0 - reflectanceNormalIncidence));
+				frontIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j] * horizonDiffuse / 0.052246; // 0.052246 = 0.5 * [cos(84) - cos(90)]
+				frontReflected[i] += arcViewFactors.factor[j] * (horizonDiffuse / 0.052246) * (1.0 - MarionAOICorrectionFactorsGlass[j] * (1.0 - reflectanceNormalIncidence));
 			}
 		}
 
@@ -1616,12 +1829,9 @@ void irrad::getFrontSurfaceIrradiances(double pvFrontShadeFraction, double rowTo
 					actualGroundGHI /= projectedX2 - projectedX1;
 				}
 			}
-			frontIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * MarionAOICorrectionFactorsGlass[j] * actualGroundGHI * this->albedo;
-			frontReflected[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * actualGroundGHI * this->albedo * (1.0 - MarionAOICorrectionFactorsGlass[j] * (1.0 - reflectanceNormalIncidence));
+			frontIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j] * actualGroundGHI * this->albedo;
+			frontReflected[i] += arcViewFactors.factor[j] * actualGroundGHI * this->albedo * (1.0 - MarionAOICorrectionFactorsGlass[j] * (1.0 - reflectanceNormalIncidence));
 		}
-		// Calculate and add direct and circumsolar irradiance components
-		incidence(0, tiltRadians * RTOD, surfaceAzimuthRadians * RTOD, 45.0, solarZenithRadians, solarAzimuthRadians, this->enableBacktrack, this->groundCoverageRatio, surfaceAnglesRadians);
-		perez(0, calculatedDirectNormal, calculatedDiffuseHorizontal, albedo, surfaceAnglesRadians[0], surfaceAnglesRadians[1], solarZenithRadians, poa, diffc);
 
 		double cellShade = pvFrontShadeFraction * cellRows - i;
 
@@ -1643,8 +1853,10 @@ void irrad::getFrontSurfaceIrradiances(double pvFrontShadeFraction, double rowTo
 	}
 }
 
-void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double , double horizontalLength, std::vector<double> rearGroundGHI, std::vector<double> frontGroundGHI, std::vector<double> frontReflected, std::vector<double> & rearIrradiance, double & rearAverageIrradiance)
+void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double , double horizontalLength, const std::vector<double> & rearGroundGHI, const std::vector<double> & frontGroundGHI, const std::vector<double> & frontReflected, std::vector<double> & rearIrradiance, double & rearAverageIrradiance)
 {
+	rearIrradiance.clear();
+
 	// front surface assumed to be glass
 	double n2 = 1.526;
 
@@ -1677,6 +1889,10 @@ void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRo
 	double PtopX = rowToRow + horizontalLength;      // x value for point on top edge of PV module/panel of row in back of (in PV panel slope lengths)
 	double PtopY = verticalHeight + clearanceGround; // y value for point on top edge of PV module/panel of row in back of (in PV panel slope lengths)
 
+	// Direct and circumsolar irradiance components do not depend on the cell row
+	incidence(0, 180.0 - tiltRadians * RTOD, (surfaceAzimuthRadians * RTOD - 180.0), 45.0, solarZenithRadians, solarAzimuthRadians, this->enableBacktrack, this->groundCoverageRatio, surfaceAnglesRadians);
+	perez(0, calculatedDirectNormal, calculatedDiffuseHorizontal, albedo, surfaceAnglesRadians[0], surfaceAnglesRadians[1], solarZenithRadians, planeOfArrayIrradianceRear, diffuseIrradianceRear);
+
 	// Calculate diffuse and direct component irradiances for each cell row (assuming 6 rows)
 	size_t cellRows = 6;
 	for (size_t i = 0; i != cellRows; i++)
@@ -1694,10 +1910,10 @@ void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRo
 		rearIrradiance.push_back(0);
 		for (size_t j = 0; j != iStopIso; j++)
 		{
-			rearIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1)*DTOR)) * MarionAOICorrectionFactorsGlass[j]* isotropicSkyDiffuse;
+			rearIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j]* isotropicSkyDiffuse;
 			if ((iStopIso - j) <= iHorBright)
 			{
-				rearIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * MarionAOICorrectionFactorsGlass[j]* horizonDiffuse / 0.052264; // 0.052246 = 0.5 * [cos(84) - cos(90)]
+				rearIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j]* horizonDiffuse / 0.052264; // 0.052246 = 0.5 * [cos(84) - cos(90)]
 			}
 		}
 
@@ -1741,7 +1957,7 @@ void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRo
 				PVreflectedIrradiance += cellLengthSeen * frontReflected[k];
 			}
 			PVreflectedIrradiance /= projectedX2 - projectedX1;
-			rearIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * MarionAOICorrectionFactorsGlass[j] * PVreflectedIrradiance;
+			rearIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j] * PVreflectedIrradiance;
 		}
 
 
@@ -1824,11 +2040,8 @@ void irrad::getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRo
 					actualGroundGHI /= projectedX2 - projectedX1;
 				}
 			}
-			rearIrradiance[i] += 0.5 * (cos(j * DTOR) - cos((j + 1) * DTOR)) * MarionAOICorrectionFactorsGlass[j] * actualGroundGHI * this->albedo;
+			rearIrradiance[i] += arcViewFactors.factor[j] * MarionAOICorrectionFactorsGlass[j] * actualGroundGHI * this->albedo;
 		}
-		// Calculate and add direct and circumsolar irradiance components
-		incidence(0, 180.0 - tiltRadians * RTOD, (surfaceAzimuthRadians * RTOD - 180.0), 45.0, solarZenithRadians, solarAzimuthRadians, this->enableBacktrack, this->groundCoverageRatio, surfaceAnglesRadians);
-		perez(0, calculatedDirectNormal, calculatedDiffuseHorizontal, albedo, surfaceAnglesRadians[0], surfaceAnglesRadians[1], solarZenithRadians, planeOfArrayIrradianceRear, diffuseIrradianceRear);
 
 		double cellShade = pvBackShadeFraction * cellRows - i;
 		
@@ -51,10 +51,12 @@
 #define __irradproc_h
 
 #include <memory>
+#include <vector>
 
 #include "lib_weatherfile.h"
 
 struct poaDecompReq;
+class irrad;
 
 /**
 * \file
@@ -120,6 +122,107 @@ void solarpos(int year,int month,int day,int hour,double minute,double lat,doubl
 void incidence(int mode,double tilt,double sazm,double rlim,double zen,double azm, bool en_backtrack, double gcr, double angle[5]);
 
 
+/**
+* \class solarpos_table
+*
+* Sun positions for a sequence of timestamps at one location, stored as one array per component.
+* Each entry holds exactly the sunAnglesRadians and timeStepSunPosition that irrad::calc() computes
+* for the same timestamp, including the sunrise and sunset interpolation, so a year of sun positions
+* can be computed once and reused by every subarray and every year of a lifetime simulation.
+* Sunrise and sunset are computed once per day rather than once per timestep.
+*/
+class solarpos_table
+{
+public:
+	/// Compute the sun positions for the given timestamps, with delt_hr as in irrad::set_time()
+	solarpos_table(double lat, double lon, double tz, double delt_hr,
+		const std::vector<int> &year, const std::vector<int> &month, const std::vector<int> &day,
+		const std::vector<int> &hour, const std::vector<double> &minute);
+
+	/// Return a table for the given location and timestamps shared with other callers, computing it if it is not cached
+	static std::shared_ptr<const solarpos_table> shared(double lat, double lon, double tz, double delt_hr,
+		const std::vector<int> &year, const std::vector<int> &month, const std::vector<int> &day,
+		const std::vector<int> &hour, const std::vector<double> &minute);
+
+	/// Read the timestamps of all records of a weather data provider and return the shared table for them, the read position is left unchanged
+	static std::shared_ptr<const solarpos_table> shared(weather_data_provider *wdprov, double delt_hr);
+
+	/// Number of tables computed (not taken from the cache) by shared() in this process
+	static size_t compute_count();
+
+	/// Number of timestamps in the table
+	size_t size() const { return sunup.size(); }
+
+	/// Copy the sun angles (as from solarpos()) and effective sun position (as irrad::timeStepSunPosition) of one timestamp
+	void get(size_t index, double sun[9], int sunPosition[3]) const;
+
+	/// Sun angles in radians and other solarpos() results, sun[k][index] for component k of sunn[9]
+	std::vector<double> sun[9];
+
+	/// Effective hour and minute used for the sun position, and sun up flag (0=no, 1=midday, 2=sunup, 3=sundown)
+	std::vector<int> calcHour, calcMinute, sunup;
+
+private:
+	bool matches(double lat, double lon, double tz, double delt_hr,
+		const std::vector<int> &year, const std::vector<int> &month, const std::vector<int> &day,
+		const std::vector<int> &hour, const std::vector<double> &minute) const;
+
+	double latitudeDegrees, longitudeDegrees, timezone, delt;
+	std::vector<int> years, months, days, hours;
+	std::vector<double> minutes;
+};
+
+/**
+* \class incidence_table
+*
+* Surface angles from incidence() for every timestamp of a solarpos_table and one fixed surface orientation,
+* stored as one array per component.  Entries where the sun is down are zero, as in irrad::calc().
+*/
+class incidence_table
+{
+public:
+	incidence_table(const solarpos_table &sun, int mode, double tilt, double sazm, double rlim, bool en_backtrack, double gcr);
+
+	/// Number of timestamps in the table
+	size_t size() const { return angle[0].size(); }
+
+	/// Copy the surface angles of one timestamp, as from incidence()
+	void get(size_t index, double surfaceAngles[5]) const;
+
+	/// Surface angles, angle[k][index] for component k of incidence() angle[5]
+	std::vector<double> angle[5];
+};
+
+/**
+* \class bifacial_workspace
+*
+* Buffers used by irrad::calc_rear_side(), kept across timesteps so that the rear-side calculation
+* does not allocate once the buffers have grown to size.  The sky configuration factors depend only on
+* the array geometry, so they are recomputed only when the geometry changes (every timestep for trackers,
+* once per simulation for fixed arrays).  Keep one workspace per subarray.
+*/
+class bifacial_workspace
+{
+public:
+	bifacial_workspace();
+
+	/// Compute the sky configuration factors with irrad::getSkyConfigurationFactors() unless they are already computed for this geometry
+	void update_geometry(irrad &irr, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength);
+
+	/// Number of times the sky configuration factors have been computed
+	size_t sky_config_count() const { return skyConfigCount; }
+
+	std::vector<double> rearSkyConfigFactors, frontSkyConfigFactors;
+	std::vector<int> rearGroundShade, frontGroundShade;
+	std::vector<double> rearGroundGHI, frontGroundGHI;
+	std::vector<double> frontIrradiance, frontReflected, rearIrradiance;
+
+private:
+	bool hasGeometry;
+	double geometry[5];
+	size_t skyConfigCount;
+};
+
 /**
 * Perez function for calculating values of diffuse + direct 
 * solar radiation + ground reflected radiation for a tilted surface and returns the total plane-of-array irradiance(poa),
@@ -329,6 +432,11 @@ protected:
 	int timeStepSunPosition[3];				///< [0] effective hour of day used for sun position, [1] effective minute of hour used for sun position, [2] is sun up?  (0=no, 1=midday, 2=sunup, 3=sundown)
 	double planeOfArrayIrradianceRearAverage; ///< Average rear side plane-of-array irradiance (W/m2)
 
+	// Precomputed angles
+	const solarpos_table *sunPositionTable;		///< Precomputed sun positions used by calc() instead of solarpos(), may be NULL
+	const incidence_table *surfaceAngleTable;	///< Precomputed surface angles used by calc() instead of incidence(), may be NULL
+	size_t angleTableIndex;						///< Index of the current timestep in the precomputed tables
+
 public:
 
 	/// Directive to indicate that if delt_hr is less than zero, do not interpolate sunrise and sunset hours
@@ -384,11 +492,14 @@ public:
 	/// Function to overwrite internally calculated sun position values, primarily to enable testing against other libraries using different sun position calculations
 	void set_sun_component(size_t index, double value);
 
+	/// Use precomputed sun positions and surface angles (either may be NULL) for the current timestep instead of calculating them in calc()
+	void set_angle_tables(const solarpos_table *sunTable, const incidence_table *surfaceTable, size_t index);
+
 	/// Run the irradiance processor and calculate the plane-of-array irradiance and diffuse components of irradiance
 	int calc();
 
-	/// Run the irradiance processor for the rear-side of the surface to calculate rear-side plane-of-array irradiance
-	int calc_rear_side(double transmissionFactor, double bifaciality, double groundClearanceHeight, double slopeLength);
+	/// Run the irradiance processor for the rear-side of the surface to calculate rear-side plane-of-array irradiance, reusing the buffers in workspace if not NULL
+	int calc_rear_side(double transmissionFactor, double bifaciality, double groundClearanceHeight, double slopeLength, bifacial_workspace *workspace = 0);
 	
 	/// Return the calculated sun angles, some of which are converted to degrees
 	void get_sun( double *solazi,
@@ -435,13 +546,13 @@ public:
 	void getGroundShadeFactors(double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, double solarAzimuthRadians, double solarElevationRadians, std::vector<int> & rearGroundFactors, std::vector<int> & frontGroundFactors, double & maxShadow, double & pvBackShadeFraction, double & pvFrontShadeFraction);
 
 	/// Return the ground global-horizonal irradiance, used by \link calc_rear_side()
-	void getGroundGHI(double transmissionFactor, std::vector<double> rearSkyConfigFactors, std::vector<double> frontSkyConfigFactors, std::vector<int> rearGroundShadeFactors, std::vector<int> frontGroundShadeFactors, std::vector<double> & rearGroundGHI, std::vector<double> & frontGroundGHI);
+	void getGroundGHI(double transmissionFactor, const std::vector<double> & rearSkyConfigFactors, const std::vector<double> & frontSkyConfigFactors, const std::vector<int> & rearGroundShadeFactors, const std::vector<int> & frontGroundShadeFactors, std::vector<double> & rearGroundGHI, std::vector<double> & frontGroundGHI);
 
 	/// Return the back surface irradiances, used by \link calc_rear_side()
-	void getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, std::vector<double> rearGroundGHI, std::vector<double> frontGroundGHI, std::vector<double> frontReflected, std::vector<double> & rearIrradiance, double & rearAverageIrradiance);
+	void getBackSurfaceIrradiances(double pvBackShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, const std::vector<double> & rearGroundGHI, const std::vector<double> & frontGroundGHI, const std::vector<double> & frontReflected, std::vector<double> & rearIrradiance, double & rearAverageIrradiance);
 
 	/// Return the front surface irradiances, used by \link calc_rear_side()
-	void getFrontSurfaceIrradiances(double pvBackShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, std::vector<double> frontGroundGHI, std::vector<double> & frontIrradiance, double & frontAverageIrradiance, std::vector<double> & frontReflected);
+	void getFrontSurfaceIrradiances(double pvBackShadeFraction, double rowToRow, double verticalHeight, double clearanceGround, double distanceBetweenRows, double horizontalLength, const std::vector<double> & frontGroundGHI, std::vector<double> & frontIrradiance, double & frontAverageIrradiance, std::vector<double> & frontReflected);
 
 	enum RADMODE { DN_DF, DN_GH, GH_DF, POA_R, POA_P };
 	enum SKYMODEL { ISOTROPIC, HDKR, PEREZ };
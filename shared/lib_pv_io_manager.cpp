@@ -78,8 +78,10 @@ Simulation_IO::Simulation_IO(compute_module* cm, Irradiance_IO & IrradianceIO)
 	useLifetimeOutput = false;
 	if (cm->is_assigned("system_use_lifetime_output")) useLifetimeOutput = cm->as_integer("system_use_lifetime_output");
 	numberOfYears = 1;
+	reuseFirstYearDC = false;
 	if (useLifetimeOutput) {
 		numberOfYears = cm->as_integer("analysis_period");
+		reuseFirstYearDC = cm->as_boolean("en_lifetime_dc_reuse");
 	}
 	numberOfSteps = numberOfYears * numberOfWeatherFileRecords;
 }
@@ -704,27 +706,29 @@ void PVSystem_IO::AllocateOutputs(compute_module* cm)
 		if (Subarrays[subarray]->enable)
 		{
 			std::string prefix = Subarrays[subarray]->prefix;
-			p_angleOfIncidence.push_back(cm->allocate(prefix + "aoi", numberOfWeatherFileRecords));
-			p_angleOfIncidenceModifier.push_back(cm->allocate(prefix + "aoi_modifier", numberOfWeatherFileRecords));
-			p_surfaceTilt.push_back(cm->allocate(prefix + "surf_tilt", numberOfWeatherFileRecords));
-			p_surfaceAzimuth.push_back(cm->allocate(prefix + "surf_azi", numberOfWeatherFileRecords));
-			p_axisRotation.push_back(cm->allocate(prefix + "axisrot", numberOfWeatherFileRecords));
-			p_idealRotation.push_back(cm->allocate(prefix + "idealrot", numberOfWeatherFileRecords));
+
+			// diagnostic outputs that are only written in the simulation loop are not allocated unless requested
+			p_angleOfIncidence.push_back(cm->allocate_if_requested(prefix + "aoi", numberOfWeatherFileRecords));
+			p_angleOfIncidenceModifier.push_back(cm->allocate_if_requested(prefix + "aoi_modifier", numberOfWeatherFileRecords));
+			p_surfaceTilt.push_back(cm->allocate_if_requested(prefix + "surf_tilt", numberOfWeatherFileRecords));
+			p_surfaceAzimuth.push_back(cm->allocate_if_requested(prefix + "surf_azi", numberOfWeatherFileRecords));
+			p_axisRotation.push_back(cm->allocate_if_requested(prefix + "axisrot", numberOfWeatherFileRecords));
+			p_idealRotation.push_back(cm->allocate_if_requested(prefix + "idealrot", numberOfWeatherFileRecords));
 			p_poaNominalFront.push_back(cm->allocate(prefix + "poa_nom", numberOfWeatherFileRecords));
-			p_poaShadedFront.push_back(cm->allocate(prefix + "poa_shaded", numberOfWeatherFileRecords));
-			p_poaShadedSoiledFront.push_back(cm->allocate(prefix + "poa_shaded_soiled", numberOfWeatherFileRecords));
-			p_poaBeamFront.push_back(cm->allocate(prefix + "poa_eff_beam", numberOfWeatherFileRecords));
-			p_poaDiffuseFront.push_back(cm->allocate(prefix + "poa_eff_diff", numberOfWeatherFileRecords));
+			p_poaShadedFront.push_back(cm->allocate_if_requested(prefix + "poa_shaded", numberOfWeatherFileRecords));
+			p_poaShadedSoiledFront.push_back(cm->allocate_if_requested(prefix + "poa_shaded_soiled", numberOfWeatherFileRecords));
+			p_poaBeamFront.push_back(cm->allocate_if_requested(prefix + "poa_eff_beam", numberOfWeatherFileRecords));
+			p_poaDiffuseFront.push_back(cm->allocate_if_requested(prefix + "poa_eff_diff", numberOfWeatherFileRecords));
 			p_poaTotal.push_back(cm->allocate(prefix + "poa_eff", numberOfWeatherFileRecords));
 			p_poaRear.push_back(cm->allocate(prefix + "poa_rear", numberOfWeatherFileRecords));
 			p_poaFront.push_back(cm->allocate(prefix + "poa_front", numberOfWeatherFileRecords));
-			p_derateSoiling.push_back(cm->allocate(prefix + "soiling_derate", numberOfWeatherFileRecords));
-			p_beamShadingFactor.push_back(cm->allocate(prefix + "beam_shading_factor", numberOfWeatherFileRecords));
-			p_temperatureCell.push_back(cm->allocate(prefix + "celltemp", numberOfWeatherFileRecords));
-			p_moduleEfficiency.push_back(cm->allocate(prefix + "modeff", numberOfWeatherFileRecords));
+			p_derateSoiling.push_back(cm->allocate_if_requested(prefix + "soiling_derate", numberOfWeatherFileRecords));
+			p_beamShadingFactor.push_back(cm->allocate_if_requested(prefix + "beam_shading_factor", numberOfWeatherFileRecords));
+			p_temperatureCell.push_back(cm->allocate_if_requested(prefix + "celltemp", numberOfWeatherFileRecords));
+			p_moduleEfficiency.push_back(cm->allocate_if_requested(prefix + "modeff", numberOfWeatherFileRecords));
 			p_dcStringVoltage.push_back(cm->allocate(prefix + "dc_voltage", numberOfWeatherFileRecords));
-			p_voltageOpenCircuit.push_back(cm->allocate(prefix + "voc", numberOfWeatherFileRecords));
-			p_currentShortCircuit.push_back(cm->allocate(prefix + "isc", numberOfWeatherFileRecords));
+			p_voltageOpenCircuit.push_back(cm->allocate_if_requested(prefix + "voc", numberOfWeatherFileRecords));
+			p_currentShortCircuit.push_back(cm->allocate_if_requested(prefix + "isc", numberOfWeatherFileRecords));
 			p_dcPowerGross.push_back(cm->allocate(prefix + "dc_gross", numberOfWeatherFileRecords));
 			p_derateLinear.push_back(cm->allocate(prefix + "linear_derate", numberOfWeatherFileRecords));
 			p_derateSelfShading.push_back(cm->allocate(prefix + "ss_derate", numberOfWeatherFileRecords));
@@ -739,13 +743,13 @@ void PVSystem_IO::AllocateOutputs(compute_module* cm)
 			if (Subarrays[subarray]->enableSelfShadingOutputs)
 			{
 				// ShadeDB validation
-				p_shadeDB_GPOA.push_back(cm->allocate("shadedb_" + prefix + "gpoa", numberOfWeatherFileRecords));
-				p_shadeDB_DPOA.push_back(cm->allocate("shadedb_" + prefix + "dpoa", numberOfWeatherFileRecords));
-				p_shadeDB_temperatureCell.push_back(cm->allocate("shadedb_" + prefix + "pv_cell_temp", numberOfWeatherFileRecords));
-				p_shadeDB_modulesPerString.push_back(cm->allocate("shadedb_" + prefix + "mods_per_str", numberOfWeatherFileRecords));
-				p_shadeDB_voltageMaxPowerSTC.push_back(cm->allocate("shadedb_" + prefix + "str_vmp_stc", numberOfWeatherFileRecords));
-				p_shadeDB_voltageMPPTLow.push_back(cm->allocate("shadedb_" + prefix + "mppt_lo", numberOfWeatherFileRecords));
-				p_shadeDB_voltageMPPTHigh.push_back(cm->allocate("shadedb_" + prefix + "mppt_hi", numberOfWeatherFileRecords));
+				p_shadeDB_GPOA.push_back(cm->allocate_if_requested("shadedb_" + prefix + "gpoa", numberOfWeatherFileRecords));
+				p_shadeDB_DPOA.push_back(cm->allocate_if_requested("shadedb_" + prefix + "dpoa", numberOfWeatherFileRecords));
+				p_shadeDB_temperatureCell.push_back(cm->allocate_if_requested("shadedb_" + prefix + "pv_cell_temp", numberOfWeatherFileRecords));
+				p_shadeDB_modulesPerString.push_back(cm->allocate_if_requested("shadedb_" + prefix + "mods_per_str", numberOfWeatherFileRecords));
+				p_shadeDB_voltageMaxPowerSTC.push_back(cm->allocate_if_requested("shadedb_" + prefix + "str_vmp_stc", numberOfWeatherFileRecords));
+				p_shadeDB_voltageMPPTLow.push_back(cm->allocate_if_requested("shadedb_" + prefix + "mppt_lo", numberOfWeatherFileRecords));
+				p_shadeDB_voltageMPPTHigh.push_back(cm->allocate_if_requested("shadedb_" + prefix + "mppt_hi", numberOfWeatherFileRecords));
 			}
 			p_shadeDBShadeFraction.push_back(cm->allocate("shadedb_" + prefix + "shade_frac", numberOfWeatherFileRecords));
 		}
@@ -227,6 +227,7 @@ struct Simulation_IO
 	size_t stepsPerHour;
 	double dtHour;
 	flag useLifetimeOutput;
+	flag reuseFirstYearDC;	///< Reuse the first year DC power for later years of a lifetime simulation
 };
 
 /***
@@ -52,6 +52,7 @@
 #include <algorithm>    // std::sort
 #include <math.h> // logarithm function
 #include <cstring> // memcpy
+#include <mutex> // process-wide database cache
 
 #include "lib_miniz.h" // decompression
 #include "DB8_vmpp_impp_uint8_bin.h" // char* of binary compressed file
@@ -67,7 +68,7 @@ typedef unsigned int uint;
 
 short ShadeDB8_mpp::get_vmpp(size_t i)
 {
-	if (i < 6045840) // uint16 check
+	if (p_vmpp && i < 6045840) // uint16 check
 		return (short)((p_vmpp[2 * i + 1] << 8) | p_vmpp[2 * i]); 
 	else 
 		return -1;
@@ -75,7 +76,7 @@ short ShadeDB8_mpp::get_vmpp(size_t i)
 
 short ShadeDB8_mpp::get_impp(size_t i)
 { 
-	if (i < 6045840) // uint16 check
+	if (p_impp && i < 6045840) // uint16 check
 		return (short)((p_impp[2 * i + 1] << 8) | p_impp[2 * i]); 
 	else 
 		return -1; 
@@ -190,46 +191,81 @@ void ShadeDB8_mpp::init()
 	p_warning_msg = "";
 	p_vmpp_uint8_size = 12091680; // uint8 size from matlab
 	p_impp_uint8_size = 12091680; // uint8 size from matlab
-	p_vmpp = (unsigned char *)malloc(p_vmpp_uint8_size);//malloc(12091680); uint8 size
-	p_impp = (unsigned char *)malloc(p_impp_uint8_size);//malloc(12091680); uint8 size
 	p_compressed_size = 3133517; // from modified example5.c in miniz project
 	decompress_file_to_uint8();
 }
 
 ShadeDB8_mpp::~ShadeDB8_mpp()
 {
-	if (p_vmpp)
-		free(p_vmpp);
-	if (p_impp)
-		free(p_impp);
+	// the process-wide cache keeps the decompressed tables until exit; p_db drops this instance's reference
+	p_vmpp = NULL;
+	p_impp = NULL;
 }
 
+// The decompressed database is read-only, so a single copy is inflated on first use and
+// shared by every ShadeDB8_mpp instance (and every concurrent simulation) in the process.
+static std::mutex &shade_db8_mutex()
+{
+	static std::mutex mtx;
+	return mtx;
+}
 
-
-bool ShadeDB8_mpp::decompress_file_to_uint8()
+static std::shared_ptr<const std::vector<uint8> > &shade_db8_cache()
 {
-	size_t status;
-	uint8 *pTmp_data;
+	static std::shared_ptr<const std::vector<uint8> > db;
+	return db;
+}
 
-	size_t mem_size = p_vmpp_uint8_size + p_impp_uint8_size;
+static size_t shade_db8_decompress_count = 0;
 
-	pTmp_data = (uint8 *)malloc(mem_size);
+std::shared_ptr<const std::vector<uint8> > ShadeDB8_mpp::shared_db(std::string &error_msg)
+{
+	std::lock_guard<std::mutex> lock(shade_db8_mutex());
+	std::shared_ptr<const std::vector<uint8> > &db = shade_db8_cache();
+	if (!db)
+	{
+		size_t mem_size = 2 * 12091680; // vmpp + impp uint8 sizes
+		std::shared_ptr<std::vector<uint8> > tmp(new std::vector<uint8>(mem_size));
 
-	status = tinfl_decompress_mem_to_mem((void *)pTmp_data, mem_size, pCmp_data, p_compressed_size, TINFL_FLAG_PARSE_ZLIB_HEADER);
+		size_t status = tinfl_decompress_mem_to_mem((void *)&(*tmp)[0], mem_size, pCmp_data, 3133517, TINFL_FLAG_PARSE_ZLIB_HEADER);
+		shade_db8_decompress_count++;
 
-	memcpy(p_vmpp, pTmp_data, p_vmpp_uint8_size);
-	memcpy(p_impp, pTmp_data + p_vmpp_uint8_size, p_impp_uint8_size);
+		if (status == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED)
+		{
+			std::stringstream outm;
+			outm << "tinfl_decompress_mem_to_mem() failed with status " << (int)status;
+			error_msg = outm.str();
+			return std::shared_ptr<const std::vector<uint8> >();
+		}
+		db = tmp;
+	}
+	return db;
+}
 
-	free(pTmp_data);
+size_t ShadeDB8_mpp::decompress_count()
+{
+	std::lock_guard<std::mutex> lock(shade_db8_mutex());
+	return shade_db8_decompress_count;
+}
 
-	if (status == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED)
+long ShadeDB8_mpp::use_count()
+{
+	std::lock_guard<std::mutex> lock(shade_db8_mutex());
+	return shade_db8_cache().use_count();
+}
+
+bool ShadeDB8_mpp::decompress_file_to_uint8()
+{
+	p_db = shared_db(p_error_msg);
+	if (!p_db)
 	{
-		std::stringstream outm;
-		outm << "tinfl_decompress_mem_to_mem() failed with status " << (int)status;
-		p_error_msg = outm.str();
-		return EXIT_FAILURE;
+		p_vmpp = NULL;
+		p_impp = NULL;
+		return false;
 	}
 
+	p_vmpp = &(*p_db)[0];
+	p_impp = &(*p_db)[0] + p_vmpp_uint8_size;
 	return true;
 };
 
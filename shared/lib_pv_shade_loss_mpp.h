@@ -56,6 +56,7 @@
 #include <vector>
 #include <stdlib.h>
 #include <string>
+#include <memory>
 
 extern const unsigned char pCmp_data[3133517];
 // shading database with up to 8 strings
@@ -68,6 +69,7 @@ public:
 		p_impp=NULL ;
 	};
 	~ShadeDB8_mpp();
+	/// Attach to the process-wide decompressed database, inflating pCmp_data on first use only
 	void init();
 	short vmpp(size_t ndx){
 		return get_vmpp(ndx);
@@ -83,13 +85,19 @@ public:
 	std::string get_warning() { return p_warning_msg; }
 	std::string get_error() { return p_error_msg; }
 
+	/// Number of times pCmp_data has been inflated in this process (1 once any instance is initialized)
+	static size_t decompress_count();
+	/// Number of ShadeDB8_mpp instances (plus the process cache) currently holding the decompressed tables
+	static long use_count();
 
 private:
-	unsigned char *p_vmpp;
-	unsigned char *p_impp;
+	const unsigned char *p_vmpp;
+	const unsigned char *p_impp;
+	std::shared_ptr<const std::vector<unsigned char> > p_db;
 	short get_vmpp(size_t i);
 	short get_impp(size_t i);
 	bool decompress_file_to_uint8();
+	static std::shared_ptr<const std::vector<unsigned char> > shared_db(std::string &error_msg);
 	size_t p_vmpp_uint8_size;
 	size_t p_impp_uint8_size;
 	size_t p_compressed_size;
@@ -274,7 +274,8 @@ bool util::mkdir( const char *path, bool make_full )
 	
 		if (parts.size() < 1) return false;
 		
-		std::string cur_path = parts[0] + path_separator();
+		// split() drops the empty part before the root of an absolute POSIX path
+		std::string cur_path = (path[0] == '/' ? "/" : "") + parts[0] + path_separator();
 		
 		for (size_t i=1;i<parts.size();i++)
 		{
@@ -286,25 +286,40 @@ namespace util
 	protected:
 		T *t_array;
 		size_t n_rows, n_cols;
+		bool t_owned; // false when t_array references an external buffer (see assign_ref)
 	public:
 
 		matrix_t()
 		{
 			t_array = new T[1];
 			n_rows = n_cols = 1;
+			t_owned = true;
 		}
 
 		matrix_t( const matrix_t &cc )
 		{
 			n_rows = n_cols = 0;
 			t_array = NULL;
+			t_owned = true;
 			copy( cc );
 		}
+
+		matrix_t( matrix_t &&rhs )
+		{
+			t_array = rhs.t_array;
+			n_rows = rhs.n_rows;
+			n_cols = rhs.n_cols;
+			t_owned = rhs.t_owned;
+			rhs.t_array = new T[1];
+			rhs.n_rows = rhs.n_cols = 1;
+			rhs.t_owned = true;
+		}
 		
 		matrix_t(size_t len)
 		{
 			n_rows = n_cols = 0;
 			t_array = NULL;
+			t_owned = true;
 			if (len < 1) len = 1;
 			resize( 1, len );
 		}
@@ -313,6 +328,7 @@ namespace util
 		{
 			n_rows = n_cols = 0;
 			t_array = NULL;
+			t_owned = true;
 			if (nr < 1) nr = 1;
 			if (nc < 1) nc = 1;
 			resize(nr,nc);
@@ -322,6 +338,7 @@ namespace util
 		{
 			n_rows = n_cols = 0;
 			t_array = NULL;
+			t_owned = true;
 			if (nr < 1) nr = 1;
 			if (nc < 1) nc = 1;
 			resize(nr,nc);
@@ -331,6 +348,7 @@ namespace util
 		{
 			n_rows = n_cols = 0;
 			t_array = NULL;
+			t_owned = true;
 			if (nr < 1) nr = 1;
 			if (nc < 1) nc = 1;
 			resize(nr, nc);
@@ -342,20 +360,22 @@ namespace util
 
 		virtual ~matrix_t()
 		{
-			if (t_array) delete [] t_array;
+			if (t_array && t_owned) delete [] t_array;
 		}
 		
 		void clear()
 		{
-			if (t_array) delete [] t_array;
+			if (t_array && t_owned) delete [] t_array;
 			n_rows = n_cols = 1;
 			t_array = new T[1];
+			t_owned = true;
 		}
 		
 		void copy( const matrix_t &rhs )
 		{
 			if (this != &rhs)
 			{
+				if (!t_owned) detach();
 				resize( rhs.nrows(), rhs.ncols() );
 				size_t nn = n_rows*n_cols;
 				for (size_t i=0;i<nn;i++)
@@ -365,6 +385,7 @@ namespace util
 
 		void assign( const T *pvalues, size_t len )
 		{
+			if (!t_owned) detach();
 			resize( len );
 			if ( n_cols == len && n_rows == 1 )
 				for (size_t i=0;i<len;i++)
@@ -373,6 +394,7 @@ namespace util
 		
 		void assign( const T *pvalues, size_t nr, size_t nc )
 		{
+			if (!t_owned) detach();
 			resize( nr, nc );
 			if ( n_rows == nr && n_cols == nc )
 			{
@@ -382,6 +404,42 @@ namespace util
 			}
 		}
 
+		/* reference an external buffer of nr*nc values without copying it.  the matrix
+		   reads and writes the buffer in place and never frees it, so the buffer must
+		   outlive the matrix or the next assign/copy/resize to a different size */
+		void assign_ref( T *pvalues, size_t nr, size_t nc )
+		{
+			if (!pvalues || nr < 1 || nc < 1) return;
+			if (t_array && t_owned) delete [] t_array;
+			t_array = pvalues;
+			n_rows = nr;
+			n_cols = nc;
+			t_owned = false;
+		}
+
+		/* give up the buffer to the caller, who must delete [] it, and leave a 1x1 matrix.
+		   a referenced external buffer is copied first so the result is always owned */
+		T *release()
+		{
+			T *p = t_array;
+			if (!t_owned)
+			{
+				size_t nn = n_rows*n_cols;
+				p = new T[ nn ];
+				for (size_t i=0;i<nn;i++)
+					p[i] = t_array[i];
+			}
+			t_array = new T[1];
+			n_rows = n_cols = 1;
+			t_owned = true;
+			return p;
+		}
+
+		inline bool owns_data() const
+		{
+			return t_owned;
+		}
+
 		matrix_t &operator=(const matrix_t &rhs)
 		{
 			if ( this != &rhs )
@@ -389,6 +447,23 @@ namespace util
 
 			return *this;
 		}
+
+		matrix_t &operator=(matrix_t &&rhs)
+		{
+			if ( this != &rhs )
+			{
+				if (t_array && t_owned) delete [] t_array;
+				t_array = rhs.t_array;
+				n_rows = rhs.n_rows;
+				n_cols = rhs.n_cols;
+				t_owned = rhs.t_owned;
+				rhs.t_array = new T[1];
+				rhs.n_rows = rhs.n_cols = 1;
+				rhs.t_owned = true;
+			}
+
+			return *this;
+		}
 		
 		matrix_t &operator=(const T &val)
 		{
@@ -436,10 +511,11 @@ namespace util
 			if (nr < 1 || nc < 1) return;
 			if (nr == n_rows && nc == n_cols) return;
 			
-			if (t_array) delete [] t_array;
+			if (t_array && t_owned) delete [] t_array;
 			t_array = new T[ nr * nc ];
 			n_rows = nr;
 			n_cols = nc;
+			t_owned = true;
 		}
 
 		void resize_fill(size_t nr, size_t nc, const T &val)
@@ -587,6 +663,15 @@ namespace util
 		{
 			return t_array[0];
 		}
+
+	private:
+		// stop referencing an external buffer before overwriting the contents
+		void detach()
+		{
+			t_array = NULL;
+			n_rows = n_cols = 0;
+			t_owned = true;
+		}
 	};
 
 	template< typename T >
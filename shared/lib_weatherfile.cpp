@@ -59,6 +59,20 @@
 #include <fstream>
 #include <sstream>
 
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <mutex>
+#include <atomic>
+
 #if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
 #define CASECMP(a,b) _stricmp(a,b)
 #define CASENCMP(a,b,n) _strnicmp(a,b,n)
@@ -474,6 +488,11 @@ void weatherfile::reset()
 
 	m_hdr.reset();
 	//m_rec.reset();
+
+	for (size_t i = 0; i < _MAXCOL_; i++)
+		m_columns[i].mapped = 0;
+	m_mapping.reset();
+	m_fromCache = false;
 }
 
 
@@ -576,7 +595,7 @@ bool weatherfile::timeStepChecks(int hdr_step_sec) {
 	return true;
 }
 
-bool weatherfile::open(const std::string &file, bool header_only)
+bool weatherfile::parse(const std::string &file, bool header_only)
 {
 	if (file.empty())
 	{
@@ -1513,25 +1532,25 @@ bool weatherfile::read_average(weather_record *r, std::vector<int> &cols, size_t
 {
 	if (r && m_index < m_nRecords && num_timesteps > 0 && num_timesteps < m_nRecords)
 	{
-		r->year = (int)m_columns[YEAR].data[m_index];
-		r->month = (int)m_columns[MONTH].data[m_index];
-		r->day = (int)m_columns[DAY].data[m_index];
-		r->hour = (int)m_columns[HOUR].data[m_index];
-		r->minute = m_columns[MINUTE].data[m_index];
-		r->gh = m_columns[GHI].data[m_index];
-		r->dn = m_columns[DNI].data[m_index];
-		r->df = m_columns[DHI].data[m_index];
-		r->poa = m_columns[POA].data[m_index];
-		r->wspd = m_columns[WSPD].data[m_index];
-		r->wdir = m_columns[WDIR].data[m_index];
-		r->tdry = m_columns[TDRY].data[m_index];
-		r->twet = m_columns[TWET].data[m_index];
-		r->tdew = m_columns[TDEW].data[m_index];
-		r->rhum = m_columns[RH].data[m_index];
-		r->pres = m_columns[PRES].data[m_index];
-		r->snow = m_columns[SNOW].data[m_index];
-		r->alb = m_columns[ALB].data[m_index];
-		r->aod = m_columns[AOD].data[m_index];
+		r->year = (int)value(YEAR, m_index);
+		r->month = (int)value(MONTH, m_index);
+		r->day = (int)value(DAY, m_index);
+		r->hour = (int)value(HOUR, m_index);
+		r->minute = value(MINUTE, m_index);
+		r->gh = value(GHI, m_index);
+		r->dn = value(DNI, m_index);
+		r->df = value(DHI, m_index);
+		r->poa = value(POA, m_index);
+		r->wspd = value(WSPD, m_index);
+		r->wdir = value(WDIR, m_index);
+		r->tdry = value(TDRY, m_index);
+		r->twet = value(TWET, m_index);
+		r->tdew = value(TDEW, m_index);
+		r->rhum = value(RH, m_index);
+		r->pres = value(PRES, m_index);
+		r->snow = value(SNOW, m_index);
+		r->alb = value(ALB, m_index);
+		r->aod = value(AOD, m_index);
 
 		// average columns requested
 		int start = (int)m_index - (int)num_timesteps / 2;
@@ -1551,7 +1570,7 @@ bool weatherfile::read_average(weather_record *r, std::vector<int> &cols, size_t
 			{
 				for (size_t j = (size_t)start; j < num_timesteps && j < m_nRecords; j++)
 				{
-					col_val += m_columns[cols[i]].data[start];
+					col_val += value(cols[i], start);
 					n_vals++;
 				}
 				if (n_vals > 0)
@@ -1637,25 +1656,25 @@ bool weatherfile::read( weather_record *r )
 {
 	if ( r && m_index < m_nRecords)
 	{
-		r->year = (int)m_columns[YEAR].data[m_index];
-		r->month = (int)m_columns[MONTH].data[m_index];
-		r->day = (int)m_columns[DAY].data[m_index];
-		r->hour = (int)m_columns[HOUR].data[m_index];
-		r->minute = m_columns[MINUTE].data[m_index];
-		r->gh = m_columns[GHI].data[m_index];
-		r->dn = m_columns[DNI].data[m_index];
-		r->df = m_columns[DHI].data[m_index];
-		r->poa = m_columns[POA].data[m_index];
-		r->wspd = m_columns[WSPD].data[m_index];
-		r->wdir = m_columns[WDIR].data[m_index];
-		r->tdry = m_columns[TDRY].data[m_index];
-		r->twet = m_columns[TWET].data[m_index];
-		r->tdew = m_columns[TDEW].data[m_index];
-		r->rhum = m_columns[RH].data[m_index];
-		r->pres = m_columns[PRES].data[m_index];
-		r->snow = m_columns[SNOW].data[m_index];
-		r->alb = m_columns[ALB].data[m_index];
-		r->aod = m_columns[AOD].data[m_index];
+		r->year = (int)value(YEAR, m_index);
+		r->month = (int)value(MONTH, m_index);
+		r->day = (int)value(DAY, m_index);
+		r->hour = (int)value(HOUR, m_index);
+		r->minute = value(MINUTE, m_index);
+		r->gh = value(GHI, m_index);
+		r->dn = value(DNI, m_index);
+		r->df = value(DHI, m_index);
+		r->poa = value(POA, m_index);
+		r->wspd = value(WSPD, m_index);
+		r->wdir = value(WDIR, m_index);
+		r->tdry = value(TDRY, m_index);
+		r->twet = value(TWET, m_index);
+		r->tdew = value(TDEW, m_index);
+		r->rhum = value(RH, m_index);
+		r->pres = value(PRES, m_index);
+		r->snow = value(SNOW, m_index);
+		r->alb = value(ALB, m_index);
+		r->aod = value(AOD, m_index);
 
 		m_index++;
 		return true;
@@ -1669,6 +1688,403 @@ bool weatherfile::has_data_column( size_t id )
 	return m_columns[id].index >= 0;
 }
 
+/* binary weather cache: fixed header, header strings, then _MAXCOL_ columns of nrecords floats */
+
+#define WFCACHE_MAGIC "SSCWFC01"
+#define WFCACHE_VERSION 2
+
+struct weatherfile_cache_header
+{
+	char magic[8];
+	unsigned int version;
+	unsigned int ncols;
+	unsigned long long source_size;
+	long long source_mtime;
+	unsigned long long source_hash;
+	unsigned long long nrecords;
+	unsigned long long start_sec;
+	unsigned long long step_sec;
+	unsigned long long data_offset;
+	int type;
+	int start_year;
+	int has_leap_year;
+	int hasunits;
+	double time;
+	double tz;
+	double lat;
+	double lon;
+	double elev;
+	int column_index[weather_data_provider::_MAXCOL_];
+};
+
+class weatherfile_mapping
+{
+public:
+	weatherfile_mapping() : m_data(0), m_size(0)
+	{
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+		m_file = INVALID_HANDLE_VALUE;
+		m_map = NULL;
+#else
+		m_fd = -1;
+#endif
+	}
+
+	~weatherfile_mapping()
+	{
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+		if (m_data) UnmapViewOfFile(m_data);
+		if (m_map) CloseHandle(m_map);
+		if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+		if (m_data) munmap((void*)m_data, m_size);
+		if (m_fd >= 0) ::close(m_fd);
+#endif
+	}
+
+	bool map(const std::string &file)
+	{
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+		m_file = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (m_file == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) return false;
+		m_size = (size_t)size.QuadPart;
+		m_map = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!m_map) return false;
+		m_data = (const unsigned char*)MapViewOfFile(m_map, FILE_MAP_READ, 0, 0, 0);
+#else
+		m_fd = ::open(file.c_str(), O_RDONLY);
+		if (m_fd < 0) return false;
+		struct stat st;
+		if (fstat(m_fd, &st) != 0 || st.st_size == 0) return false;
+		m_size = (size_t)st.st_size;
+		void *p = mmap(0, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+		m_data = (p == MAP_FAILED) ? 0 : (const unsigned char*)p;
+#endif
+		return m_data != 0;
+	}
+
+	const unsigned char *data() { return m_data; }
+	size_t size() { return m_size; }
+
+private:
+	const unsigned char *m_data;
+	size_t m_size;
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+	HANDLE m_file;
+	HANDLE m_map;
+#else
+	int m_fd;
+#endif
+};
+
+// 64-bit FNV-1a
+static unsigned long long fnv1a(const char *p, size_t n, unsigned long long h = 14695981039346656037ULL)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		h ^= (unsigned char)p[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+static bool hash_file(const std::string &file, unsigned long long *size, unsigned long long *hash)
+{
+	std::ifstream ifs(file, std::ios::in | std::ios::binary);
+	if (!ifs.is_open()) return false;
+
+	std::vector<char> buf(1 << 16);
+	*size = 0;
+	*hash = 14695981039346656037ULL;
+	while (ifs)
+	{
+		ifs.read(&buf[0], buf.size());
+		size_t n = (size_t)ifs.gcount();
+		*hash = fnv1a(&buf[0], n, *hash);
+		*size += n;
+	}
+	return true;
+}
+
+// size and last modification time of a file, the time in the finest units the platform provides
+static bool file_stamp(const std::string &file, unsigned long long *size, long long *mtime)
+{
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA fad;
+	if (!GetFileAttributesExA(file.c_str(), GetFileExInfoStandard, &fad)) return false;
+	*size = ((unsigned long long)fad.nFileSizeHigh << 32) | fad.nFileSizeLow;
+	*mtime = (long long)(((unsigned long long)fad.ftLastWriteTime.dwHighDateTime << 32) | fad.ftLastWriteTime.dwLowDateTime);
+#else
+	struct stat st;
+	if (stat(file.c_str(), &st) != 0) return false;
+	*size = (unsigned long long)st.st_size;
+#if defined(__APPLE__)
+	*mtime = (long long)st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+	*mtime = (long long)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+#endif
+	return true;
+}
+
+// temporary file name next to 'file' that is unique across threads and processes
+static std::string unique_temp_name(const std::string &file)
+{
+	static std::atomic<unsigned int> counter(0);
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+	unsigned int pid = (unsigned int)GetCurrentProcessId();
+#else
+	unsigned int pid = (unsigned int)getpid();
+#endif
+	return file + util::format(".%u.%u.tmp", pid, counter++);
+}
+
+// replace 'file' with 'tmp' in one step, so readers see either the old or the new file
+static bool replace_file(const std::string &tmp, const std::string &file)
+{
+#if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
+	return MoveFileExA(tmp.c_str(), file.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(tmp.c_str(), file.c_str()) == 0;
+#endif
+}
+
+static void write_cache_string(std::ofstream &ofs, const std::string &str)
+{
+	unsigned int len = (unsigned int)str.length();
+	ofs.write((const char*)&len, sizeof(len));
+	ofs.write(str.c_str(), len);
+}
+
+static bool read_cache_string(const unsigned char *data, size_t size, size_t &pos, std::string &str)
+{
+	unsigned int len;
+	if (pos + sizeof(len) > size) return false;
+	memcpy(&len, data + pos, sizeof(len));
+	pos += sizeof(len);
+	if (pos + len > size) return false;
+	str.assign((const char*)data + pos, len);
+	pos += len;
+	return true;
+}
+
+static std::mutex &cache_dir_mutex()
+{
+	static std::mutex mtx;
+	return mtx;
+}
+
+static std::string &cache_dir_value()
+{
+	static std::string dir = getenv("SSC_WEATHER_CACHE_DIR") ? getenv("SSC_WEATHER_CACHE_DIR") : "";
+	return dir;
+}
+
+void weatherfile::set_cache_dir(const std::string &dir)
+{
+	std::lock_guard<std::mutex> lock(cache_dir_mutex());
+	cache_dir_value() = dir;
+}
+
+std::string weatherfile::cache_dir()
+{
+	std::lock_guard<std::mutex> lock(cache_dir_mutex());
+	return cache_dir_value();
+}
+
+std::string weatherfile::cache_file_name(const std::string &file, const std::string &dir)
+{
+	// the path hash keeps files with the same name in different folders apart
+	unsigned long long h = fnv1a(file.c_str(), file.length());
+	return dir + "/" + util::name_only(file) + util::format(".%08x%08x.swc", (unsigned int)(h >> 32), (unsigned int)(h & 0xffffffff));
+}
+
+bool weatherfile::open(const std::string &file, bool header_only)
+{
+	return open(file, header_only, cache_dir());
+}
+
+bool weatherfile::open(const std::string &file, bool header_only, const std::string &dir)
+{
+	// clears any columns mapped from a cache by an earlier open, which read() would otherwise still use
+	reset();
+
+	std::string cache_file;
+	if (!header_only && !dir.empty() && !file.empty())
+	{
+		cache_file = cache_file_name(file, dir);
+		if (read_cache(file, cache_file))
+			return true;
+		reset();
+	}
+
+	if (!parse(file, header_only))
+		return false;
+
+	m_file = file;
+
+	// failing to write the cache is not an error, the next open just parses again
+	if (!cache_file.empty())
+		write_cache(cache_file);
+
+	return true;
+}
+
+bool weatherfile::write_cache(const std::string &cache_file)
+{
+	if (m_nRecords == 0) return false;
+
+	weatherfile_cache_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, WFCACHE_MAGIC, 8);
+	h.version = WFCACHE_VERSION;
+	h.ncols = _MAXCOL_;
+	unsigned long long stamp_size;
+	if (!file_stamp(m_file, &stamp_size, &h.source_mtime)
+		|| !hash_file(m_file, &h.source_size, &h.source_hash)
+		|| stamp_size != h.source_size)
+		return false;
+	h.nrecords = m_nRecords;
+	h.start_sec = m_startSec;
+	h.step_sec = m_stepSec;
+	h.type = m_type;
+	h.start_year = m_startYear;
+	h.has_leap_year = m_hasLeapYear ? 1 : 0;
+	h.hasunits = m_hdr.hasunits ? 1 : 0;
+	h.time = m_time;
+	h.tz = m_hdr.tz;
+	h.lat = m_hdr.lat;
+	h.lon = m_hdr.lon;
+	h.elev = m_hdr.elev;
+	for (size_t i = 0; i < _MAXCOL_; i++)
+		h.column_index[i] = m_columns[i].index;
+
+	// write to a temporary file and rename, so concurrent processes never map a partial cache
+	std::string tmp = unique_temp_name(cache_file);
+	{
+		std::ofstream ofs(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open()) return false;
+
+		ofs.write((const char*)&h, sizeof(h));
+		write_cache_string(ofs, m_hdr.location);
+		write_cache_string(ofs, m_hdr.city);
+		write_cache_string(ofs, m_hdr.state);
+		write_cache_string(ofs, m_hdr.country);
+		write_cache_string(ofs, m_hdr.source);
+		write_cache_string(ofs, m_hdr.description);
+		write_cache_string(ofs, m_hdr.url);
+
+		// align the column data for direct float access from the mapping
+		size_t pos = (size_t)ofs.tellp();
+		h.data_offset = (pos + 15) / 16 * 16;
+		static const char pad[16] = { 0 };
+		ofs.write(pad, h.data_offset - pos);
+
+		for (size_t i = 0; i < _MAXCOL_; i++)
+		{
+			const float *col = m_columns[i].mapped ? m_columns[i].mapped : &m_columns[i].data[0];
+			ofs.write((const char*)col, m_nRecords * sizeof(float));
+		}
+
+		ofs.seekp(0);
+		ofs.write((const char*)&h, sizeof(h));
+		if (!ofs.good())
+		{
+			ofs.close();
+			util::remove_file(tmp.c_str());
+			return false;
+		}
+	}
+
+	if (!replace_file(tmp, cache_file))
+	{
+		util::remove_file(tmp.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool weatherfile::read_cache(const std::string &file, const std::string &cache_file)
+{
+	if (!util::file_exists(cache_file.c_str())) return false;
+
+	std::shared_ptr<weatherfile_mapping> mapping(new weatherfile_mapping);
+	if (!mapping->map(cache_file)) return false;
+
+	const unsigned char *data = mapping->data();
+	size_t size = mapping->size();
+
+	weatherfile_cache_header h;
+	if (size < sizeof(h)) return false;
+	memcpy(&h, data, sizeof(h));
+	if (memcmp(h.magic, WFCACHE_MAGIC, 8) != 0
+		|| h.version != WFCACHE_VERSION
+		|| h.ncols != _MAXCOL_
+		|| h.nrecords == 0
+		|| h.data_offset % sizeof(float) != 0
+		|| h.data_offset + _MAXCOL_ * h.nrecords * sizeof(float) != size)
+		return false;
+
+	// the cache is only valid for the exact source file contents it was built from. An unchanged size and
+	// modification time is taken as unchanged contents; otherwise the source is hashed.
+	unsigned long long source_size, source_hash;
+	long long source_mtime;
+	if (!file_stamp(file, &source_size, &source_mtime)
+		|| source_size != h.source_size)
+		return false;
+	bool stamp_changed = (source_mtime != h.source_mtime);
+	if (stamp_changed
+		&& (!hash_file(file, &source_size, &source_hash)
+			|| source_size != h.source_size
+			|| source_hash != h.source_hash))
+		return false;
+
+	size_t pos = sizeof(h);
+	if (!read_cache_string(data, size, pos, m_hdr.location)
+		|| !read_cache_string(data, size, pos, m_hdr.city)
+		|| !read_cache_string(data, size, pos, m_hdr.state)
+		|| !read_cache_string(data, size, pos, m_hdr.country)
+		|| !read_cache_string(data, size, pos, m_hdr.source)
+		|| !read_cache_string(data, size, pos, m_hdr.description)
+		|| !read_cache_string(data, size, pos, m_hdr.url)
+		|| pos > h.data_offset)
+		return false;
+
+	m_file = file;
+	m_type = h.type;
+	m_startYear = h.start_year;
+	m_hasLeapYear = (h.has_leap_year != 0);
+	m_time = h.time;
+	m_startSec = (size_t)h.start_sec;
+	m_stepSec = (size_t)h.step_sec;
+	m_nRecords = (size_t)h.nrecords;
+	m_index = 0;
+	m_hdr.hasunits = (h.hasunits != 0);
+	m_hdr.tz = h.tz;
+	m_hdr.lat = h.lat;
+	m_hdr.lon = h.lon;
+	m_hdr.elev = h.elev;
+
+	const float *columns = (const float*)(data + h.data_offset);
+	for (size_t i = 0; i < _MAXCOL_; i++)
+	{
+		m_columns[i].index = h.column_index[i];
+		m_columns[i].data.clear();
+		m_columns[i].mapped = columns + i * m_nRecords;
+	}
+
+	m_mapping = mapping;
+	m_fromCache = true;
+
+	// same contents under a new time stamp: record the new stamp so later opens skip the hash
+	if (stamp_changed)
+		write_cache(cache_file);
+
+	return true;
+}
+
 bool weatherfile::convert_to_wfcsv( const std::string &input, const std::string &output )
 {
 	weatherfile wf( input );
@@ -53,6 +53,7 @@
 #include <string>
 #include <vector>  // needed to compile in typelib_vc2012
 #include <cmath>
+#include <memory>
 
 /***************************************************************************\
 
@@ -226,6 +227,8 @@ public:
 	}
 };
 
+class weatherfile_mapping; // read-only memory map of a binary weather cache file
+
 class weatherfile : public weather_data_provider
 {
 private:
@@ -236,8 +239,22 @@ private:
 	{
 		int index; // used for wfcsv to get column index in CSV file from which to read
 		std::vector<float> data;
+		const float *mapped; // column in a memory mapped binary cache, used instead of data when not NULL
 	};
 	column m_columns[_MAXCOL_];
+	std::shared_ptr<weatherfile_mapping> m_mapping;
+	bool m_fromCache;
+
+	float value(int col, size_t index) const
+	{
+		return m_columns[col].mapped ? m_columns[col].mapped[index] : m_columns[col].data[index];
+	}
+
+	/// Parse the text weather file
+	bool parse( const std::string &file, bool header_only );
+
+	/// Load the columns from a binary cache of file, if one exists and matches the file contents
+	bool read_cache( const std::string &file, const std::string &cache_file );
 
 public:
 	weatherfile();
@@ -258,7 +275,14 @@ public:
 	/// Check timestep of weatherfile and leap year, returns true if success
 	bool timeStepChecks(int hdr_step_sec = -1);
 
+	/* Opens the file, loading it from the binary cache when caching is enabled (see set_cache_dir)
+	and a cache built from the same file contents exists, otherwise parsing the text and writing the cache */
 	bool open( const std::string &file, bool header_only = false );
+	/// Opens the file as above, using the cache in cache_dir (no caching if empty) instead of the global folder
+	bool open( const std::string &file, bool header_only, const std::string &cache_dir );
+
+	/// True if the data was loaded from a binary cache file rather than parsed
+	bool from_cache() { return m_fromCache; }
 
 	bool read( weather_record *r ); 
 	bool read_average(weather_record *r, std::vector<int> &cols, size_t &num_timesteps);
@@ -266,6 +290,17 @@ public:
 	
 	static std::string normalize_city( const std::string &in );
 	static bool convert_to_wfcsv( const std::string &input, const std::string &output );
+
+	/* Binary columnar cache: the parsed columns, header and the size, modification time and checksum of
+	the source file are written to <cache dir>/<name>.<path hash>.swc, which is memory mapped by later
+	opens of the same file so that processes share the pages.  The source is only hashed when its
+	modification time has changed.  Caching is off unless a cache directory is set here or through
+	the SSC_WEATHER_CACHE_DIR environment variable. */
+	static void set_cache_dir( const std::string &dir );
+	static std::string cache_dir();
+	static std::string cache_file_name( const std::string &file, const std::string &dir );
+	/// Write the binary cache of an opened (not header only) weather file
+	bool write_cache( const std::string &cache_file );
 	
 };
 
@@ -0,0 +1,415 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "API_cache.h"
+#include "definitions.h"
+
+using namespace std;
+
+static const string _cache_header = "sp_field_cache " + my_to_string(SP_CACHE_VERSION);
+static const int _cache_precision = 17;		//significant digits of variable values, enough to read back the same double
+
+static unsigned long long checksum(const string &data)
+{
+	//64-bit FNV-1a hash of the file contents
+	unsigned long long h = 14695981039346656037ULL;
+	for(size_t i=0; i<data.size(); i++)
+		h = (h ^ (unsigned char)data[i]) * 1099511628211ULL;
+	return h;
+}
+
+static string temp_path(const string &path)
+{
+	//unique among the processes and threads that might store the same entry at once
+	static atomic<unsigned int> counter(0);
+#ifdef _WIN32
+	unsigned long pid = (unsigned long)GetCurrentProcessId();
+#else
+	unsigned long pid = (unsigned long)getpid();
+#endif
+	return path + "." + my_to_string(pid) + "." + my_to_string(counter++) + ".tmp";
+}
+
+static bool replace_file(const string &from, const string &to)
+{
+	//move from onto to in one step, replacing any existing file
+#ifdef _WIN32
+	return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+static void write_str(ostream &f, const string &s)
+{
+	f << s.size() << " " << s << "\n";
+}
+
+static bool read_str(istream &f, string &s)
+{
+	size_t n;
+	if(! (f >> n) )
+		return false;
+	f.get();	//separator
+	s.resize(n);
+	if( n > 0 )
+		f.read(&s[0], n);
+	f.get();	//newline
+	return !f.fail();
+}
+
+static void write_vec(ostream &f, const vector<double> &v)
+{
+	f << v.size();
+	for(size_t i=0; i<v.size(); i++)
+		f << " " << v[i];
+	f << "\n";
+}
+
+static bool read_vec(istream &f, vector<double> &v)
+{
+	size_t n;
+	if(! (f >> n) )
+		return false;
+	v.resize(n);
+	for(size_t i=0; i<n; i++)
+		f >> v[i];
+	return !f.fail();
+}
+
+sp_field_cache::sp_field_cache()
+{
+	_key = _check = 0;
+}
+
+void sp_field_cache::hash(const string &text)
+{
+	/* 
+	_key is a 64-bit FNV-1a hash and _check is a 64-bit sdbm hash of all text added since StartKey()
+	*/
+	for(size_t i=0; i<text.size(); i++)
+	{
+		unsigned long long c = (unsigned char)text[i];
+		_key = (_key ^ c) * 1099511628211ULL;
+		_check = c + (_check << 6) + (_check << 16) - _check;
+	}
+}
+
+void sp_field_cache::SetDirectory(const string &dir)
+{
+	_dir = dir;
+	//drop any trailing separator
+	while( _dir.size() > 1 && (_dir[_dir.size()-1] == '/' || _dir[_dir.size()-1] == '\\') )
+		_dir.erase(_dir.size()-1);
+}
+
+bool sp_field_cache::IsEnabled()
+{
+	return !_dir.empty();
+}
+
+void sp_field_cache::StartKey(var_map &V)
+{
+	/* 
+	Hash the name and value of every input variable. Outputs are calculated from the inputs and are 
+	not initialized before the first calculation, so they are left out. The variable map is unordered, 
+	so sort the names first to give the same key for the same inputs.
+	*/
+	_key = 14695981039346656037ULL;
+	_check = 0;
+
+	hash(_cache_header);
+
+	vector<string> names;
+	names.reserve(V._varptrs.size());
+	for(unordered_map<string, spbase*>::iterator it = V._varptrs.begin(); it != V._varptrs.end(); it++)
+		if(! it->second->is_output() )
+			names.push_back(it->first);
+	sort(names.begin(), names.end());
+
+	for(size_t i=0; i<names.size(); i++)
+	{
+		hash(names[i]);
+		hash("=");
+		hash(V._varptrs[names[i]]->as_string(_cache_precision));
+		hash("\n");
+	}
+}
+
+void sp_field_cache::AddToKey(const string &text)
+{
+	hash(text);
+	hash("\n");
+}
+
+string sp_field_cache::GetKey()
+{
+	char buf[17];
+	sprintf(buf, "%016llx", _key);
+	return string(buf);
+}
+
+string sp_field_cache::GetFilePath()
+{
+	return _dir + "/" + GetKey() + ".spcache";
+}
+
+bool sp_field_cache::Load(var_map &V, sp_layout &layout, sp_flux_table &fluxtab, vector<double> &values)
+{
+	/* 
+	Read the entry for the current key. Nothing is changed unless the whole file reads correctly and 
+	the contents match the size and checksum in the header.
+	*/
+	if(! IsEnabled() )
+		return false;
+
+	ifstream fin(GetFilePath().c_str(), ios::binary);
+	if(! fin.is_open() )
+		return false;
+
+	string line;
+	getline(fin, line);
+	if( line != _cache_header )
+		return false;
+
+	unsigned long long check, size, sum;
+	if(! (fin >> hex >> check >> size >> sum >> dec) || check != _check )
+		return false;
+	fin.get();	//newline
+
+	//the contents must run exactly to the end of the file
+	streampos start = fin.tellg();
+	fin.seekg(0, ios::end);
+	if( fin.fail() || (unsigned long long)(fin.tellg() - start) != size )
+		return false;
+	fin.seekg(start);
+	string data((size_t)size, '\0');
+	if( size > 0 )
+		fin.read(&data[0], (streamsize)size);
+	if( fin.fail() || checksum(data) != sum )
+		return false;
+
+	istringstream f(data);
+
+	//variables
+	size_t nvar;
+	if(! (f >> nvar) )
+		return false;
+	vector<string> vnames(nvar), vvals(nvar);
+	for(size_t i=0; i<nvar; i++)
+	{
+		if(! read_str(f, vnames[i]) || ! read_str(f, vvals[i]) )
+			return false;
+		if( V._varptrs.find(vnames[i]) == V._varptrs.end() )
+			return false;
+	}
+
+	//layout
+	size_t npos;
+	if(! (f >> npos) )
+		return false;
+	sp_layout lay;
+	lay.heliostat_positions.resize(npos);
+	for(size_t i=0; i<npos; i++)
+	{
+		sp_layout::h_position *p = &lay.heliostat_positions[i];
+		f >> p->location.x >> p->location.y >> p->location.z
+			>> p->aimpoint.x >> p->aimpoint.y >> p->aimpoint.z
+			>> p->template_number 
+			>> p->cant_vector.i >> p->cant_vector.j >> p->cant_vector.k
+			>> p->focal_length;
+	}
+	if( f.fail() )
+		return false;
+
+	//flux and efficiency table
+	sp_flux_table ftab;
+	f >> ftab.is_user_spacing >> ftab.n_flux_days >> ftab.delta_flux_hrs;
+	if(! read_vec(f, ftab.azimuths) || ! read_vec(f, ftab.zeniths) || ! read_vec(f, ftab.efficiency) )
+		return false;
+
+	size_t nsurf;
+	if(! (f >> nsurf) )
+		return false;
+	ftab.flux_surfaces.resize(nsurf);
+	for(size_t i=0; i<nsurf; i++)
+	{
+		sp_flux_map::sp_flux_stack *s = &ftab.flux_surfaces[i];
+		if(! read_str(f, s->map_name) || ! read_vec(f, s->xpos) || ! read_vec(f, s->ypos) )
+			return false;
+		int nr, nc, nl;
+		if(! (f >> nr >> nc >> nl) )
+			return false;
+		s->flux_data.resize(nr, nc, nl);
+		double *d = s->flux_data.data();
+		for(int j=0; j<nr*nc*nl; j++)
+			f >> d[j];
+	}
+
+	//other results
+	vector<double> vals;
+	if(! read_vec(f, vals) )
+		return false;
+
+	getline(f, line);
+	getline(f, line);
+	if( f.fail() || line != "end" )
+		return false;
+
+	for(size_t i=0; i<nvar; i++)
+		V._varptrs[vnames[i]]->set_from_string( vvals[i].c_str() );
+	layout.heliostat_positions.swap(lay.heliostat_positions);
+	fluxtab.is_user_spacing = ftab.is_user_spacing;
+	fluxtab.n_flux_days = ftab.n_flux_days;
+	fluxtab.delta_flux_hrs = ftab.delta_flux_hrs;
+	fluxtab.azimuths.swap(ftab.azimuths);
+	fluxtab.zeniths.swap(ftab.zeniths);
+	fluxtab.efficiency.swap(ftab.efficiency);
+	fluxtab.flux_surfaces.swap(ftab.flux_surfaces);
+	values.swap(vals);
+
+	return true;
+}
+
+bool sp_field_cache::Store(var_map &V, sp_layout &layout, sp_flux_table &fluxtab, vector<double> &values)
+{
+	/* 
+	Write the results under the current key. The file is written under a name unique to this call 
+	and then moved into place in one step, so that another process never reads a partial entry.
+	*/
+	if(! IsEnabled() )
+		return false;
+
+	string path = GetFilePath();
+	string tmppath = temp_path(path);
+
+	ostringstream f;
+	f.precision(_cache_precision);
+
+	//variables
+	f << V._varptrs.size() << "\n";
+	for(unordered_map<string, spbase*>::iterator it = V._varptrs.begin(); it != V._varptrs.end(); it++)
+	{
+		write_str(f, it->first);
+		write_str(f, it->second->as_string(_cache_precision));
+	}
+
+	//layout
+	f << layout.heliostat_positions.size() << "\n";
+	for(size_t i=0; i<layout.heliostat_positions.size(); i++)
+	{
+		sp_layout::h_position *p = &layout.heliostat_positions[i];
+		f << p->location.x << " " << p->location.y << " " << p->location.z << " "
+			<< p->aimpoint.x << " " << p->aimpoint.y << " " << p->aimpoint.z << " "
+			<< p->template_number << " "
+			<< p->cant_vector.i << " " << p->cant_vector.j << " " << p->cant_vector.k << " "
+			<< p->focal_length << "\n";
+	}
+
+	//flux and efficiency table
+	f << fluxtab.is_user_spacing << " " << fluxtab.n_flux_days << " " << fluxtab.delta_flux_hrs << "\n";
+	write_vec(f, fluxtab.azimuths);
+	write_vec(f, fluxtab.zeniths);
+	write_vec(f, fluxtab.efficiency);
+
+	f << fluxtab.flux_surfaces.size() << "\n";
+	for(size_t i=0; i<fluxtab.flux_surfaces.size(); i++)
+	{
+		sp_flux_map::sp_flux_stack *s = &fluxtab.flux_surfaces[i];
+		write_str(f, s->map_name);
+		write_vec(f, s->xpos);
+		write_vec(f, s->ypos);
+		int nr = (int)s->flux_data.nrows(), nc = (int)s->flux_data.ncols(), nl = (int)s->flux_data.nlayers();
+		f << nr << " " << nc << " " << nl << "\n";
+		double *d = s->flux_data.data();
+		for(int j=0; j<nr*nc*nl; j++)
+			f << d[j] << "\n";
+	}
+
+	//other results
+	write_vec(f, values);
+
+	f << "end\n";
+
+	string data = f.str();
+	{
+		ofstream fout(tmppath.c_str(), ios::binary);
+		if(! fout.is_open() )
+			return false;
+		fout << _cache_header << "\n";
+		fout << hex << _check << " " << (unsigned long long)data.size() << " " << checksum(data) << dec << "\n";
+		fout.write(data.c_str(), (streamsize)data.size());
+		if( fout.fail() )
+		{
+			fout.close();
+			remove(tmppath.c_str());
+			return false;
+		}
+	}
+
+	if(! replace_file(tmppath, path) )
+	{
+		remove(tmppath.c_str());
+		return false;
+	}
+
+	return true;
+}
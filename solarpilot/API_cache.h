@@ -0,0 +1,103 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#ifndef _API_CACHE_
+#define _API_CACHE_ 1
+
+#include <string>
+#include <vector>
+
+#include "API_structures.h"
+
+struct var_map;
+
+//Version of the cached results, part of every key. Increase it with any change to the models or to the 
+//file format that changes what a run stores, so that entries written by older code are not reused.
+#define SP_CACHE_VERSION 2
+
+class sp_field_cache
+{
+	/* 
+	Stores the results of a field layout and flux/efficiency table calculation on disk so that a 
+	later run with identical inputs can load them instead of simulating again. 
+
+	Each entry is named by a hash of SP_CACHE_VERSION, every input in the variable map and any other 
+	text that affects the results (weather data, flux map resolution, etc.). A second, independent hash 
+	of the same text is written into the file and checked on load to guard against key collisions. The 
+	file header also holds the size and a checksum of the contents, so a truncated or damaged entry is 
+	treated as missing.
+
+	The cache is disabled until a directory is provided.
+	*/
+
+	std::string _dir;
+	unsigned long long _key;
+	unsigned long long _check;
+
+	void hash(const std::string &text);
+
+public:
+	sp_field_cache();
+
+	void SetDirectory(const std::string &dir);	//empty directory disables the cache
+	bool IsEnabled();
+
+	void StartKey(var_map &V);	//begin a new key from the current state of the variable map
+	void AddToKey(const std::string &text);	//include additional inputs in the key
+	std::string GetKey();
+	std::string GetFilePath();
+
+	//load results for the current key. Returns false if there is no valid entry.
+	bool Load(var_map &V, sp_layout &layout, sp_flux_table &fluxtab, std::vector<double> &values);
+	//save results under the current key. Returns false if the file could not be written.
+	bool Store(var_map &V, sp_layout &layout, sp_flux_table &fluxtab, std::vector<double> &values);
+
+};
+
+#endif
@@ -490,6 +490,7 @@ AutoPilot::AutoPilot()
 	_has_summary_callback = false;
 	_has_detail_callback = false;
 	_is_solarfield_external = false;
+	_n_sim_threads = 1;
 	_SF = 0;
 	_summary_callback = 0;
 	_detail_callback = 0;
@@ -579,6 +580,13 @@ void AutoPilot::SetExternalSFObject( SolarField *SF )
 	_is_solarfield_external = true;
 }
 
+void AutoPilot::SetSimulationThreads( int nthreads )
+{
+	_n_sim_threads = nthreads;
+	if( _SF != 0 )
+		_SF->setSimulationThreads( nthreads );
+}
+
 bool AutoPilot::Setup(var_map &V, bool /*for_optimize*/)
 {
 
@@ -608,6 +616,7 @@ bool AutoPilot::Setup(var_map &V, bool /*for_optimize*/)
 	if(! _is_solarfield_external ){
 		_SF = new SolarField();
 	}
+	_SF->setSimulationThreads( _n_sim_threads );
 
 	//---Set a couple of parameters here that should be consistent for simple API use
 	
@@ -2115,8 +2124,8 @@ bool AutoPilot_S::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 			//if(! _cancel_simulation)
 				//interop::AimpointUpdateHandler(*_SF);
             double azzen[2];
-            azzen[0] = opttab.azimuths.at(i)-180.;
-            azzen[1] = opttab.zeniths.at(j) ;
+            azzen[0] = (opttab.azimuths.at(i)-180.)*D2R;
+            azzen[1] = opttab.zeniths.at(j)*D2R;
 			//Run the performance simulation
 			if(! _cancel_simulation)
 				_SF->Simulate(azzen[0], azzen[1], P);
@@ -2255,6 +2264,8 @@ bool AutoPilot_S::CalculateFluxMaps(vector<vector<double> > &sunpos, vector<vect
 AutoPilot_MT::AutoPilot_MT()
 {
 	_in_mt_simulation = false;	//initialize
+	_simthread = 0;
+	_n_threads_active = 0;
 	_cancel_simulation = false;
 	_has_summary_callback = false;
 	_has_detail_callback = false;
@@ -2296,118 +2307,22 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
 			//If full simulation is required...
 			if(full_sim){
 
-				int nthreads = min(nsim_req, _n_threads);
-
 				//update progress
 				if(_has_detail_callback)
-					_detail_siminfo->addSimulationNotice("Preparing " + my_to_string(_n_threads) + " threads for simulation");
-				
-				
-				//Duplicate SF objects in memory
-				SolarField **SFarr;
-				SFarr = new SolarField*[nthreads];
-				for(int i=0; i<nthreads; i++){
-					SFarr[i] = new SolarField(*_SF);
-				}
-			
+					_detail_siminfo->addSimulationNotice("Preparing " + my_to_string(min(nsim_req, _n_threads)) + " threads for simulation");
+
 				//Create sufficient results arrays in memory
 				sim_results results;
 				results.resize(nsim_req);
-						
-				//Calculate the number of simulations per thread
-				int npert = (int)ceil((float)nsim_req/(float)nthreads);
 
-				//Create thread objects
-				_simthread = new LayoutSimThread[nthreads];
-				_n_threads_active = nthreads;	//Keep track of how many threads are active
-				_in_mt_simulation = true;
-			
-				int
-					sim_first = 0,
-					sim_last = npert;
-				for(int i=0; i<nthreads; i++){
-                    std::string istr = my_to_string(i+1);
-                    _simthread[i].Setup(istr, SFarr[i], &results, &wdata, sim_first, sim_last, false, false);
-					sim_first = sim_last;
-					sim_last = min(sim_last+npert, nsim_req);
-				}
-				
 				if(_has_detail_callback){
 					_detail_siminfo->setTotalSimulationCount(nsim_req);
 					_detail_siminfo->setCurrentSimulation(0);
 					_detail_siminfo->addSimulationNotice("Simulating layout design-point hours...");
 				}
-				
-				//Run
-				for(int i=0; i<nthreads; i++)
-					thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ).detach();
-			
 
-				//Wait loop
-				while(true){
-					int nsim_done = 0, nsim_remain=0, nthread_done=0;
-					for(int i=0; i<nthreads; i++){
-						if( _simthread[i].IsFinished() )
-							nthread_done ++;
-					
-						int ns, nr;
-						_simthread[i].GetStatus(&ns, &nr);
-						nsim_done += ns;
-						nsim_remain += nr;
-					
-					
-					}
-					_sim_total = nsim_req;
-					_sim_complete = nsim_done;
-
-					if(_has_detail_callback){
-						if(! _detail_siminfo->setCurrentSimulation(nsim_done) )
-                            break;
-                    }
-					
-				
-					if(nthread_done == nthreads) break;
-					std::this_thread::sleep_for(std::chrono::milliseconds(75));
-
-				}
-
-				//Check to see whether the simulation was cancelled
-				bool cancelled = false;
-				for(int i=0; i<nthreads; i++){
-					cancelled = cancelled || _simthread[i].IsSimulationCancelled();
-				}
-			    //check to see whether simulation errored out
-                bool errored_out = false;
-                for(int i=0; i<_n_threads; i++){
-                    errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
-                }
-                if( errored_out )
-                {
-                    CancelSimulation();
-                    //Get the error messages, if any
-                    string errmsgs;
-                    for(int i=0; i<_n_threads; i++){
-                        for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
-                            errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
-                    }
-                    //Display error messages
-                    if(! errmsgs.empty() && _has_summary_callback)
-                        _summary_siminfo->addSimulationNotice( errmsgs.c_str() );
-            
-                }
-
-	            //Clean up dynamic memory
-	            for(int i=0; i<_n_threads; i++){
-		            delete SFarr[i];
-	            }
-	            delete [] SFarr;
-	            delete [] _simthread;
-	            _simthread = 0;
-
-	            //If the simulation was cancelled per the check above, exit out
-	            if(cancelled || errored_out){
-		            return false;
-	            }
+				if(! RunSimulationThreads(results, nsim_req, &wdata, 0, 0, false, false, true, _has_detail_callback ? _detail_siminfo : 0) )
+					return false;
 			
 				//For the map-to-annual case, run a simulation here
 				if(_SF->getVarMap()->sf.des_sim_detail.mapval() == var_solarfield::DES_SIM_DETAIL::EFFICIENCY_MAP__ANNUAL)	
@@ -2434,7 +2349,10 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
             Vect sun = Ambient::calcSunVectorFromAzZen( _SF->getVarMap()->sf.sun_az_des.Val()*D2R, (90. - _SF->getVarMap()->sf.sun_el_des.Val())*D2R );   
 
 			if(! _cancel_simulation)
-				_SF->calcHeliostatShadows(sun);	if(_SF->ErrCheck()){return false;}
+			{
+				_SF->calcHeliostatShadows(sun);
+				if(_SF->ErrCheck()){return false;}
+			}
 			if(! _cancel_simulation)
 				PostProcessLayout(layout);
 		}
@@ -2453,10 +2371,10 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
 bool AutoPilot_MT::SetMaxThreadCount(int nt)
 {
 	//check to make sure the max number of threads is less
-	//than the machine's capacity
+	//than the machine's capacity. nt <= 0 uses all of the machine's threads.
 	try{
-		unsigned int nmax = std::thread::hardware_concurrency();
-		_n_threads = min(max(nt,1), (int)nmax);
+		int nmax = max((int)std::thread::hardware_concurrency(), 1);
+		_n_threads = nt > 0 ? min(nt, nmax) : nmax;
 	}
 	catch(...)
 	{
@@ -2465,6 +2383,121 @@ bool AutoPilot_MT::SetMaxThreadCount(int nt)
 	return true;
 }
 
+bool AutoPilot_MT::RunSimulationThreads(sim_results &results, int nsim, WeatherData *wdata, matrix_t<double> *sunpos, sim_params *P, 
+	bool is_shadow_detail, bool is_flux_detail, bool is_normalized, simulation_info *siminfo)
+{
+	/* 
+	Divide 'nsim' simulations among up to _n_threads threads and wait for them to finish. Simulations 
+	are taken from the weather data steps in 'wdata' when it is provided, otherwise from the sun 
+	positions in 'sunpos' at the conditions in 'P'.
+
+	Simulating a sun position updates the tracking, efficiency and flux state of every heliostat, so 
+	each thread still needs its own field. The first thread simulates on _SF itself, as the single-
+	threaded API does, and only the remaining threads work on copies. Threads left over when there
+	are fewer simulations than threads are given to the heliostat loop within each simulation.
+
+	"siminfo"	optional progress object. Returning false from its update cancels the simulation.
+
+	Returns false if the simulation was cancelled or a thread failed.
+	*/
+	int nthreads = max(min(nsim, _n_threads), 1);
+	int nthreads_sf = max(_n_threads / nthreads, 1);
+	int nthreads_sf_master = _SF->getSimulationThreads();
+
+	//Only the threads beyond the first need a copy of the field
+	vector<SolarField*> SFarr(nthreads, _SF);
+	_SF->setSimulationThreads(nthreads_sf);
+	for(int i=1; i<nthreads; i++)
+		SFarr[i] = new SolarField(*_SF);
+
+	//Calculate the number of simulations per thread
+	int npert = (int)ceil((float)nsim/(float)nthreads);
+
+	//Create thread objects
+	SimThreadMonitor monitor;
+	_simthread = new LayoutSimThread[nthreads];
+	_n_threads_active = nthreads;	//Keep track of how many threads are active
+	_in_mt_simulation = true;
+
+	int
+		sim_first = 0,
+		sim_last = npert;
+	for(int i=0; i<nthreads; i++){
+		std::string istr = my_to_string(i+1);
+		if(wdata != 0)
+			_simthread[i].Setup(istr, SFarr[i], &results, wdata, sim_first, sim_last, is_shadow_detail, is_flux_detail);
+		else
+			_simthread[i].Setup(istr, SFarr[i], &results, sunpos, *P, sim_first, sim_last, is_shadow_detail, is_flux_detail);
+		_simthread[i].IsFluxmapNormalized(is_normalized);
+		_simthread[i].SetMonitor(&monitor);
+		sim_first = sim_last;
+		sim_last = min(sim_last+npert, nsim);
+	}
+
+	//Run
+	vector<thread> threads;
+	for(int i=0; i<nthreads; i++)
+		threads.push_back( thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ) );
+
+	//Report progress each time a thread updates its status, until all of the threads have finished
+	int nevents = 0;
+	while(true){
+		int nsim_done = 0, nthread_done = 0;
+		for(int i=0; i<nthreads; i++){
+			if( _simthread[i].IsFinished() )
+				nthread_done ++;
+
+			int ns, nr;
+			_simthread[i].GetStatus(&ns, &nr);
+			nsim_done += ns;
+		}
+		_sim_total = nsim;
+		_sim_complete = nsim_done;
+
+		if(siminfo != 0 && ! _cancel_simulation){
+			if(! siminfo->setCurrentSimulation(nsim_done) )
+				CancelSimulation();
+		}
+
+		if(nthread_done == nthreads) break;
+		monitor.Wait(nevents);
+	}
+	for(int i=0; i<nthreads; i++)
+		threads.at(i).join();
+	_in_mt_simulation = false;
+
+	//Check to see whether the simulation was cancelled or errored out
+	bool cancelled = false;
+	bool errored_out = false;
+	for(int i=0; i<nthreads; i++){
+		cancelled = cancelled || _simthread[i].IsSimulationCancelled();
+		errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
+	}
+	if( errored_out )
+	{
+		CancelSimulation();
+		//Get the error messages, if any
+		string errmsgs;
+		for(int i=0; i<nthreads; i++){
+			for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
+				errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
+		}
+		//Display error messages
+		if(! errmsgs.empty() && _has_summary_callback)
+			_summary_siminfo->addSimulationNotice( errmsgs.c_str() );
+	}
+
+	//Clean up dynamic memory
+	for(int i=1; i<nthreads; i++){
+		delete SFarr[i];
+	}
+	_SF->setSimulationThreads(nthreads_sf_master);
+	delete [] _simthread;
+	_simthread = 0;
+
+	return !(cancelled || errored_out);
+}
+
 bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 {
 	
@@ -2523,99 +2556,11 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 	}
 
 	//------------do the multithreaded run----------------
-	
-	//Create copies of the solar field
-	SolarField **SFarr;
-	SFarr = new SolarField*[_n_threads];
-	for(int i=0; i<_n_threads; i++){
-		SFarr[i] = new SolarField(*_SF);
-	}
-
-	//Create sufficient results arrays in memory
 	sim_results results;
 	results.resize(_sim_total);
-						
-	//Calculate the number of simulations per thread
-	int npert = (int)ceil((float)_sim_total/(float)_n_threads);
 
-	//Create thread objects
-	_simthread = new LayoutSimThread[_n_threads];
-	_n_threads_active = _n_threads;	//Keep track of how many threads are active
-				
-	int
-		sim_first = 0,
-		sim_last = npert;
-	for(int i=0; i<_n_threads; i++){
-        std::string istr = my_to_string(i);
-		_simthread[i].Setup(istr, SFarr[i], &results, &sunpos, P, sim_first, sim_last, true, false);
-		sim_first = sim_last;
-		sim_last = min(sim_last+npert, _sim_total);
-	}
-	//Run
-	for(int i=0; i<_n_threads; i++)
-		thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ).detach();
-			
-
-	//Wait loop
-	while(true){
-		int nsim_done = 0, nsim_remain=0, nthread_done=0;
-		for(int i=0; i<_n_threads; i++){
-			if( _simthread[i].IsFinished() )
-				nthread_done ++;
-					
-			int ns, nr;
-			_simthread[i].GetStatus(&ns, &nr);
-			nsim_done += ns;
-			nsim_remain += nr;
-					
-					
-		}
-		if(_has_summary_callback){
-			if( ! _summary_siminfo->setCurrentSimulation(nsim_done) )
-				CancelSimulation();
-		}
-		if(nthread_done == _n_threads) break;
-		std::this_thread::sleep_for(std::chrono::milliseconds(75));
-	}
-
-	//Check to see whether the simulation was cancelled
-	bool cancelled = false;
-	for(int i=0; i<_n_threads; i++){
-		cancelled = cancelled || _simthread[i].IsSimulationCancelled();
-	}
-    
-    //check to see whether simulation errored out
-    bool errored_out = false;
-    for(int i=0; i<_n_threads; i++){
-        errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
-    }
-    if( errored_out )
-    {
-        CancelSimulation();
-        //Get the error messages, if any
-        string errmsgs;
-        for(int i=0; i<_n_threads; i++){
-            for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
-                errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
-        }
-        //Display error messages
-        if(! errmsgs.empty() && _has_summary_callback)
-            _summary_siminfo->addSimulationNotice( errmsgs.c_str() );
-            
-    }
-
-	//Clean up dynamic memory
-	for(int i=0; i<_n_threads; i++){
-		delete SFarr[i];
-	}
-	delete [] SFarr;
-	delete [] _simthread;
-	_simthread = 0;
-
-	//If the simulation was cancelled per the check above, exit out
-	if(cancelled || errored_out){
+	if(! RunSimulationThreads(results, _sim_total, 0, &sunpos, &P, true, false, true, _has_summary_callback ? _summary_siminfo : 0) )
 		return false;
-	}
 
 	//collect all of the results and process into the efficiency table data structure
 	opttab.eff_data.clear();
@@ -2693,99 +2638,11 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
 
 
 	//------------do the multithreaded run----------------
-	
-	//Create copies of the solar field
-	SolarField **SFarr;
-	SFarr = new SolarField*[_n_threads];
-	for(int i=0; i<_n_threads; i++){
-		SFarr[i] = new SolarField(*_SF);
-	}
-
-	//Create sufficient results arrays in memory
 	sim_results results;
 	results.resize(_sim_total);
 
-	//Calculate the number of simulations per thread
-	int npert = (int)ceil((float)_sim_total/(float)_n_threads);
-
-	//Create thread objects
-	_simthread = new LayoutSimThread[_n_threads];
-	_n_threads_active = _n_threads;	//Keep track of how many threads are active
-	
-	int
-		sim_first = 0,
-		sim_last = npert;
-	for(int i=0; i<_n_threads; i++){
-        std::string istr = my_to_string(i);
-        _simthread[i].Setup(istr, SFarr[i], &results, &sunpos, P, sim_first, sim_last, true, true);
-		_simthread[i].IsFluxmapNormalized(is_normalized);
-		sim_first = sim_last;
-		sim_last = min(sim_last+npert, _sim_total);
-	}
-	//Run
-	for(int i=0; i<_n_threads; i++)
-		thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ).detach();
-			
-
-	//Wait loop
-	while(true){
-		int nsim_done = 0, nsim_remain=0, nthread_done=0;
-		for(int i=0; i<_n_threads; i++){
-			if( _simthread[i].IsFinished() )
-				nthread_done ++;
-					
-			int ns, nr;
-			_simthread[i].GetStatus(&ns, &nr);
-			nsim_done += ns;
-			nsim_remain += nr;
-					
-					
-		}
-		if(_has_summary_callback){
-			if( ! _summary_siminfo->setCurrentSimulation(nsim_done) ) 
-				CancelSimulation();
-		}
-		if(nthread_done == _n_threads) break;
-		std::this_thread::sleep_for(std::chrono::milliseconds(75));
-	}
-
-	//Check to see whether the simulation was cancelled
-	bool cancelled = false;
-	for(int i=0; i<_n_threads; i++){
-		cancelled = cancelled || _simthread[i].IsSimulationCancelled();
-	}
-	//check to see whether simulation errored out
-    bool errored_out = false;
-    for(int i=0; i<_n_threads; i++){
-        errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
-    }
-    if( errored_out )
-    {
-        CancelSimulation();
-        //Get the error messages, if any
-        string errmsgs;
-        for(int i=0; i<_n_threads; i++){
-            for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
-                errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
-        }
-        //Display error messages
-        if(! errmsgs.empty() && _has_summary_callback)
-            _summary_siminfo->addSimulationNotice( errmsgs.c_str() );
-            
-    }
-
-	//Clean up dynamic memory
-	for(int i=0; i<_n_threads; i++){
-		delete SFarr[i];
-	}
-	delete [] SFarr;
-	delete [] _simthread;
-	_simthread = 0;
-
-	//If the simulation was cancelled per the check above, exit out
-	if(cancelled || errored_out){
+	if(! RunSimulationThreads(results, _sim_total, 0, &sunpos, &P, true, true, is_normalized, _has_summary_callback ? _summary_siminfo : 0) )
 		return false;
-	}
 
 	for(int i=0; i<_sim_total; i++){
 		PostProcessFlux(results.at(i), fluxtab, i);
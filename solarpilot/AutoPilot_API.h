@@ -66,6 +66,8 @@ class simulation_info;
 class sim_result;
 class SolarField;
 class LayoutSimThread;
+class WeatherData;
+struct sim_params;
 
 
 
@@ -90,6 +92,7 @@ protected:
 	bool _has_summary_callback;			//A callback function has been provided to the API.
 	bool _has_detail_callback;
 	bool _is_solarfield_external;		//Is the SolarField object provided externally? Otherwise, it will be created and destroyed locally
+	int _n_sim_threads;		//Number of threads used by the SolarField to simulate heliostats at each sun position
 	bool
 		_setup_ok,	//The variable structure has been created
 		_simflag;	//add bool flags here to indicate simulation/setup status
@@ -121,6 +124,7 @@ public:
 	//setup
 	void PreSimCallbackUpdate();
 	void SetExternalSFObject(SolarField *SF);
+	void SetSimulationThreads(int nthreads);	//0 = number of hardware threads
 	bool Setup(var_map &V, bool for_optimize = false);
 	//generate weather data
 	void GenerateDesignPointSimulations(var_map &V, std::vector<std::string> &hourly_weather_data);
@@ -170,6 +174,8 @@ class SPEXPORT AutoPilot_MT : public AutoPilot
 	LayoutSimThread *_simthread;
 	bool _in_mt_simulation;
 	void CancelMTSimulation();
+	bool RunSimulationThreads(std::vector<sim_result> &results, int nsim, WeatherData *wdata, matrix_t<double> *sunpos, sim_params *P, 
+		bool is_shadow_detail, bool is_flux_detail, bool is_normalized, simulation_info *siminfo);
 
 public:
 	//constructor
@@ -151,6 +151,8 @@ Flux::Flux(Flux &f) :
 	_mu_GN(f._mu_GN),
 	_n_order(f._n_order),
 	_n_terms(f._n_terms),
+	_term_i(f._term_i),
+	_term_j(f._term_j),
 	pi(f.pi),
 	Pi(f.Pi)
 {
@@ -162,13 +164,13 @@ Flux::Flux(Flux &f) :
 	for(int i=0; i<16; i++){
 			_ag[i] = f._ag[i];
 			_xg[i] = f._xg[i];
+	}
 
-		_jmax = new int[_n_terms];
-		_jmin = new int[_n_terms];
-		for(int i=0; i<_n_terms; i++){
-			_jmax[i] = f._jmax[i];
-			_jmin[i] = f._jmin[i];
-		}
+	_jmax = new int[_n_terms];
+	_jmin = new int[_n_terms];
+	for(int i=0; i<_n_terms; i++){
+		_jmax[i] = f._jmax[i];
+		_jmin[i] = f._jmin[i];
 	}
 };
 
@@ -212,6 +214,16 @@ void Flux::Setup()
 		_jmax[i] = _n_terms - i;
 	}
 
+	//List the polynomial orders of the packed coefficients (the 'ipak' index used throughout)
+	_term_i.clear();
+	_term_j.clear();
+	for(int i=0; i<_n_terms; i++){
+		for(int j=_jmin[i]; j<_jmax[i]+1; j+=2){
+			_term_i.push_back(i);
+			_term_j.push_back(j-1);
+		}
+	}
+
 }
 
 void Flux::factOdds(){
@@ -285,24 +297,22 @@ void Flux::Binomials_hxn(){
 	}
 }
 
-matrix_t<double> Flux::hermitePoly( double x) {
-//THIS ISN"T USED
+void Flux::hermitePoly( double x, double *h) {
 	/*Evaluate the set of Hermite polynomials described by
     H_n(x)=SUM_(p=0)^(n){h_p^n*x^n}
     Where the only non-zero h_p^n are those for which p+n=even
 	
 	This method is used to calculate the polynomial coefficients for the Hermite series, given a slant range
 	'x' and desired order of the equation. DELSOL3 recommends N_order=6 (or 7 polynomial terms).
-	
+
+	The array 'h' must hold _n_terms values.
 	*/
         
     //Evaluate the polynomial equations
-	matrix_t<double> hermitePoly(1,_n_terms+1,0.0);
-	//for (int i=0; i<N_order+1; i+=1) {_hermitePoly.push_back(0.); }
-	hermitePoly[0] = 1.;
-	hermitePoly[1] = x;		//Need to set H0 and H1
-    for(int n=1; n<_n_terms+1; n++) {
-		hermitePoly[n+1] = x*hermitePoly[n] - double(n)*hermitePoly[n-1];
+	h[0] = 1.;
+	h[1] = x;		//Need to set H0 and H1
+    for(int n=1; n<_n_terms-1; n++) {
+		h[n+1] = x*h[n] - double(n)*h[n-1];
 	}
     
 	/*
@@ -315,8 +325,6 @@ matrix_t<double> Flux::hermitePoly( double x) {
     H[5]=x**5-10*x**3+15*x
     H[6]=x**6-15*x**4+45*x**2-15.
     */
-	
-	return hermitePoly;
 }
 
 void Flux::initHermiteCoefs(var_map &V){
@@ -2058,12 +2066,13 @@ void Flux::hermiteIntegral(double G[5], double F[5], double X[2], double A[2], d
 	double
 		xta = TA[0],
 		yta = TA[1];
-	matrix_t<double> h;
-	h.resize_fill(3,9,0.0);
+	//Quadrature weight times the hermite polynomials, offset by 2 orders (see DELSOL). Sized for _n_terms <= 7.
+	double h[3][9] = {{0.}};
 
 	//declare other temp variables
 	double xx, x12, x[3], xsq[3], fk, s2, s3, sign2, sign3;
-	int ipak, i, j, k, n, jmin, jmax;
+	int ipak, i, j, k, n;
+	int nterm = (int)_term_i.size();
 #ifdef _WRITE_FILE
     string name = "C:/Users/mwagner/Documents/NREL/Field optimization/Misc sim files/int/hdat.csv";
     ofstream fout(name.c_str());
@@ -2096,20 +2105,20 @@ void Flux::hermiteIntegral(double G[5], double F[5], double X[2], double A[2], d
         //The distance between the current abscissa and the aim point (X) in # of std-dev's
 		x[0] = (xx-xta)*A[0];
         //Initialize the Hermite coefficient array
-		h.at(0,0) = 0.;
-		h.at(1,0) = 0.;
-		h.at(2,0) = 0.;
+		h[0][0] = 0.;
+		h[1][0] = 0.;
+		h[2][0] = 0.;
 		for(i=0; i<3; i++){xsq[i] = x[i]*x[i];}
         //Calculate the quadrature weights. If the xsq value is large, don't bother since it will be zero.
-		if(xsq[0] < 100.) {h.at(0,0) = exp( -xsq[0]/2. )*WT/A[1]*xdiff;}
-		if(xsq[1] < 100.) {h.at(1,0) = exp( -xsq[1]/2. );}
-		if(xsq[2] < 100.) {h.at(2,0) = exp( -xsq[2]/2. );}
+		if(xsq[0] < 100.) {h[0][0] = exp( -xsq[0]/2. )*WT/A[1]*xdiff;}
+		if(xsq[1] < 100.) {h[1][0] = exp( -xsq[1]/2. );}
+		if(xsq[2] < 100.) {h[2][0] = exp( -xsq[2]/2. );}
 #ifdef _WRITE_FILE
         fout << x[0] << "," << x[1] << "," << x[2] << ",";
         fout << xsq[0] << "," << xsq[1] << "," << xsq[2] << ",";
 #endif
         //Initialize
-		h.at(1,1) = 0.;
+		h[1][1] = 0.;
 		fk = -2.;
         /* 
         Evaluate the hermite polynomial series coefficients. 
@@ -2119,9 +2128,9 @@ void Flux::hermiteIntegral(double G[5], double F[5], double X[2], double A[2], d
         */
 		for(k=3; k<_n_terms+3; k++){
 			fk += 1.;
-			h.at(0,k-1) = x[0]*h.at(0,k-2) - fk*h.at(0,k-3);
-			h.at(1,k-1) = x[1]*h.at(1,k-2) - fk*h.at(1,k-3);
-			h.at(2,k-1) = x[2]*h.at(2,k-2) - fk*h.at(2,k-3);
+			h[0][k-1] = x[0]*h[0][k-2] - fk*h[0][k-3];
+			h[1][k-1] = x[1]*h[1][k-2] - fk*h[1][k-3];
+			h[2][k-1] = x[2]*h[2][k-2] - fk*h[2][k-3];
 		}
 		s2 = 1.; s3 = 1.;
 		sign2 = (x[1]+dsmall)/fabs(x[1]+dsmall);
@@ -2136,27 +2145,22 @@ void Flux::hermiteIntegral(double G[5], double F[5], double X[2], double A[2], d
 		s2 = ss*((sign2 - 1.)/(-2.) + sign2*(1.-.5*pow(s2, -4)));
 		s3 = ss*((sign3 - 1.)/(-2.) + sign3*(1.-.5*pow(s3, -4)));
 		
-		h.at(1,1) = s3 - s2;
+		h[1][1] = s3 - s2;
 
 #ifdef _WRITE_FILE
         fout << sign2 << "," << sign3 << "," << s2 << "," << s3 << ",";
 
-        for(int rr =0; rr<h.nrows(); rr++)
-            for(int cc=0; cc<h.ncols(); cc++)
-               fout << h.at(rr,cc) << ",";
+        for(int rr =0; rr<3; rr++)
+            for(int cc=0; cc<9; cc++)
+               fout << h[rr][cc] << ",";
         
         fout << "\n";
 #endif
-		ipak = 0;
-		for(i=1; i<_n_terms+1; i++){
-			int im1 = i-1;
-			jmin = im1%2+1; //jmin = JMN(i-1);
-			jmax = _n_terms - im1; //jmax = JMX(i-1);
-			for(j=jmin; j<jmax+1; j+=2){
-				ipak++;
-				hspill.at(ipak-1) += _ag[n-1]*h.at(0,i+1)*(h.at(1,j) - h.at(2,j));
-			}
-		}	
+		for(ipak=0; ipak<nterm; ipak++){
+			i = _term_i[ipak]+2;
+			j = _term_j[ipak]+1;
+			hspill.at(ipak) += _ag[n-1]*h[0][i]*(h[1][j] - h[2][j]);
+		}
 	}
 #ifdef _WRITE_FILE
     fout.close();
@@ -2221,6 +2225,21 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 	//Get the flux surface offset
 	sp_point *offset = flux_surface.getSurfaceOffset();
 	
+	//List the grid nodes contiguously so each heliostat is evaluated in one pass over the grid. The work arrays 
+	//are local so that separate flux surfaces can be evaluated at the same time.
+	int nnode = nfx*nfy;
+	vector<FluxPoint*> pts(nnode);	//flux grid nodes
+	for(int j=0; j<nfx; j++)
+		for(int k=0; k<nfy; k++)
+			pts.at(j*nfy+k) = &grid->at(j).at(k);
+	vector<int> node(nnode);		//grid node index of each point in view of the current heliostat
+	vector<double> 
+		xs(nnode),			//normalized image plane x position of each point
+		ys(nnode),			//normalized image plane y position of each point
+		dots(nnode),		//dot product of the node normal and the receiver-to-heliostat vector
+		fluxes(nnode),		//flux evaluated at each point
+		work(2*_n_terms*nnode);	//Hermite polynomial tables for hermiteFluxEval
+
 	int nh = (int)helios.size();
 	if(show_progress){
 		siminfo->setTotalSimulationCount(nh);
@@ -2232,77 +2251,81 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 		if(show_progress && i % update_every == 0)
 			siminfo->setCurrentSimulation(i+1);
 		
-        if(! helios.at(i)->IsEnabled() )
+		Heliostat *H = helios.at(i);
+        if(! H->IsEnabled() )
             continue;
 
 		//Get the image error std dev's
 		double sigx, sigy;	
-		helios.at(i)->getImageSize(sigx, sigy);	//Image size is normalized by the tower height
+		H->getImageSize(sigx, sigy);	//Image size is normalized by the tower height
 		
 		//Get the heliostat aim point
-		sp_point *aim = helios.at(i)->getAimPoint();
+		sp_point *aim = H->getAimPoint();
 		//Get the height of the receiver that the heliostat is aiming at
-		double tht = helios.at(i)->getWhichReceiver()->getVarMap()->optical_height.Val();
+		double tht = H->getWhichReceiver()->getVarMap()->optical_height.Val();
 
 		//Calculate the normalizing constant. This is equal to the normalized power delivered by the heliostat to the
 		//reciever divided by the tower height squared. (the tht^2 term falls out of the normalizing procedure
 		//that we previously used in defining the Hermite moments). See DELSOL 7634.
-		double cnorm = helios.at(i)->getArea() * helios.at(i)->getEfficiencyTotal()/(tht*tht);
-		//Loop through each flux point
-		//Rows
-		for(int j=0; j<nfx; j++){
-			//Cols
-			for(int k=0; k<nfy; k++){
-				//Get the flux point
-				FluxPoint *pt = &grid->at(j).at(k);
-				//Calculate the dot product between the flux point normal and the helio->tower vector
-				Vect *tv = helios.at(i)->getTowerVector();
-				Vect tvr;
-				tvr.Set( -tv->i, -tv->j, -tv->k );	//Reverse
-
-				double f_dot_t = Toolbox::dotprod(pt->normal, tvr);	
-				//If the dot product is negative, the point is not in view of the heliostat, so continue.
-				if(f_dot_t < 0.) continue;
-				if(f_dot_t>1.){
-					continue;
-				}
-				//Translate the flux point location into global coordinates
-				sp_point pt_g;
-				pt_g.Set(pt->location.x + offset->x, pt->location.y + offset->y, pt->location.z + tht); //tht include z offset
-
-				//Project the current flux point into the image plane as defined by the 
-				//aim point and the heliostat-to-receiver vector.
-				sp_point pt_ip;
-				Toolbox::plane_intersect(*aim, tvr, pt_g, tvr, pt_ip); 
-				
-				//Now the point pt_ip indicates in global coordinates the projection of the flux point onto the image plane.
-				
-				//Translate the flux point into coordinates relative to the aim point
-				pt_ip.Subtract( *aim );
-				
-				//Express this point in image plane coordinates
-                double azpt = atan2(tvr.i, tvr.j);
-                double zenpt = acos(tvr.k);
-
-				Toolbox::rotation(pi-azpt, 2, pt_ip);
-				Toolbox::rotation(zenpt, 0, pt_ip);
+		double cnorm = H->getArea() * H->getEfficiencyTotal()/(tht*tht);
 
-				//This rotation now expresses pt_ip in x,y coordinates of the image plane.
+		//The helio->tower vector, reversed
+		Vect *tv = H->getTowerVector();
+		Vect tvr;
+		tvr.Set( -tv->i, -tv->j, -tv->k );
 
-				//Normalize the x,y coordinates with respect to the image error size
-				double
-					xn = -pt_ip.x/tht / sigx,       //with delsol formulation, image is flipped in x direction. Not sure why.
-					yn = pt_ip.y/tht / sigy;
-				
-				//Calculate the flux
-                double hfe = hermiteFluxEval(helios.at(i), xn, yn) * exp( -0.5 *( xn*xn + yn*yn) );
-                //if( hfe != hfe )
-                //{
-                //    double xxxxx = 0.;
-                //}
-				pt->flux += f_dot_t * hfe * cnorm;
+		//Rotation of a point into x,y coordinates of the image plane. This is Toolbox::rotation(pi-azpt, 2, ..) 
+		//followed by Toolbox::rotation(zenpt, 0, ..), evaluated once for the heliostat.
+        double azpt = atan2(tvr.i, tvr.j);
+        double zenpt = acos(tvr.k);
+		double
+			cos_az = cos(pi-azpt),
+			sin_az = sin(pi-azpt),
+			cos_zen = cos(zenpt),
+			sin_zen = sin(zenpt);
+
+		//Project each flux point in view of the heliostat into the image plane
+		int npt = 0;
+		for(int n=0; n<nnode; n++){
+			FluxPoint *pt = pts[n];
+			//Calculate the dot product between the flux point normal and the helio->tower vector
+			double f_dot_t = Toolbox::dotprod(pt->normal, tvr);	
+			//If the dot product is negative, the point is not in view of the heliostat, so continue.
+			if(f_dot_t < 0.) continue;
+			if(f_dot_t>1.){
+				continue;
 			}
+			//Translate the flux point location into global coordinates
+			sp_point pt_g;
+			pt_g.Set(pt->location.x + offset->x, pt->location.y + offset->y, pt->location.z + tht); //tht include z offset
+
+			//Project the current flux point into the image plane as defined by the 
+			//aim point and the heliostat-to-receiver vector.
+			sp_point pt_ip;
+			Toolbox::plane_intersect(*aim, tvr, pt_g, tvr, pt_ip); 
+				
+			//Translate the flux point into coordinates relative to the aim point
+			pt_ip.Subtract( *aim );
+				
+			//Express this point in image plane coordinates
+			double
+				xip = cos_az*pt_ip.x + sin_az*pt_ip.y,
+				yip = cos_zen*(-sin_az*pt_ip.x + cos_az*pt_ip.y) + sin_zen*pt_ip.z;
+
+			//Normalize the x,y coordinates with respect to the image error size
+			xs[npt] = -xip/tht / sigx;       //with delsol formulation, image is flipped in x direction. Not sure why.
+			ys[npt] = yip/tht / sigy;
+			dots[npt] = f_dot_t;
+			node[npt] = n;
+			npt++;
 		}
+		if(npt == 0) continue;
+
+		//Calculate the flux at all of the points
+		hermiteFluxEval(H, npt, &xs[0], &ys[0], &fluxes[0], &work[0]);
+
+		for(int n=0; n<npt; n++)
+			pts[node[n]]->flux += dots[n] * fluxes[n] * cnorm;
 	}
 	if(show_progress){
 		siminfo->Reset();
@@ -2335,34 +2358,81 @@ double Flux::hermiteFluxEval(Heliostat *H, double xs, double ys){
 	//get the hermite coef array from the heliostat
 	matrix_t<double> *hc = H->getHermiteCoefObject();
 
-	double HX[9], HY[9];
-	HX[0] = 1.;
-	HX[1] = 0.;
-	HY[0] = 1.;
-	HY[1] = 0.;
-
-	double FX = -2.;
+	double HX[9], HY[9];	//sized for _n_terms <= 9
+	hermitePoly(xs, HX);
+	hermitePoly(ys, HY);
 
-	for(int i=1; i<_n_terms+1; i++){
-		FX ++;
-		HX[i+1] = xs*HX[i] - FX*HX[i-1];
-		HY[i+1] = ys*HY[i] - FX*HY[i-1];
-	}
-	int ipak = 0;
 	double flux = 0.;
-	for(int i=1; i<_n_terms+1; i++){
-		int
-			jmin = JMN(i-1),
-			jmax = JMX(i-1);
-		for(int j=jmin; j<jmax+1; j+=2){
-			flux += hc->at(ipak)*HX[i+1]*HY[j+1];
-			ipak++;
-		}
+	for(int ipak=0; ipak<(int)_term_i.size(); ipak++){
+		flux += hc->at(ipak)*HX[_term_i[ipak]]*HY[_term_j[ipak]];
 	}
 	if(flux < 0.) flux = 0.;
 	return flux;
 }
 
+void Flux::hermiteFluxEval(Heliostat *H, int npt, const double *xs, const double *ys, double *flux, double *work){
+	/* 
+	Evaluate the flux density for heliostat H at the 'npt' image plane points (xs[i], ys[i]), including 
+	the exp(-(x^2 + y^2)/2) weighting. Each point gets the same value as 
+		hermiteFluxEval(H, xs[i], ys[i]) * exp( -0.5*(xs[i]*xs[i] + ys[i]*ys[i]) )
+
+	The Hermite polynomials for all points are tabulated by order first, so the inner loops 
+	run over contiguous points. The tables are kept in 'work' (2*_n_terms*npt values), which the caller 
+	can provide to avoid allocating them on each call.
+	*/
+	if(npt < 1) return;
+
+	vector<double> local;
+	if(work == 0){
+		local.resize(2*_n_terms*npt);
+		work = &local[0];
+	}
+	double 
+		*hx = work,
+		*hy = work + _n_terms*npt;
+
+	//H0 and H1, then the recurrence H_n = x * H_n-1 - (n-1)*H_n-2
+	for(int p=0; p<npt; p++){
+		hx[p] = 1.;
+		hy[p] = 1.;
+		hx[npt+p] = xs[p];
+		hy[npt+p] = ys[p];
+	}
+	for(int n=2; n<_n_terms; n++){
+		double fn = double(n-1);
+		double 
+			*hx0 = hx + n*npt,
+			*hy0 = hy + n*npt;
+		const double 
+			*hx1 = hx0 - npt,
+			*hx2 = hx1 - npt,
+			*hy1 = hy0 - npt,
+			*hy2 = hy1 - npt;
+		for(int p=0; p<npt; p++){
+			hx0[p] = xs[p]*hx1[p] - fn*hx2[p];
+			hy0[p] = ys[p]*hy1[p] - fn*hy2[p];
+		}
+	}
+
+	//Sum the terms of the expansion
+	const double *hc = H->getHermiteCoefObject()->data();
+	for(int p=0; p<npt; p++)
+		flux[p] = 0.;
+	for(int ipak=0; ipak<(int)_term_i.size(); ipak++){
+		double c = hc[ipak];
+		const double 
+			*tx = hx + _term_i[ipak]*npt,
+			*ty = hy + _term_j[ipak]*npt;
+		for(int p=0; p<npt; p++)
+			flux[p] += c*tx[p]*ty[p];
+	}
+
+	for(int p=0; p<npt; p++){
+		double f = flux[p] < 0. ? 0. : flux[p];
+		flux[p] = f * exp( -0.5 *( xs[p]*xs[p] + ys[p]*ys[p]) );
+	}
+}
+
 /* 
 -----------------------------------------------------------------
 						Aim point methods  
@@ -65,6 +65,7 @@ and heliostat shape using the MOMENT subroutine, line 8244
 
 */
 class FluxSurface;
+struct FluxPoint;
 class Heliostat;
 class Receiver;
 class SolarField;
@@ -103,6 +104,11 @@ class Flux
 	int *_jmin;
 	int *_jmax;
 
+	//x and y polynomial order of each packed Hermite coefficient, in the order the coefficients are stored
+	std::vector<int> 
+		_term_i,
+		_term_j;
+
 	double pi,Pi;
 	
 	Random *_random;
@@ -138,7 +144,7 @@ class Flux
 
 	void Binomials_hxn();
 
-	matrix_t<double> hermitePoly( double x );	//This will return a vector<double> of hermite coefficients
+	void hermitePoly( double x, double *h );	//Fills h[0.._n_terms-1] with the hermite polynomials evaluated at x
 
 	//moments of sunshape distribution. If user-defined, also requires specification of the _user_sun vector
 	void hermiteSunCoefs(var_map &V, matrix_t<double> &mSun);
@@ -171,6 +177,10 @@ class Flux
 
 	double hermiteFluxEval(Heliostat *H, double xs, double ys);
 
+	//Evaluate the flux (including the gaussian weight) at npt normalized image plane points at once. 'work' is scratch 
+	//space for at least 2*_n_terms*npt values, or null to allocate it for the call.
+	void hermiteFluxEval(Heliostat *H, int npt, const double *xs, const double *ys, double *flux, double *work=0);
+
 	//-------------End DELSOL3 methods--------------------
 
 	void calcBestReceiverTarget(Heliostat *H, std::vector<Receiver*> *Recs, double tht, int &rec_index, Vect *rtoh=0);
@@ -92,7 +92,6 @@ double Heliostat::getAzimuthTrack(){return _azimuth;}
 double Heliostat::getZenithTrack(){return _zenith;}
 double Heliostat::getCollisionRadius(){return _r_collision;}
 double Heliostat::getArea(){return _area;}
-vector<Heliostat*> *Heliostat::getNeighborList(){return _neighbors;}
 vector<sp_point> *Heliostat::getCornerCoords(){return &_corners;}
 vector<sp_point> *Heliostat::getShadowCoords(){return &_shadow;}
 matrix_t<double> *Heliostat::getMirrorShapeNormCoefObject(){return &_mu_MN;}
@@ -117,7 +116,6 @@ void Heliostat::IsEnabled(bool enable){_is_enabled = enable;}
 void Heliostat::setId(int id){_id = id;}
 void Heliostat::setGroupId(int row, int col){_group[0] = row; _group[1] = col;}
 void Heliostat::setInLayout(bool in_layout){_in_layout = in_layout;}
-void Heliostat::setNeighborList(vector<Heliostat*> *list){_neighbors = list;}
 void Heliostat::setEfficiencyCosine(double eta_cos){eff_data.eta_cos = fmin(fmax(eta_cos,0.),1.);}
 void Heliostat::setEfficiencyAtmAtten(double eta_att){eff_data.eta_att = eta_att;}
 void Heliostat::setEfficiencyIntercept(double eta_int){eff_data.eta_int = eta_int;}
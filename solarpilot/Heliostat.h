@@ -73,8 +73,6 @@ class Heliostat : public mod_base
 		_track, //The tracking vector for the heliostat
 		_tower_vect,  //Heliostat-to-tower unit vector
 		_cant_vect;	//Canting vector (not normalized)
-	std::vector<Heliostat*>
-		*_neighbors; //pointer to a vector of neighboring heliostats
 	matrix_t<Reflector>
 		_panels; //Array of cant panels
 	std::vector<sp_point>
@@ -168,7 +166,6 @@ public:
 	double getZenithTrack();
     double getArea();
     double getCollisionRadius();
-	std::vector<Heliostat*> *getNeighborList();
 	std::vector<sp_point> *getCornerCoords();
 	std::vector<sp_point> *getShadowCoords();
 	matrix_t<double> *getMirrorShapeNormCoefObject();
@@ -193,7 +190,6 @@ public:
 	void setId(int id);
 	void setGroupId(int row, int col);
 	void setInLayout(bool in_layout);
-	void setNeighborList(std::vector<Heliostat*> *list);
 	void setEfficiencyCosine(double eta_cos);
 	void setEfficiencyAtmAtten(double eta_att);
 	void setEfficiencyIntercept(double eta_int);
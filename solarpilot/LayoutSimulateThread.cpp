@@ -53,6 +53,44 @@
 #ifdef SP_USE_THREADS
 
 using namespace std;
+
+SimThreadMonitor::SimThreadMonitor()
+{
+	_nevents = 0;
+}
+
+void SimThreadMonitor::Notify()
+{
+	/* 
+	Count the event under the lock so that a Wait() that is checking the count cannot miss it
+	*/
+	_lock.lock();
+	_nevents++;
+	_lock.unlock();
+	_cv.notify_all();
+}
+
+void SimThreadMonitor::Wait(int &nevents_seen)
+{
+	unique_lock<mutex> lock(_lock);
+	while(_nevents == nevents_seen)
+		_cv.wait(lock);
+	nevents_seen = _nevents;
+}
+
+LayoutSimThread::LayoutSimThread()
+{
+	Finished = false;
+	CancelFlag = false;
+	FinishedWithErrors = false;
+	Nsim_complete = 0;
+	Nsim_total = 0;
+	_SF = 0;
+	_wdata = 0;
+	_results = 0;
+	_sol_azzen = 0;
+	_monitor = 0;
+}
 	
 void LayoutSimThread::Setup(string &tname, SolarField *SF, sim_results *results, WeatherData *wdata, 
 	int sim_first, int sim_last, bool is_shadow_detail, bool is_flux_detail)
@@ -120,19 +158,33 @@ void LayoutSimThread::IsFluxmapNormalized(bool is_normal)
 	_is_flux_normalized = is_normal;
 }
 
+void LayoutSimThread::SetMonitor(SimThreadMonitor *monitor)
+{
+	_monitor = monitor;
+}
+
+void LayoutSimThread::SetFinished()
+{
+	FinishedLock.lock();
+	Finished = true;
+	FinishedLock.unlock();
+	if(_monitor != 0)
+		_monitor->Notify();
+}
+
 void LayoutSimThread::CancelSimulation()
 {
-	CancelLock.lock();
+	StatusLock.lock();
 	CancelFlag = true;
-	CancelLock.unlock();
+	StatusLock.unlock();
 }
 
 bool LayoutSimThread::IsSimulationCancelled()
 {
 	bool r;
-	CancelLock.lock();
+	StatusLock.lock();
 	r = CancelFlag;
-	CancelLock.unlock();
+	StatusLock.unlock();
 	return r;
 }
 
@@ -160,6 +212,8 @@ void LayoutSimThread::UpdateStatus(int nsim_complete, int nsim_total)
 	Nsim_complete = nsim_complete;
 	Nsim_total = nsim_total;
 	StatusLock.unlock();
+	if(_monitor != 0)
+		_monitor->Notify();
 }
 
 void LayoutSimThread::GetStatus( int *nsim_complete, int *nsim_total)
@@ -193,7 +247,6 @@ void LayoutSimThread::StartThread() //Entry()
         FinErrLock.unlock();
         _sim_messages.clear();
 
-	    double pi = PI;
 	    //Run the simulation 
 	    double dom, doy, hour, month;
 	    double az, zen;
@@ -201,17 +254,13 @@ void LayoutSimThread::StartThread() //Entry()
 	    bool is_pmt_factors = _SF->getVarMap()->fin.is_pmt_factors.val;
 
         vector<double> *tous = &_SF->getVarMap()->fin.pricing_array.Val();
-
-	    int Npos = (int)_SF->getHeliostats()->size();
 				
 	    //Simulate for each time
 	    StatusLock.lock();
 	    bool is_cancel = this->CancelFlag; //check for cancelled simulation
 	    StatusLock.unlock();
 	    if(is_cancel){
-		    FinishedLock.lock();
-		    Finished = true;
-		    FinishedLock.unlock();
+		    SetFinished();
 		    return; // (wxThread::ExitCode)-1;
 	    }
 
@@ -305,15 +354,11 @@ void LayoutSimThread::StartThread() //Entry()
 		    is_cancel = this->CancelFlag; 
 		    StatusLock.unlock();
 		    if(is_cancel){
-			    FinishedLock.lock();
-			    Finished = true;
-			    FinishedLock.unlock();
+			    SetFinished();
 			    return;
 		    }			
 	    }
-	    FinishedLock.lock();
-	    Finished = true;
-	    FinishedLock.unlock();
+	    SetFinished();
 
     }
     catch(spexception &e)
@@ -323,15 +368,13 @@ void LayoutSimThread::StartThread() //Entry()
 		this->CancelFlag = true; 
 		StatusLock.unlock();
         
-        FinishedLock.lock();
-		Finished = true;
-		FinishedLock.unlock();
-        
         FinErrLock.lock();
         FinishedWithErrors = true;
         FinErrLock.unlock();
 
         _sim_messages.push_back( "Thread " + this->_thread_id + ": " +  e.what() );
+
+        SetFinished();
     }
     catch(...)
     {
@@ -340,15 +383,13 @@ void LayoutSimThread::StartThread() //Entry()
 		this->CancelFlag = true; 
 		StatusLock.unlock();
         
-        FinishedLock.lock();
-		Finished = true;
-		FinishedLock.unlock();
-        
         FinErrLock.lock();
         FinishedWithErrors = true;
         FinErrLock.unlock();        
         
         _sim_messages.push_back( "Thread " + this->_thread_id + ": " +  "Caught unspecified error in a simulation thread. Simulation was not successful." );
+
+        SetFinished();
     }
 
 	return;
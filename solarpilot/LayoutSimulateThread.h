@@ -56,6 +56,7 @@
 #ifdef SP_USE_THREADS
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 
 
 class Heliostat;	//Forward declaration
@@ -64,6 +65,26 @@ class WeatherData;
 typedef std::vector<Heliostat*> Hvector;	//Needs declaring here
 
 
+class SimThreadMonitor
+{
+	/* 
+	Shared by a set of simulation threads so that the controlling thread can sleep until one of 
+	them reports progress or finishes, rather than polling each thread's status.
+	*/
+	std::mutex _lock;
+	std::condition_variable _cv;
+	int _nevents;
+
+public:
+	SimThreadMonitor();
+
+	void Notify();	//called by a simulation thread after its status changes
+
+	void Wait(int &nevents_seen);	//block until a status change that has not yet been seen
+
+};
+
+
 class LayoutSimThread 
 {
 	bool _is_user_sun_pos;		//Has the user specified sun positions? (opposed to day/time combos)
@@ -86,16 +107,20 @@ class LayoutSimThread
 	matrix_t<double> *_sol_azzen;
 	sim_params _sim_params; 
     std::vector<std::string> _sim_messages;
+	SimThreadMonitor *_monitor;
 
 	//wxMutex
 	std::mutex
 		StatusLock,
-		CancelLock,
 		FinishedLock,
         FinErrLock;
 
+	void SetFinished();
+
 public:
 
+	LayoutSimThread();
+
 	void Setup(std::string &tname, SolarField *SF, sim_results *results, WeatherData *wdata, 
 		int sim_first, int sim_last, bool is_shadow_detail, bool is_flux_detail);
 
@@ -104,6 +129,8 @@ public:
 
 	void IsFluxmapNormalized(bool is_normal);	//set whether the fluxmap should be normalized (default TRUE)
 
+	void SetMonitor(SimThreadMonitor *monitor);	//notify this monitor of progress and completion
+
 	void CancelSimulation();
 
 	bool IsSimulationCancelled();
@@ -50,6 +50,10 @@
 #include <assert.h>
 #include <algorithm>
 #include <math.h>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <functional>
 
 #include "exceptions.hpp"
 #include "SolarField.h"
@@ -67,6 +71,56 @@
 
 using namespace std;
 
+//Call func(i) for each i in [0,n) on up to nthreads threads (0 = number of hardware threads).
+//Indices are handed out in blocks, and the first exception thrown by any call is rethrown after all threads finish.
+static void parallelFor(int n, int nthreads, const std::function<void(int)> &func)
+{
+	const int block = 32;
+
+	if(nthreads < 1)
+		nthreads = std::max(1, (int)std::thread::hardware_concurrency());
+	nthreads = std::min(nthreads, (n + block - 1)/block);
+
+	if(nthreads <= 1)
+	{
+		for(int i=0; i<n; i++)
+			func(i);
+		return;
+	}
+
+	std::atomic<int> next(0);
+	std::vector<std::exception_ptr> errors(nthreads);
+
+	auto work = [&](int t)
+	{
+		try
+		{
+			for(int first = next.fetch_add(block); first < n; first = next.fetch_add(block))
+			{
+				int last = std::min(first + block, n);
+				for(int i=first; i<last; i++)
+					func(i);
+			}
+		}
+		catch(...)
+		{
+			errors.at(t) = std::current_exception();
+			next = n;	//stop handing out work
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for(int t=1; t<nthreads; t++)
+		threads.push_back( std::thread(work, t) );
+	work(0);
+	for(size_t t=0; t<threads.size(); t++)
+		threads.at(t).join();
+
+	for(int t=0; t<nthreads; t++)
+		if(errors.at(t))
+			std::rethrow_exception(errors.at(t));
+}
+
 //Sim params
 sim_params::sim_params()
 {
@@ -116,6 +170,8 @@ void SolarField::setHeliostatExtents(double xmax, double xmin, double ymax, doub
 	_helio_extents[2] = ymax;
 	_helio_extents[3] = ymin;
 };
+void SolarField::setSimulationThreads(int nthreads){ _n_sim_threads = nthreads; }
+int SolarField::getSimulationThreads(){ return _n_sim_threads; }
 	
 //Scripts
 bool SolarField::ErrCheck(){return _sim_error.checkForErrors();}
@@ -135,6 +191,7 @@ SolarField::SolarField(){
 	_flux = 0;
     _var_map = 0;
 	_is_created = false;	//The Create() method hasn't been called yet.
+	_n_sim_threads = 1;
 	_estimated_annual_power = 0.;
 };		
 
@@ -156,6 +213,7 @@ SolarField::SolarField( const SolarField &sf )
 	_is_aimpoints_updated( sf._is_aimpoints_updated ),
 	_cancel_flag( sf._cancel_flag ),
 	_is_created( sf._is_created ),
+	_n_sim_threads( sf._n_sim_threads ),
 	_layout( sf._layout ),
 	_helio_objects( sf._helio_objects ),	//This contains the heliostat objects. The heliostat constructor will handle all internal pointer copy operations
 	_helio_template_objects( sf._helio_template_objects ),	//This contains the heliostat template objects.
@@ -205,20 +263,11 @@ SolarField::SolarField( const SolarField &sf )
 		_helio_by_id[ id ] = hp_map[ const_cast<Heliostat*>( const_cast<SolarField*>(&sf)->_helio_by_id[id] ) ];
 	}
 
-	//Heliostat groups
-	int nr, nc;
-	nr = (int)sf._helio_groups.nrows();
-	nc = (int)sf._helio_groups.ncols();
-	_helio_groups.resize_fill(nr, nc, Hvector()); //NULL));
-	for(int i=0; i<nr; i++){
-		for(int j=0; j<nc; j++){
-			int nh = (int)sf._helio_groups.at(i,j).size();
-			_helio_groups.at(i,j).resize(nh);
-			for(int k=0; k<nh; k++){
-				_helio_groups.at(i,j).at(k) = hp_map[ sf._helio_groups.at(i,j).at(k) ];
-			}
-		}
-	}
+	//Neighbor mesh
+	_neighbor_mesh = sf._neighbor_mesh;
+	for(size_t i=0; i<_neighbor_mesh.helios.size(); i++)
+		_neighbor_mesh.helios.at(i) = hp_map[ _neighbor_mesh.helios.at(i) ];
+	_neighbor_mesh.first = _helio_objects.empty() ? 0 : &_helio_objects.front();
 
 	//Layout groups
 	_layout_groups.resize(sf._layout_groups.size());
@@ -231,25 +280,6 @@ SolarField::SolarField( const SolarField &sf )
 	}
 	
 
-	//Neighbors
-	nr = (int)sf._neighbors.nrows();
-	nc = (int)sf._neighbors.ncols();
-	_neighbors.resize_fill(nr, nc, Hvector()); //0, NULL));
-	for(int i=0; i<nr; i++){
-		for(int j=0; j<nc; j++){
-			int nh = (int)sf._neighbors.at(i,j).size();
-			_neighbors.at(i,j).resize(nh);
-			for(int k=0; k<nh; k++){
-				_neighbors.at(i,j).at(k) = hp_map[ sf._neighbors.at(i,j).at(k)];
-			}
-		}
-	}
-	for(int i=0; i<npos; i++){
-		//Each heliostat needs to have the neighbor group assigned to it
-		Heliostat *hptr = _heliostats.at(i);
-		hptr->setNeighborList( &_neighbors.at( hptr->getGroupId()[0], hptr->getGroupId()[1] ) );
-	}
-
 	//Create receivers
 	unordered_map<Receiver*, Receiver*> r_map;	//map old receiver -> new receiver
 	int nrec = (int)sf._receivers.size();
@@ -458,9 +488,8 @@ void SolarField::Clean(){
 	_helio_templates.clear();
     _helio_template_objects.clear();
 	_heliostats.clear();
-	_helio_groups.clear();
 	_helio_by_id.clear();
-	_neighbors.clear();
+	_neighbor_mesh.clear();
 	_receivers.clear();
 	
 	_is_created = false;
@@ -520,7 +549,8 @@ double SolarField::calcAverageAttenuation()
 bool SolarField::UpdateNeighborList(double lims[4], double zen){
 	/* 
 	Update the neighbors associated with each heliostat based on the shadow extent. Determine this range
-	based on the current sun position
+	based on the current sun position. The neighbor mesh from the previous call is reused when neither the 
+	mesh dimensions nor the heliostat cells have changed.
 
 	lims:
 	0 : xmin
@@ -568,11 +598,16 @@ bool SolarField::UpdateNeighborList(double lims[4], double zen){
 	dcol = (xmax - xmin)/float(ncol);
 	drow = (ymax - ymin)/float(nrow);			//The column and row node width
 
-	//resize the mesh array accordingly
-	_helio_groups.resize_fill(nrow, ncol, Hvector());
+	//Find the mesh cell of each heliostat, and check whether the stored mesh still applies
+	neighbor_mesh *M = &_neighbor_mesh;
+	int Npos = (int)_helio_objects.size();
+	Heliostat *first = Npos > 0 ? &_helio_objects.front() : 0;
+
+	bool is_current = M->nrow == nrow && M->ncol == ncol && M->xmin == xmin && M->ymin == ymin 
+		&& M->dcol == dcol && M->drow == drow && M->first == first && (int)M->cell.size() == Npos;
+	M->cell.resize(Npos);
 
 	int col, row;	//indicates which node the heliostat is in
-	int Npos = (int)_helio_objects.size();
 	for(int i=0; i<Npos; i++){
 		Heliostat *hptr = &_helio_objects.at(i);
 		//Find which node to add this heliostat to
@@ -580,41 +615,55 @@ bool SolarField::UpdateNeighborList(double lims[4], double zen){
 		row = (int)fmax(0., fmin(row, nrow-1));
 		col = (int)(floor((hptr->getLocation()->x - xmin)/dcol));
 		col = (int)fmax(0., fmin(col, ncol-1));
-		//Add the heliostat ID to the mesh node
-		_helio_groups.at(row,col).push_back(hptr); 
 		//Add the mesh node ID to the heliostat information
 		hptr->setGroupId(row,col);
-	}
-
-	//Go over each node and compile a list of neighbors from the block of 9 adjacent cells.
-	if(CheckCancelStatus()) return false;	//check for cancelled simulation
-	int nh;
-	_neighbors.resize_fill(nrow, ncol, Hvector());
-	for(int i=0; i<nrow; i++){		//Loop over each row
-		for(int j=0; j<ncol; j++){	//Loop over each column
-			for(int k=i-1;k<i+2;k++){	//At each node position, get the surrounding nodes in the +/-y direction
-				if(k<0 || k>nrow-1) continue;	//If the search goes out of bounds in the y direction, loop to the next position
-				for(int l=j-1;l<j+2;l++){	//At each node position, get the surrounding nodes in the +/-x direction
-					if(l<0 || l>ncol-1) continue;	//If the search goes out of bounds in the x direction, loop to the next position
-					nh = (int)_helio_groups.at(k,l).size();	//How many heliostats are in this cell?
-					for(int m=0; m<nh; m++){	//Add each heliostat element in the mesh to the list of neighbors for the current cell at (i,j)
-						_neighbors.at(i,j).push_back( _helio_groups.at(k,l).at(m) );
-					}
-				}
-			}
+		if(M->cell[i] != row*ncol + col){
+			M->cell[i] = row*ncol + col;
+			is_current = false;
 		}
 	}
+	if(is_current) return true;
+
+	//Sort the heliostats by mesh cell. Heliostats within a cell stay in object order.
 	if(CheckCancelStatus()) return false;	//check for cancelled simulation
+	M->nrow = nrow;
+	M->ncol = ncol;
+	M->xmin = xmin;
+	M->ymin = ymin;
+	M->dcol = dcol;
+	M->drow = drow;
+	M->first = first;
+
+	M->cell_start.assign(nrow*ncol + 1, 0);
+	for(int i=0; i<Npos; i++)
+		M->cell_start.at(M->cell[i] + 1)++;
+	for(int i=0; i<nrow*ncol; i++)
+		M->cell_start.at(i+1) += M->cell_start.at(i);
+
+	std::vector<int> next(M->cell_start.begin(), M->cell_start.end() - 1);	//next open position in each cell
+	M->helios.resize(Npos);
+	for(int i=0; i<Npos; i++)
+		M->helios.at( next[M->cell[i]]++ ) = &_helio_objects.at(i);
 
-	//For each heliostat, assign the list of neighbors that are stored in the _neighbors grid
-	for(int i=0;i<Npos;i++){
-		Heliostat *hptr = &_helio_objects.at(i);
-		hptr->setNeighborList( &_neighbors.at( hptr->getGroupId()[0], hptr->getGroupId()[1] ) );	//Set the neighbor list according to the stored _neighbors indices
-	}
 	return true;
 
 }
 
+SolarField::neighbor_mesh::neighbor_mesh()
+{
+	clear();
+}
+
+void SolarField::neighbor_mesh::clear()
+{
+	nrow = ncol = 0;
+	xmin = ymin = dcol = drow = 0.;
+	first = 0;
+	helios.clear();
+	cell_start.clear();
+	cell.clear();
+}
+
 bool SolarField::UpdateLayoutGroups(double lims[4]){
 	
 	/* 
@@ -3068,13 +3117,13 @@ void SolarField::Simulate(double azimuth, double zenith, sim_params &P)
 		//The intercept factor is the most time consuming calculation. Simulate just a single heliostat in the 
 		//neighboring group and apply it to all the rest.
 		
-		for(int i=0; i<(int)_layout_groups.size(); i++){
+		parallelFor((int)_layout_groups.size(), _n_sim_threads, [&](int i){
 			
 			Hvector *hg = &_layout_groups.at(i);
 
 			int ngroup = (int)hg->size();
 
-			if(ngroup == 0) continue;
+			if(ngroup == 0) return;
 
 			Heliostat *helios = hg->front(); // just use the first one
 			double eta_int = _flux->imagePlaneIntercept(*_var_map, *helios, helios->getWhichReceiver(), &Sun);
@@ -3087,12 +3136,13 @@ void SolarField::Simulate(double azimuth, double zenith, sim_params &P)
 			}
 
 			
-		}
+		});
 	}
 	
-	//Simulate efficiency for all heliostats
-	for(int i=0; i<nh; i++)
+	//Simulate efficiency for all heliostats. Each call only modifies its own heliostat, so these can run in parallel.
+	parallelFor(nh, _n_sim_threads, [&](int i){
 		SimulateHeliostatEfficiency(this, Sun, _heliostats.at(i), P); 
+	});
 	
 	
 
@@ -3141,20 +3191,48 @@ void SolarField::SimulateHeliostatEfficiency(SolarField *SF, Vect &Sun, Heliosta
 		helios->setEfficiencyIntercept(eta_int);
 	}
 
-	//Shadowing and blocking
+	//Shadowing and blocking. Don't calculate shadowing for layout simulations. Cascaded shadowing effects can skew the layout.
+	SF->calcNeighborShadowBlock(helios, Sun, !P.is_layout);
+	
+	//Soiling, reflectivity, and receiver absorptance factors are included in the total calculation
+	double eta_rec_abs = Rec->getVarMap()->absorptance.val; // * eta_rec_acc,
+	double eta_total = helios->calcTotalEfficiency();
+	double power = eta_total * P.dni * helios->getArea() * eta_rec_abs;
+	helios->setPowerToReceiver( power );
+	helios->setPowerValue( power * P.Simweight*P.TOUweight * Rec->getThermalEfficiency() );
+
+	return;
+	
+}
+
+void SolarField::calcNeighborShadowBlock(Heliostat *helios, Vect &Sun, bool is_shadow)
+{
+	/* 
+	Calculate the shadowing and blocking efficiency of a heliostat from the heliostats in its own and the 
+	8 surrounding cells of the neighbor mesh. UpdateNeighborList() must be called first. If 'is_shadow' is 
+	false, the shadowing efficiency is set to 1.
+	*/
 	double
 		shad_tot = 1.,
 		block_tot = 1.;
 		
-    double interaction_limit = V->sf.interaction_limit.val;
-	Hvector *neibs = helios->getNeighborList();
-	int nn = (int)neibs->size();
-	for(int j=0; j<nn; j++){
-		if(helios == neibs->at(j) ) continue;	//Don't calculate blocking or shading for the same heliostat
+    double interaction_limit = _var_map->sf.interaction_limit.val;
+	neighbor_mesh *M = &_neighbor_mesh;
+	int row = helios->getGroupId()[0], 
+		col = helios->getGroupId()[1];
+	int col_first = max(col-1, 0),
+		col_last = min(col+1, M->ncol-1);
+
+	for(int k=max(row-1, 0); k<=min(row+1, M->nrow-1); k++){	//The cells in each mesh row are contiguous
+		int jend = M->cell_start[k*M->ncol + col_last + 1];
+		for(int j=M->cell_start[k*M->ncol + col_first]; j<jend; j++){
+			Heliostat *HI = M->helios[j];
+			if(helios == HI) continue;	//Don't calculate blocking or shading for the same heliostat
 		
-        if(!P.is_layout) shad_tot += -SF->calcShadowBlock(helios, neibs->at(j), 0, Sun, interaction_limit);	//Don't calculate shadowing for layout simulations. Cascaded shadowing effects can skew the layout.
+			if(is_shadow) shad_tot += -calcShadowBlock(helios, HI, 0, Sun, interaction_limit);
 		
-        block_tot += -SF->calcShadowBlock(helios, neibs->at(j), 1, Sun, interaction_limit);
+			block_tot += -calcShadowBlock(helios, HI, 1, Sun, interaction_limit);
+		}
 	}
 		
 	if(shad_tot < 0.) shad_tot = 0.;
@@ -3164,16 +3242,6 @@ void SolarField::SimulateHeliostatEfficiency(SolarField *SF, Vect &Sun, Heliosta
 	if(block_tot < 0.) block_tot = 0.;
 	if(block_tot > 1.) block_tot = 1.;
 	helios->setEfficiencyBlocking(block_tot);
-	
-	//Soiling, reflectivity, and receiver absorptance factors are included in the total calculation
-	double eta_rec_abs = Rec->getVarMap()->absorptance.val; // * eta_rec_acc,
-	double eta_total = helios->calcTotalEfficiency();
-	double power = eta_total * P.dni * helios->getArea() * eta_rec_abs;
-	helios->setPowerToReceiver( power );
-	helios->setPowerValue( power * P.Simweight*P.TOUweight * Rec->getThermalEfficiency() );
-
-	return;
-	
 }
 
 double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &Sun, double interaction_limit)
@@ -3560,11 +3628,14 @@ void SolarField::calcAllAimPoints(Vect &Sun, sim_params &P) //bool force_simple,
 
 		//Create a list of heliostats sorted by their Y image size
 		int nh = (int)_heliostats.size();
-		for(int i=0; i<nh; i++)
-        {
-            //update heliostat efficiency and optical coefficients
+
+        //update heliostat efficiency and optical coefficients
+        parallelFor(nh, _n_sim_threads, [&](int i){
             SimulateHeliostatEfficiency(this, Sun, _heliostats.at(i), P);
+        });
 
+		for(int i=0; i<nh; i++)
+        {
             hsort.push_back(_heliostats.at(i));
 			ysize.push_back(_heliostats.at(i)->getImageSize()[1]);
 		}
@@ -138,6 +138,8 @@ protected:
 		_cancel_flag,	//Flag indicating the current simulation should be cancelled
 		_is_created;	//Has the solar field Create() method been called?
 
+	int _n_sim_threads;	//Number of threads used to evaluate heliostat efficiencies in Simulate(). 0 = number of hardware threads
+
 
 	double _helio_extents[4];	//Extents of the heliostat field [xmax, xmin, ymax, ymin]
 	layout_shell _layout;	//All of the layouts associated with this solar field
@@ -148,9 +150,28 @@ protected:
 	std::vector<Heliostat> _helio_template_objects;	//Actual heliostat objects
 	unordered_map<int,Heliostat*> _helio_by_id;	//map of heliostats by ID#
 	Hvector _heliostats; //A std::vector containing all of the heliostats in the field that are used in calculation
-	matrix_t<Hvector> 
-		_helio_groups,	//A 2-D mesh containing vectors that list the heliostats in each field group.
-		_neighbors;	//A 2-D mesh where each node lists the heliostats that neighbor each other
+	
+	class neighbor_mesh
+	{
+		/* 
+		A 2-D mesh over the field used to find the heliostats that may shadow or block each other. The heliostats
+		are stored contiguously in row-major order of their mesh cells, so the heliostats in cells (r,c1) through 
+		(r,c2) are helios[cell_start[r*ncol+c1]] up to (not including) helios[cell_start[r*ncol+c2+1]]. 
+
+		The mesh is kept between simulations and rebuilt only when its dimensions or the heliostat cells change.
+		*/
+	public:
+		int nrow, ncol;
+		double xmin, ymin, dcol, drow;	//Mesh origin and cell dimensions
+		Heliostat *first;				//Address of the first heliostat object when the mesh was built
+		Hvector helios;					//Heliostats sorted by mesh cell
+		std::vector<int> cell_start;	//Index in 'helios' of the first heliostat in each cell, followed by the total count
+		std::vector<int> cell;			//Mesh cell of each heliostat object
+
+		neighbor_mesh();
+		void clear();
+	} _neighbor_mesh;
+
 	std::vector<Hvector> _layout_groups; //a std::vector of heliostat vectors that share flux intercept factor during layout calculations
 	std::vector<Receiver*> _receivers; //A std::vector containing all of the receiver objects
 	std::vector<Receiver*> _active_receivers;	//A std::vector containing only active receivers
@@ -227,6 +248,8 @@ public:
 	void setAimpointStatus(bool state);
 	void setSimulatedPowerToReceiver(double val);
 	void setHeliostatExtents(double xmax, double xmin, double ymax, double ymin);
+	void setSimulationThreads(int nthreads);
+	int getSimulationThreads();
 	
 	//Scripts
 	void Create(var_map &V);
@@ -259,6 +282,7 @@ public:
 	
     static void SimulateHeliostatEfficiency(SolarField *SF, Vect &Sun, Heliostat *helio, sim_params &P);
 	double calcShadowBlock(Heliostat *H, Heliostat *HS, int mode, Vect &Sun, double interaction_limit = 100.);	//Calculate the shadowing or blocking between two heliostats
+	void calcNeighborShadowBlock(Heliostat *H, Vect &Sun, bool is_shadow);	//Calculate shadowing (optional) and blocking efficiency of a heliostat from its neighbors
 	void updateAllTrackVectors(Vect &Sun);	//Macro for calculating corner positions
 	void calcHeliostatShadows(Vect &Sun);	//Macro for calculating heliostat shadows
 	void calcAllAimPoints(Vect &Sun, sim_params &P); //bool force_simple=false, bool quiet=true); 
@@ -250,8 +250,8 @@ DTobj *DTobj::Now()
 	time_t long_time;
 	// Get time as 64-bit integer.
 	time( &long_time ); 
-	// Convert to local time.
-	now = *localtime(&long_time);
+	// Convert to local time. The reentrant version is needed since simulation threads construct DateTime objects.
+	localtime_r(&long_time, &now);
 #endif
 	_year=now.tm_year+1900;  
 	_month=now.tm_mon;  
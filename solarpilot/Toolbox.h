@@ -147,7 +147,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			resize( rhs.nlayers(), rhs.nrows(), rhs.ncols() );
+			resize( rhs.nrows(), rhs.ncols(), rhs.nlayers() );
 			size_t nn = n_layers*n_rows*n_cols;
 			for (size_t i=0;i<nn;i++)
 				t_array[i] = rhs.t_array[i];
@@ -216,7 +216,7 @@ public:
 	void resize(size_t nr, size_t nc, size_t nl)
 	{
 		if (nr < 1 || nc < 1 || nl < 1) return;
-		if (nr == n_rows && nc == n_cols && n_layers) return;
+		if (nr == n_rows && nc == n_cols && nl == n_layers) return;
 			
 		if (t_array) delete [] t_array;
 		t_array = new T[ nr * nc * nl];
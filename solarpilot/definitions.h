@@ -62,10 +62,10 @@
 //Sandbox mode
 #define _SANDBOX 0
 //Include Coretrace (relevant to fieldcore only! Disabling this option will cause SolarPILOT compilation to fail.).
+//Compile without threading functionality? Comment out to remove.
+#define SP_USE_THREADS
 #ifdef SP_STANDALONE
 	#define SP_USE_SOLTRACE
-	//Compile without threading functionality? Comment out to remove.
-	#define SP_USE_THREADS
 	//crete local make-dir functions
 	#ifdef _WIN32
 	    #define SP_USE_MKDIR
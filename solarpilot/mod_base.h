@@ -347,41 +347,56 @@ public:
 
 protected:
     //----------------------------------------------------------------------------------------
-    void _as_str(std::string &vout, void* v)
+    static std::string _dbl_str(double v, int prec)
+    {
+        //prec is the number of significant digits. 0 uses the stream default of 6 digits
+        if( prec < 1 )
+            return my_to_string(v);
+        std::ostringstream x;
+        x.precision(prec);
+        x << v;
+        return x.str();
+    };
+
+    void _as_str(std::string &vout, void* v, int prec=0)
     {
         //don't do anything with a void argument
         (void)vout;
         (void)v;
+        (void)prec;
     }
 
-    void _as_str(std::string &vout, int &v)
+    void _as_str(std::string &vout, int &v, int prec=0)
     {
+        (void)prec;
         vout = my_to_string(v);
     };
 
-    void _as_str(std::string &vout, std::string &v)
+    void _as_str(std::string &vout, std::string &v, int prec=0)
     {
+        (void)prec;
         vout = v;
     };
 
-    void _as_str(std::string &vout, double &v)
+    void _as_str(std::string &vout, double &v, int prec=0)
     {
-        vout = my_to_string(v);
+        vout = _dbl_str(v, prec);
     };
 
-    void _as_str(std::string &vout, bool &v)
+    void _as_str(std::string &vout, bool &v, int prec=0)
     {
+        (void)prec;
         vout = v ? "true" : "false";
     };
 
-    void _as_str(std::string &vout,  matrix_t<double> &v)
+    void _as_str(std::string &vout,  matrix_t<double> &v, int prec=0)
     {
         vout.clear();
         for(size_t i=0; i<v.nrows(); i++)
         {
             for(size_t j=0; j<v.ncols(); j++)
             {
-                vout.append( my_to_string(v.at(i,j)) );
+                vout.append( _dbl_str(v.at(i,j), prec) );
                 if( j < v.ncols()-1 )
                     vout.append(",");
             }
@@ -389,27 +404,28 @@ protected:
         }
     };
 
-    void _as_str(std::string &vout, std::vector< sp_point > &v)
+    void _as_str(std::string &vout, std::vector< sp_point > &v, int prec=0)
     {
         vout.clear();
 
         for(size_t i=0; i<v.size(); i++)
-            vout.append("[P]" + my_to_string(v.at(i).x) + "," + my_to_string(v.at(i).y) + "," + my_to_string(v.at(i).z) );
+            vout.append("[P]" + _dbl_str(v.at(i).x, prec) + "," + _dbl_str(v.at(i).y, prec) + "," + _dbl_str(v.at(i).z, prec) );
     };
 
-    void _as_str(std::string &vout, std::vector< double > &v)
+    void _as_str(std::string &vout, std::vector< double > &v, int prec=0)
     {
         vout.clear();
         for(size_t i=0; i<v.size(); i++)
         {
-            vout.append( my_to_string(v.at(i)) );
+            vout.append( _dbl_str(v.at(i), prec) );
             if(i<v.size()-1)
                 vout.append(",");
         }
     };
 
-    void _as_str(std::string &vout, std::vector< int > &v)
+    void _as_str(std::string &vout, std::vector< int > &v, int prec=0)
     {
+        (void)prec;
         vout.clear();
         for(size_t i=0; i<v.size(); i++)
         {
@@ -419,11 +435,13 @@ protected:
         }
     };
 
-    void _as_str(std::string &vout, WeatherData &v)
+    void _as_str(std::string &vout, WeatherData &v, int prec=0)
     {
         vout.clear();
 
         std::stringstream S;
+        if( prec > 0 )
+            S.precision(prec);
 
         std::vector<std::vector<double>*> *wp = v.getEntryPointers();
 
@@ -441,7 +459,7 @@ protected:
         vout = S.str();
     };
 
-    void _as_str(std::string &vout, std::vector< std::vector< sp_point > > &v)
+    void _as_str(std::string &vout, std::vector< std::vector< sp_point > > &v, int prec=0)
     {
         /* 
         [POLY] separates entries
@@ -461,7 +479,7 @@ protected:
 
                 for(int k=0; k<3; k++)
                 {
-                    vout.append(my_to_string(v.at(i).at(j)[k]));
+                    vout.append(_dbl_str(v.at(i).at(j)[k], prec));
                     if( k<2 )
                         vout.append(",");
                 }
@@ -491,6 +509,7 @@ public:
     virtual bool set_from_string(const char* Val){(void)Val; return false;};
     virtual void as_string(std::string &ValAsStr){ (void)ValAsStr; throw spexception("Virtual method as_string cannot be executed in base class");};
     virtual std::string as_string(){throw spexception("Virtual method as_string cannot be executed in base class");};
+    virtual std::string as_string(int prec){ (void)prec; throw spexception("Virtual method as_string cannot be executed in base class");};	//doubles with prec significant digits
     virtual bool combo_select(std::string choice){ (void)choice; throw spexception("Virtual method combo_select cannot be executed in base class"); };
     virtual bool combo_select_by_choice_index(int index){ (void)index; throw spexception("Virtual method combo_select_by_choice_index cannot be executed in base class");};
     virtual bool combo_select_by_mapval(int mapval){ (void)mapval; throw spexception("Virtual method combo_select_by_mapval cannot be executed in base class");};
@@ -499,6 +518,7 @@ public:
     virtual int mapval(){throw spexception("Virtual method combo_get_current_mapval cannot be executed in base class");};
     virtual int combo_get_current_index(){throw spexception("Virtual method combo_get_current_index cannot be executed in base class");};
     virtual SP_DATTYPE get_data_type(){ return dattype; }
+    virtual bool is_output(){ return false; }	//calculated by SolarPILOT rather than set by the user
 };
 
 template <typename T>
@@ -623,6 +643,12 @@ public:
         _as_str(vstr, val);
         return vstr;
     }
+    std::string as_string(int prec)
+    {
+        std::string vstr;
+        _as_str(vstr, val, prec);
+        return vstr;
+    }
 
     void set( 
         std::string Address, 
@@ -719,6 +745,12 @@ public:
         _as_str(vstr, _val);
         return vstr;
     }
+    std::string as_string(int prec)
+    {
+        std::string vstr;
+        _as_str(vstr, _val, prec);
+        return vstr;
+    }
     void setup( 
         std::string Address, 
         SP_DATTYPE Dtype, 
@@ -746,6 +778,8 @@ public:
 
     }
 
+    bool is_output(){ return true; }
+
     //create methods for the variable members to emphasize that these cannot be modified
     T& Val() { return _val; };	//get variable value
     void Setval(T v) { _val = v; };  //set variable value
@@ -649,28 +649,31 @@ battstor::battstor(compute_module &cm, bool setup_model, size_t nrec, double dt_
 	Initialize outputs
 	********************************************************************** */
 
+	// state and loss diagnostics are only written in outputs_fixed/outputs_topology_dependent,
+	// so they are not allocated unless requested
+
 	// non-lifetime outputs
 	if (nyears <= 1)
 	{
 		// only allocate if lead-acid
 		if (chem == 0)
 		{
-			outAvailableCharge = cm.allocate("batt_q1", nrec*nyears);
-			outBoundCharge = cm.allocate("batt_q2", nrec*nyears);
+			outAvailableCharge = cm.allocate_if_requested("batt_q1", nrec*nyears);
+			outBoundCharge = cm.allocate_if_requested("batt_q2", nrec*nyears);
 		}
-		outCellVoltage = cm.allocate("batt_voltage_cell", nrec*nyears);
-		outMaxCharge = cm.allocate("batt_qmax", nrec*nyears);
-		outMaxChargeThermal = cm.allocate("batt_qmax_thermal", nrec*nyears);
-		outBatteryTemperature = cm.allocate("batt_temperature", nrec*nyears);
-		outCapacityThermalPercent = cm.allocate("batt_capacity_thermal_percent", nrec*nyears);
+		outCellVoltage = cm.allocate_if_requested("batt_voltage_cell", nrec*nyears);
+		outMaxCharge = cm.allocate_if_requested("batt_qmax", nrec*nyears);
+		outMaxChargeThermal = cm.allocate_if_requested("batt_qmax_thermal", nrec*nyears);
+		outBatteryTemperature = cm.allocate_if_requested("batt_temperature", nrec*nyears);
+		outCapacityThermalPercent = cm.allocate_if_requested("batt_capacity_thermal_percent", nrec*nyears);
 	}
-	outCurrent = cm.allocate("batt_I", nrec*nyears);
-	outBatteryVoltage = cm.allocate("batt_voltage", nrec*nyears);
-	outTotalCharge = cm.allocate("batt_q0", nrec*nyears);
-	outCycles = cm.allocate("batt_cycles", nrec*nyears);
-	outSOC = cm.allocate("batt_SOC", nrec*nyears);
-	outDOD = cm.allocate("batt_DOD", nrec*nyears);
-	outCapacityPercent = cm.allocate("batt_capacity_percent", nrec*nyears);
+	outCurrent = cm.allocate_if_requested("batt_I", nrec*nyears);
+	outBatteryVoltage = cm.allocate_if_requested("batt_voltage", nrec*nyears);
+	outTotalCharge = cm.allocate_if_requested("batt_q0", nrec*nyears);
+	outCycles = cm.allocate_if_requested("batt_cycles", nrec*nyears);
+	outSOC = cm.allocate_if_requested("batt_SOC", nrec*nyears);
+	outDOD = cm.allocate_if_requested("batt_DOD", nrec*nyears);
+	outCapacityPercent = cm.allocate_if_requested("batt_capacity_percent", nrec*nyears);
 	outBatteryPower = cm.allocate("batt_power", nrec*nyears);
 	outGridPower = cm.allocate("grid_power", nrec*nyears); // Net grid energy required.  Positive indicates putting energy on grid.  Negative indicates pulling off grid
 	outGenPower = cm.allocate("pv_batt_gen", nrec*nyears);
@@ -684,8 +687,8 @@ battstor::battstor(compute_module &cm, bool setup_model, size_t nrec, double dt_
 
 		if (batt_vars->batt_dispatch != dispatch_t::MANUAL)
 		{
-			outGridPowerTarget = cm.allocate("grid_power_target", nrec*nyears);
-			outBattPowerTarget = cm.allocate("batt_power_target", nrec*nyears);
+			outGridPowerTarget = cm.allocate_if_requested("grid_power_target", nrec*nyears);
+			outBattPowerTarget = cm.allocate_if_requested("batt_power_target", nrec*nyears);
 		}
 	}
 	else if (batt_vars->batt_meter_position == dispatch_t::FRONT)
@@ -693,8 +696,8 @@ battstor::battstor(compute_module &cm, bool setup_model, size_t nrec, double dt_
 		outBatteryToGrid = cm.allocate("batt_to_grid", nrec*nyears);
 
 		if (batt_vars->batt_dispatch != dispatch_t::FOM_MANUAL) {
-			outCostToCycle = cm.allocate("batt_cost_to_cycle", nrec*nyears);
-			outBattPowerTarget = cm.allocate("batt_power_target", nrec*nyears);
+			outCostToCycle = cm.allocate_if_requested("batt_cost_to_cycle", nrec*nyears);
+			outBattPowerTarget = cm.allocate_if_requested("batt_power_target", nrec*nyears);
 		}
 	}
 	outPVToBatt = cm.allocate("pv_to_batt", nrec*nyears);
@@ -707,8 +710,8 @@ battstor::battstor(compute_module &cm, bool setup_model, size_t nrec, double dt_
 
 	}
 
-	outBatteryConversionPowerLoss = cm.allocate("batt_conversion_loss", nrec*nyears);
-	outBatterySystemLoss = cm.allocate("batt_system_loss", nrec*nyears);
+	outBatteryConversionPowerLoss = cm.allocate_if_requested("batt_conversion_loss", nrec*nyears);
+	outBatterySystemLoss = cm.allocate_if_requested("batt_system_loss", nrec*nyears);
 
 	// annual outputs
 	size_t annual_size = nyears + 1;
@@ -1173,26 +1176,26 @@ void battstor::outputs_fixed(compute_module &cm)
 		// Capacity Output with Losses Applied
 		if (capacity_kibam_t * kibam = dynamic_cast<capacity_kibam_t*>(capacity_model))
 		{
-			outAvailableCharge[index] = (ssc_number_t)(kibam->q1());
-			outBoundCharge[index] = (ssc_number_t)(kibam->q2());
+			if (outAvailableCharge) outAvailableCharge[index] = (ssc_number_t)(kibam->q1());
+			if (outBoundCharge) outBoundCharge[index] = (ssc_number_t)(kibam->q2());
 		}
-		outCellVoltage[index] = (ssc_number_t)(voltage_model->cell_voltage());
-		outMaxCharge[index] = (ssc_number_t)(capacity_model->qmax());
-		outMaxChargeThermal[index] = (ssc_number_t)(capacity_model->qmax_thermal());
+		if (outCellVoltage) outCellVoltage[index] = (ssc_number_t)(voltage_model->cell_voltage());
+		if (outMaxCharge) outMaxCharge[index] = (ssc_number_t)(capacity_model->qmax());
+		if (outMaxChargeThermal) outMaxChargeThermal[index] = (ssc_number_t)(capacity_model->qmax_thermal());
 	
-		outBatteryTemperature[index] = (ssc_number_t)(thermal_model->T_battery() - 273.15);
-		outCapacityThermalPercent[index] = (ssc_number_t)(thermal_model->capacity_percent());
+		if (outBatteryTemperature) outBatteryTemperature[index] = (ssc_number_t)(thermal_model->T_battery() - 273.15);
+		if (outCapacityThermalPercent) outCapacityThermalPercent[index] = (ssc_number_t)(thermal_model->capacity_percent());
 	}
 
 	// Lifetime outputs
-	outTotalCharge[index] = (ssc_number_t)(capacity_model->q0());
-	outCurrent[index] = (ssc_number_t)(capacity_model->I());
-	outBatteryVoltage[index] = (ssc_number_t)(voltage_model->battery_voltage());
-
-	outCycles[index] = (ssc_number_t)(lifetime_cycle_model->cycles_elapsed());
-	outSOC[index] = (ssc_number_t)(capacity_model->SOC());
-	outDOD[index] = (ssc_number_t)(lifetime_cycle_model->cycle_range());
-	outCapacityPercent[index] = (ssc_number_t)(lifetime_model->capacity_percent());
+	if (outTotalCharge) outTotalCharge[index] = (ssc_number_t)(capacity_model->q0());
+	if (outCurrent) outCurrent[index] = (ssc_number_t)(capacity_model->I());
+	if (outBatteryVoltage) outBatteryVoltage[index] = (ssc_number_t)(voltage_model->battery_voltage());
+
+	if (outCycles) outCycles[index] = (ssc_number_t)(lifetime_cycle_model->cycles_elapsed());
+	if (outSOC) outSOC[index] = (ssc_number_t)(capacity_model->SOC());
+	if (outDOD) outDOD[index] = (ssc_number_t)(lifetime_cycle_model->cycle_range());
+	if (outCapacityPercent) outCapacityPercent[index] = (ssc_number_t)(lifetime_model->capacity_percent());
 }
  
 void battstor::outputs_topology_dependent(compute_module &)
@@ -1210,8 +1213,8 @@ void battstor::outputs_topology_dependent(compute_module &)
 		outFuelCellToBatt[index] = (ssc_number_t)(dispatch_model->power_fuelcell_to_batt());
 		outFuelCellToGrid[index] = (ssc_number_t)(dispatch_model->power_fuelcell_to_grid());
 	}
-	outBatteryConversionPowerLoss[index] = (ssc_number_t)(dispatch_model->power_conversion_loss());
-	outBatterySystemLoss[index] = (ssc_number_t)(dispatch_model->power_system_loss());
+	if (outBatteryConversionPowerLoss) outBatteryConversionPowerLoss[index] = (ssc_number_t)(dispatch_model->power_conversion_loss());
+	if (outBatterySystemLoss) outBatterySystemLoss[index] = (ssc_number_t)(dispatch_model->power_system_loss());
 	outPVToGrid[index] = (ssc_number_t)(dispatch_model->power_pv_to_grid());
 
 	// Fuel cell updates
@@ -1220,8 +1223,8 @@ void battstor::outputs_topology_dependent(compute_module &)
 		outFuelCellToBatt[index] = (ssc_number_t)(dispatch_model->power_fuelcell_to_batt());
 		outFuelCellToGrid[index] = (ssc_number_t)(dispatch_model->power_fuelcell_to_grid());
 	}
-	outBatteryConversionPowerLoss[index] = (ssc_number_t)(dispatch_model->power_conversion_loss());
-	outBatterySystemLoss[index] = (ssc_number_t)(dispatch_model->power_system_loss());
+	if (outBatteryConversionPowerLoss) outBatteryConversionPowerLoss[index] = (ssc_number_t)(dispatch_model->power_conversion_loss());
+	if (outBatterySystemLoss) outBatterySystemLoss[index] = (ssc_number_t)(dispatch_model->power_system_loss());
 	outPVToGrid[index] = (ssc_number_t)(dispatch_model->power_pv_to_grid());
 
 	if (batt_vars->batt_meter_position == dispatch_t::BEHIND)
@@ -1232,8 +1235,8 @@ void battstor::outputs_topology_dependent(compute_module &)
 
 		if (batt_vars->batt_dispatch != dispatch_t::MANUAL)
 		{
-			outGridPowerTarget[index] = (ssc_number_t)(dispatch_model->power_grid_target());
-			outBattPowerTarget[index] = (ssc_number_t)(dispatch_model->power_batt_target());
+			if (outGridPowerTarget) outGridPowerTarget[index] = (ssc_number_t)(dispatch_model->power_grid_target());
+			if (outBattPowerTarget) outBattPowerTarget[index] = (ssc_number_t)(dispatch_model->power_batt_target());
 		}
 
 	}
@@ -1242,8 +1245,8 @@ void battstor::outputs_topology_dependent(compute_module &)
 		outBatteryToGrid[index] = (ssc_number_t)(dispatch_model->power_battery_to_grid());
 
 		if (batt_vars->batt_dispatch != dispatch_t::FOM_MANUAL) {
-			outCostToCycle[index] = (ssc_number_t)(dispatch_model->cost_to_cycle());
-			outBattPowerTarget[index] = (ssc_number_t)(dispatch_model->power_batt_target());
+			if (outCostToCycle) outCostToCycle[index] = (ssc_number_t)(dispatch_model->cost_to_cycle());
+			if (outBattPowerTarget) outBattPowerTarget[index] = (ssc_number_t)(dispatch_model->power_batt_target());
 		}
 	}
 }
@@ -69,6 +69,7 @@ static var_info _cm_vtab_pvsamv1[] = {
 //	{ SSC_INPUT,        SSC_ARRAY,       "ac_degradation",                              "Annual AC degradation",                                "%/year",   "",                              "pvsamv1",             "system_use_lifetime_output=1",   "",                             "" },
 	{ SSC_OUTPUT,       SSC_ARRAY,       "dc_degrade_factor",                           "Annual module degrade factor",                         "",         "",                              "Annual",             "system_use_lifetime_output=1",   "",                             "" },
 //	{ SSC_OUTPUT,       SSC_ARRAY,       "ac_degrade_factor",                           "Annual AC degrade factor",                             "",         "",                              "pvsamv1",             "system_use_lifetime_output=1",   "",                             "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "en_lifetime_dc_reuse",                        "Reuse first year DC power in later years",             "0/1",      "",                              "pvsamv1",             "?=0",                        "BOOLEAN",                      "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "en_dc_lifetime_losses",                       "Enable lifetime daily DC losses",                      "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 	{ SSC_INPUT,        SSC_ARRAY,       "dc_lifetime_losses",                          "Lifetime daily DC losses",                             "%",        "",                              "pvsamv1",             "en_dc_lifetime_losses=1",    "",                             "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "en_ac_lifetime_losses",                       "Enable lifetime daily AC losses",                      "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
@@ -995,7 +996,7 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 	}
 
 	// Warning workaround
-	static bool is32BitLifetime = (__ARCHBITS__ == 32 && system_use_lifetime_output);
+	bool is32BitLifetime = (__ARCHBITS__ == 32 && system_use_lifetime_output);
 	if (is32BitLifetime)
 		throw exec_error( "pvsamv1", "Lifetime simulation of PV systems is only available in the 64 bit version of SAM.");
 
@@ -1086,6 +1087,45 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 		std::vector<double> tmp;
 		dcStringVoltage.push_back(tmp);
 	}
+
+	// sun positions and surface angles repeat every year and are shared by subarrays with the same
+	// orientation, so compute them once for the whole weather file
+	std::shared_ptr<const solarpos_table> sunPositionTable = solarpos_table::shared(wdprov,
+		Irradiance->instantaneous ? IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET : Irradiance->dtHour);
+	std::vector< std::shared_ptr<incidence_table> > surfaceAngleTables(num_subarrays);
+	for (size_t nn = 0; nn < num_subarrays; nn++)
+	{
+		// seasonal tilt changes the surface every month
+		if (!Subarrays[nn]->enable || Subarrays[nn]->trackMode == irrad::SEASONAL_TILT)
+			continue;
+
+		for (size_t mm = 0; mm < nn && !surfaceAngleTables[nn]; mm++)
+		{
+			if (surfaceAngleTables[mm] && Subarrays[mm]->trackMode == Subarrays[nn]->trackMode
+				&& Subarrays[mm]->tiltDegrees == Subarrays[nn]->tiltDegrees && Subarrays[mm]->azimuthDegrees == Subarrays[nn]->azimuthDegrees
+				&& Subarrays[mm]->trackerRotationLimitDegrees == Subarrays[nn]->trackerRotationLimitDegrees
+				&& Subarrays[mm]->backtrackingEnabled == Subarrays[nn]->backtrackingEnabled
+				&& Subarrays[mm]->groundCoverageRatio == Subarrays[nn]->groundCoverageRatio)
+				surfaceAngleTables[nn] = surfaceAngleTables[mm];
+		}
+		if (!surfaceAngleTables[nn])
+			surfaceAngleTables[nn] = std::make_shared<incidence_table>(*sunPositionTable, Subarrays[nn]->trackMode,
+				Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->trackerRotationLimitDegrees,
+				Subarrays[nn]->backtrackingEnabled, Subarrays[nn]->groundCoverageRatio);
+	}
+
+	// rear-side irradiance buffers are reused every timestep
+	std::vector<bifacial_workspace> bifacialWorkspaces(num_subarrays);
+
+	// with the default models, irradiance, shading, cell temperature and module power do not change from year to year, only
+	// the degradation and lifetime losses applied to the subarray DC power after them.  when the caller opts in, compute them
+	// in the first year and reuse the subarray DC power in later years, unless a model carries state from one year into the next
+	bool reuse_dc = nyears > 1 && Simulation->reuseFirstYearDC
+		&& !PVSystem->enableSnowModel && radmode != irrad::POA_R && radmode != irrad::POA_P;
+	std::vector< std::vector<double> > dcPowerSubarrayFirstYear;
+	if (reuse_dc)
+		dcPowerSubarrayFirstYear.assign(num_subarrays, std::vector<double>(nrec, 0.0));
+
 	for (size_t iyear = 0; iyear < nyears; iyear++)
 	{
 		for (hour = 0; hour < 8760; hour++)
@@ -1122,699 +1162,753 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 				//						iyear, hour, jj, cur_load), SSC_WARNING, (float)idx);
 				p_load_full.push_back((ssc_number_t)cur_load);
 
-				if (!wdprov->read(&Irradiance->weatherRecord))
-					throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(idx + 1)) + " in weather file");
+				if (!reuse_dc || iyear == 0)
+				{
+					if (!wdprov->read(&Irradiance->weatherRecord))
+						throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(idx + 1)) + " in weather file");
 
-				weather_record wf = Irradiance->weatherRecord;
+					weather_record wf = Irradiance->weatherRecord;
 
-				//update POA data structure indicies if radmode is POA model is enabled
-				if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-					for (size_t nn = 0; nn < num_subarrays; nn++){
-						if (!Subarrays[nn]->enable) continue;
+					//update POA data structure indicies if radmode is POA model is enabled
+					if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+						for (size_t nn = 0; nn < num_subarrays; nn++){
+							if (!Subarrays[nn]->enable) continue;
 
-						Subarrays[nn]->poa.poaAll->tDew = wf.tdew;
-						Subarrays[nn]->poa.poaAll->i = idx;
-						if (jj == 0 && wf.hour == 0) {
-							Subarrays[nn]->poa.poaAll->dayStart = idx;
-							Subarrays[nn]->poa.poaAll->doy += 1;
-						}
+							Subarrays[nn]->poa.poaAll->tDew = wf.tdew;
+							Subarrays[nn]->poa.poaAll->i = idx;
+							if (jj == 0 && wf.hour == 0) {
+								Subarrays[nn]->poa.poaAll->dayStart = idx;
+								Subarrays[nn]->poa.poaAll->doy += 1;
+							}
 
+						}
 					}
-				}
-				
-				double solazi = 0, solzen = 0, solalt = 0;
-				int sunup = 0;
-
-				// accumulators for radiation power (W) over this
-				// timestep from each subarray
-				double ts_accum_poa_front_nom = 0.0;
-				double ts_accum_poa_front_beam_nom = 0.0;
-				double ts_accum_poa_front_shaded = 0.0;
-				double ts_accum_poa_front_shaded_soiled = 0.0;
-				double ts_accum_poa_front_total = 0.0;
-				double ts_accum_poa_rear = 0.0;
-				double ts_accum_poa_rear_after_losses = 0.0;
-				double ts_accum_poa_total_eff = 0.0;
-				double ts_accum_poa_front_beam_eff = 0.0;
-
-				// calculate incident irradiance on each subarray
-				std::vector<double> ipoa_rear, ipoa_rear_after_losses, ipoa_front, ipoa;
-				double alb;
-				alb = 0;
-
-				for (size_t nn = 0; nn < num_subarrays; nn++)
-				{
-					ipoa_rear.push_back(0);
-					ipoa_rear_after_losses.push_back(0);
-					ipoa_front.push_back(0);
-					ipoa.push_back(0);
-
-					if (!Subarrays[nn]->enable
-						|| Subarrays[nn]->nStrings < 1)
-						continue; // skip disabled subarrays
-
-					irrad irr(Irradiance->weatherRecord, Irradiance->weatherHeader,
-						Irradiance->skyModel, Irradiance->radiationMode, Subarrays[nn]->trackMode,
-						Irradiance->useWeatherFileAlbedo, Irradiance->instantaneous, Subarrays[nn]->backtrackingEnabled,
-						Irradiance->dtHour, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->trackerRotationLimitDegrees, Subarrays[nn]->groundCoverageRatio,
-						Subarrays[nn]->monthlyTiltDegrees, Irradiance->userSpecifiedMonthlyAlbedo,
-						Subarrays[nn]->poa.poaAll.get());
-											
-					int code = irr.calc();
-
-					if (code < 0) //jmf updated 11/30/18 so that negative numbers are errors, positive numbers are warnings, 0 is everything correct. implemented in patch for POA model only, will be added to develop for other irrad models as well
-						throw exec_error("pvsamv1",
-						util::format("failed to calculate irradiance incident on surface (POA) %d (code: %d) [y:%d m:%d d:%d h:%d]",
-						nn + 1, code, wf.year, wf.month, wf.day, wf.hour));
-
-					if (code == 40)
-						log(util::format("SAM calculated negative direct normal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
-							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-					else if (code == 41)
-						log(util::format("SAM calculated negative diffuse horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
-							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-					else if (code == 42)
-						log(util::format("SAM calculated negative global horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
-							wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-									   					 
-					// p_irrad_calc is only weather file records long...
-					if (iyear == 0)
+					
+					double solazi = 0, solzen = 0, solalt = 0;
+					int sunup = 0;
+
+					// accumulators for radiation power (W) over this
+					// timestep from each subarray
+					double ts_accum_poa_front_nom = 0.0;
+					double ts_accum_poa_front_beam_nom = 0.0;
+					double ts_accum_poa_front_shaded = 0.0;
+					double ts_accum_poa_front_shaded_soiled = 0.0;
+					double ts_accum_poa_front_total = 0.0;
+					double ts_accum_poa_rear = 0.0;
+					double ts_accum_poa_rear_after_losses = 0.0;
+					double ts_accum_poa_total_eff = 0.0;
+					double ts_accum_poa_front_beam_eff = 0.0;
+
+					// calculate incident irradiance on each subarray
+					std::vector<double> ipoa_rear, ipoa_rear_after_losses, ipoa_front, ipoa;
+					double alb;
+					alb = 0;
+
+					for (size_t nn = 0; nn < num_subarrays; nn++)
 					{
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P) {
-							double gh_temp, df_temp, dn_temp;
-							gh_temp = df_temp = dn_temp = 0;
-							irr.get_irrad(&gh_temp, &dn_temp, &df_temp);
-							Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)df_temp;
-							Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)dn_temp;
+						ipoa_rear.push_back(0);
+						ipoa_rear_after_losses.push_back(0);
+						ipoa_front.push_back(0);
+						ipoa.push_back(0);
+
+						if (!Subarrays[nn]->enable
+							|| Subarrays[nn]->nStrings < 1)
+							continue; // skip disabled subarrays
+
+						irrad irr(Irradiance->weatherRecord, Irradiance->weatherHeader,
+							Irradiance->skyModel, Irradiance->radiationMode, Subarrays[nn]->trackMode,
+							Irradiance->useWeatherFileAlbedo, Irradiance->instantaneous, Subarrays[nn]->backtrackingEnabled,
+							Irradiance->dtHour, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->trackerRotationLimitDegrees, Subarrays[nn]->groundCoverageRatio,
+							Subarrays[nn]->monthlyTiltDegrees, Irradiance->userSpecifiedMonthlyAlbedo,
+							Subarrays[nn]->poa.poaAll.get());
+						irr.set_angle_tables(sunPositionTable.get(), surfaceAngleTables[nn].get(), hour*step_per_hour + jj);
+												
+						int code = irr.calc();
+
+						if (code < 0) //jmf updated 11/30/18 so that negative numbers are errors, positive numbers are warnings, 0 is everything correct. implemented in patch for POA model only, will be added to develop for other irrad models as well
+							throw exec_error("pvsamv1",
+							util::format("failed to calculate irradiance incident on surface (POA) %d (code: %d) [y:%d m:%d d:%d h:%d]",
+							nn + 1, code, wf.year, wf.month, wf.day, wf.hour));
+
+						if (code == 40)
+							log(util::format("SAM calculated negative direct normal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
+								wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+						else if (code == 41)
+							log(util::format("SAM calculated negative diffuse horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
+								wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+						else if (code == 42)
+							log(util::format("SAM calculated negative global horizontal irradiance in the POA decomposition algorithm at time [y:%d m:%d d:%d h:%d], set to zero.",
+								wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+										   					 
+						// p_irrad_calc is only weather file records long...
+						if (iyear == 0)
+						{
+							if (radmode == irrad::POA_R || radmode == irrad::POA_P) {
+								double gh_temp, df_temp, dn_temp;
+								gh_temp = df_temp = dn_temp = 0;
+								irr.get_irrad(&gh_temp, &dn_temp, &df_temp);
+								Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)df_temp;
+								Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)dn_temp;
+							}
 						}
-					}
-					// beam, skydiff, and grounddiff IN THE PLANE OF ARRAY (W/m2)
-					double ibeam, iskydiff, ignddiff;
-					double aoi, stilt, sazi, rot, btd;
-
-					// Ensure that the usePOAFromWF flag is false unless a reference cell has been used. 
-					//  This will later get forced to false if any shading has been applied (in any scenario)
-					//  also this will also be forced to false if using the cec mcsp thermal model OR if using the spe module model with a diffuse util. factor < 1.0
-					Subarrays[nn]->poa.usePOAFromWF = false;
-					if (radmode == irrad::POA_R){
-						ipoa[nn] = wf.poa;
-						Subarrays[nn]->poa.usePOAFromWF = true;
-					}
-					else if (radmode == irrad::POA_P){
-						ipoa[nn] = wf.poa;
-					}
+						// beam, skydiff, and grounddiff IN THE PLANE OF ARRAY (W/m2)
+						double ibeam, iskydiff, ignddiff;
+						double aoi, stilt, sazi, rot, btd;
 
-					if (Subarrays[nn]->Module->simpleEfficiencyForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){  // only will be true if using a poa model AND spe module model AND spe_fp is < 1
+						// Ensure that the usePOAFromWF flag is false unless a reference cell has been used. 
+						//  This will later get forced to false if any shading has been applied (in any scenario)
+						//  also this will also be forced to false if using the cec mcsp thermal model OR if using the spe module model with a diffuse util. factor < 1.0
 						Subarrays[nn]->poa.usePOAFromWF = false;
-						if (idx == 0)
-							log("The combination of POA irradiance as in input, single point efficiency module model, and module diffuse utilization factor less than one means that SAM must use a POA decomposition model to calculate the incident diffuse irradiance", SSC_WARNING);
-					}
+						if (radmode == irrad::POA_R){
+							ipoa[nn] = wf.poa;
+							Subarrays[nn]->poa.usePOAFromWF = true;
+						}
+						else if (radmode == irrad::POA_P){
+							ipoa[nn] = wf.poa;
+						}
 
-					if (Subarrays[nn]->Module->mountingSpecificCellTemperatureForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){
-						Subarrays[nn]->poa.usePOAFromWF = false;
-						if (idx == 0)
-							log("The combination of POA irradiance as input and heat transfer method for cell temperature means that SAM must use a POA decomposition model to calculate the beam irradiance required by the cell temperature model", SSC_WARNING);
-					}
+						if (Subarrays[nn]->Module->simpleEfficiencyForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){  // only will be true if using a poa model AND spe module model AND spe_fp is < 1
+							Subarrays[nn]->poa.usePOAFromWF = false;
+							if (idx == 0)
+								log("The combination of POA irradiance as in input, single point efficiency module model, and module diffuse utilization factor less than one means that SAM must use a POA decomposition model to calculate the incident diffuse irradiance", SSC_WARNING);
+						}
 
+						if (Subarrays[nn]->Module->mountingSpecificCellTemperatureForceNoPOA && (radmode == irrad::POA_R || radmode == irrad::POA_P)){
+							Subarrays[nn]->poa.usePOAFromWF = false;
+							if (idx == 0)
+								log("The combination of POA irradiance as input and heat transfer method for cell temperature means that SAM must use a POA decomposition model to calculate the beam irradiance required by the cell temperature model", SSC_WARNING);
+						}
 
-					// Get Incident angles and irradiances
-					irr.get_sun(&solazi, &solzen, &solalt, 0, 0, 0, &sunup, 0, 0, 0);
-					irr.get_angles(&aoi, &stilt, &sazi, &rot, &btd);
-					irr.get_poa(&ibeam, &iskydiff, &ignddiff, 0, 0, 0);
-					alb = irr.getAlbedo();
 
-					if (iyear == 0)
-						Irradiance->p_sunPositionTime[idx] = (ssc_number_t)irr.get_sunpos_calc_hour();
+						// Get Incident angles and irradiances
+						irr.get_sun(&solazi, &solzen, &solalt, 0, 0, 0, &sunup, 0, 0, 0);
+						irr.get_angles(&aoi, &stilt, &sazi, &rot, &btd);
+						irr.get_poa(&ibeam, &iskydiff, &ignddiff, 0, 0, 0);
+						alb = irr.getAlbedo();
 
-					// save weather file beam, diffuse, and global for output and for use later in pvsamv1- year 1 only
-					/*jmf 2016: these calculations are currently redundant with calculations in irrad.calc() because ibeam and idiff in that function are DNI and DHI, **NOT** in the plane of array
-					we'll have to fix this redundancy in the pvsamv1 rewrite. it will require allowing irradproc to report the errors below
-					and deciding what to do if the weather file DOES contain the third component but it's not being used in the calculations.*/
-					if (iyear == 0)
-					{
-						// Apply all irradiance component data from weather file (if it exists)
-						Irradiance->p_weatherFilePOA[0][idx] = (ssc_number_t)wf.poa;
-						Irradiance->p_weatherFileDNI[idx] = (ssc_number_t)wf.dn;
-						Irradiance->p_weatherFileGHI[idx] = (ssc_number_t)(wf.gh);
-						Irradiance->p_weatherFileDHI[idx] = (ssc_number_t)(wf.df);
-
-						// calculate beam if global & diffuse are selected as inputs
-						if (radmode == irrad::GH_DF)
+						if (iyear == 0)
+							Irradiance->p_sunPositionTime[idx] = (ssc_number_t)irr.get_sunpos_calc_hour();
+
+						// save weather file beam, diffuse, and global for output and for use later in pvsamv1- year 1 only
+						/*jmf 2016: these calculations are currently redundant with calculations in irrad.calc() because ibeam and idiff in that function are DNI and DHI, **NOT** in the plane of array
+						we'll have to fix this redundancy in the pvsamv1 rewrite. it will require allowing irradproc to report the errors below
+						and deciding what to do if the weather file DOES contain the third component but it's not being used in the calculations.*/
+						if (iyear == 0)
 						{
-							Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[2][idx] < -1)
+							// Apply all irradiance component data from weather file (if it exists)
+							Irradiance->p_weatherFilePOA[0][idx] = (ssc_number_t)wf.poa;
+							Irradiance->p_weatherFileDNI[idx] = (ssc_number_t)wf.dn;
+							Irradiance->p_weatherFileGHI[idx] = (ssc_number_t)(wf.gh);
+							Irradiance->p_weatherFileDHI[idx] = (ssc_number_t)(wf.df);
+
+							// calculate beam if global & diffuse are selected as inputs
+							if (radmode == irrad::GH_DF)
 							{
-								log(util::format("SAM calculated negative direct normal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[2][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[2][idx] = 0;
+								Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
+								if (Irradiance->p_IrradianceCalculated[2][idx] < -1)
+								{
+									log(util::format("SAM calculated negative direct normal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+										Irradiance->p_IrradianceCalculated[2][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+									Irradiance->p_IrradianceCalculated[2][idx] = 0;
+								}
 							}
-						}
 
-						// calculate global if beam & diffuse are selected as inputs
-						if (radmode == irrad::DN_DF)
-						{
-							Irradiance->p_IrradianceCalculated[0][idx] = (ssc_number_t)(wf.df + wf.dn * cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[0][idx] < -1)
+							// calculate global if beam & diffuse are selected as inputs
+							if (radmode == irrad::DN_DF)
 							{
-								log(util::format("SAM calculated negative global horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[0][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[0][idx] = 0;
+								Irradiance->p_IrradianceCalculated[0][idx] = (ssc_number_t)(wf.df + wf.dn * cos(solzen*3.1415926 / 180));
+								if (Irradiance->p_IrradianceCalculated[0][idx] < -1)
+								{
+									log(util::format("SAM calculated negative global horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+										Irradiance->p_IrradianceCalculated[0][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+									Irradiance->p_IrradianceCalculated[0][idx] = 0;
+								}
 							}
-						}
 
-						// calculate diffuse if total & beam are selected as inputs
-						if (radmode == irrad::DN_GH)
-						{
-							Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)(wf.gh - wf.dn * cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[1][idx] < -1)
+							// calculate diffuse if total & beam are selected as inputs
+							if (radmode == irrad::DN_GH)
 							{
-								log(util::format("SAM calculated negative diffuse horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[1][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[1][idx] = 0;
+								Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)(wf.gh - wf.dn * cos(solzen*3.1415926 / 180));
+								if (Irradiance->p_IrradianceCalculated[1][idx] < -1)
+								{
+									log(util::format("SAM calculated negative diffuse horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+										Irradiance->p_IrradianceCalculated[1][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+									Irradiance->p_IrradianceCalculated[1][idx] = 0;
+								}
 							}
 						}
-					}
-
-					// record sub-array plane of array output before computing shading and soiling
-					if (iyear == 0)
-					{
-						if (radmode != irrad::POA_R)
-							PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ibeam + iskydiff + ignddiff));
-						else
-							PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ipoa[nn]));
-					}
 
+						// record sub-array plane of array output before computing shading and soiling
+						if (iyear == 0)
+						{
+							if (radmode != irrad::POA_R)
+								PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ibeam + iskydiff + ignddiff));
+							else
+								PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ipoa[nn]));
+						}
 
-					// record sub-array contribution to total POA power for this time step  (W)
-					if (radmode != irrad::POA_R)
-						ts_accum_poa_front_nom += (ibeam + iskydiff + ignddiff) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					else
-						ts_accum_poa_front_nom += (ipoa[nn])* ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-					// record sub-array contribution to total POA beam power for this time step (W)
-					ts_accum_poa_front_beam_nom += ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						// record sub-array contribution to total POA power for this time step  (W)
+						if (radmode != irrad::POA_R)
+							ts_accum_poa_front_nom += (ibeam + iskydiff + ignddiff) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						else
+							ts_accum_poa_front_nom += (ipoa[nn])* ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-					// for non-linear shading from shading database
-					if (Subarrays[nn]->shadeCalculator.use_shade_db())
-					{
-						double shadedb_gpoa = ibeam + iskydiff + ignddiff;
-						double shadedb_dpoa = iskydiff + ignddiff;
+						// record sub-array contribution to total POA beam power for this time step (W)
+						ts_accum_poa_front_beam_nom += ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-						// update cell temperature - unshaded value per Sara 1/25/16
-						double tcell = wf.tdry;
-						if (sunup > 0)
-						{
-							// calculate cell temperature using selected temperature model
-							pvinput_t in(ibeam, iskydiff, ignddiff, 0, ipoa[nn],
-								wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-								solzen, aoi, hdr.elev,
-								stilt, sazi,
-								((double)wf.hour) + wf.minute / 60.0,
-								radmode, Subarrays[nn]->poa.usePOAFromWF);
-							// voltage set to -1 for max power
-							(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, -1.0, tcell);
-						}
-						double shadedb_str_vmp_stc = Subarrays[nn]->nModulesPerString * Subarrays[nn]->Module->voltageMaxPower;
-						double shadedb_mppt_lo = PVSystem->Inverter->mpptLowVoltage;
-						double shadedb_mppt_hi = PVSystem->Inverter->mpptHiVoltage;
-						 
-						// shading database if necessary
-						if (!Subarrays[nn]->shadeCalculator.fbeam_shade_db(shadeDatabase, hour, solalt, solazi, jj, step_per_hour, shadedb_gpoa, shadedb_dpoa, tcell, Subarrays[nn]->nModulesPerString, shadedb_str_vmp_stc, shadedb_mppt_lo, shadedb_mppt_hi))
-						{
-							throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
-						}
-						if (iyear == 0)
+						// for non-linear shading from shading database
+						if (Subarrays[nn]->shadeCalculator.use_shade_db())
 						{
+							double shadedb_gpoa = ibeam + iskydiff + ignddiff;
+							double shadedb_dpoa = iskydiff + ignddiff;
+
+							// update cell temperature - unshaded value per Sara 1/25/16
+							double tcell = wf.tdry;
+							if (sunup > 0)
+							{
+								// calculate cell temperature using selected temperature model
+								pvinput_t in(ibeam, iskydiff, ignddiff, 0, ipoa[nn],
+									wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+									solzen, aoi, hdr.elev,
+									stilt, sazi,
+									((double)wf.hour) + wf.minute / 60.0,
+									radmode, Subarrays[nn]->poa.usePOAFromWF);
+								// voltage set to -1 for max power
+								(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, -1.0, tcell);
+							}
+							double shadedb_str_vmp_stc = Subarrays[nn]->nModulesPerString * Subarrays[nn]->Module->voltageMaxPower;
+							double shadedb_mppt_lo = PVSystem->Inverter->mpptLowVoltage;
+							double shadedb_mppt_hi = PVSystem->Inverter->mpptHiVoltage;
+							 
+							// shading database if necessary
+							if (!Subarrays[nn]->shadeCalculator.fbeam_shade_db(shadeDatabase, hour, solalt, solazi, jj, step_per_hour, shadedb_gpoa, shadedb_dpoa, tcell, Subarrays[nn]->nModulesPerString, shadedb_str_vmp_stc, shadedb_mppt_lo, shadedb_mppt_hi))
+							{
+								throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+							}
+							if (iyear == 0)
+							{
 #ifdef SHADE_DB_OUTPUTS
-							p_shadedb_gpoa[nn][idx] = (ssc_number_t)shadedb_gpoa;
-							p_shadedb_dpoa[nn][idx] = (ssc_number_t)shadedb_dpoa;
-							p_shadedb_pv_cell_temp[nn][idx] = (ssc_number_t)tcell;
-							p_shadedb_mods_per_str[nn][idx] = (ssc_number_t)Subarrays[nn]->nModulesPerString;
-							p_shadedb_str_vmp_stc[nn][idx] = (ssc_number_t)shadedb_str_vmp_stc;
-							p_shadedb_mppt_lo[nn][idx] = (ssc_number_t)shadedb_mppt_lo;
-							p_shadedb_mppt_hi[nn][idx] = (ssc_number_t)shadedb_mppt_hi;
-							log("shade db hour " + util::to_string((int)hour) +"\n" + shadeCalculator->get_warning());
+								p_shadedb_gpoa[nn][idx] = (ssc_number_t)shadedb_gpoa;
+								p_shadedb_dpoa[nn][idx] = (ssc_number_t)shadedb_dpoa;
+								p_shadedb_pv_cell_temp[nn][idx] = (ssc_number_t)tcell;
+								p_shadedb_mods_per_str[nn][idx] = (ssc_number_t)Subarrays[nn]->nModulesPerString;
+								p_shadedb_str_vmp_stc[nn][idx] = (ssc_number_t)shadedb_str_vmp_stc;
+								p_shadedb_mppt_lo[nn][idx] = (ssc_number_t)shadedb_mppt_lo;
+								p_shadedb_mppt_hi[nn][idx] = (ssc_number_t)shadedb_mppt_hi;
+								log("shade db hour " + util::to_string((int)hour) +"\n" + shadeCalculator->get_warning());
 #endif
-							// fraction shaded for comparison
-							PVSystem->p_shadeDBShadeFraction[nn][idx] = (ssc_number_t)(Subarrays[nn]->shadeCalculator.dc_shade_factor());
-						} 
-					}
-					else
-					{
-						if (!Subarrays[nn]->shadeCalculator.fbeam(hour, solalt, solazi, jj, step_per_hour))
+								// fraction shaded for comparison
+								PVSystem->p_shadeDBShadeFraction[nn][idx] = (ssc_number_t)(Subarrays[nn]->shadeCalculator.dc_shade_factor());
+							} 
+						}
+						else
 						{
-							throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+							if (!Subarrays[nn]->shadeCalculator.fbeam(hour, solalt, solazi, jj, step_per_hour))
+							{
+								throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+							}
 						}
-					}
 
-					// apply hourly shading factors to beam (if none enabled, factors are 1.0)
-					// shj 3/21/16 - update to handle negative shading loss
-					if (Subarrays[nn]->shadeCalculator.beam_shade_factor() != 1.0){
-						//							if (sa[nn].shad.beam_shade_factor() < 1.0){
-						// Sara 1/25/16 - shading database derate applied to dc only
-						// shading loss applied to beam if not from shading database
-						ibeam *= Subarrays[nn]->shadeCalculator.beam_shade_factor();
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							Subarrays[nn]->poa.usePOAFromWF = false;
-							if (Subarrays[nn]->poa.poaShadWarningCount == 0){
-								log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
-									wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-							}
-							else{
-								log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
-									wf.year, wf.month, wf.day, wf.hour), SSC_NOTICE, (float)idx);
+						// apply hourly shading factors to beam (if none enabled, factors are 1.0)
+						// shj 3/21/16 - update to handle negative shading loss
+						if (Subarrays[nn]->shadeCalculator.beam_shade_factor() != 1.0){
+							//							if (sa[nn].shad.beam_shade_factor() < 1.0){
+							// Sara 1/25/16 - shading database derate applied to dc only
+							// shading loss applied to beam if not from shading database
+							ibeam *= Subarrays[nn]->shadeCalculator.beam_shade_factor();
+							if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+								Subarrays[nn]->poa.usePOAFromWF = false;
+								if (Subarrays[nn]->poa.poaShadWarningCount == 0){
+									log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
+										wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+								}
+								else{
+									log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
+										wf.year, wf.month, wf.day, wf.hour), SSC_NOTICE, (float)idx);
+								}
+								Subarrays[nn]->poa.poaShadWarningCount++;
 							}
-							Subarrays[nn]->poa.poaShadWarningCount++;
 						}
-					}
 
-					// apply sky diffuse shading factor (specified as constant, nominally 1.0 if disabled in UI)
-					if (Subarrays[nn]->shadeCalculator.fdiff() < 1.0){
-						iskydiff *= Subarrays[nn]->shadeCalculator.fdiff();
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							if (idx == 0)
-								log("Combining POA irradiance as input with the diffuse shading losses forces SAM to use a POA decomposition model to calculate incident diffuse irradiance", SSC_WARNING);
-							Subarrays[nn]->poa.usePOAFromWF = false;
+						// apply sky diffuse shading factor (specified as constant, nominally 1.0 if disabled in UI)
+						if (Subarrays[nn]->shadeCalculator.fdiff() < 1.0){
+							iskydiff *= Subarrays[nn]->shadeCalculator.fdiff();
+							if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+								if (idx == 0)
+									log("Combining POA irradiance as input with the diffuse shading losses forces SAM to use a POA decomposition model to calculate incident diffuse irradiance", SSC_WARNING);
+								Subarrays[nn]->poa.usePOAFromWF = false;
+							}
 						}
-					}
-
-					double beam_shading_factor = Subarrays[nn]->shadeCalculator.beam_shade_factor();
 
-					//self-shading calculations
-					if (((Subarrays[nn]->trackMode == 0 || Subarrays[nn]->trackMode == 4) && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2)) //fixed tilt or timeseries tilt, self-shading (linear or non-linear) OR
-						|| (Subarrays[nn]->trackMode == 1 && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2) && Subarrays[nn]->backtrackingEnabled == 0)) //one-axis tracking, self-shading, not backtracking
-					{
+						double beam_shading_factor = Subarrays[nn]->shadeCalculator.beam_shade_factor();
 
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							if (idx == 0)
-								log("Combining POA irradiance as input with self shading forces SAM to employ a POA decomposition model to calculate incident beam irradiance", SSC_WARNING);
-							Subarrays[nn]->poa.usePOAFromWF = false;
-						}
+						//self-shading calculations
+						if (((Subarrays[nn]->trackMode == 0 || Subarrays[nn]->trackMode == 4) && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2)) //fixed tilt or timeseries tilt, self-shading (linear or non-linear) OR
+							|| (Subarrays[nn]->trackMode == 1 && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2) && Subarrays[nn]->backtrackingEnabled == 0)) //one-axis tracking, self-shading, not backtracking
+						{
 
-						// info to be passed to self-shading function
-						bool trackbool = (Subarrays[nn]->trackMode == 1);	// 0 for fixed tilt and timeseries tilt, 1 for one-axis
-						bool linear = (Subarrays[nn]->shadeMode == 2); //0 for full self-shading, 1 for linear self-shading
+							if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+								if (idx == 0)
+									log("Combining POA irradiance as input with self shading forces SAM to employ a POA decomposition model to calculate incident beam irradiance", SSC_WARNING);
+								Subarrays[nn]->poa.usePOAFromWF = false;
+							}
 
-						//geometric fraction of the array that is shaded for one-axis trackers.
-						//USES A DIFFERENT FUNCTION THAN THE SELF-SHADING BECAUSE SS IS MEANT FOR FIXED ONLY. shadeFraction1x IS FOR ONE-AXIS TRACKERS ONLY.
-						//used in the non-linear self-shading calculator for one-axis tracking only
-						double shad1xf = 0;
-						if (trackbool)
-							shad1xf = shadeFraction1x(solazi, solzen, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->groundCoverageRatio, rot);
+							// info to be passed to self-shading function
+							bool trackbool = (Subarrays[nn]->trackMode == 1);	// 0 for fixed tilt and timeseries tilt, 1 for one-axis
+							bool linear = (Subarrays[nn]->shadeMode == 2); //0 for full self-shading, 1 for linear self-shading
 
-						//execute self-shading calculations
-						ssc_number_t beam_to_use; //some self-shading calculations require DNI, NOT ibeam (beam in POA). Need to know whether to use DNI from wf or calculated, depending on radmode
-						if (radmode == irrad::DN_DF || radmode == irrad::DN_GH) beam_to_use = (ssc_number_t)wf.dn;
-						else beam_to_use = Irradiance->p_IrradianceCalculated[2][hour * step_per_hour]; // top of hour in first year
+							//geometric fraction of the array that is shaded for one-axis trackers.
+							//USES A DIFFERENT FUNCTION THAN THE SELF-SHADING BECAUSE SS IS MEANT FOR FIXED ONLY. shadeFraction1x IS FOR ONE-AXIS TRACKERS ONLY.
+							//used in the non-linear self-shading calculator for one-axis tracking only
+							double shad1xf = 0;
+							if (trackbool)
+								shad1xf = shadeFraction1x(solazi, solzen, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->groundCoverageRatio, rot);
 
-						if (linear && trackbool) //one-axis linear
-						{
-							ibeam *= (1 - shad1xf); //derate beam irradiance linearly by the geometric shading fraction calculated above per Chris Deline 2/10/16
-							beam_shading_factor *= (1 - shad1xf);
-							if (iyear == 0)
-							{
-								PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
-								PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - shad1xf);
-								PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
-								PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
-							}
-						}
+							//execute self-shading calculations
+							ssc_number_t beam_to_use; //some self-shading calculations require DNI, NOT ibeam (beam in POA). Need to know whether to use DNI from wf or calculated, depending on radmode
+							if (radmode == irrad::DN_DF || radmode == irrad::DN_GH) beam_to_use = (ssc_number_t)wf.dn;
+							else beam_to_use = Irradiance->p_IrradianceCalculated[2][hour * step_per_hour]; // top of hour in first year
 
-						else if (ss_exec(Subarrays[nn]->selfShadingInputs, stilt, sazi, solzen, solazi, beam_to_use, ibeam, (iskydiff + ignddiff), alb, trackbool, linear, shad1xf, Subarrays[nn]->selfShadingOutputs))
-						{
-							if (linear) //fixed tilt linear
+							if (linear && trackbool) //one-axis linear
 							{
-								ibeam *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-								beam_shading_factor *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+								ibeam *= (1 - shad1xf); //derate beam irradiance linearly by the geometric shading fraction calculated above per Chris Deline 2/10/16
+								beam_shading_factor *= (1 - shad1xf);
 								if (iyear == 0)
 								{
 									PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
-									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - shad1xf);
 									PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
 									PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
 								}
 							}
-							else //non-linear: fixed tilt AND one-axis
+
+							else if (ss_exec(Subarrays[nn]->selfShadingInputs, stilt, sazi, solzen, solazi, beam_to_use, ibeam, (iskydiff + ignddiff), alb, trackbool, linear, shad1xf, Subarrays[nn]->selfShadingOutputs))
 							{
-								if (iyear == 0)
+								if (linear) //fixed tilt linear
 								{
-									PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
-									PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
-									PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_dc_derate;
-									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)1;
+									ibeam *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+									beam_shading_factor *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+									if (iyear == 0)
+									{
+										PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
+										PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+										PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
+										PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
+									}
+								}
+								else //non-linear: fixed tilt AND one-axis
+								{
+									if (iyear == 0)
+									{
+										PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
+										PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
+										PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_dc_derate;
+										PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)1;
+									}
+
+									// Sky diffuse and ground-reflected diffuse are derated according to C. Deline's algorithm
+									iskydiff *= Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
+									ignddiff *= Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
+									// Beam is not derated- all beam derate effects (linear and non-linear) are taken into account in the nonlinear_dc_shading_derate
+									Subarrays[nn]->poa.nonlinearDCShadingDerate = Subarrays[nn]->selfShadingOutputs.m_dc_derate;
 								}
-
-								// Sky diffuse and ground-reflected diffuse are derated according to C. Deline's algorithm
-								iskydiff *= Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
-								ignddiff *= Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
-								// Beam is not derated- all beam derate effects (linear and non-linear) are taken into account in the nonlinear_dc_shading_derate
-								Subarrays[nn]->poa.nonlinearDCShadingDerate = Subarrays[nn]->selfShadingOutputs.m_dc_derate;
 							}
+							else
+								throw exec_error("pvsamv1", util::format("Self-shading calculation failed at %d", (int)idx));
 						}
-						else
-							throw exec_error("pvsamv1", util::format("Self-shading calculation failed at %d", (int)idx));
-					}
 
-					double poashad = (radmode == irrad::POA_R) ? ipoa[nn] : (ibeam + iskydiff + ignddiff);
+						double poashad = (radmode == irrad::POA_R) ? ipoa[nn] : (ibeam + iskydiff + ignddiff);
 
-					// determine sub-array contribution to total shaded plane of array for this hour
-					ts_accum_poa_front_shaded += poashad * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						// determine sub-array contribution to total shaded plane of array for this hour
+						ts_accum_poa_front_shaded += poashad * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-					// apply soiling derate to all components of irradiance
-					double soiling_factor = 1.0;
-					int month_idx = wf.month - 1;
-					if (month_idx >= 0 && month_idx < 12)
-					{
-						soiling_factor = Subarrays[nn]->monthlySoiling[month_idx];
-						ibeam *= soiling_factor;
-						iskydiff *= soiling_factor;
-						ignddiff *= soiling_factor;
-						if (radmode == irrad::POA_R || radmode == irrad::POA_P){
-							ipoa[nn] *= soiling_factor;
-							if (soiling_factor < 1 && idx == 0)
-								log("Soiling may already be accounted for in the input POA data. Please confirm that the input data does not contain soiling effects, or remove the additional losses on the Losses page.", SSC_WARNING);
+						// apply soiling derate to all components of irradiance
+						double soiling_factor = 1.0;
+						int month_idx = wf.month - 1;
+						if (month_idx >= 0 && month_idx < 12)
+						{
+							soiling_factor = Subarrays[nn]->monthlySoiling[month_idx];
+							ibeam *= soiling_factor;
+							iskydiff *= soiling_factor;
+							ignddiff *= soiling_factor;
+							if (radmode == irrad::POA_R || radmode == irrad::POA_P){
+								ipoa[nn] *= soiling_factor;
+								if (soiling_factor < 1 && idx == 0)
+									log("Soiling may already be accounted for in the input POA data. Please confirm that the input data does not contain soiling effects, or remove the additional losses on the Losses page.", SSC_WARNING);
+							}
+							beam_shading_factor *= soiling_factor;
 						}
-						beam_shading_factor *= soiling_factor;
-					}
 
-					// Calculate total front irradiation after soiling added to shading
-					ipoa_front[nn] = ibeam + iskydiff + ignddiff;
-					ts_accum_poa_front_shaded_soiled += ipoa_front[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					
-					// Calculate rear-side irradiance for bifacial modules
-					if (Subarrays[0]->Module->isBifacial)
-					{
-						double slopeLength = Subarrays[nn]->selfShadingInputs.length * Subarrays[nn]->selfShadingInputs.nmody;
-						if (Subarrays[nn]->selfShadingInputs.mod_orient == 1) {
-							slopeLength = Subarrays[nn]->selfShadingInputs.width * Subarrays[nn]->selfShadingInputs.nmody;
+						// Calculate total front irradiation after soiling added to shading
+						ipoa_front[nn] = ibeam + iskydiff + ignddiff;
+						ts_accum_poa_front_shaded_soiled += ipoa_front[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						
+						// Calculate rear-side irradiance for bifacial modules
+						if (Subarrays[0]->Module->isBifacial)
+						{
+							double slopeLength = Subarrays[nn]->selfShadingInputs.length * Subarrays[nn]->selfShadingInputs.nmody;
+							if (Subarrays[nn]->selfShadingInputs.mod_orient == 1) {
+								slopeLength = Subarrays[nn]->selfShadingInputs.width * Subarrays[nn]->selfShadingInputs.nmody;
+							}
+							irr.calc_rear_side(Subarrays[0]->Module->bifacialTransmissionFactor, Subarrays[0]->Module->bifaciality, Subarrays[0]->Module->groundClearanceHeight, slopeLength, &bifacialWorkspaces[nn]);
+							ipoa_rear[nn] = irr.get_poa_rear();
+							ipoa_rear_after_losses[nn] = ipoa_rear[nn] * (1 - Subarrays[nn]->rearIrradianceLossPercent);
 						}
-						irr.calc_rear_side(Subarrays[0]->Module->bifacialTransmissionFactor, Subarrays[0]->Module->bifaciality, Subarrays[0]->Module->groundClearanceHeight, slopeLength);
-						ipoa_rear[nn] = irr.get_poa_rear();
-						ipoa_rear_after_losses[nn] = ipoa_rear[nn] * (1 - Subarrays[nn]->rearIrradianceLossPercent);
-					}
 
-					ts_accum_poa_rear += ipoa_rear[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					ts_accum_poa_rear_after_losses = ts_accum_poa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+						ts_accum_poa_rear += ipoa_rear[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						ts_accum_poa_rear_after_losses = ts_accum_poa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
 
-					if (iyear == 0) 
-					{
-						// save sub-array level outputs			
-						PVSystem->p_poaShadedFront[nn][idx] = (ssc_number_t)poashad;
-						PVSystem->p_poaShadedSoiledFront[nn][idx] = (ssc_number_t)ipoa_front[nn];
-						PVSystem->p_poaBeamFront[nn][idx] = (ssc_number_t)ibeam;
-						PVSystem->p_poaDiffuseFront[nn][idx] = (ssc_number_t)(iskydiff + ignddiff);
-						PVSystem->p_poaRear[nn][idx] = (ssc_number_t)(ipoa_rear_after_losses[nn]);
-						PVSystem->p_beamShadingFactor[nn][idx] = (ssc_number_t)beam_shading_factor;
-						PVSystem->p_axisRotation[nn][idx] = (ssc_number_t)rot;
-						PVSystem->p_idealRotation[nn][idx] = (ssc_number_t)(rot - btd);
-						PVSystem->p_angleOfIncidence[nn][idx] = (ssc_number_t)aoi;
-						PVSystem->p_surfaceTilt[nn][idx] = (ssc_number_t)stilt;
-						PVSystem->p_surfaceAzimuth[nn][idx] = (ssc_number_t)sazi;
-						PVSystem->p_derateSoiling[nn][idx] = (ssc_number_t)soiling_factor;
-					}
+						if (iyear == 0) 
+						{
+							// save sub-array level outputs			
+							if (PVSystem->p_poaShadedFront[nn]) PVSystem->p_poaShadedFront[nn][idx] = (ssc_number_t)poashad;
+							if (PVSystem->p_poaShadedSoiledFront[nn]) PVSystem->p_poaShadedSoiledFront[nn][idx] = (ssc_number_t)ipoa_front[nn];
+							if (PVSystem->p_poaBeamFront[nn]) PVSystem->p_poaBeamFront[nn][idx] = (ssc_number_t)ibeam;
+							if (PVSystem->p_poaDiffuseFront[nn]) PVSystem->p_poaDiffuseFront[nn][idx] = (ssc_number_t)(iskydiff + ignddiff);
+							PVSystem->p_poaRear[nn][idx] = (ssc_number_t)(ipoa_rear_after_losses[nn]);
+							if (PVSystem->p_beamShadingFactor[nn]) PVSystem->p_beamShadingFactor[nn][idx] = (ssc_number_t)beam_shading_factor;
+							if (PVSystem->p_axisRotation[nn]) PVSystem->p_axisRotation[nn][idx] = (ssc_number_t)rot;
+							if (PVSystem->p_idealRotation[nn]) PVSystem->p_idealRotation[nn][idx] = (ssc_number_t)(rot - btd);
+							if (PVSystem->p_angleOfIncidence[nn]) PVSystem->p_angleOfIncidence[nn][idx] = (ssc_number_t)aoi;
+							if (PVSystem->p_surfaceTilt[nn]) PVSystem->p_surfaceTilt[nn][idx] = (ssc_number_t)stilt;
+							if (PVSystem->p_surfaceAzimuth[nn]) PVSystem->p_surfaceAzimuth[nn][idx] = (ssc_number_t)sazi;
+							if (PVSystem->p_derateSoiling[nn]) PVSystem->p_derateSoiling[nn][idx] = (ssc_number_t)soiling_factor;
+						}
 
-					// accumulate incident total radiation (W) in this timestep (all subarrays)
-					ts_accum_poa_front_beam_eff += ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-
-					// save the required irradiance inputs on array plane for the module output calculations.
-					Subarrays[nn]->poa.poaBeamFront = ibeam;
-					Subarrays[nn]->poa.poaDiffuseFront = iskydiff;
-					Subarrays[nn]->poa.poaGroundFront = ignddiff;
-					Subarrays[nn]->poa.poaRear = ipoa_rear_after_losses[nn];
-					Subarrays[nn]->poa.poaTotal = (radmode == irrad::POA_R) ? ipoa[nn] :(ipoa_front[nn] + ipoa_rear_after_losses[nn]);
-					Subarrays[nn]->poa.angleOfIncidenceDegrees = aoi;
-					Subarrays[nn]->poa.sunUp = sunup;
-					Subarrays[nn]->poa.surfaceTiltDegrees = stilt;
-					Subarrays[nn]->poa.surfaceAzimuthDegrees = sazi;
-				}
+						// accumulate incident total radiation (W) in this timestep (all subarrays)
+						ts_accum_poa_front_beam_eff += ibeam * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+
+						// save the required irradiance inputs on array plane for the module output calculations.
+						Subarrays[nn]->poa.poaBeamFront = ibeam;
+						Subarrays[nn]->poa.poaDiffuseFront = iskydiff;
+						Subarrays[nn]->poa.poaGroundFront = ignddiff;
+						Subarrays[nn]->poa.poaRear = ipoa_rear_after_losses[nn];
+						Subarrays[nn]->poa.poaTotal = (radmode == irrad::POA_R) ? ipoa[nn] :(ipoa_front[nn] + ipoa_rear_after_losses[nn]);
+						Subarrays[nn]->poa.angleOfIncidenceDegrees = aoi;
+						Subarrays[nn]->poa.sunUp = sunup;
+						Subarrays[nn]->poa.surfaceTiltDegrees = stilt;
+						Subarrays[nn]->poa.surfaceAzimuthDegrees = sazi;
+					}
 
-				std::vector<double> mpptVoltageClipping; //a vector to store power that is clipped due to the inverter MPPT low & high voltage limits for each subarray
-				for (size_t nn = 0; nn < PVSystem->numberOfSubarrays; nn++) {
-					mpptVoltageClipping.push_back(0.0);
-				}
+					std::vector<double> mpptVoltageClipping; //a vector to store power that is clipped due to the inverter MPPT low & high voltage limits for each subarray
+					for (size_t nn = 0; nn < PVSystem->numberOfSubarrays; nn++) {
+						mpptVoltageClipping.push_back(0.0);
+					}
 
-				//Calculate power of each MPPT input
-				for (size_t mpptInput = 0; mpptInput < PVSystem->Inverter->nMpptInputs; mpptInput++) //remember that actual named mppt inputs are 1-indexed, and these are 0-indexed
-				{
-					int nSubarraysOnMpptInput = (int)(PVSystem->mpptMapping[mpptInput].size()); //number of subarrays attached to this MPPT input
-					std::vector<int> SubarraysOnMpptInput = PVSystem->mpptMapping[mpptInput]; //vector of which subarrays are attached to this MPPT input
-
-					//string voltage for this MPPT input- if 1 subarray, this will be the string voltage. if >1 subarray and mismatch enabled, this
-					//will be the string voltage found by the mismatch calculation. if >1 subarray and mismatch not enabled, this will be the average
-					//voltage of the strings from all the subarrays on this mppt input.
-					//initialize it as -1 and check for that later
-					double stringVoltage = -1;
-
-					//mismatch calculations assume that the inverter MPPT operates all strings on that MPPT input at the same voltage.
-					//this algorithm sweeps across a range of string voltages, calculating total power for all strings on this MPPT input at each voltage.
-					//it finds the maximum total power of all string voltages swept, then uses that in subsequent power calculations for each subarray. 
-					if (PVSystem->enableMismatchVoltageCalc)
+					//Calculate power of each MPPT input
+					for (size_t mpptInput = 0; mpptInput < PVSystem->Inverter->nMpptInputs; mpptInput++) //remember that actual named mppt inputs are 1-indexed, and these are 0-indexed
 					{
-						double vmax = PVSystem->Inverter->mpptHiVoltage; //the upper MPPT range of the inverter is the high end for string voltages that it will control
-						double vmin = PVSystem->Inverter->mpptLowVoltage; //the lower MPPT range of the inverter is the low end for string voltages that it will control
-						const int NP = 100; //number of points in between max and min voltage to sweep
-						double Pmax = 0; //variable to store the maximum power for comparison between different points along the voltage sweep
-						// sweep voltage, calculating current for each subarray, add all subarray currents together at each voltage
-						for (int i = 0; i < NP; i++)
+						int nSubarraysOnMpptInput = (int)(PVSystem->mpptMapping[mpptInput].size()); //number of subarrays attached to this MPPT input
+						std::vector<int> SubarraysOnMpptInput = PVSystem->mpptMapping[mpptInput]; //vector of which subarrays are attached to this MPPT input
+
+						//string voltage for this MPPT input- if 1 subarray, this will be the string voltage. if >1 subarray and mismatch enabled, this
+						//will be the string voltage found by the mismatch calculation. if >1 subarray and mismatch not enabled, this will be the average
+						//voltage of the strings from all the subarrays on this mppt input.
+						//initialize it as -1 and check for that later
+						double stringVoltage = -1;
+
+						//mismatch calculations assume that the inverter MPPT operates all strings on that MPPT input at the same voltage.
+						//this algorithm sweeps across a range of string voltages, calculating total power for all strings on this MPPT input at each voltage.
+						//it finds the maximum total power of all string voltages swept, then uses that in subsequent power calculations for each subarray. 
+						if (PVSystem->enableMismatchVoltageCalc)
 						{
-							double stringV = vmin + (vmax - vmin)*i / ((double)NP); //voltage of a string at this point in the voltage sweep							
-
-							//if the voltage is ok, continue to calculate total power on this MPPT input at this voltage
-							double P = 0; //temporary variable to store the total power on this MPPT input at this voltage
-							for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
+							double vmax = PVSystem->Inverter->mpptHiVoltage; //the upper MPPT range of the inverter is the high end for string voltages that it will control
+							double vmin = PVSystem->Inverter->mpptLowVoltage; //the lower MPPT range of the inverter is the low end for string voltages that it will control
+							const int NP = 100; //number of points in between max and min voltage to sweep
+							double Pmax = 0; //variable to store the maximum power for comparison between different points along the voltage sweep
+							// sweep voltage, calculating current for each subarray, add all subarray currents together at each voltage
+							for (int i = 0; i < NP; i++)
 							{
-								int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
-								double V = stringV / (double)Subarrays[nn]->nModulesPerString; //voltage of an individual module on a string on this subarray
+								double stringV = vmin + (vmax - vmin)*i / ((double)NP); //voltage of a string at this point in the voltage sweep							
 
-								//initalize pvinput and pvoutput structures for the model
-								pvinput_t in(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
-									wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-									solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
-									Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
-									((double)wf.hour) + wf.minute / 60.0,
-									radmode, Subarrays[nn]->poa.usePOAFromWF);
-								pvoutput_t out(0, 0, 0, 0, 0, 0, 0, 0);
-
-								//calculate the output power for one module in this subarray at this voltage
-								if (Subarrays[nn]->poa.sunUp)
+								//if the voltage is ok, continue to calculate total power on this MPPT input at this voltage
+								double P = 0; //temporary variable to store the total power on this MPPT input at this voltage
+								for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
 								{
-									double tcell = wf.tdry;
-									// calculate cell temperature using selected temperature model
-									(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, V, tcell);
-									// calculate module power output using conversion model previously specified
-									(*Subarrays[nn]->Module->moduleModel)(in, tcell, V, out);
+									int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+									double V = stringV / (double)Subarrays[nn]->nModulesPerString; //voltage of an individual module on a string on this subarray
+
+									//initalize pvinput and pvoutput structures for the model
+									pvinput_t in(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
+										wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+										solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
+										Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
+										((double)wf.hour) + wf.minute / 60.0,
+										radmode, Subarrays[nn]->poa.usePOAFromWF);
+									pvoutput_t out(0, 0, 0, 0, 0, 0, 0, 0);
+
+									//calculate the output power for one module in this subarray at this voltage
+									if (Subarrays[nn]->poa.sunUp)
+									{
+										double tcell = wf.tdry;
+										// calculate cell temperature using selected temperature model
+										(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, V, tcell);
+										// calculate module power output using conversion model previously specified
+										(*Subarrays[nn]->Module->moduleModel)(in, tcell, V, out);
+									}
+									//add the power from this subarray to the total power
+									P += V * out.Current * (double)Subarrays[nn]->nModulesPerString * (double)Subarrays[nn]->nStrings;
 								}
-								//add the power from this subarray to the total power
-								P += V * out.Current * (double)Subarrays[nn]->nModulesPerString * (double)Subarrays[nn]->nStrings;
-							}
 
-							//check if the total power at this voltage is higher than the power values we've calculated before, if so, set it as the new max
-							if (P > Pmax)
-							{
-								Pmax = P;
-								stringVoltage = stringV;
+								//check if the total power at this voltage is higher than the power values we've calculated before, if so, set it as the new max
+								if (P > Pmax)
+								{
+									Pmax = P;
+									stringVoltage = stringV;
+								}
 							}
-						}
 
-					} //now we have the string voltage at which the MPPT input will produce max power, to be used in subsequent calcs
+						} //now we have the string voltage at which the MPPT input will produce max power, to be used in subsequent calcs
 
-					//now calculate power for each subarray on this mppt input. stringVoltage will still be -1 if mismatch calcs aren't enabled, or the value decided by mismatch calcs if they are enabled
-					std::vector<pvinput_t> in{ num_subarrays }; //create arrays for the pv input and output structures because we have to deal with them in multiple loops to check for MPPT clipping
-					std::vector<pvoutput_t> out{ num_subarrays };
-					double tcell = wf.tdry;
-					for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
-					{
-						int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
-						//initalize pvinput and pvoutput structures for the model
-						pvinput_t in_temp(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
-							wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-							solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
-							Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
-							((double)wf.hour) + wf.minute / 60.0,
-							radmode, Subarrays[nn]->poa.usePOAFromWF);
-						pvoutput_t out_temp(0, 0, 0, 0, 0, 0, 0, 0);
-						in[nn] = in_temp;
-						out[nn] = out_temp;					
-						
-						if (Subarrays[nn]->poa.sunUp)
+						//now calculate power for each subarray on this mppt input. stringVoltage will still be -1 if mismatch calcs aren't enabled, or the value decided by mismatch calcs if they are enabled
+						std::vector<pvinput_t> in{ num_subarrays }; //create arrays for the pv input and output structures because we have to deal with them in multiple loops to check for MPPT clipping
+						std::vector<pvoutput_t> out{ num_subarrays };
+						double tcell = wf.tdry;
+						for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
 						{
-							//module voltage value to be passed into module power function. 
-							//if -1 is passed in, power will be calculated at max power point. 
-							//if a voltage value is passed in, power will be calculated at the specified voltage for all single-diode module models
-							double module_voltage = -1;
-							if (stringVoltage != -1) module_voltage = stringVoltage / (double)Subarrays[nn]->nModulesPerString;
-							// calculate cell temperature using selected temperature model
-							// calculate module power output using conversion model previously specified
-							(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
-							(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
+							int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+							//initalize pvinput and pvoutput structures for the model
+							pvinput_t in_temp(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
+								wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+								solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
+								Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
+								((double)wf.hour) + wf.minute / 60.0,
+								radmode, Subarrays[nn]->poa.usePOAFromWF);
+							pvoutput_t out_temp(0, 0, 0, 0, 0, 0, 0, 0);
+							in[nn] = in_temp;
+							out[nn] = out_temp;					
+							
+							if (Subarrays[nn]->poa.sunUp)
+							{
+								//module voltage value to be passed into module power function. 
+								//if -1 is passed in, power will be calculated at max power point. 
+								//if a voltage value is passed in, power will be calculated at the specified voltage for all single-diode module models
+								double module_voltage = -1;
+								if (stringVoltage != -1) module_voltage = stringVoltage / (double)Subarrays[nn]->nModulesPerString;
+								// calculate cell temperature using selected temperature model
+								// calculate module power output using conversion model previously specified
+								(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
+								(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
+							}
 						}
-					}
 
-					//assign input voltage at this MPPT input
-					//if mismatch was enabled, the voltage already was clipped to the inverter MPPT range as needed and  
-					//the string voltage is the same for all subarrays, so the voltage at the MPPT input is the same as the string voltage of any subarray
-					if (PVSystem->enableMismatchVoltageCalc) {
-						PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)out[SubarraysOnMpptInput[0]].Voltage * Subarrays[SubarraysOnMpptInput[0]]->nModulesPerString;
-					}
-					//if mismatch wasn't enabled, we assume the MPPT input voltage is a weighted average of the string voltages on this MPPT input,
-					//and still need to check that average against the inverter MPPT bounds
-					else
-					{
-						//create temporary values to calculate the weighted average string voltage
-						double nStrings = 0;
-						double avgVoltage = 0;
-						for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++)
-						{
-							int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray itself
-							nStrings += Subarrays[nn]->nStrings;
-							avgVoltage += out[nn].Voltage * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						//assign input voltage at this MPPT input
+						//if mismatch was enabled, the voltage already was clipped to the inverter MPPT range as needed and  
+						//the string voltage is the same for all subarrays, so the voltage at the MPPT input is the same as the string voltage of any subarray
+						if (PVSystem->enableMismatchVoltageCalc) {
+							PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)out[SubarraysOnMpptInput[0]].Voltage * Subarrays[SubarraysOnMpptInput[0]]->nModulesPerString;
 						}
-						avgVoltage /= nStrings;
-						PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)avgVoltage;
-
-						//check the weighted average string voltage against the inverter MPPT bounds
-						bool recalculatePower = false;
-						if (PVSystem->clipMpptWindow)
+						//if mismatch wasn't enabled, we assume the MPPT input voltage is a weighted average of the string voltages on this MPPT input,
+						//and still need to check that average against the inverter MPPT bounds
+						else
 						{
-							if (avgVoltage < PVSystem->Inverter->mpptLowVoltage)
-							{
-								avgVoltage = PVSystem->Inverter->mpptLowVoltage;
-								recalculatePower = true;
-							}
-							else if (avgVoltage > PVSystem->Inverter->mpptHiVoltage)
+							//create temporary values to calculate the weighted average string voltage
+							double nStrings = 0;
+							double avgVoltage = 0;
+							for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++)
 							{
-								avgVoltage = PVSystem->Inverter->mpptHiVoltage;
-								recalculatePower = true;
+								int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray itself
+								nStrings += Subarrays[nn]->nStrings;
+								avgVoltage += out[nn].Voltage * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 							}
-							
-							//if MPPT clipping occurs, we need to recalculate the module power for each subarray
-							if (recalculatePower)
+							avgVoltage /= nStrings;
+							PVSystem->p_mpptVoltage[mpptInput][idx] = (ssc_number_t)avgVoltage;
+
+							//check the weighted average string voltage against the inverter MPPT bounds
+							bool recalculatePower = false;
+							if (PVSystem->clipMpptWindow)
 							{
-								for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
+								if (avgVoltage < PVSystem->Inverter->mpptLowVoltage)
 								{
-									int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
+									avgVoltage = PVSystem->Inverter->mpptLowVoltage;
+									recalculatePower = true;
+								}
+								else if (avgVoltage > PVSystem->Inverter->mpptHiVoltage)
+								{
+									avgVoltage = PVSystem->Inverter->mpptHiVoltage;
+									recalculatePower = true;
+								}
+								
+								//if MPPT clipping occurs, we need to recalculate the module power for each subarray
+								if (recalculatePower)
+								{
+									for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
+									{
+										int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
 
-									if (iyear == 0) mpptVoltageClipping[nn] = out[nn].Power; //initialize the voltage clipping loss with the power at module MPP, subtract from this later for the actual MPPT clipping loss
+										if (iyear == 0) mpptVoltageClipping[nn] = out[nn].Power; //initialize the voltage clipping loss with the power at module MPP, subtract from this later for the actual MPPT clipping loss
 
-									//recalculate power at the correct voltage
-									double module_voltage = avgVoltage / (double)Subarrays[nn]->nModulesPerString;
-									(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
-									(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
+										//recalculate power at the correct voltage
+										double module_voltage = avgVoltage / (double)Subarrays[nn]->nModulesPerString;
+										(*Subarrays[nn]->Module->cellTempModel)(in[nn], *Subarrays[nn]->Module->moduleModel, module_voltage, tcell);
+										(*Subarrays[nn]->Module->moduleModel)(in[nn], tcell, module_voltage, out[nn]);
 
-									if (iyear == 0)	mpptVoltageClipping[nn] -= out[nn].Power; //subtract the power that remains after voltage clipping in order to get the total loss. if no power was lost, all the power will be subtracted away again.
+										if (iyear == 0)	mpptVoltageClipping[nn] -= out[nn].Power; //subtract the power that remains after voltage clipping in order to get the total loss. if no power was lost, all the power will be subtracted away again.
+									}
 								}
 							}
 						}
-					}
-
-					//now that we have the correct power for all subarrays, subject to inverter MPPT clipping, save outputs 
-					for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
-					{
-						int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
 
-						//check for weird results
-						if (out[nn].Voltage > Subarrays[nn]->Module->moduleModel->VocRef()*1.3)
-							log(util::format("Module voltage is unrealistically high (exceeds 1.3*VocRef) at [mdhm: %d %d %d %lg]: %lg V\n", wf.month, wf.day, wf.hour, wf.minute, out[nn].Voltage), SSC_NOTICE);
-						if (!std::isfinite(out[nn].Power))
+						//now that we have the correct power for all subarrays, subject to inverter MPPT clipping, save outputs 
+						for (int nSubarray = 0; nSubarray < nSubarraysOnMpptInput; nSubarray++) //sweep across all subarrays connected to this MPPT input
 						{
-							out[nn].Power = 0;
-							out[nn].Voltage = 0;
-							out[nn].Current = 0;
-							out[nn].Efficiency = 0;
-							out[nn].CellTemp = tcell;
-							log(util::format("Non-finite power output calculated at [mdhm: %d %d %d %lg], set to zero.\n"
-								"could be due to anomolous equation behavior at very low irradiances (poa: %lg W/m2)",
-								wf.month, wf.day, wf.hour, wf.minute, Subarrays[nn]->poa.poaTotal), SSC_NOTICE);
-						}
+							int nn = SubarraysOnMpptInput[nSubarray]; //get the index of the subarray we're checking here
 
-						// save DC module outputs for this subarray
-						Subarrays[nn]->Module->dcPowerW = out[nn].Power;
-						Subarrays[nn]->Module->dcEfficiency = out[nn].Efficiency * 100;
-						Subarrays[nn]->Module->dcVoltage = out[nn].Voltage;
-						Subarrays[nn]->Module->temperatureCellCelcius = out[nn].CellTemp;
-						Subarrays[nn]->Module->currentShortCircuit = out[nn].Isc_oper;
-						Subarrays[nn]->Module->voltageOpenCircuit = out[nn].Voc_oper;
-						Subarrays[nn]->Module->angleOfIncidenceModifier = out[nn].AOIModifier;
-						
-						// Lifetime dcStringVoltage
-						dcStringVoltage[nn].push_back(Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString);
+							//check for weird results
+							if (out[nn].Voltage > Subarrays[nn]->Module->moduleModel->VocRef()*1.3)
+								log(util::format("Module voltage is unrealistically high (exceeds 1.3*VocRef) at [mdhm: %d %d %d %lg]: %lg V\n", wf.month, wf.day, wf.hour, wf.minute, out[nn].Voltage), SSC_NOTICE);
+							if (!std::isfinite(out[nn].Power))
+							{
+								out[nn].Power = 0;
+								out[nn].Voltage = 0;
+								out[nn].Current = 0;
+								out[nn].Efficiency = 0;
+								out[nn].CellTemp = tcell;
+								log(util::format("Non-finite power output calculated at [mdhm: %d %d %d %lg], set to zero.\n"
+									"could be due to anomolous equation behavior at very low irradiances (poa: %lg W/m2)",
+									wf.month, wf.day, wf.hour, wf.minute, Subarrays[nn]->poa.poaTotal), SSC_NOTICE);
+							}
 
-						// Output front-side irradiance after the reflection (IAM) loss - needs to be after the module model for now because reflection effects are part of the module model
-						if (iyear == 0)
-						{
-							ipoa_front[nn] *= out[nn].AOIModifier;
-							PVSystem->p_poaFront[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)ipoa[nn] : (ssc_number_t)(ipoa_front[nn]);
-							PVSystem->p_poaTotal[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)ipoa[nn] : (ssc_number_t)(ipoa_front[nn] + ipoa_rear[nn]);
+							// save DC module outputs for this subarray
+							Subarrays[nn]->Module->dcPowerW = out[nn].Power;
+							Subarrays[nn]->Module->dcEfficiency = out[nn].Efficiency * 100;
+							Subarrays[nn]->Module->dcVoltage = out[nn].Voltage;
+							Subarrays[nn]->Module->temperatureCellCelcius = out[nn].CellTemp;
+							Subarrays[nn]->Module->currentShortCircuit = out[nn].Isc_oper;
+							Subarrays[nn]->Module->voltageOpenCircuit = out[nn].Voc_oper;
+							Subarrays[nn]->Module->angleOfIncidenceModifier = out[nn].AOIModifier;
+							
+							// Lifetime dcStringVoltage
+							dcStringVoltage[nn].push_back(Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString);
 
-							ts_accum_poa_front_total += ipoa_front[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-							ts_accum_poa_total_eff += ((radmode == irrad::POA_R) ? ipoa[nn] : (ipoa_front[nn] + ipoa_rear_after_losses[nn])) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+							// Output front-side irradiance after the reflection (IAM) loss - needs to be after the module model for now because reflection effects are part of the module model
+							if (iyear == 0)
+							{
+								ipoa_front[nn] *= out[nn].AOIModifier;
+								PVSystem->p_poaFront[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)ipoa[nn] : (ssc_number_t)(ipoa_front[nn]);
+								PVSystem->p_poaTotal[nn][idx] = (radmode == irrad::POA_R) ? (ssc_number_t)ipoa[nn] : (ssc_number_t)(ipoa_front[nn] + ipoa_rear[nn]);
+
+								ts_accum_poa_front_total += ipoa_front[nn] * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+								ts_accum_poa_total_eff += ((radmode == irrad::POA_R) ? ipoa[nn] : (ipoa_front[nn] + ipoa_rear_after_losses[nn])) * ref_area_m2 * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
 
-							//assign final string voltage output
-							PVSystem->p_dcStringVoltage[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString;
+								//assign final string voltage output
+								PVSystem->p_dcStringVoltage[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcVoltage * Subarrays[nn]->nModulesPerString;
+							}
 						}
 					}
-				}
-
-				// sum up all DC power from the whole array
-				PVSystem->p_systemDCPower[idx] = 0;
-				for (size_t nn = 0; nn < num_subarrays; nn++)
-				{
-					// DC derates for snow and shading must be applied first
-					// these can't be applied before the power calculation because they are POWER derates
 
-					// self-shading derate (by default it is 1.0 if disbled)
-					Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
-					if (iyear == 0) mpptVoltageClipping[nn] *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
+					// apply DC power derates and scale to subarray dimensions
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+					{
+						// DC derates for snow and shading must be applied first
+						// these can't be applied before the power calculation because they are POWER derates
 
-					// Sara 1/25/16 - shading database derate applied to dc only
-					// shading loss applied to beam if not from shading database
-					Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->shadeCalculator.dc_shade_factor();
+						// self-shading derate (by default it is 1.0 if disbled)
+						Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
+						if (iyear == 0) mpptVoltageClipping[nn] *= Subarrays[nn]->poa.nonlinearDCShadingDerate;
 
-					// Calculate and apply snow coverage losses if activated
-					if (PVSystem->enableSnowModel)
-					{
-						float smLoss = 0.0f;
+						// Sara 1/25/16 - shading database derate applied to dc only
+						// shading loss applied to beam if not from shading database
+						Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->shadeCalculator.dc_shade_factor();
 
-						if (Subarrays[nn]->snowModel.getLoss((float)(Subarrays[nn]->poa.poaBeamFront + Subarrays[nn]->poa.poaDiffuseFront + Subarrays[nn]->poa.poaGroundFront),
-							(float)Subarrays[nn]->poa.surfaceTiltDegrees, (float)wf.wspd, (float)wf.tdry, (float)wf.snow, sunup, 1.0f / step_per_hour, smLoss))
+						// Calculate and apply snow coverage losses if activated
+						if (PVSystem->enableSnowModel)
 						{
-							if (!Subarrays[nn]->snowModel.good)
-								throw exec_error("pvsamv1", Subarrays[nn]->snowModel.msg);
+							float smLoss = 0.0f;
+
+							if (Subarrays[nn]->snowModel.getLoss((float)(Subarrays[nn]->poa.poaBeamFront + Subarrays[nn]->poa.poaDiffuseFront + Subarrays[nn]->poa.poaGroundFront),
+								(float)Subarrays[nn]->poa.surfaceTiltDegrees, (float)wf.wspd, (float)wf.tdry, (float)wf.snow, sunup, 1.0f / step_per_hour, smLoss))
+							{
+								if (!Subarrays[nn]->snowModel.good)
+									throw exec_error("pvsamv1", Subarrays[nn]->snowModel.msg);
+							}
+
+							if (iyear == 0)
+							{
+								PVSystem->p_snowLoss[nn][idx] = (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
+								PVSystem->p_snowLossTotal[idx] += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
+								PVSystem->p_snowCoverage[nn][idx] = (ssc_number_t)(Subarrays[nn]->snowModel.coverage);
+								annual_snow_loss += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
+							}
+
+							Subarrays[nn]->Module->dcPowerW *= (1 - smLoss);
+							if (iyear == 0) mpptVoltageClipping[nn] *= (1 - smLoss);
 						}
 
+						// scale power and mppt voltage clipping to subarray dimensions
+						Subarrays[nn]->dcPowerSubarray = Subarrays[nn]->Module->dcPowerW * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
+						if (iyear == 0) mpptVoltageClipping[nn] *= Subarrays[nn]->nModulesPerString* Subarrays[nn]->nStrings;
+
+						//assign gross outputs per subarray at this point
 						if (iyear == 0)
 						{
-							PVSystem->p_snowLoss[nn][idx] = (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
-							PVSystem->p_snowLossTotal[idx] += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
-							PVSystem->p_snowCoverage[nn][idx] = (ssc_number_t)(Subarrays[nn]->snowModel.coverage);
-							annual_snow_loss += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->Module->dcPowerW*smLoss);
+							//Gross DC power
+							dc_gross[nn] += Subarrays[nn]->dcPowerSubarray*util::watt_to_kilowatt*ts_hour; //power W to	energy kWh
+							PVSystem->p_dcPowerGross[nn][idx] = (ssc_number_t)dc_gross[nn];
+							//Add to annual MPPT clipping
+							annualMpptVoltageClipping += mpptVoltageClipping[nn]*util::watt_to_kilowatt*ts_hour; //power W to energy kWh
+							// save to SSC output arrays
+							if (PVSystem->p_temperatureCell[nn]) PVSystem->p_temperatureCell[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->temperatureCellCelcius;
+							if (PVSystem->p_moduleEfficiency[nn]) PVSystem->p_moduleEfficiency[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcEfficiency;					
+							if (PVSystem->p_voltageOpenCircuit[nn]) PVSystem->p_voltageOpenCircuit[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->voltageOpenCircuit * (double)Subarrays[nn]->nModulesPerString);
+							if (PVSystem->p_currentShortCircuit[nn]) PVSystem->p_currentShortCircuit[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->currentShortCircuit;
+							if (PVSystem->p_angleOfIncidenceModifier[nn]) PVSystem->p_angleOfIncidenceModifier[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->angleOfIncidenceModifier);
+
 						}
 
-						Subarrays[nn]->Module->dcPowerW *= (1 - smLoss);
-						if (iyear == 0) mpptVoltageClipping[nn] *= (1 - smLoss);
+						if (reuse_dc)
+							dcPowerSubarrayFirstYear[nn][idx] = Subarrays[nn]->dcPowerSubarray;
 					}
 
-					// scale power and mppt voltage clipping to subarray dimensions
-					Subarrays[nn]->dcPowerSubarray = Subarrays[nn]->Module->dcPowerW * Subarrays[nn]->nModulesPerString * Subarrays[nn]->nStrings;
-					if (iyear == 0) mpptVoltageClipping[nn] *= Subarrays[nn]->nModulesPerString* Subarrays[nn]->nStrings;
-
-					//assign gross outputs per subarray at this point
+					// save other array-level environmental and irradiance outputs	- year 1 only outputs
 					if (iyear == 0)
 					{
-						//Gross DC power
-						dc_gross[nn] += Subarrays[nn]->dcPowerSubarray*util::watt_to_kilowatt*ts_hour; //power W to	energy kWh
-						PVSystem->p_dcPowerGross[nn][idx] = (ssc_number_t)dc_gross[nn];
-						//Add to annual MPPT clipping
-						annualMpptVoltageClipping += mpptVoltageClipping[nn]*util::watt_to_kilowatt*ts_hour; //power W to energy kWh
-						// save to SSC output arrays
-						PVSystem->p_temperatureCell[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->temperatureCellCelcius;
-						PVSystem->p_moduleEfficiency[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->dcEfficiency;					
-						PVSystem->p_voltageOpenCircuit[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->voltageOpenCircuit * (double)Subarrays[nn]->nModulesPerString);
-						PVSystem->p_currentShortCircuit[nn][idx] = (ssc_number_t)Subarrays[nn]->Module->currentShortCircuit;
-						PVSystem->p_angleOfIncidenceModifier[nn][idx] = (ssc_number_t)(Subarrays[nn]->Module->angleOfIncidenceModifier);
-
+						Irradiance->p_weatherFileWindSpeed[idx] = (ssc_number_t)wf.wspd;
+						Irradiance->p_weatherFileAmbientTemp[idx] = (ssc_number_t)wf.tdry;
+						Irradiance->p_weatherFileAlbedo[idx] = (ssc_number_t)alb;
+						Irradiance->p_weatherFileSnowDepth[idx] = (ssc_number_t)wf.snow;
+
+						Irradiance->p_sunZenithAngle[idx] = (ssc_number_t)solzen;
+						Irradiance->p_sunAltitudeAngle[idx] = (ssc_number_t)solalt;
+						Irradiance->p_sunAzimuthAngle[idx] = (ssc_number_t)solazi;
+
+						// absolute relative airmass calculation as f(zenith angle, site elevation)
+						Irradiance->p_absoluteAirmass[idx] = sunup > 0 ? (ssc_number_t)(exp(-0.0001184 * hdr.elev) / (cos(solzen*3.1415926 / 180) + 0.5057*pow(96.080 - solzen, -1.634))) : 0.0f;
+						Irradiance->p_sunUpOverHorizon[idx] = (ssc_number_t)sunup;
+
+						// Sum of radiation power on each subarray for the current timestep [kW]
+						PVSystem->p_poaFrontNominalTotal[idx] = (ssc_number_t)(ts_accum_poa_front_nom * util::watt_to_kilowatt); 
+						PVSystem->p_poaFrontBeamNominalTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_nom * util::watt_to_kilowatt); 
+						PVSystem->p_poaFrontShadedTotal[idx] = (ssc_number_t)(ts_accum_poa_front_shaded * util::watt_to_kilowatt); 
+						PVSystem->p_poaFrontShadedSoiledTotal[idx] = (ssc_number_t)(ts_accum_poa_front_shaded_soiled * util::watt_to_kilowatt);
+						PVSystem->p_poaFrontTotal[idx] = (ssc_number_t)(ts_accum_poa_front_total * util::watt_to_kilowatt);
+						PVSystem->p_poaRearTotal[idx] = (ssc_number_t)(ts_accum_poa_rear_after_losses * util::watt_to_kilowatt);
+						PVSystem->p_poaTotalAllSubarrays[idx] = (ssc_number_t)(ts_accum_poa_total_eff * util::watt_to_kilowatt); 
+						PVSystem->p_poaFrontBeamTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_eff * util::watt_to_kilowatt);
+						PVSystem->p_inverterMPPTLoss[idx] = 0;
+						for (size_t nn = 0; nn < num_subarrays; nn++) {
+							PVSystem->p_inverterMPPTLoss[idx] = (ssc_number_t)(mpptVoltageClipping[nn] * util::watt_to_kilowatt);
+						}
 					}
-					
+				}
+				else
+				{
+					// later years of a lifetime simulation start from the first year subarray DC power
+					size_t idx_first_year = idx % nrec;
+					for (size_t m = 0; m < PVSystem->Inverter->nMpptInputs; m++)
+						PVSystem->p_mpptVoltage[m][idx] = PVSystem->p_mpptVoltage[m][idx_first_year];
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+					{
+						Subarrays[nn]->dcPowerSubarray = dcPowerSubarrayFirstYear[nn][idx_first_year];
+						dcStringVoltage[nn].push_back(dcStringVoltage[nn][idx_first_year]);
+					}
+				}
+
+				// sum up all DC power from the whole array
+				PVSystem->p_systemDCPower[idx] = 0;
+				for (size_t nn = 0; nn < num_subarrays; nn++)
+				{
 					//calculate net power for each subarray
 
 					// apply pre-inverter power derate
@@ -1845,37 +1939,6 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					dcPowerNetTotalSystem += dcPowerNetPerSubarray[nn];	
 				}								
 
-				// save other array-level environmental and irradiance outputs	- year 1 only outputs
-				if (iyear == 0)
-				{
-					Irradiance->p_weatherFileWindSpeed[idx] = (ssc_number_t)wf.wspd;
-					Irradiance->p_weatherFileAmbientTemp[idx] = (ssc_number_t)wf.tdry;
-					Irradiance->p_weatherFileAlbedo[idx] = (ssc_number_t)alb;
-					Irradiance->p_weatherFileSnowDepth[idx] = (ssc_number_t)wf.snow;
-
-					Irradiance->p_sunZenithAngle[idx] = (ssc_number_t)solzen;
-					Irradiance->p_sunAltitudeAngle[idx] = (ssc_number_t)solalt;
-					Irradiance->p_sunAzimuthAngle[idx] = (ssc_number_t)solazi;
-
-					// absolute relative airmass calculation as f(zenith angle, site elevation)
-					Irradiance->p_absoluteAirmass[idx] = sunup > 0 ? (ssc_number_t)(exp(-0.0001184 * hdr.elev) / (cos(solzen*3.1415926 / 180) + 0.5057*pow(96.080 - solzen, -1.634))) : 0.0f;
-					Irradiance->p_sunUpOverHorizon[idx] = (ssc_number_t)sunup;
-
-					// Sum of radiation power on each subarray for the current timestep [kW]
-					PVSystem->p_poaFrontNominalTotal[idx] = (ssc_number_t)(ts_accum_poa_front_nom * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontBeamNominalTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_nom * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontShadedTotal[idx] = (ssc_number_t)(ts_accum_poa_front_shaded * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontShadedSoiledTotal[idx] = (ssc_number_t)(ts_accum_poa_front_shaded_soiled * util::watt_to_kilowatt);
-					PVSystem->p_poaFrontTotal[idx] = (ssc_number_t)(ts_accum_poa_front_total * util::watt_to_kilowatt);
-					PVSystem->p_poaRearTotal[idx] = (ssc_number_t)(ts_accum_poa_rear_after_losses * util::watt_to_kilowatt);
-					PVSystem->p_poaTotalAllSubarrays[idx] = (ssc_number_t)(ts_accum_poa_total_eff * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontBeamTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_eff * util::watt_to_kilowatt);
-					PVSystem->p_inverterMPPTLoss[idx] = 0;
-					for (size_t nn = 0; nn < num_subarrays; nn++) {
-						PVSystem->p_inverterMPPTLoss[idx] = (ssc_number_t)(mpptVoltageClipping[nn] * util::watt_to_kilowatt);
-					}
-				}
-
 				// Predict clipping for DC battery controller
 				if (en_batt)
 				{
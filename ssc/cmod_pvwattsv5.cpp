@@ -239,7 +239,8 @@ public:
 
 	
 	int process_irradiance(int year, int month, int day, int hour, double minute, double ts_hour,
-		double lat, double lon, double tz, double dn, double df, double alb )
+		double lat, double lon, double tz, double dn, double df, double alb,
+		const solarpos_table *sun_table = 0, size_t sun_index = 0 )
 	{
 		irrad irr;
 		irr.set_time( year, month, day, hour, minute, ts_hour );
@@ -249,6 +250,7 @@ public:
 		irr.set_surface( track_mode, tilt, azimuth, 45.0, 
 			shade_mode_1x == 1, // backtracking mode
 			gcr );
+		irr.set_angle_tables( sun_table, 0, sun_index );
 
 		int code = irr.calc();
 			
@@ -472,6 +474,10 @@ public:
 
 		initialize_cell_temp( ts_hour );
 
+		// sun positions for every record, shared with other simulations at the same location
+		std::shared_ptr<const solarpos_table> sun_table = solarpos_table::shared( wdprov.get(),
+			instantaneous ? IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET : ts_hour );
+
 		double annual_kwh = 0; 
 					
 		size_t hour=0, idx=0;
@@ -506,7 +512,7 @@ public:
 				
 				int code = process_irradiance(wf.year, wf.month, wf.day, wf.hour, wf.minute, 
 					instantaneous ? IRRADPROC_NO_INTERPOLATE_SUNRISE_SUNSET : ts_hour,
-					hdr.lat, hdr.lon, hdr.tz, wf.dn, wf.df, alb );
+					hdr.lat, hdr.lon, hdr.tz, wf.dn, wf.df, alb, sun_table.get(), idx );
 
 				if ( -1 == code )
 				{
@@ -284,6 +284,8 @@ public:
 
 	void exec() throw(general_error)
 	{
+		N_co2_props::C_table_lookup_scope co2_table_scope(as_boolean("is_co2_prop_table"));
+
 		C_sco2_recomp_csp c_sco2_cycle;
 
 		int sco2_des_err = sco2_design_cmod_common(this, c_sco2_cycle);
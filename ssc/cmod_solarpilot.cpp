@@ -133,6 +133,8 @@ static var_info _cm_vtab_solarpilot[] = {
     { SSC_INPUT,        SSC_NUMBER,      "opt_conv_tol",              "Optimization convergence tol",               "",       "",         "SolarPILOT",   "?=0.001",          "",                "" },
     { SSC_INPUT,        SSC_NUMBER,      "opt_algorithm",             "Optimization algorithm",                     "",       "",         "SolarPILOT",   "?=0",              "",                "" },
     { SSC_INPUT,        SSC_NUMBER,      "opt_flux_penalty",          "Optimization flux overage penalty",          "",       "",         "SolarPILOT",   "*",                "",                "" },
+    { SSC_INPUT,        SSC_NUMBER,      "sp_n_threads",              "Number of threads for SolarPILOT simulations, 0 = number of hardware threads", "", "", "SolarPILOT", "?=1",     "",                "" },
+    { SSC_INPUT,        SSC_STRING,      "sp_cache_dir",              "Existing directory for saving and reusing SolarPILOT results, empty to disable", "", "", "SolarPILOT", "?",         "",                "" },
 	{ SSC_INPUT,        SSC_MATRIX,      "helio_positions_in",        "Heliostat position table",                   "",       "",         "SolarPILOT",   "",                "",                "" },
 
 
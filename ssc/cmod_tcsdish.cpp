@@ -57,6 +57,7 @@ static var_info _cm_vtab_tcsdish[] = {
 //   weather reader inputs
 //   VARTYPE            DATATYPE          NAME                      LABEL                                                                             UNITS           META            GROUP            REQUIRED_IF                CONSTRAINTS              UI_HINTS
     { SSC_INPUT,        SSC_STRING,      "file_name",               "local weather file path",                                                        "",             "",             "Weather",       "*",                       "LOCAL_FILE",            "" },
+    { SSC_INPUT,        SSC_NUMBER,      "tcs_n_threads",           "Number of threads for independent groups of units, 0 = number of hardware threads", "",             "",             "",              "?=1",                     "",                      "" },
     //{ SSC_INPUT,        SSC_NUMBER,      "track_mode",              "Tracking mode",                                                                  "",             "",             "Weather",       "*",                       "",                      "" },
     //{ SSC_INPUT,        SSC_NUMBER,      "tilt",                    "Tilt angle of surface/axis",                                                     "",             "",             "Weather",       "*",                       "",                      "" },
     //{ SSC_INPUT,        SSC_NUMBER,      "azimuth",                 "Azimuth angle of surface/axis",                                                  "",             "",             "Weather",       "*",                       "",                      "" },
@@ -490,6 +491,7 @@ public:
 
 		// Run simulation
 		size_t hours = 8760;
+		set_max_threads( as_integer("tcs_n_threads") );
 		if (0 > simulate(3600.0, hours*3600.0, 3600) )
 			throw exec_error( "tcsdish", util::format("there was a problem simulating in tcsdish.") );
 
@@ -63,6 +63,7 @@ using namespace std;
 static var_info _cm_vtab_tcsiscc[] = {
 //    VARTYPE           DATATYPE          NAME                   LABEL                                                                UNITS           META            GROUP            REQUIRED_IF                CONSTRAINTS              UI_HINTS
     { SSC_INPUT,        SSC_STRING,      "solar_resource_file",  "local weather file path",                                           "",             "",            "Weather",        "*",                       "LOCAL_FILE",            "" },
+    { SSC_INPUT,        SSC_NUMBER,      "tcs_n_threads",        "Number of threads for independent groups of units, 0 = number of hardware threads", "",             "",            "",               "?=1",                     "",                      "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "system_capacity",      "Nameplate capacity",                                                "kW",           "",            "molten salt tower", "*",                    "",   "" },
 														     																	  
 	// Heliostat field  parameters				     																	  
@@ -107,6 +108,7 @@ static var_info _cm_vtab_tcsiscc[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "cant_type",            "Heliostat cant method",                                             "",             "",            "heliostat",      "*",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "n_flux_days",          "No. days in flux map lookup",                                       "",             "",            "heliostat",      "?=8",                     "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "delta_flux_hrs",       "Hourly frequency in flux map lookup",                               "",             "",            "heliostat",      "?=1",                     "",                     "" },
+    { SSC_INPUT,        SSC_NUMBER,      "sp_n_threads",         "Number of threads for SolarPILOT simulations, 0 = number of hardware threads", "",  "",            "heliostat",      "?=1",                     "",                     "" },
         
 	{ SSC_INPUT,        SSC_NUMBER,      "h_tower",                   "Tower height",                               "m",      "",         "heliostat",   "*",                "",                "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "q_design",                  "Receiver thermal design power",              "MW",     "",         "heliostat",   "*",                "",                "" },
@@ -480,6 +482,7 @@ public:
 		set_unit_value_ssc_double(type_hel_field, "cant_type");
 		set_unit_value_ssc_double(type_hel_field, "n_flux_days");
 		set_unit_value_ssc_double(type_hel_field, "delta_flux_hrs");
+		set_unit_value_ssc_double(type_hel_field, "n_threads", "sp_n_threads");
 
 		int run_type = (int)get_unit_value_number(type_hel_field, "run_type");
 		/*if(run_type == 0){
@@ -622,6 +625,7 @@ public:
 
 		// Run simulation
 		size_t hours = 8760;
+		set_max_threads( as_integer("tcs_n_threads") );
 		if (0 > simulate(3600.0, hours*3600.0, 3600.0) )
 			throw exec_error( "tcs_iscc", util::format("there was a problem simulating in tcs_iscc.") );
 
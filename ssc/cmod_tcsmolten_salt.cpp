@@ -114,6 +114,8 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "focus_type",           "Heliostat focus method",                                            "",             "",            "heliostat",      "*",                       "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "cant_type",            "Heliostat cant method",                                             "",             "",            "heliostat",      "*",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "n_flux_days",          "No. days in flux map lookup",                                       "",             "",            "heliostat",      "?=8",                     "",                     "" },
+    { SSC_INPUT,        SSC_NUMBER,      "sp_n_threads",         "Number of threads for SolarPILOT simulations, 0 = number of hardware threads", "",  "",            "heliostat",      "?=1",                     "",                     "" },
+    { SSC_INPUT,        SSC_STRING,      "sp_cache_dir",         "Existing directory for saving and reusing SolarPILOT results, empty to disable", "",  "",            "heliostat",      "?",                       "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "delta_flux_hrs",       "Hourly frequency in flux map lookup",                               "",             "",            "heliostat",      "?=1",                     "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "water_usage_per_wash", "Water usage per wash",                                              "L/m2_aper",    "",            "heliostat",      "*",                       "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "washing_frequency",    "Mirror washing frequency",                                          "none",         "",            "heliostat",      "*",                       "",                     "" },
@@ -306,6 +308,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
     { SSC_INPUT,        SSC_NUMBER,      "disp_reporting",       "Dispatch optimization reporting level",                             "-",            "",            "sys_ctrl_disp_opt", "?=-1",                    "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "disp_spec_presolve",   "Dispatch optimization presolve heuristic",                          "-",            "",            "sys_ctrl_disp_opt", "?=-1",                    "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "disp_spec_scaling",    "Dispatch optimization scaling heuristic",                           "-",            "",            "sys_ctrl_disp_opt", "?=-1",                    "",                      "" }, 
+    { SSC_INPUT,        SSC_NUMBER,      "disp_warm_start",      "Dispatch optimization warm start from previous horizon",            "-",            "",            "sys_ctrl_disp_opt", "?=0",                     "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "disp_time_weighting",  "Dispatch optimization future time discounting factor",              "-",            "",            "sys_ctrl_disp_opt", "?=0.99",                    "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "is_write_ampl_dat",    "Write AMPL data files for dispatch run",                            "-",            "",            "sys_ctrl_disp_opt", "?=0",                     "",                      "" }, 
     { SSC_INPUT,        SSC_STRING,      "ampl_data_dir",        "AMPL data file directory",                                          "-",            "",            "sys_ctrl_disp_opt", "?=''",                    "",                      "" }, 
@@ -560,6 +563,7 @@ public:
 		add_var_info(_cm_vtab_tcsmolten_salt);
 		add_var_info(vtab_adjustment_factors);
         add_var_info(vtab_sf_adjustment_factors);
+		add_var_info(vtab_csp_solver_counters);
 	} 
 
 	bool relay_message(string &msg, double percent)
@@ -1579,6 +1583,7 @@ public:
 			tou.mc_dispatch_params.m_bb_type = as_integer("disp_spec_bb");
 			tou.mc_dispatch_params.m_disp_reporting = as_integer("disp_reporting");
 			tou.mc_dispatch_params.m_scaling_type = as_integer("disp_spec_scaling");
+			tou.mc_dispatch_params.m_is_warm_start = as_boolean("disp_warm_start");
 			tou.mc_dispatch_params.m_disp_time_weighting = as_double("disp_time_weighting");
             tou.mc_dispatch_params.m_rsu_cost = as_double("disp_rsu_cost");
             tou.mc_dispatch_params.m_csu_cost = as_double("disp_csu_cost");
@@ -1655,6 +1660,8 @@ public:
 						ssc_cmod_update,
 						(void*)(this));
 
+		csp_solver_counters_setup(this, csp_solver);
+
 
 		// Set solver reporting outputs
 		csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::TIME_FINAL, allocate("time_hr", n_steps_fixed), n_steps_fixed);
@@ -1805,6 +1812,8 @@ public:
 			log(out_msg, out_type);
 		}
 
+		csp_solver_counters_outputs(this, csp_solver);
+
 		// ******* Re-calculate system costs here ************
 		C_mspt_system_costs sys_costs;
 
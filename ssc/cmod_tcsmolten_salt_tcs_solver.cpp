@@ -70,6 +70,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "cant_type",            "Heliostat cant method",                                             "",             "",            "heliostat",      "*",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "n_flux_days",          "No. days in flux map lookup",                                       "",             "",            "heliostat",      "?=8",                     "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "delta_flux_hrs",       "Hourly frequency in flux map lookup",                               "",             "",            "heliostat",      "?=1",                     "",                     "" },
+    { SSC_INPUT,        SSC_NUMBER,      "sp_n_threads",         "Number of threads for SolarPILOT simulations, 0 = number of hardware threads", "",  "",            "heliostat",      "?=1",                     "",                     "" },
     
     
 	{ SSC_INPUT,        SSC_NUMBER,      "h_tower",                   "Tower height",                               "m",      "",         "heliostat",   "*",                "",                "" },
@@ -790,6 +791,7 @@ public:
 		set_unit_value_ssc_double(type_hel_field, "cant_type");
 		set_unit_value_ssc_double(type_hel_field, "n_flux_days");
 		set_unit_value_ssc_double(type_hel_field, "delta_flux_hrs");
+		set_unit_value_ssc_double(type_hel_field, "n_threads", "sp_n_threads");
 		
         int run_type = (int)get_unit_value_number(type_hel_field, "run_type");
         /*if(run_type == 0){
@@ -60,6 +60,7 @@ static var_info _cm_vtab_tcstrough_physical[] = {
 //   weather reader inputs
 //   VARTYPE            DATATYPE          NAME                        LABEL                                                                               UNITS           META            GROUP             REQUIRED_IF                CONSTRAINTS              UI_HINTS
     { SSC_INPUT,        SSC_STRING,      "file_name",                 "Local weather file with path",                                                     "none",         "",             "Weather",        "*",                       "LOCAL_FILE",            "" },
+    { SSC_INPUT,        SSC_NUMBER,      "tcs_n_threads",             "Number of threads for independent groups of units, 0 = number of hardware threads", "",             "",             "",               "?=1",                     "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "track_mode",                "Tracking mode",                                                                    "none",         "",             "Weather",        "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "tilt",                      "Tilt angle of surface/axis",                                                       "none",         "",             "Weather",        "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "azimuth",                   "Azimuth angle of surface/axis",                                                    "none",         "",             "Weather",        "*",                       "",                      "" },
@@ -899,6 +900,7 @@ public:
 		// size_t hours = 8760; 
 		// size_t start_hour = ts_hour;
 		// if ( 0 != simulate(3600, hours * 3600, 3600))
+		set_max_threads( as_integer("tcs_n_threads") );
 		if( 0 != simulate(start_hour*3600.0, hours_year*3600.0, ts_hour*3600.0))
 			throw exec_error( "tcstrough_physical", "there was a problem simulating in tcskernel(physical trough)" );
 
@@ -53,6 +53,7 @@
 
 // for adjustment factors
 #include "common.h"
+#include "csp_common.h"
 
 //#include "lib_weatherfile.h
 //#include "csp_solver_util.h"
@@ -502,6 +503,7 @@ public:
     {
         add_var_info( _cm_vtab_trough_physical );
         add_var_info( vtab_adjustment_factors );
+        add_var_info( vtab_csp_solver_counters );
     }
 
     void exec( ) throw( general_error )
@@ -1045,6 +1047,8 @@ public:
                                 ssc_cmod_update,
                                 (void*)(this));
 
+        csp_solver_counters_setup(this, csp_solver);
+
         // Set solver reporting outputs
         // Simulation Kernel
         csp_solver.mc_reported_outputs.assign(C_csp_solver::C_solver_outputs::TIME_FINAL, allocate("time_hr", n_steps_fixed), n_steps_fixed);
@@ -1196,6 +1200,8 @@ public:
             log(out_msg, out_type);
         }
 
+        csp_solver_counters_outputs(this, csp_solver);
+
 
         // Do unit post-processing here
         float *p_q_pc_startup = allocate("q_pc_startup", n_steps_fixed);
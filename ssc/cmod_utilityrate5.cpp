@@ -402,6 +402,51 @@ public:
 
 };
 
+// copy of the arrays filled by one bill calculation (ur_calc or ur_calc_timestep)
+// every charge and credit is proportional to the rate escalation for a given energy and demand,
+// so a later year with the same energy and demand is restored from the copy and rescaled instead of billed again
+class ur_bill_snapshot
+{
+public:
+	ur_bill_snapshot() : m_rate_esc(0) {}
+
+	// true when a bill has been saved and can be rescaled to rate_esc
+	bool can_rescale(ssc_number_t rate_esc) const
+	{
+		// minimum charge comparisons only keep their outcome for positive escalation
+		return !m_charges.empty() && m_rate_esc > 0 && rate_esc > 0;
+	}
+
+	void save(const std::vector<std::vector<ssc_number_t> *> &charges, const std::vector<std::vector<ssc_number_t> *> &quantities, ssc_number_t rate_esc)
+	{
+		m_rate_esc = rate_esc;
+		m_charges.resize(charges.size());
+		for (size_t i = 0; i < charges.size(); i++)
+			m_charges[i] = *charges[i];
+		m_quantities.resize(quantities.size());
+		for (size_t i = 0; i < quantities.size(); i++)
+			m_quantities[i] = *quantities[i];
+	}
+
+	void restore(const std::vector<std::vector<ssc_number_t> *> &charges, const std::vector<std::vector<ssc_number_t> *> &quantities, ssc_number_t rate_esc) const
+	{
+		double scale = (double)rate_esc / m_rate_esc;
+		for (size_t i = 0; i < charges.size() && i < m_charges.size(); i++)
+		{
+			std::vector<ssc_number_t> &charge = *charges[i];
+			for (size_t j = 0; j < charge.size() && j < m_charges[i].size(); j++)
+				charge[j] = (ssc_number_t)(m_charges[i][j] * scale);
+		}
+		for (size_t i = 0; i < quantities.size() && i < m_quantities.size(); i++)
+			*quantities[i] = m_quantities[i];
+	}
+
+private:
+	ssc_number_t m_rate_esc;
+	std::vector<std::vector<ssc_number_t> > m_charges;
+	std::vector<std::vector<ssc_number_t> > m_quantities;
+};
+
 class cm_utilityrate5 : public compute_module
 {
 private:
@@ -419,6 +464,9 @@ private:
 	std::vector<std::vector<int> >  m_dc_tou_periods_tiers; // tier numbers
 	std::vector<std::vector<int> >  m_dc_flat_tiers; // tier numbers for each month of flat demand charge
 	size_t m_num_rec_yearly;
+	// row of each time step's period in its month's ec_periods and dc_periods, -1 if not found (resolved in setup)
+	std::vector<int> m_ec_period_row;
+	std::vector<int> m_dc_period_row;
 
 public:
 	cm_utilityrate5()
@@ -642,8 +690,8 @@ public:
 
 
 		// Enphase outputs requested - see emails 2/12/16- first year system to grid and from grid
-		ssc_number_t *year1_hourly_e_togrid = allocate("year1_hourly_e_togrid", m_num_rec_yearly);
-		ssc_number_t *year1_hourly_e_fromgrid = allocate("year1_hourly_e_fromgrid", m_num_rec_yearly);
+		ssc_number_t *year1_hourly_e_togrid = allocate_if_requested("year1_hourly_e_togrid", m_num_rec_yearly);
+		ssc_number_t *year1_hourly_e_fromgrid = allocate_if_requested("year1_hourly_e_fromgrid", m_num_rec_yearly);
 
 
 
@@ -760,7 +808,30 @@ public:
 		int metering_option = as_integer("ur_metering_option");
 		bool two_meter = (metering_option == 4 );
 		bool timestep_reconciliation = (metering_option == 2 || metering_option == 3 || metering_option == 4);
-
+		bool use_lifetime_output = (as_integer("system_use_lifetime_output") == 1);
+
+		// arrays filled by each bill calculation: charges and credits scale with the rate escalation, energy and demand do not
+		std::vector<std::vector<ssc_number_t> *> wo_sys_charges, w_sys_charges, bill_quantities;
+		std::vector<ssc_number_t> *bill_charges[] = { &payment, &income,
+			&monthly_fixed_charges, &monthly_minimum_charges, &monthly_dc_fixed, &monthly_dc_tou,
+			&monthly_ec_charges, &monthly_ec_charges_gross, &monthly_excess_dollars_earned, &monthly_excess_dollars_applied,
+			&monthly_cumulative_excess_dollars, &monthly_bill };
+		wo_sys_charges.assign(bill_charges, bill_charges + sizeof(bill_charges) / sizeof(bill_charges[0]));
+		w_sys_charges = wo_sys_charges;
+		wo_sys_charges.push_back(&revenue_wo_sys);
+		wo_sys_charges.push_back(&demand_charge_wo_sys);
+		wo_sys_charges.push_back(&energy_charge_wo_sys);
+		w_sys_charges.push_back(&revenue_w_sys);
+		w_sys_charges.push_back(&demand_charge_w_sys);
+		w_sys_charges.push_back(&energy_charge_w_sys);
+		bill_quantities.push_back(&monthly_excess_kwhs_earned);
+		bill_quantities.push_back(&monthly_excess_kwhs_applied);
+		bill_quantities.push_back(&dc_hourly_peak);
+		bill_quantities.push_back(&monthly_cumulative_excess_energy);
+
+		// last calculated bills and the load and system scaling they were calculated for
+		ur_bill_snapshot wo_sys_bill, w_sys_bill;
+		ssc_number_t wo_sys_bill_load_scale = 0, w_sys_bill_load_scale = 0, w_sys_bill_sys_scale = 0;
 
 		idx = 0;
 		for (i=0;i<nyears;i++)
@@ -794,7 +865,7 @@ public:
 
 
 				// update e_sys per year if lifetime output
-				if ((as_integer("system_use_lifetime_output") == 1) && ( idx < nrec_gen ))
+				if (use_lifetime_output && ( idx < nrec_gen ))
 				{
 //					e_sys[j] = p_sys[j] = 0.0;
 //					ts_power = (idx < nrec_gen) ? pgen[idx] : 0;
@@ -822,34 +893,43 @@ public:
 			}
 
 
-			// now calculate revenue without solar system (using load only)
-			if (timestep_reconciliation)
-			{
-				ur_calc_timestep(&e_load_cy[0], &p_load_cy[0],
-					&revenue_wo_sys[0], &payment[0], &income[0], &demand_charge_wo_sys[0], &energy_charge_wo_sys[0],
-					&monthly_fixed_charges[0], &monthly_minimum_charges[0],
-					&monthly_dc_fixed[0], &monthly_dc_tou[0],
-					&monthly_ec_charges[0],
-					&monthly_ec_charges_gross[0],
-					&monthly_excess_dollars_earned[0],
-					&monthly_excess_dollars_applied[0],
-					&monthly_excess_kwhs_earned[0],
-					&monthly_excess_kwhs_applied[0],
-					&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i]);
-			}
+			// the bill without the system depends only on the load, so when the load is unchanged
+			// from the last calculated year only the rate escalation has to be applied
+			if (wo_sys_bill.can_rescale(rate_scale[i]) && (load_scale[i] == wo_sys_bill_load_scale))
+				wo_sys_bill.restore(wo_sys_charges, bill_quantities, rate_scale[i]);
 			else
 			{
-				ur_calc(&e_load_cy[0], &p_load_cy[0],
-					&revenue_wo_sys[0], &payment[0], &income[0], &demand_charge_wo_sys[0], &energy_charge_wo_sys[0],
-					&monthly_fixed_charges[0], &monthly_minimum_charges[0],
-					&monthly_dc_fixed[0], &monthly_dc_tou[0],
-					&monthly_ec_charges[0], 
-					&monthly_ec_charges_gross[0],
-					&monthly_excess_dollars_earned[0],
-					&monthly_excess_dollars_applied[0],
-					&monthly_excess_kwhs_earned[0],
-					&monthly_excess_kwhs_applied[0],
-					&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1);
+				// now calculate revenue without solar system (using load only)
+				if (timestep_reconciliation)
+				{
+					ur_calc_timestep(&e_load_cy[0], &p_load_cy[0],
+						&revenue_wo_sys[0], &payment[0], &income[0], &demand_charge_wo_sys[0], &energy_charge_wo_sys[0],
+						&monthly_fixed_charges[0], &monthly_minimum_charges[0],
+						&monthly_dc_fixed[0], &monthly_dc_tou[0],
+						&monthly_ec_charges[0],
+						&monthly_ec_charges_gross[0],
+						&monthly_excess_dollars_earned[0],
+						&monthly_excess_dollars_applied[0],
+						&monthly_excess_kwhs_earned[0],
+						&monthly_excess_kwhs_applied[0],
+						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i]);
+				}
+				else
+				{
+					ur_calc(&e_load_cy[0], &p_load_cy[0],
+						&revenue_wo_sys[0], &payment[0], &income[0], &demand_charge_wo_sys[0], &energy_charge_wo_sys[0],
+						&monthly_fixed_charges[0], &monthly_minimum_charges[0],
+						&monthly_dc_fixed[0], &monthly_dc_tou[0],
+						&monthly_ec_charges[0], 
+						&monthly_ec_charges_gross[0],
+						&monthly_excess_dollars_earned[0],
+						&monthly_excess_dollars_applied[0],
+						&monthly_excess_kwhs_earned[0],
+						&monthly_excess_kwhs_applied[0],
+						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1);
+				}
+				wo_sys_bill.save(wo_sys_charges, bill_quantities, rate_scale[i]);
+				wo_sys_bill_load_scale = load_scale[i];
 			}
 	
 			for (j = 0; j < 12; j++)
@@ -969,73 +1049,84 @@ public:
 			
 // with system
 
-			if (timestep_reconciliation)
-			{
-				if (two_meter)
-				{
-					ur_calc_timestep(&e_sys_cy[0], &p_sys_cy[0],
-						&revenue_w_sys[0], &payment[0], &income[0],
-						&demand_charge_w_sys[0], &energy_charge_w_sys[0],
-						&monthly_fixed_charges[0], &monthly_minimum_charges[0],
-						&monthly_dc_fixed[0], &monthly_dc_tou[0],
-						&monthly_ec_charges[0],
-						&monthly_ec_charges_gross[0],
-						&monthly_excess_dollars_earned[0],
-						&monthly_excess_dollars_applied[0],
-						&monthly_excess_kwhs_earned[0],
-						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], false, false, true);
-				}
-				else
-				{
-					ur_calc_timestep(&e_grid_cy[0], &p_grid_cy[0],
-						&revenue_w_sys[0], &payment[0], &income[0], 
-						&demand_charge_w_sys[0], &energy_charge_w_sys[0],
-						&monthly_fixed_charges[0], &monthly_minimum_charges[0],
-						&monthly_dc_fixed[0], &monthly_dc_tou[0],
-						&monthly_ec_charges[0],
-						&monthly_ec_charges_gross[0],
-						&monthly_excess_dollars_earned[0],
-						&monthly_excess_dollars_applied[0],
-						&monthly_excess_kwhs_earned[0],
-						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i]);
-				}
-			}
-			else // monthly reconciliation per 2015.6.30 release
+			// lifetime generation changes every year, otherwise the bill with the system is
+			// unchanged apart from the rate escalation while the load and system scaling are
+			if (!use_lifetime_output && w_sys_bill.can_rescale(rate_scale[i])
+				&& (load_scale[i] == w_sys_bill_load_scale) && (sys_scale[i] == w_sys_bill_sys_scale))
+				w_sys_bill.restore(w_sys_charges, bill_quantities, rate_scale[i]);
+			else
 			{
-				if (two_meter)
+				if (timestep_reconciliation)
 				{
-					// calculate revenue with solar system (using system energy & maxpower)
-					ur_calc(&e_sys_cy[0], &p_sys_cy[0],
-						&revenue_w_sys[0], &payment[0], &income[0],
-						&demand_charge_w_sys[0], &energy_charge_w_sys[0],
-						&monthly_fixed_charges[0], &monthly_minimum_charges[0],
-						&monthly_dc_fixed[0], &monthly_dc_tou[0],
-						&monthly_ec_charges[0],
-						&monthly_ec_charges_gross[0],
-						&monthly_excess_dollars_earned[0],
-						&monthly_excess_dollars_applied[0],
-						&monthly_excess_kwhs_earned[0],
-						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1, false, false, true);
+					if (two_meter)
+					{
+						ur_calc_timestep(&e_sys_cy[0], &p_sys_cy[0],
+							&revenue_w_sys[0], &payment[0], &income[0],
+							&demand_charge_w_sys[0], &energy_charge_w_sys[0],
+							&monthly_fixed_charges[0], &monthly_minimum_charges[0],
+							&monthly_dc_fixed[0], &monthly_dc_tou[0],
+							&monthly_ec_charges[0],
+							&monthly_ec_charges_gross[0],
+							&monthly_excess_dollars_earned[0],
+							&monthly_excess_dollars_applied[0],
+							&monthly_excess_kwhs_earned[0],
+							&monthly_excess_kwhs_applied[0],
+							&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], false, false, true);
+					}
+					else
+					{
+						ur_calc_timestep(&e_grid_cy[0], &p_grid_cy[0],
+							&revenue_w_sys[0], &payment[0], &income[0], 
+							&demand_charge_w_sys[0], &energy_charge_w_sys[0],
+							&monthly_fixed_charges[0], &monthly_minimum_charges[0],
+							&monthly_dc_fixed[0], &monthly_dc_tou[0],
+							&monthly_ec_charges[0],
+							&monthly_ec_charges_gross[0],
+							&monthly_excess_dollars_earned[0],
+							&monthly_excess_dollars_applied[0],
+							&monthly_excess_kwhs_earned[0],
+							&monthly_excess_kwhs_applied[0],
+							&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i]);
+					}
 				}
-				else
+				else // monthly reconciliation per 2015.6.30 release
 				{
-					// calculate revenue with solar system (using net grid energy & maxpower)
-					ur_calc(&e_grid_cy[0], &p_grid_cy[0],
-						&revenue_w_sys[0], &payment[0], &income[0], 
-						&demand_charge_w_sys[0], &energy_charge_w_sys[0],
-						&monthly_fixed_charges[0], &monthly_minimum_charges[0],
-						&monthly_dc_fixed[0], &monthly_dc_tou[0],
-						&monthly_ec_charges[0],
-						&monthly_ec_charges_gross[0],
-						&monthly_excess_dollars_earned[0],
-						&monthly_excess_dollars_applied[0],
-						&monthly_excess_kwhs_earned[0],
-						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1);
+					if (two_meter)
+					{
+						// calculate revenue with solar system (using system energy & maxpower)
+						ur_calc(&e_sys_cy[0], &p_sys_cy[0],
+							&revenue_w_sys[0], &payment[0], &income[0],
+							&demand_charge_w_sys[0], &energy_charge_w_sys[0],
+							&monthly_fixed_charges[0], &monthly_minimum_charges[0],
+							&monthly_dc_fixed[0], &monthly_dc_tou[0],
+							&monthly_ec_charges[0],
+							&monthly_ec_charges_gross[0],
+							&monthly_excess_dollars_earned[0],
+							&monthly_excess_dollars_applied[0],
+							&monthly_excess_kwhs_earned[0],
+							&monthly_excess_kwhs_applied[0],
+							&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1, false, false, true);
+					}
+					else
+					{
+						// calculate revenue with solar system (using net grid energy & maxpower)
+						ur_calc(&e_grid_cy[0], &p_grid_cy[0],
+							&revenue_w_sys[0], &payment[0], &income[0], 
+							&demand_charge_w_sys[0], &energy_charge_w_sys[0],
+							&monthly_fixed_charges[0], &monthly_minimum_charges[0],
+							&monthly_dc_fixed[0], &monthly_dc_tou[0],
+							&monthly_ec_charges[0],
+							&monthly_ec_charges_gross[0],
+							&monthly_excess_dollars_earned[0],
+							&monthly_excess_dollars_applied[0],
+							&monthly_excess_kwhs_earned[0],
+							&monthly_excess_kwhs_applied[0],
+							&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1);
+					}
 				}
+				w_sys_bill.save(w_sys_charges, bill_quantities, rate_scale[i]);
+				w_sys_bill_load_scale = load_scale[i];
+				w_sys_bill_sys_scale = sys_scale[i];
 			}
 			if (two_meter)
 			{
@@ -1191,16 +1282,8 @@ public:
 					dc_tou_sched[ii] = (ssc_number_t)m_dc_tou_sched[ii];
 					load[ii] = -e_load_cy[ii];
 					e_tofromgrid[ii] = e_grid_cy[ii];
-					if (e_tofromgrid[ii] > 0)
-					{
-						year1_hourly_e_togrid[ii] = e_tofromgrid[ii];
-						year1_hourly_e_fromgrid[ii] = 0.0;
-					}
-					else
-					{
-						year1_hourly_e_togrid[ii] = 0.0;
-						year1_hourly_e_fromgrid[ii] = -e_tofromgrid[ii];
-					}
+					if (year1_hourly_e_togrid) year1_hourly_e_togrid[ii] = e_tofromgrid[ii] > 0 ? e_tofromgrid[ii] : (ssc_number_t)0.0;
+					if (year1_hourly_e_fromgrid) year1_hourly_e_fromgrid[ii] = e_tofromgrid[ii] > 0 ? (ssc_number_t)0.0 : -e_tofromgrid[ii];
 					p_tofromgrid[ii] = p_grid_cy[ii];
 					salespurchases[ii] = revenue_w_sys[ii];
 				}
@@ -1228,29 +1311,34 @@ public:
 				// output and demand per Paul's email 9/10/10
 				// positive demand indicates system does not produce enough electricity to meet load
 				// zero if the system produces more than the demand
-				std::vector<ssc_number_t> output(m_num_rec_yearly), edemand(m_num_rec_yearly), pdemand(m_num_rec_yearly), e_sys_to_grid(m_num_rec_yearly), e_sys_to_load(m_num_rec_yearly), p_sys_to_load(m_num_rec_yearly);
-				for (j = 0; j<m_num_rec_yearly; j++)
+				if (is_output_requested("year1_hourly_system_output") || is_output_requested("year1_hourly_e_demand")
+					|| is_output_requested("year1_hourly_p_demand") || is_output_requested("year1_hourly_system_to_load")
+					|| is_output_requested("year1_hourly_p_system_to_load"))
 				{
-					output[j] = e_sys_cy[j];
-					edemand[j] = e_grid_cy[j] < 0.0 ? -e_grid_cy[j] : (ssc_number_t)0.0;
-					pdemand[j] = p_grid_cy[j] < 0.0 ? -p_grid_cy[j] : (ssc_number_t)0.0;
+					std::vector<ssc_number_t> output(m_num_rec_yearly), edemand(m_num_rec_yearly), pdemand(m_num_rec_yearly), e_sys_to_grid(m_num_rec_yearly), e_sys_to_load(m_num_rec_yearly), p_sys_to_load(m_num_rec_yearly);
+					for (j = 0; j<m_num_rec_yearly; j++)
+					{
+						output[j] = e_sys_cy[j];
+						edemand[j] = e_grid_cy[j] < 0.0 ? -e_grid_cy[j] : (ssc_number_t)0.0;
+						pdemand[j] = p_grid_cy[j] < 0.0 ? -p_grid_cy[j] : (ssc_number_t)0.0;
 
-					ssc_number_t sys_e_net = output[j] + e_load_cy[j];// loads are assumed negative
-					e_sys_to_grid[j] = sys_e_net > 0 ? sys_e_net : (ssc_number_t)0.0;
-					e_sys_to_load[j] = sys_e_net > 0 ? -e_load_cy[j] : output[j];
+						ssc_number_t sys_e_net = output[j] + e_load_cy[j];// loads are assumed negative
+						e_sys_to_grid[j] = sys_e_net > 0 ? sys_e_net : (ssc_number_t)0.0;
+						e_sys_to_load[j] = sys_e_net > 0 ? -e_load_cy[j] : output[j];
 
 //					ssc_number_t sys_p_net = output[j] + p_load[j];// loads are assumed negative
 //					p_sys_to_load[j] = sys_p_net > 0 ? -p_load[j] : output[j];
-					ssc_number_t sys_p_net = output[j] + p_load_cy[j];// loads are assumed negative
-					p_sys_to_load[j] = sys_p_net > 0 ? -p_load_cy[j] : output[j];
-				}
+						ssc_number_t sys_p_net = output[j] + p_load_cy[j];// loads are assumed negative
+						p_sys_to_load[j] = sys_p_net > 0 ? -p_load_cy[j] : output[j];
+					}
 
-				assign("year1_hourly_system_output", var_data(&output[0], (int)m_num_rec_yearly));
-				assign("year1_hourly_e_demand", var_data(&edemand[0], (int)m_num_rec_yearly));
-				assign("year1_hourly_p_demand", var_data(&pdemand[0], (int)m_num_rec_yearly));
+					assign("year1_hourly_system_output", var_data(&output[0], (int)m_num_rec_yearly));
+					assign("year1_hourly_e_demand", var_data(&edemand[0], (int)m_num_rec_yearly));
+					assign("year1_hourly_p_demand", var_data(&pdemand[0], (int)m_num_rec_yearly));
 
-				assign("year1_hourly_system_to_load", var_data(&e_sys_to_load[0], (int)m_num_rec_yearly));
-				assign("year1_hourly_p_system_to_load", var_data(&p_sys_to_load[0], (int)m_num_rec_yearly));
+					assign("year1_hourly_system_to_load", var_data(&e_sys_to_load[0], (int)m_num_rec_yearly));
+					assign("year1_hourly_p_system_to_load", var_data(&p_sys_to_load[0], (int)m_num_rec_yearly));
+				}
 
 				assign("year1_monthly_fixed_with_system", var_data(&monthly_fixed_charges[0], 12));
 				assign("year1_monthly_minimum_with_system", var_data(&monthly_minimum_charges[0], 12));
@@ -1874,6 +1962,22 @@ public:
 
 		}
 
+		// resolve the monthly period row of every time step once instead of searching in each bill calculation
+		m_ec_period_row.assign(m_num_rec_yearly, -1);
+		m_dc_period_row.assign(m_num_rec_yearly, -1);
+		idx = 0;
+		for (m = 0; m < m_month.size(); m++)
+		{
+			for (i = 0; i < util::nday[m] * 24 * steps_per_hour && idx < m_num_rec_yearly; i++, idx++)
+			{
+				std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), m_ec_tou_sched[idx]);
+				if (per_num != m_month[m].ec_periods.end())
+					m_ec_period_row[idx] = (int)(per_num - m_month[m].ec_periods.begin());
+				per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), m_dc_tou_sched[idx]);
+				if (per_num != m_month[m].dc_periods.end())
+					m_dc_period_row[idx] = (int)(per_num - m_month[m].dc_periods.begin());
+			}
+		}
 	}
 
 
@@ -2113,14 +2217,13 @@ public:
 						{
 							mon_e_net += e_in[c];
 							int toup = m_ec_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
-							if (per_num == m_month[m].ec_periods.end())
+							int row = m_ec_period_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
 								ss << "Energy rate TOU Period " << toup << " not found for Month " << util::schedule_int_to_month(m) << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
 							// place all in tier 0 initially and then update appropriately
 							// net energy per period per month
 							m_month[m].ec_energy_use(row, 0) += e_in[c];
@@ -2308,14 +2411,13 @@ public:
 						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
 							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
+							int row = m_dc_period_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
 								ss << "Demand rate Period " << todp << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
 							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
 							{
 								m_month[m].dc_tou_peak[row] = -p_in[c];
@@ -2868,14 +2970,13 @@ public:
 						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
 							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
+							int row = m_dc_period_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
 								ss << "Demand charge Period " << todp << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
 							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
 							{
 								m_month[m].dc_tou_peak[row] = -p_in[c];
@@ -2910,14 +3011,13 @@ public:
 							period = m_ec_tou_sched[c];
 							// find corresponding monthly period
 							// check for valid period
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), period);
-							if (per_num == m_month[m].ec_periods.end())
+							int row = m_ec_period_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
 								ss << "Energy rate Period " << period << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
 
 							if (e_in[c] >= 0.0)
 							{ // calculate income or credit
@@ -0,0 +1,103 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (“Alliance”) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as “System Advisor Model” or “SAM”. Except
+*  to comply with the foregoing, the terms “System Advisor Model”, “SAM”, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#include "core.h"
+#include "lib_weatherfile.h"
+
+static var_info _cm_vtab_wfcache[] = 
+{	
+/*   VARTYPE           DATATYPE         NAME                         LABEL                              UNITS     META                      GROUP                     REQUIRED_IF                 CONSTRAINTS                      UI_HINTS*/
+	{ SSC_INPUT,        SSC_STRING,      "input_file",               "Input weather file name",         "",       "tmy2,tmy3,csv,epw,smw",  "Weather Cache",          "*",                       "LOCAL_FILE",           "" },
+	{ SSC_INPUT,        SSC_STRING,      "cache_dir",                "Cache folder",                    "",       "defaults to SSC_WEATHER_CACHE_DIR",    "Weather Cache",          "?",                       "",                     "" },
+	{ SSC_OUTPUT,       SSC_STRING,      "cache_file",               "Binary cache file name",          "",       "",                       "Weather Cache",          "*",                       "",                     "" },
+	{ SSC_OUTPUT,       SSC_NUMBER,      "nrecords",                 "Number of records",               "",       "",                       "Weather Cache",          "*",                       "",                     "" },
+
+var_info_invalid };
+
+class cm_wfcache : public compute_module
+{
+private:
+public:
+	cm_wfcache()
+	{
+		add_var_info( _cm_vtab_wfcache );
+	}
+
+	void exec( ) throw( general_error )
+	{
+		std::string input = as_string("input_file");
+
+		std::string folder = weatherfile::cache_dir();
+		if ( is_assigned("cache_dir") )
+			folder = as_string("cache_dir");
+		if ( folder.empty() )
+			throw exec_error( "wfcache", "no cache folder: set cache_dir or the SSC_WEATHER_CACHE_DIR environment variable" );
+
+		if ( !util::dir_exists( folder.c_str() ) && !util::mkdir( folder.c_str(), true ) )
+			throw exec_error( "wfcache", "could not create cache folder: " + folder );
+
+		// loads the cache in the folder if it is up to date with the input file, otherwise parses the input and writes it
+		weatherfile wfile;
+		if ( !wfile.open( input, false, folder ) ) throw exec_error( "wfcache", "could not read input file: " + input + " " + wfile.message() );
+
+		// open() does not report a failed write, so check that the new cache loads the way later opens will read it
+		std::string output = weatherfile::cache_file_name( input, folder );
+		if ( !wfile.from_cache() )
+		{
+			weatherfile check;
+			if ( !check.open( input, false, folder ) || !check.from_cache() )
+				throw exec_error( "wfcache", "could not write cache file: " + output );
+		}
+
+		assign( "cache_file", var_data( output ) );
+		assign( "nrecords", var_data( (ssc_number_t)wfile.nrecords() ) );
+	}
+};
+
+DEFINE_MODULE_ENTRY( wfcache, "Builds the binary columnar cache for a TMY2, TMY3, CSV, EPW or SMW weather file", 1 )
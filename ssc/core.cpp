@@ -57,7 +57,7 @@
 const var_info var_info_invalid = {	0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 
 compute_module::compute_module( )
-	:  m_infomap(NULL), m_handler(NULL), m_vartab(NULL)
+	:  m_infomap(NULL), m_filterOutputs(false), m_handler(NULL), m_vartab(NULL)
 {
 	/* nothing to do */
 }
@@ -91,19 +91,46 @@ bool compute_module::compute( handler_interface *handler, var_table *data )
 		log("no variables defined for computation engine", SSC_ERROR);
 		return false;
 	}
+
+	load_requested_outputs();
+	bool ok = true;
 	
 	try { // catch any 'general_error' that can be thrown during precheck, exec, and postcheck
 
-		if (!verify("precheck input", SSC_INPUT)) return false;
-		exec();
-		if (!verify("postcheck output", SSC_OUTPUT)) return false;
+		if (!verify("precheck input", SSC_INPUT)) ok = false;
+		else
+		{
+			exec();
+			if (!verify("postcheck output", SSC_OUTPUT)) ok = false;
+		}
 
 	} catch ( general_error &e )	{
 		log( e.err_text, SSC_ERROR, e.time );
-		return false;
+		ok = false;
 	}
+
+	// outputs the caller did not ask for are dropped here
+	m_discard.clear();
+	m_requested.clear();
+	m_filterOutputs = false;
 	
-	return true;
+	return ok;
+}
+
+void compute_module::load_requested_outputs()
+{
+	m_discard.clear();
+	m_requested.clear();
+	m_filterOutputs = false;
+
+	var_data *req = m_vartab->lookup( SSC_REQUESTED_OUTPUTS );
+	if (!req || req->type != SSC_STRING || req->str.empty()) return;
+
+	std::vector<std::string> names = util::split( req->str, " ,;\t\n" );
+	for (size_t i=0;i<names.size();i++)
+		m_requested[ util::lower_case( names[i] ) ] = true;
+
+	m_filterOutputs = !m_requested.empty();
 }
 
 bool compute_module::verify(const std::string &phase, int check_var_type) throw( general_error )
@@ -112,6 +139,9 @@ bool compute_module::verify(const std::string &phase, int check_var_type) throw(
 	for (it=m_varlist.begin();it!=m_varlist.end();++it)
 	{
 		var_info *vi = *it;
+		if ( is_filtered_output( vi ) )
+			continue;
+
 		if ( vi->var_type == check_var_type
 			|| vi->var_type == SSC_INOUT )
 		{
@@ -269,19 +299,69 @@ bool compute_module::is_ssc_array_output( const std::string &name ) throw( gener
 	return false;
 }
 
+bool compute_module::is_output_requested( const std::string &name ) throw( general_error )
+{
+	if (!m_filterOutputs) return true;
+
+	var_info *vi = NULL;
+	if (m_infomap != NULL)
+	{
+		unordered_map<std::string, var_info*>::iterator pos = m_infomap->find(name);
+		if (pos != m_infomap->end())
+			vi = pos->second;
+	}
+	if (!vi)
+	{
+		std::string lcname( util::lower_case(name) );
+		std::vector< var_info* >::iterator it;
+		for (it = m_varlist.begin(); it != m_varlist.end() && !vi; ++it)
+			if ( util::lower_case((*it)->name) == lcname )
+				vi = *it;
+	}
+
+	return !vi || !is_filtered_output( vi );
+}
+
+bool compute_module::is_filtered_output( const var_info *vi )
+{
+	// only array and matrix outputs are filtered; everything else is always computed
+	if (!m_filterOutputs || vi->var_type != SSC_OUTPUT
+		|| (vi->data_type != SSC_ARRAY && vi->data_type != SSC_MATRIX))
+		return false;
+
+	return m_requested.find( util::lower_case(vi->name) ) == m_requested.end();
+}
 
 var_data *compute_module::lookup( const std::string &name ) throw( general_error )
 {
 	if (!m_vartab) throw general_error("invalid data container object reference");
-	return m_vartab->lookup(name);
+	var_data *v = m_vartab->lookup(name);
+	if (!v && m_filterOutputs) v = m_discard.lookup(name);
+	return v;
 }
 
 var_data *compute_module::assign( const std::string &name, const var_data &value ) throw( general_error )
 {
 	if (!m_vartab) throw general_error("invalid data container object reference");
+	if (!is_output_requested(name))
+	{
+		m_vartab->unassign( name );
+		return m_discard.assign( name, value );
+	}
 	return m_vartab->assign( name, value );
 }
 
+var_data *compute_module::assign( const std::string &name, var_data &&value ) throw( general_error )
+{
+	if (!m_vartab) throw general_error("invalid data container object reference");
+	if (!is_output_requested(name))
+	{
+		m_vartab->unassign( name );
+		return m_discard.assign( name, std::move(value) );
+	}
+	return m_vartab->assign( name, std::move(value) );
+}
+
 ssc_number_t *compute_module::allocate( const std::string &name, size_t length ) throw( general_error )
 {
 	var_data *v = assign(name, var_data());
@@ -298,6 +378,16 @@ ssc_number_t *compute_module::allocate( const std::string &name, size_t nrows, s
 	return v->num.data();
 }
 
+ssc_number_t *compute_module::allocate_if_requested( const std::string &name, size_t length ) throw( general_error )
+{
+	if (!is_output_requested(name))
+	{
+		m_vartab->unassign( name );
+		return NULL;
+	}
+	return allocate( name, length );
+}
+
 util::matrix_t<ssc_number_t>& compute_module::allocate_matrix( const std::string &name, size_t nrows, size_t ncols ) throw( general_error )
 {
 	var_data *v = assign(name, var_data());
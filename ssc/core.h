@@ -140,6 +140,9 @@ struct var_info
 
 extern const var_info var_info_invalid;
 
+// string variable in a data container listing the outputs a caller wants (see ssc_data_set_requested_outputs)
+#define SSC_REQUESTED_OUTPUTS "ssc_requested_outputs"
+
 class handler_interface; // forward decl
 
 class compute_module
@@ -255,11 +258,14 @@ public:
 	/* for working with input/output/inout variables during 'compute'*/
 	const var_info &info( const std::string &name ) throw( general_error );
 	bool is_ssc_array_output( const std::string &name ) throw( general_error );
+	bool is_output_requested( const std::string &name ) throw( general_error );
 	var_data *lookup( const std::string &name ) throw( general_error );
 	var_data *assign( const std::string &name, const var_data &value ) throw( general_error );
+	var_data *assign( const std::string &name, var_data &&value ) throw( general_error );
 	ssc_number_t *allocate( const std::string &name, size_t length ) throw( general_error );
 	ssc_number_t *allocate( const std::string &name, size_t nrows, size_t ncols ) throw( general_error );
 	util::matrix_t<ssc_number_t>& allocate_matrix( const std::string &name, size_t nrows, size_t ncols ) throw( general_error );
+	ssc_number_t *allocate_if_requested( const std::string &name, size_t length ) throw( general_error );
 	var_data &value( const std::string &name ) throw( general_error );
 	bool is_assigned( const std::string &name ) throw( general_error );
 	size_t as_unsigned_long(const std::string &name) throw(general_error);
@@ -295,6 +301,8 @@ private:
 	bool verify(const std::string &phase, int var_types) throw( general_error );
 	
 	bool check_required( const std::string &name ) throw( general_error );
+	void load_requested_outputs();
+	bool is_filtered_output( const var_info *vi );
 	bool check_constraints( const std::string &name, std::string &fail_text ) throw( general_error );
 
 	// helper functions for check_required
@@ -307,6 +315,13 @@ private:
 	
 	unordered_map< std::string, var_info* > *m_infomap;
 
+	/* output selection: when the data container lists requested outputs, array and
+	   matrix outputs not on the list are kept in m_discard for the duration of 'compute'
+	   so the module can still read them back, and are never returned to the caller */
+	bool m_filterOutputs;
+	unordered_map< std::string, bool > m_requested;
+	var_table m_discard;
+
 	/* these members are take values only during a call to 'compute(..)'
 	  and are NULL otherwise */
 	handler_interface   *m_handler;
@@ -49,6 +49,7 @@
 
 #include "csp_common.h"
 #include "core.h"
+#include "sscapi.h"
 #include "lib_weatherfile.h"
 #include "lib_util.h"
 #include <sstream>
@@ -57,6 +58,7 @@
 
 // solarpilot header files
 #include "AutoPilot_API.h"
+#include "API_cache.h"
 #include "SolarField.h"
 #include "IOUtil.h"
 
@@ -85,7 +87,7 @@ solarpilot_invoke::~solarpilot_invoke()
         delete m_sapi;
 }
 
-AutoPilot_S *solarpilot_invoke::GetSAPI()
+AutoPilot *solarpilot_invoke::GetSAPI()
 {
     return m_sapi;
 }
@@ -96,11 +98,26 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
     
     */
     if(m_sapi != 0)
+    {
         delete m_sapi;
-
-    m_sapi = new AutoPilot_S();
+        m_sapi = 0;
+    }
 
 	// read inputs from SSC module
+	int n_threads = 1;
+	if( m_cmod->is_assigned("sp_n_threads") )
+		n_threads = m_cmod->as_integer("sp_n_threads");
+
+	// simulate sun positions on separate threads when more than one thread is requested
+	if( n_threads != 1 )
+	{
+		AutoPilot_MT *sapi_mt = new AutoPilot_MT();
+		sapi_mt->SetMaxThreadCount( n_threads );
+		m_sapi = sapi_mt;
+	}
+	else
+		m_sapi = new AutoPilot_S();
+	m_sapi->SetSimulationThreads( n_threads );
 		
     //fin.is_pmt_factors.val = true;
     //testing <<<
@@ -242,12 +259,14 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
     amb.atm_coefs.val.at(2,2) = m_cmod->as_double("c_atm_2");
     amb.atm_coefs.val.at(2,3) = m_cmod->as_double("c_atm_3");
 
-    if(! m_cmod->is_assigned("helio_positions_in") ) 
+    bool is_layout = ! m_cmod->is_assigned("helio_positions_in");
+
+    vector<string> wfdata;
+    if( is_layout ) 
     {
 
 	    weather_record wf;
 
-	    vector<string> wfdata;
 	    wfdata.reserve( 8760 );
 	    char buf[1024];
 	    for( int i=0;i<8760;i++ )
@@ -258,7 +277,65 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 		    mysnprintf(buf, 1023, "%d,%d,%d,%.2lf,%.1lf,%.1lf,%.1lf", wf.day, wf.hour, wf.month, wf.dn, wf.tdry, wf.pres/1000., wf.wspd);
 		    wfdata.push_back( std::string(buf) );
 	    }
+    }
+    else
+    {
+        /* 
+		Load in the heliostat field positions that are provided by the user.
+		*/
+		//layout.heliostat_positions.clear();
+		//layout.heliostat_positions.resize(m_N_hel);
+		string format = "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;";
+        sf.layout_data.val.clear();
+
+        util::matrix_t<double> hpos = m_cmod->as_matrix("helio_positions_in");
 
+        char row[200];
+		for( size_t i=0; i<hpos.nrows(); i++)
+		{
+            sprintf(row, format.c_str(), hpos.at(i,0), hpos.at(i,1),  0. );
+
+            sf.layout_data.val.append( row );
+		}
+    }
+
+    //check for results saved by an earlier run with the same inputs. Optimization runs always simulate, since the 
+    //cache does not hold the optimization history that is reported with their results.
+    sp_field_cache cache;
+    if( m_cmod->is_assigned("sp_cache_dir") )
+    {
+        if( isopt )
+            m_cmod->log( "SolarPILOT results are not cached for optimization runs", SSC_NOTICE );
+        else
+            cache.SetDirectory( m_cmod->as_string("sp_cache_dir") );
+    }
+
+    if( cache.IsEnabled() )
+    {
+        cache.StartKey( *this );
+        cache.AddToKey( "ssc " + util::to_string(ssc_version()) );
+
+        //inputs that are not part of the variable map
+        const char *keyvars[] = {"calc_fluxmaps", "n_flux_days", "delta_flux_hrs", "n_flux_x", "n_flux_y", "check_max_flux"};
+        for( int i=0; i<6; i++ )
+            cache.AddToKey( string(keyvars[i]) + "=" + (m_cmod->is_assigned(keyvars[i]) ? util::to_string(m_cmod->as_double(keyvars[i]), "%.17g") : "") );
+        for( size_t i=0; i<wfdata.size(); i++ )
+            cache.AddToKey( wfdata[i] );
+
+        vector<double> cache_values;
+        if( cache.Load( *this, layout, fluxtab, cache_values ) )
+        {
+            m_cmod->log( "Loaded SolarPILOT results from cache: " + cache.GetFilePath(), SSC_NOTICE );
+            if( m_cmod->as_boolean("check_max_flux") && cache_values.size() > 0 )
+                m_cmod->assign("flux_max_observed", (ssc_number_t)cache_values.front());
+            return true;
+        }
+        
+        m_cmod->log( "No cached SolarPILOT results found, running simulation: " + cache.GetFilePath(), SSC_NOTICE );
+    }
+
+    if( is_layout ) 
+    {
 	    m_sapi->SetDetailCallback( ssc_cmod_solarpilot_callback, m_cmod);
 	    m_sapi->SetSummaryCallbackStatus(false);
 
@@ -309,24 +386,6 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
     }
     else
     {
-        /* 
-		Load in the heliostat field positions that are provided by the user.
-		*/
-		//layout.heliostat_positions.clear();
-		//layout.heliostat_positions.resize(m_N_hel);
-		string format = "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;";
-        sf.layout_data.val.clear();
-
-        util::matrix_t<double> hpos = m_cmod->as_matrix("helio_positions_in");
-
-        char row[200];
-		for( size_t i=0; i<hpos.nrows(); i++)
-		{
-            sprintf(row, format.c_str(), hpos.at(i,0), hpos.at(i,1),  0. );
-
-            sf.layout_data.val.append( row );
-		}
-
 		m_sapi->Setup(*this);
     }
     
@@ -369,6 +428,7 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 	}
 
     //check if max flux check is desired
+    double flux_max_observed = 0.;
     if( m_cmod->as_boolean("check_max_flux") )
     {
         m_sapi->SetDetailCallbackStatus(false);
@@ -392,8 +452,6 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
         
 		block_t<double> *flux_data = &flux_temp.flux_surfaces.front().flux_data;  //there should be only one flux stack for SAM
         
-        double flux_max_observed = 0.;
-
         for(size_t i=0; i<flux_data->nrows(); i++)
         {
             for(size_t j=0; j<flux_data->ncols(); j++)
@@ -405,6 +463,13 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 
 		m_cmod->assign("flux_max_observed", (ssc_number_t)flux_max_observed);
     }
+
+    if( cache.IsEnabled() )
+    {
+        vector<double> cache_values(1, flux_max_observed);
+        if(! cache.Store( *this, layout, fluxtab, cache_values ) )
+            m_cmod->log( "Could not save SolarPILOT results to cache: " + cache.GetFilePath(), SSC_WARNING );
+    }
         
     return true;
 }
@@ -594,6 +659,7 @@ var_info vtab_sco2_design[] = {
 	{ SSC_INPUT,  SSC_NUMBER,  "des_objective",        "[2] = hit min phx deltat then max eta, [else] max eta",  "",           "",    "",      "?=0",   "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "min_phx_deltaT",       "Minimum design temperature difference across PHX",       "C",          "",    "",      "?=0",   "",       "" },	
 	{ SSC_INPUT,  SSC_NUMBER,  "rel_tol",              "Baseline solver and optimization relative tolerance exponent (10^-rel_tol)", "-", "", "", "?=3","",       "" },	
+	{ SSC_INPUT,  SSC_NUMBER,  "is_co2_prop_table",    "1 = Tabulated CO2 properties, 0 = FIT routines (default)", "",        "",    "",      "?=0",   "",       "" },
 		// Cycle Design
 	{ SSC_INPUT,  SSC_NUMBER,  "eta_isen_mc",          "Design main compressor isentropic efficiency",           "-",          "",    "",      "*",     "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "eta_isen_rc",          "Design re-compressor isentropic efficiency",             "-",          "",    "",      "*",     "",       "" },
@@ -1402,3 +1468,47 @@ int sco2_design_cmod_common(compute_module *cm, C_sco2_recomp_csp & c_sco2_cycle
 
 	return 0;
 }
+
+var_info vtab_csp_solver_counters[] = {
+
+	/*   VARTYPE   DATATYPE         NAME                     LABEL                                                    UNITS     META  GROUP REQUIRED_IF CONSTRAINTS     UI_HINTS*/
+	{ SSC_INPUT,  SSC_NUMBER,  "is_mono_eq_memo",        "Start operating mode iterations from the previous solution of the same mode? 1 = yes, 0 = no", "-", "", "sys_ctrl", "?=0", "", "" },
+	{ SSC_INPUT,  SSC_NUMBER,  "is_csp_instrumentation", "Record wall time and call counts of operating modes and component calls? 1 = yes, 0 = no", "-", "", "sys_ctrl", "?=0", "", "" },
+
+	{ SSC_OUTPUT, SSC_MATRIX,  "mono_eq_counters",       "Operating mode iteration counters: op mode, equation, solves, equation calls, seeded solves, seeded solves repeated, solve time [s]", "", "", "Solver", "*", "", "COL_LABEL=MONO_EQ_COUNTERS,ROW_LABEL=NO_ROW_LABEL" },
+	{ SSC_OUTPUT, SSC_NUMBER,  "instr_sim_time",         "Wall time of the CSP solver timestep loop",              "s",      "",   "Solver", "is_csp_instrumentation=1", "", "" },
+	{ SSC_OUTPUT, SSC_MATRIX,  "instr_op_modes",         "Operating modes: op mode, tries, wall time [s], component calls, tries by component calls per try (0, 1, 2, 3-4, ..., 65-128, >128)", "", "", "Solver", "is_csp_instrumentation=1", "", "COL_LABEL=INSTR_OP_MODES,ROW_LABEL=NO_ROW_LABEL" },
+	{ SSC_OUTPUT, SSC_MATRIX,  "instr_component_calls",  "Component calls (rows: CR off, startup, on, PC call, TES discharge, discharge full, charge, charge full, idle): calls, wall time [s]", "", "", "Solver", "is_csp_instrumentation=1", "", "COL_LABEL=INSTR_COMPONENT_CALLS,ROW_LABEL=NO_ROW_LABEL" },
+
+	var_info_invalid };
+
+static void assign_matrix(compute_module *cm, const std::string & name, util::matrix_t<double> & mat)
+{
+	ssc_number_t *p_mat = cm->allocate(name, mat.nrows(), mat.ncols());
+	for( size_t i = 0; i < mat.ncells(); i++ )
+		p_mat[i] = (ssc_number_t)mat.data()[i];
+}
+
+void csp_solver_counters_setup(compute_module *cm, C_csp_solver & csp_solver)
+{
+	csp_solver.m_is_mono_eq_memo = cm->as_boolean("is_mono_eq_memo");
+	csp_solver.mc_instrumentation.m_is_on = cm->as_boolean("is_csp_instrumentation");
+}
+
+void csp_solver_counters_outputs(compute_module *cm, C_csp_solver & csp_solver)
+{
+	util::matrix_t<double> mono_eq_counters;
+	csp_solver.get_mono_eq_counters(mono_eq_counters);
+	assign_matrix(cm, "mono_eq_counters", mono_eq_counters);
+
+	if( csp_solver.mc_instrumentation.m_is_on )
+	{
+		cm->assign("instr_sim_time", (ssc_number_t)csp_solver.mc_instrumentation.m_time_sim);
+
+		util::matrix_t<double> op_modes, component_calls;
+		csp_solver.mc_instrumentation.get_op_mode_table(op_modes);
+		assign_matrix(cm, "instr_op_modes", op_modes);
+		csp_solver.mc_instrumentation.get_component_call_table(component_calls);
+		assign_matrix(cm, "instr_component_calls", component_calls);
+	}
+}
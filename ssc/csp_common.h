@@ -56,11 +56,12 @@
 #include "lib_weatherfile.h"
 
 #include "sco2_pc_csp_int.h"
+#include "csp_solver_core.h"
 
 class solarpilot_invoke : public var_map
 {
     compute_module *m_cmod;
-    AutoPilot_S *m_sapi;
+    AutoPilot *m_sapi;
 	std::vector<std::vector<double> > _optimization_sim_points;
 	std::vector<double>
 		_optimization_objectives,
@@ -82,7 +83,7 @@ public:
 
     solarpilot_invoke( compute_module *cm );
     ~solarpilot_invoke();
-    AutoPilot_S *GetSAPI();
+    AutoPilot *GetSAPI();
     bool run(std::shared_ptr<weather_data_provider> wdata = nullptr);
     bool postsim_calcs( compute_module *cm );
 };
@@ -93,6 +94,14 @@ extern var_info vtab_sco2_design[];
 
 int sco2_design_cmod_common(compute_module *cm, C_sco2_recomp_csp & c_sco2_cycle);
 
+extern var_info vtab_csp_solver_counters[];
+
+// Applies the 'vtab_csp_solver_counters' inputs to the CSP solver before Ssimulate
+void csp_solver_counters_setup(compute_module *cm, C_csp_solver & csp_solver);
+
+// Assigns the 'vtab_csp_solver_counters' outputs after Ssimulate
+void csp_solver_counters_outputs(compute_module *cm, C_csp_solver & csp_solver);
+
 
 
 
@@ -50,6 +50,9 @@
 #include <stdio.h>
 #include <cstring>
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "core.h"
 #include "sscapi.h"
@@ -116,6 +119,7 @@ extern module_entry_info
 	cm_entry_snowmodel,
 	cm_entry_generic_system,
 	cm_entry_wfcsvconv,
+	cm_entry_wfcache,
 	cm_entry_tcstrough_empirical,
 	cm_entry_tcstrough_physical,
     cm_entry_trough_physical,
@@ -202,6 +206,7 @@ static module_entry_info *module_table[] = {
 	&cm_entry_snowmodel,
 	&cm_entry_generic_system,
 	&cm_entry_wfcsvconv,
+	&cm_entry_wfcache,
 	&cm_entry_tcstrough_empirical,
 	&cm_entry_tcstrough_physical,
     &cm_entry_trough_physical,
@@ -365,6 +370,14 @@ SSCEXPORT void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data
 	dat->table = *value;  // invokes operator= for deep copy
 }
 
+SSCEXPORT void ssc_data_set_requested_outputs( ssc_data_t p_data, const char *names )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt) return;
+	if (!names || !*names) vt->unassign( SSC_REQUESTED_OUTPUTS );
+	else vt->assign( SSC_REQUESTED_OUTPUTS, var_data( std::string(names) ) );
+}
+
 SSCEXPORT const char *ssc_data_get_string( ssc_data_t p_data, const char *name )
 {
 	var_table *vt = static_cast<var_table*>(p_data);
@@ -415,6 +428,54 @@ SSCEXPORT ssc_data_t ssc_data_get_table( ssc_data_t p_data, const char *name )
 	return static_cast<ssc_data_t>( &(dat->table) );
 }
 
+SSCEXPORT void ssc_data_set_array_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int length )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || !pvalues || length < 1) return;
+	var_data *dat = vt->assign( name, var_data() );
+	dat->type = SSC_ARRAY;
+	dat->num.assign_ref( pvalues, 1, (size_t)length );
+}
+
+SSCEXPORT void ssc_data_set_matrix_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int nrows, int ncols )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || !pvalues || nrows < 1 || ncols < 1) return;
+	var_data *dat = vt->assign( name, var_data() );
+	dat->type = SSC_MATRIX;
+	dat->num.assign_ref( pvalues, (size_t)nrows, (size_t)ncols );
+}
+
+SSCEXPORT ssc_number_t *ssc_data_take_array( ssc_data_t p_data, const char *name, int *length )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt) return 0;
+	var_data *dat = vt->lookup(name);
+	if (!dat || dat->type != SSC_ARRAY) return 0;
+	if (length) *length = (int) dat->num.length();
+	ssc_number_t *p = dat->num.release();
+	vt->unassign( name );
+	return p;
+}
+
+SSCEXPORT ssc_number_t *ssc_data_take_matrix( ssc_data_t p_data, const char *name, int *nrows, int *ncols )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt) return 0;
+	var_data *dat = vt->lookup(name);
+	if (!dat || dat->type != SSC_MATRIX) return 0;
+	if (nrows) *nrows = (int) dat->num.nrows();
+	if (ncols) *ncols = (int) dat->num.ncols();
+	ssc_number_t *p = dat->num.release();
+	vt->unassign( name );
+	return p;
+}
+
+SSCEXPORT void ssc_data_free_array( ssc_number_t *pvalues )
+{
+	if (pvalues) delete [] pvalues;
+}
+
 SSCEXPORT ssc_entry_t ssc_module_entry( int index )
 {
 	int max=0;
@@ -695,6 +756,228 @@ SSCEXPORT const char *ssc_module_log( ssc_module_t p_mod, int index, int *item_t
 	return l->text.c_str();
 }
 
+/*************************** batch execution ***************************/
+
+class ssc_batch
+{
+public:
+	struct batch_case
+	{
+		batch_case() : cm(0), data(0), status(SSC_BATCH_PENDING), percent(0.0f) { }
+		compute_module *cm;
+		var_table *data;
+		int status;
+		float percent;
+	};
+
+	ssc_batch() : running(false), cancelled(false), next_case(0), ncomplete(0) { }
+	~ssc_batch()
+	{
+		for (size_t i = 0; i < cases.size(); i++)
+			if (cases[i].cm) delete cases[i].cm;
+	}
+
+	std::vector<batch_case> cases;
+	std::atomic<bool> running;
+	std::atomic<bool> cancelled;
+	std::atomic<size_t> next_case;
+	size_t ncomplete;
+
+	std::mutex status_lock;	// guards case status, percent and ncomplete
+	std::mutex progress_lock;	// serializes calls to the progress callback
+
+	ssc_bool_t (*pf_progress)( ssc_batch_t, int, int, float, void * );
+	void *pf_user_data;
+
+	float progress()
+	{
+		std::lock_guard<std::mutex> lock(status_lock);
+		return progress_nolock();
+	}
+
+	float progress_nolock()
+	{
+		if (cases.size() == 0) return 100.0f;
+		double sum = 0;
+		for (size_t i = 0; i < cases.size(); i++)
+			sum += (cases[i].status == SSC_BATCH_PENDING || cases[i].status == SSC_BATCH_RUNNING) ? cases[i].percent : 100.0f;
+		return (float)(sum / cases.size());
+	}
+
+	void set_status(size_t index, int status)
+	{
+		std::lock_guard<std::mutex> lock(status_lock);
+		cases[index].status = status;
+		if (status != SSC_BATCH_RUNNING) ncomplete++;
+	}
+
+	void worker();
+};
+
+class batch_exec_handler : public handler_interface
+{
+private:
+	ssc_batch *m_batch;
+	size_t m_index;
+
+public:
+	batch_exec_handler( compute_module *cm, ssc_batch *batch, size_t index )
+		: handler_interface(cm), m_batch(batch), m_index(index)
+	{
+	}
+
+	virtual void on_log( const std::string &, int, float )
+	{
+		// messages are kept in the compute module log and retrieved with ssc_batch_log
+	}
+
+	virtual bool on_update( const std::string &, float percent, float )
+	{
+		std::lock_guard<std::mutex> lock(m_batch->status_lock);
+		m_batch->cases[m_index].percent = percent;
+		return !m_batch->cancelled;
+	}
+};
+
+void ssc_batch::worker()
+{
+	// cases are handed out one at a time from a shared counter, so fast and slow cases balance across threads
+	size_t i;
+	while ((i = next_case++) < cases.size())
+	{
+		if (cancelled)
+		{
+			set_status(i, SSC_BATCH_CANCELLED);
+			continue;
+		}
+
+		set_status(i, SSC_BATCH_RUNNING);
+
+		batch_exec_handler h(cases[i].cm, this, i);
+		bool ok = cases[i].cm->compute(&h, cases[i].data);
+		set_status(i, ok ? SSC_BATCH_SUCCESS : (cancelled ? SSC_BATCH_CANCELLED : SSC_BATCH_FAILED));
+
+		if (pf_progress)
+		{
+			std::lock_guard<std::mutex> lock(progress_lock);
+			int n;
+			float percent;
+			{
+				std::lock_guard<std::mutex> slock(status_lock);
+				n = (int)ncomplete;
+				percent = progress_nolock();
+			}
+			if (!(*pf_progress)(static_cast<ssc_batch_t>(this), n, (int)cases.size(), percent, pf_user_data))
+				cancelled = true;
+		}
+	}
+}
+
+SSCEXPORT ssc_batch_t ssc_batch_create()
+{
+	return static_cast<ssc_batch_t>( new ssc_batch );
+}
+
+SSCEXPORT void ssc_batch_free( ssc_batch_t p_batch )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	if (b) delete b;
+}
+
+SSCEXPORT int ssc_batch_add( ssc_batch_t p_batch, const char *name, ssc_data_t p_data )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	if (!b || b->running || !p_data) return -1;
+
+	compute_module *cm = static_cast<compute_module*>( ssc_module_create( name ) );
+	if (!cm) return -1;
+
+	ssc_batch::batch_case c;
+	c.cm = cm;
+	c.data = static_cast<var_table*>(p_data);
+	b->cases.push_back(c);
+	return (int)b->cases.size() - 1;
+}
+
+SSCEXPORT int ssc_batch_count( ssc_batch_t p_batch )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	return b ? (int)b->cases.size() : 0;
+}
+
+SSCEXPORT int ssc_batch_run( ssc_batch_t p_batch, int nthreads,
+	ssc_bool_t (*pf_progress)( ssc_batch_t, int, int, float, void * ),
+	void *pf_user_data )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	if (!b || b->running) return 0;
+
+	b->running = true;
+	b->cancelled = false;
+	b->next_case = 0;
+	b->ncomplete = 0;
+	b->pf_progress = pf_progress;
+	b->pf_user_data = pf_user_data;
+	for (size_t i = 0; i < b->cases.size(); i++)
+	{
+		b->cases[i].status = SSC_BATCH_PENDING;
+		b->cases[i].percent = 0.0f;
+		b->cases[i].cm->clear_log();
+	}
+
+	size_t n = nthreads > 0 ? (size_t)nthreads : (size_t)std::thread::hardware_concurrency();
+	if (n < 1) n = 1;
+	if (n > b->cases.size()) n = b->cases.size();
+
+	if (n <= 1)
+		b->worker();
+	else
+	{
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < n; i++)
+			threads.push_back(std::thread(&ssc_batch::worker, b));
+		for (size_t i = 0; i < threads.size(); i++)
+			threads[i].join();
+	}
+
+	b->running = false;
+
+	int nok = 0;
+	for (size_t i = 0; i < b->cases.size(); i++)
+		if (b->cases[i].status == SSC_BATCH_SUCCESS) nok++;
+	return nok;
+}
+
+SSCEXPORT void ssc_batch_cancel( ssc_batch_t p_batch )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	if (b) b->cancelled = true;
+}
+
+SSCEXPORT int ssc_batch_status( ssc_batch_t p_batch, int index )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	if (!b || index < 0 || index >= (int)b->cases.size()) return -1;
+
+	std::lock_guard<std::mutex> lock(b->status_lock);
+	return b->cases[index].status;
+}
+
+SSCEXPORT float ssc_batch_progress( ssc_batch_t p_batch )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	return b ? b->progress() : 0.0f;
+}
+
+SSCEXPORT const char *ssc_batch_log( ssc_batch_t p_batch, int case_index, int index, int *item_type, float *time )
+{
+	ssc_batch *b = static_cast<ssc_batch*>(p_batch);
+	if (!b || case_index < 0 || case_index >= (int)b->cases.size()) return 0;
+	if (ssc_batch_status(p_batch, case_index) == SSC_BATCH_RUNNING) return 0;
+
+	return ssc_module_log( static_cast<ssc_module_t>(b->cases[case_index].cm), index, item_type, time );
+}
+
 SSCEXPORT void __ssc_segfault()
 {
 	std::string *pstr = 0;
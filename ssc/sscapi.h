@@ -164,6 +164,9 @@ SSCEXPORT void ssc_data_set_matrix( ssc_data_t p_data, const char *name, ssc_num
 
 /** Assigns value of type @a SSC_TABLE. */
 SSCEXPORT void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data_t table );
+
+/** Restricts the array and matrix outputs that compute modules store in this data container to the listed names, separated by commas or spaces. Unlisted array and matrix outputs are neither returned nor, where a module supports it, computed; number and string outputs are always returned. Pass 0 (NULL) or an empty string to request all outputs again. The list is kept in the @a SSC_STRING variable "ssc_requested_outputs". */
+SSCEXPORT void ssc_data_set_requested_outputs( ssc_data_t p_data, const char *names );
 /**@}*/ 
 
 /** @name Retrieving variable values.
@@ -186,6 +189,30 @@ SSCEXPORT ssc_number_t *ssc_data_get_matrix( ssc_data_t p_data, const char *name
 SSCEXPORT ssc_data_t ssc_data_get_table( ssc_data_t p_data, const char *name );
 /**@}*/ 
 
+/** @name Transferring arrays without copying.
+The ssc_data_set_array( ) and ssc_data_set_matrix( ) functions copy the caller's values into the data container.
+For long time series the following functions avoid that copy.  A referenced buffer is used in place:  it is never
+freed by SSC, must remain valid until the variable is reassigned or unassigned or the data container is freed, and
+may be modified by compute modules that declare the variable as @a SSC_INOUT.  A taken array is removed from the data
+container and belongs to the caller, who must release it with ssc_data_free_array( ).
+*/
+/**@{*/
+/** Assigns value of type @a SSC_ARRAY that references the caller's buffer instead of copying it. */
+SSCEXPORT void ssc_data_set_array_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int length );
+
+/** Assigns value of type @a SSC_MATRIX that references the caller's buffer (row-major order) instead of copying it. */
+SSCEXPORT void ssc_data_set_matrix_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int nrows, int ncols );
+
+/** Removes a @a SSC_ARRAY variable from the data container and returns its values without copying them. Returns 0 (NULL) if the variable does not exist or is not an array. The result must be released with ssc_data_free_array( ). */
+SSCEXPORT ssc_number_t *ssc_data_take_array( ssc_data_t p_data, const char *name, int *length );
+
+/** Removes a @a SSC_MATRIX variable from the data container and returns its values without copying them. Returns 0 (NULL) if the variable does not exist or is not a matrix. The result must be released with ssc_data_free_array( ). */
+SSCEXPORT ssc_number_t *ssc_data_take_matrix( ssc_data_t p_data, const char *name, int *nrows, int *ncols );
+
+/** Frees an array returned by ssc_data_take_array( ) or ssc_data_take_matrix( ). */
+SSCEXPORT void ssc_data_free_array( ssc_number_t *pvalues );
+/**@}*/ 
+
 /** The opaque data structure that stores information about a compute module. */
 typedef void* ssc_entry_t;
 
@@ -324,6 +351,62 @@ SSCEXPORT ssc_bool_t ssc_module_exec_with_handler(
 /** Retrive notices, warnings, and error messages from the simulation. Returns a NULL-terminated ASCII C string with the message text, or NULL if the index passed in was invalid. */
 SSCEXPORT const char *ssc_module_log( ssc_module_t p_mod, int index, int *item_type, float *time );
 
+/** @name Batch execution:
+  * A batch holds any number of independent cases, each a compute module name and a data set, and runs them concurrently on a pool of worker threads. Each case gets its own compute module instance, so its notices, warnings, and errors can be retrieved with ssc_batch_log after the run. The data sets are not copied: they must stay valid until ssc_batch_run returns, and the same data set must not be added twice. Example:
+
+	\verbatim
+	ssc_batch_t p_batch = ssc_batch_create();
+	for( i=0; i<ncases; i++ )
+		ssc_batch_add( p_batch, "pvwattsv5", p_data[i] );
+
+	int nok = ssc_batch_run( p_batch, 0, NULL, NULL );  // 0 threads: use all hardware threads
+	for( i=0; i<ncases; i++ )
+		if ( ssc_batch_status( p_batch, i ) != SSC_BATCH_SUCCESS )
+			printf("case %d failed: %s\n", i, ssc_batch_log( p_batch, i, 0, NULL, NULL ) );
+
+	ssc_batch_free( p_batch );
+	\endverbatim
+*/
+/**@{*/
+/** An opaque reference to a batch of simulation cases. */
+typedef void* ssc_batch_t;
+
+#define SSC_BATCH_PENDING 0
+#define SSC_BATCH_RUNNING 1
+#define SSC_BATCH_SUCCESS 2
+#define SSC_BATCH_FAILED 3
+#define SSC_BATCH_CANCELLED 4
+
+/** Creates a new, empty batch. */
+SSCEXPORT ssc_batch_t ssc_batch_create();
+
+/** Frees a batch and the compute modules created for its cases. The data sets added to the batch are not freed. */
+SSCEXPORT void ssc_batch_free( ssc_batch_t p_batch );
+
+/** Adds a case that runs the named compute module over p_data. Returns the index of the case, or -1 if the module name is invalid or the batch is running. */
+SSCEXPORT int ssc_batch_add( ssc_batch_t p_batch, const char *name, ssc_data_t p_data );
+
+/** Returns the number of cases in a batch. */
+SSCEXPORT int ssc_batch_count( ssc_batch_t p_batch );
+
+/** Runs all cases on nthreads worker threads (nthreads <= 0 uses the number of hardware threads) and blocks until they finish. The optional pf_progress callback is called after each case completes with the number of finished cases and the overall percent done; it is never called concurrently, and returning 0 cancels the batch. Returns the number of cases that succeeded. */
+SSCEXPORT int ssc_batch_run( ssc_batch_t p_batch, int nthreads,
+	ssc_bool_t (*pf_progress)( ssc_batch_t, int ncomplete, int ntotal, float percent, void *user_data ),
+	void *pf_user_data );
+
+/** Requests cancellation of a running batch. Cases not yet started are marked SSC_BATCH_CANCELLED, and running cases are asked to abort at their next progress update. Safe to call from any thread. */
+SSCEXPORT void ssc_batch_cancel( ssc_batch_t p_batch );
+
+/** Returns the status of a case: SSC_BATCH_PENDING, SSC_BATCH_RUNNING, SSC_BATCH_SUCCESS, SSC_BATCH_FAILED, or SSC_BATCH_CANCELLED. Returns -1 for an invalid index. */
+SSCEXPORT int ssc_batch_status( ssc_batch_t p_batch, int index );
+
+/** Returns the overall percent done of a batch, aggregated over the progress updates of all cases. Safe to call from any thread while the batch is running. */
+SSCEXPORT float ssc_batch_progress( ssc_batch_t p_batch );
+
+/** Retrieve notices, warnings, and error messages logged by a case, as for ssc_module_log. Returns NULL if either index is invalid. */
+SSCEXPORT const char *ssc_batch_log( ssc_batch_t p_batch, int case_index, int index, int *item_type, float *time );
+/**@}*/
+
 /** DO NOT CALL THIS FUNCTION: immediately causes a segmentation fault within the library. This is only useful for testing crash handling from an external application that is dynamically linked to the SSC library */
 SSCEXPORT void __ssc_segfault();
 
@@ -232,6 +232,19 @@ var_data *var_table::assign( const std::string &name, const var_data &val )
 	return v;
 }
 
+var_data *var_table::assign( const std::string &name, var_data &&val )
+{
+	var_data *v = lookup(name);
+	if (!v)
+	{
+		v = new var_data;
+		m_hash[ util::lower_case(name) ] = v;
+	}
+	
+	v->move(val);
+	return v;
+}
+
 void var_table::unassign( const std::string &name )
 {
 	var_hash::iterator it = m_hash.find( util::lower_case(name) );
@@ -74,6 +74,7 @@ public:
 
 	void clear();
 	var_data *assign( const std::string &name, const var_data &value );
+	var_data *assign( const std::string &name, var_data &&value );
 	void unassign( const std::string &name );
 	bool rename( const std::string &oldname, const std::string &newname );
 	var_data *lookup( const std::string &name );
@@ -94,6 +95,7 @@ public:
 	
 	var_data() : type(SSC_INVALID) { num=0.0; }
 	var_data( const var_data &cp ) : type(cp.type), num(cp.num), str(cp.str) {  }
+	var_data( var_data &&mv ) : type(mv.type), num(std::move(mv.num)), str(std::move(mv.str)) {  }
 	var_data( const std::string &s ) : type(SSC_STRING), str(s) {  }
 	var_data( ssc_number_t n ) : type(SSC_NUMBER) { num = n; }
 	var_data(const ssc_number_t *pvalues, int length) : type(SSC_ARRAY) { num.assign(pvalues, (size_t)length); }
@@ -108,7 +110,9 @@ public:
 	static bool parse( unsigned char type, const std::string &buf, var_data &value );
 
 	var_data &operator=(const var_data &rhs) { copy(rhs); return *this; }
+	var_data &operator=(var_data &&rhs) { move(rhs); return *this; }
 	void copy( const var_data &rhs ) { type=rhs.type; num=rhs.num; str=rhs.str; table = rhs.table; }
+	void move( var_data &rhs ) { if (this != &rhs) { type=rhs.type; num=std::move(rhs.num); str=std::move(rhs.str); table = rhs.table; } }
 	
 	unsigned char type;
 	util::matrix_t<ssc_number_t> num;
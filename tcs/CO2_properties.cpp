@@ -30,10 +30,28 @@ OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMA
 ***************************************************************************************************/
 
 #include <math.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
 #include "CO2_properties.h"
 
 using namespace N_co2_props;
 
+// Tabulated CO2_TP, CO2_PH, and CO2_PS, see end of file
+namespace {
+
+#ifdef _MSC_VER
+__declspec(thread) bool s_is_table_lookup = false;
+#else
+__thread bool s_is_table_lookup = false;
+#endif
+
+enum E_co2_table { E_table_TP, E_table_PH, E_table_PS, E_n_tables };
+
+bool table_lookup(E_co2_table inputs, double P, double y, CO2_state *state);
+
+} // namespace
+
 //const double T_crit = 304.1282;
 //const double P_crit = 7377.3;
 //const double D_crit = 467.6;
@@ -44549,6 +44567,8 @@ void N_co2_props::get_prop_derivatives(
 }
 
 int CO2_TP(const double T, const double P, CO2_state *__restrict state) {
+  if (s_is_table_lookup && table_lookup(E_table_TP, P, T, state))
+    return 0;
   const int max_iter = 20;
   const double rel_tol = 1e-10;
   const double P_tol = fmax(rel_tol, P * rel_tol);
@@ -44750,6 +44770,8 @@ int CO2_TP(const double T, const double P, CO2_state *__restrict state) {
 }
 
 int CO2_PH(const double P, const double H, CO2_state *__restrict state) {
+  if (s_is_table_lookup && table_lookup(E_table_PH, P, H, state))
+    return 0;
   const int max_iter = 20;
   const double rel_tol = 1e-10;
   const double P_tol = fmax(rel_tol, P * rel_tol);
@@ -44897,6 +44919,8 @@ int CO2_PH(const double P, const double H, CO2_state *__restrict state) {
 }
 
 int CO2_PS(const double P, const double S, CO2_state *__restrict state) {
+  if (s_is_table_lookup && table_lookup(E_table_PS, P, S, state))
+    return 0;
   const int max_iter = 20;
   const double rel_tol = 1e-10;
   const double P_tol = fmax(rel_tol, P * rel_tol);
@@ -70067,3 +70091,246 @@ double CO2_cond(const double D, const double T) {
   const double px2 = cy[4] * x + cy[5];
   return px0 * x4 + px1 * x2 + px2;
 }
+
+//------------------------------------------------------------------------------------------------
+// Tabulated CO2_TP, CO2_PH, and CO2_PS
+//------------------------------------------------------------------------------------------------
+
+namespace {
+
+// State table on a uniform (P,y) grid, where y is the other independent property (T, H, or S) of one
+//   of the FIT routines. y varies fastest in memory, as it does in the cycle and heat exchanger models.
+//   Nodes store the properties that are not inputs and cannot be recovered from the others
+//   (h = u + P/D), which are interpolated with a 4x4 Catmull-Rom stencil. In cells where every stencil
+//   node is above the critical temperature, quality is a flag and the saturation densities are zero,
+//   so only the first E_n_fields_super fields are interpolated. A cell is used only if all stencil
+//   nodes are valid states and the interpolated state matches the FIT routine to within 'rel_tol'
+//   at the cell center and the centers of its low P and low y edges
+class C_co2_state_table {
+public:
+  C_co2_state_table(E_co2_table inputs, double P_low, double P_high, double dP,
+                    double y_low, double y_high, double dy)
+      : m_inputs(inputs), m_P_low(P_low), m_y_low(y_low) {
+    const double rel_tol = 1.E-5;
+
+    m_n_P = (int)ceil((P_high - P_low) / dP) + 1;
+    m_n_y = (int)ceil((y_high - y_low) / dy) + 1;
+    double delta_P = (P_high - P_low) / (m_n_P - 1);
+    double delta_y = (y_high - y_low) / (m_n_y - 1);
+    m_inv_dP = 1.0 / delta_P;
+    m_inv_dy = 1.0 / delta_y;
+
+    m_nodes.resize((size_t)m_n_P * m_n_y * E_n_fields);
+    std::vector<unsigned char> is_node_ok((size_t)m_n_P * m_n_y);
+    CO2_state state;
+    for (int i = 0; i < m_n_P; ++i) {
+      for (int j = 0; j < m_n_y; ++j) {
+        size_t k = (size_t)i * m_n_y + j;
+        is_node_ok[k] = call_fit(P_low + i * delta_P, y_low + j * delta_y, &state) == 0;
+        set_node(&state, &m_nodes[k * E_n_fields]);
+      }
+    }
+
+    // Cells are identified by their low corner node
+    m_cells.assign((size_t)m_n_P * m_n_y, E_cell_invalid);
+    const double t_check[3][2] = {{0.5, 0.5}, {0.5, 0.0}, {0.0, 0.5}};
+    CO2_state state_table;
+    for (int i = 1; i < m_n_P - 2; ++i) {
+      for (int j = 1; j < m_n_y - 2; ++j) {
+        int n_ok = 0, n_super = 0;
+        for (int si = -1; si <= 2; ++si) {
+          for (int sj = -1; sj <= 2; ++sj) {
+            size_t k = (size_t)(i + si) * m_n_y + (j + sj);
+            n_ok += is_node_ok[k];
+            n_super += m_nodes[k * E_n_fields + E_qual] >= 998.0;
+          }
+        }
+        if (n_ok < 16 || (n_super > 0 && n_super < 16))
+          continue;
+
+        unsigned char cell = n_super == 16 ? E_cell_super : E_cell_all;
+        for (int c = 0; c < 3 && cell != E_cell_invalid; ++c) {
+          double P = P_low + (i + t_check[c][0]) * delta_P;
+          double y = y_low + (j + t_check[c][1]) * delta_y;
+          if (call_fit(P, y, &state) != 0) {
+            cell = E_cell_invalid;
+            break;
+          }
+          interpolate(i, j, t_check[c][0], t_check[c][1], cell, P, y, &state_table);
+          const double *a_fit = &state.temp;
+          const double *a_table = &state_table.temp;
+          for (int f = 0; f < (int)(sizeof(CO2_state) / sizeof(double)); ++f) {
+            if (!(fabs(a_table[f] - a_fit[f]) <= rel_tol * fmax(fabs(a_fit[f]), 1.0))) {
+              cell = E_cell_invalid;
+              break;
+            }
+          }
+        }
+        m_cells[(size_t)i * m_n_y + j] = cell;
+      }
+    }
+  }
+
+  bool lookup(double P, double y, CO2_state *state) const {
+    double P_ND = (P - m_P_low) * m_inv_dP;
+    double y_ND = (y - m_y_low) * m_inv_dy;
+    if (!(P_ND >= 1.0 && P_ND < m_n_P - 2 && y_ND >= 1.0 && y_ND < m_n_y - 2))
+      return false;
+
+    int i = (int)P_ND;
+    int j = (int)y_ND;
+    unsigned char cell = m_cells[(size_t)i * m_n_y + j];
+    if (cell == E_cell_invalid)
+      return false;
+
+    interpolate(i, j, P_ND - i, y_ND - j, cell, P, y, state);
+    return true;
+  }
+
+private:
+  // E_prop_1 and E_prop_2 are (u,s) for TP, (T,s) for PH, and (T,u) for PS
+  enum {
+    E_dens, E_cv, E_cp, E_ssnd, E_prop_1, E_prop_2,
+    E_qual, E_sat_vap_dens, E_sat_liq_dens,
+
+    E_n_fields,
+    E_n_fields_super = E_qual
+  };
+  enum { E_cell_invalid, E_cell_all, E_cell_super };
+
+  E_co2_table m_inputs;
+  double m_P_low, m_inv_dP, m_y_low, m_inv_dy;
+  int m_n_P, m_n_y;
+  std::vector<double> m_nodes;        // E_n_fields per node, y varies fastest
+  std::vector<unsigned char> m_cells; // E_cell_* per cell
+
+  int call_fit(double P, double y, CO2_state *state) const {
+    switch (m_inputs) {
+    case E_table_TP:
+      return CO2_TP(y, P, state);
+    case E_table_PH:
+      return CO2_PH(P, y, state);
+    default:
+      return CO2_PS(P, y, state);
+    }
+  }
+
+  void set_node(const CO2_state *state, double *node) const {
+    node[E_dens] = state->dens;
+    node[E_cv] = state->cv;
+    node[E_cp] = state->cp;
+    node[E_ssnd] = state->ssnd;
+    node[E_prop_1] = m_inputs == E_table_TP ? state->inte : state->temp;
+    node[E_prop_2] = m_inputs == E_table_PS ? state->inte : state->entr;
+    node[E_qual] = state->qual;
+    node[E_sat_vap_dens] = state->sat_vap_dens;
+    node[E_sat_liq_dens] = state->sat_liq_dens;
+  }
+
+  static void catmull_rom(double t, double *w) {
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    w[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+    w[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+    w[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+    w[3] = 0.5 * (t3 - t2);
+  }
+
+  void interpolate(int i, int j, double tP, double ty, unsigned char cell, double P, double y,
+                   CO2_state *state) const {
+    double wP[4], wy[4];
+    catmull_rom(tP, wP);
+    catmull_rom(ty, wy);
+
+    // Along y on each of the 4 stencil rows, then along P
+    const int n_fields = cell == E_cell_super ? (int)E_n_fields_super : (int)E_n_fields;
+    double a[E_n_fields] = {0.0};
+    for (int si = 0; si < 4; ++si) {
+      const double *__restrict node = &m_nodes[((size_t)(i - 1 + si) * m_n_y + (j - 1)) * E_n_fields];
+      for (int f = 0; f < n_fields; ++f)
+        a[f] += wP[si] * (wy[0] * node[f] + wy[1] * node[E_n_fields + f] +
+                          wy[2] * node[2 * E_n_fields + f] + wy[3] * node[3 * E_n_fields + f]);
+    }
+
+    state->pres = P;
+    state->dens = a[E_dens];
+    state->cv = a[E_cv];
+    state->cp = a[E_cp];
+    state->ssnd = a[E_ssnd];
+    switch (m_inputs) {
+    case E_table_TP:
+      state->temp = y;
+      state->inte = a[E_prop_1];
+      state->entr = a[E_prop_2];
+      state->enth = state->inte + P / state->dens;
+      break;
+    case E_table_PH:
+      state->temp = a[E_prop_1];
+      state->entr = a[E_prop_2];
+      state->enth = y;
+      state->inte = y - P / state->dens;
+      break;
+    default:
+      state->temp = a[E_prop_1];
+      state->inte = a[E_prop_2];
+      state->entr = y;
+      state->enth = state->inte + P / state->dens;
+      break;
+    }
+    if (cell == E_cell_super) {
+      state->qual = P < P_crit ? 998.0 : 999.0;
+      state->sat_vap_dens = 0.0;
+      state->sat_liq_dens = 0.0;
+    } else {
+      state->qual = a[E_qual];
+      state->sat_vap_dens = a[E_sat_vap_dens];
+      state->sat_liq_dens = a[E_sat_liq_dens];
+    }
+  }
+};
+
+// Grids cover the sCO2 cycle and component models; tables are kept for the life of the process
+std::mutex s_table_mutex;
+std::atomic<const C_co2_state_table *> s_tables[E_n_tables];
+
+const C_co2_state_table *get_table(E_co2_table inputs) {
+  const C_co2_state_table *table = s_tables[inputs].load(std::memory_order_acquire);
+  if (table != 0)
+    return table;
+
+  std::lock_guard<std::mutex> lock(s_table_mutex);
+  table = s_tables[inputs].load(std::memory_order_relaxed);
+  if (table == 0) {
+    // Build from the FIT routines
+    bool is_table_lookup = s_is_table_lookup;
+    s_is_table_lookup = false;
+    switch (inputs) {
+    case E_table_TP:
+      table = new C_co2_state_table(inputs, 1000.0, 35000.0, 100.0, 270.0, 1100.0, 2.0);
+      break;
+    case E_table_PH:
+      table = new C_co2_state_table(inputs, 1000.0, 35000.0, 100.0, 150.0, 1450.0, 2.0);
+      break;
+    default:
+      table = new C_co2_state_table(inputs, 1000.0, 35000.0, 100.0, 0.75, 3.75, 0.005);
+      break;
+    }
+    s_is_table_lookup = is_table_lookup;
+    s_tables[inputs].store(table, std::memory_order_release);
+  }
+  return table;
+}
+
+bool table_lookup(E_co2_table inputs, double P, double y, CO2_state *state) {
+  return get_table(inputs)->lookup(P, y, state);
+}
+
+} // namespace
+
+void CO2_set_table_lookup(bool is_table_lookup) {
+  s_is_table_lookup = is_table_lookup;
+}
+
+bool CO2_is_table_lookup() {
+  return s_is_table_lookup;
+}
@@ -131,6 +131,14 @@ int CO2_TQ( double T, double Q, CO2_state * state );
 double CO2_visc( double D, double T);	//(uPa-s)
 double CO2_cond( double D, double T);	//(W/m-K)
 
+// Optional tabulated CO2_TP, CO2_PH, and CO2_PS for the calling thread (off by default).
+//   When enabled, states are interpolated (bicubic Catmull-Rom) from (T,P), (P,H), and (P,S) grids
+//   that are built once per process on first use and shared by all threads. Grid cells that miss the
+//   interpolation tolerance when checked against these routines at build time (near the critical point
+//   and across the saturation dome) and states outside of the grids are calculated by these routines
+void CO2_set_table_lookup( bool is_table_lookup );
+bool CO2_is_table_lookup();
+
 namespace N_co2_props
 {
 	const double T_crit = 304.1282;
@@ -181,6 +189,23 @@ namespace N_co2_props
 
 	void find_element(const double T, const double D, Element * __restrict e);
 
+	// Sets CO2_set_table_lookup for the calling thread and restores the previous setting at the end of the scope
+	class C_table_lookup_scope
+	{
+	public:
+		C_table_lookup_scope(bool is_table_lookup)
+		{
+			m_is_table_lookup_prev = CO2_is_table_lookup();
+			CO2_set_table_lookup(is_table_lookup);
+		}
+		~C_table_lookup_scope()
+		{
+			CO2_set_table_lookup(m_is_table_lookup_prev);
+		}
+	private:
+		bool m_is_table_lookup_prev;
+	};
+
 	void get_prop_derivatives(
 		const double T,
 		const double D,
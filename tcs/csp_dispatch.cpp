@@ -51,6 +51,7 @@
 #include <sstream>
 #include <stdlib.h>
 #include <algorithm>
+#include <chrono>
 #include "csp_dispatch.h"
 #include "lp_lib.h" 
 #include "lib_util.h"
@@ -118,6 +119,13 @@ csp_dispatch_opt::csp_dispatch_opt()
     price_signal.clear();
     clear_output_arrays();
     m_is_weather_setup = false;
+    m_lp_model = NULL;
+    m_lp_model_nt = 0;
+    m_lp_is_update = false;
+    m_lp_nrow = 0;
+    m_last_info_time = 0.;
+    m_forecast_col_rec = 0;
+    m_forecast_area = numeric_limits<double>::quiet_NaN();
 
     //parameters
     params.is_pb_operating0 = false;
@@ -157,10 +165,87 @@ csp_dispatch_opt::csp_dispatch_opt()
 
     outputs.presolve_nconstr = 0;
     outputs.solve_time = 0.;
+    outputs.setup_time = 0.;
+    outputs.is_model_reused = false;
+    outputs.is_warm_start = false;
     outputs.presolve_nvar = 0;
 
 }
 
+csp_dispatch_opt::~csp_dispatch_opt()
+{
+    release_lp_model();
+}
+
+void csp_dispatch_opt::release_lp_model()
+{
+    if( m_lp_model != NULL )
+        delete_lp(m_lp_model);
+    m_lp_model = NULL;
+    m_lp_model_nt = 0;
+    m_lp_rows.clear();
+    m_last_solution.clear();
+}
+
+void csp_dispatch_opt::add_constraint(lprec *lp, int count, REAL *row, int *col, int constr_type, REAL rh)
+{
+    /* 
+    The constraint structure is the same for every optimization horizon of a given length. The first time the problem
+    is assembled the rows are added as usual. Afterwards, the rows are written in the same order and only the 
+    coefficients, types, and right-hand sides that differ from the previous horizon are changed in the problem.
+    */
+
+    int r = m_lp_nrow++;
+
+    if( !m_lp_is_update )
+    {
+        if( !add_constraintex(lp, count, row, col, constr_type, rh) )
+            throw C_csp_exception("Failed to add a constraint to the CSP dispatch optimization problem.");
+
+        m_lp_rows.push_back( s_lp_row() );
+        s_lp_row &added = m_lp_rows.back();
+        added.type = constr_type;
+        added.rh = rh;
+        added.col.assign(col, col + count);
+        added.val.assign(row, row + count);
+        return;
+    }
+
+    if( r >= (int)m_lp_rows.size() )
+        throw C_csp_exception("CSP dispatch optimization problem structure changed between horizons.");
+
+    s_lp_row &current = m_lp_rows[r];
+
+    if( current.type != constr_type )
+    {
+        set_constr_type(lp, r+1, constr_type);
+        current.type = constr_type;
+    }
+
+    //remove coefficients that are no longer present
+    for(int j=0; j<(int)current.col.size(); j++)
+    {
+        if( std::find(col, col + count, current.col[j]) == col + count )
+            set_mat(lp, r+1, current.col[j], 0.);
+    }
+
+    //update coefficients that changed
+    for(int j=0; j<count; j++)
+    {
+        int k = (int)(std::find(current.col.begin(), current.col.end(), col[j]) - current.col.begin());
+        if( k == (int)current.col.size() || current.val[k] != row[j] )
+            set_mat(lp, r+1, col[j], row[j]);
+    }
+    current.col.assign(col, col + count);
+    current.val.assign(row, row + count);
+
+    if( current.rh != rh )
+    {
+        set_rh(lp, r+1, rh);
+        current.rh = rh;
+    }
+}
+
 void csp_dispatch_opt::clear_output_arrays()
 {
     m_current_read_step = 0;
@@ -202,10 +287,18 @@ bool csp_dispatch_opt::copy_weather_data(C_csp_weatherreader &weather_source)
 {
     //Copy the weather data
     m_weather = weather_source;
+    invalidate_forecast();
 
     return m_is_weather_setup = true;
 }
 
+void csp_dispatch_opt::invalidate_forecast()
+{
+    m_forecast.clear();
+    m_forecast_col_rec = 0;
+    m_forecast_area = numeric_limits<double>::quiet_NaN();
+}
+
 bool csp_dispatch_opt::predict_performance(int step_start, int ntimeints, int divs_per_int)
 {
     //Step number - 1-based index for first hour of the year.
@@ -226,6 +319,17 @@ bool csp_dispatch_opt::predict_performance(int step_start, int ntimeints, int di
 
     double Asf = params.col_rec->get_collector_area();
 
+    /* 
+    Successive horizons overlap, so the weather-dependent performance of each step is calculated once and stored. The
+    forecast is recalculated if the collector changes.
+    */
+    if( params.col_rec != m_forecast_col_rec || Asf != m_forecast_area )
+    {
+        invalidate_forecast();
+        m_forecast_col_rec = params.col_rec;
+        m_forecast_area = Asf;
+    }
+
     double ave_weight = 1./(double)divs_per_int;
 
     for(int i=0; i<m_nstep_opt; i++)
@@ -239,23 +343,50 @@ bool csp_dispatch_opt::predict_performance(int step_start, int ntimeints, int di
 
         for(int j=0; j<divs_per_int; j++)     //take averages over hour if needed
         {
+            int step = step_start+i*divs_per_int+j;
 
-            //jump to the current step
-            if(! m_weather.read_time_step( step_start+i*divs_per_int+j, simloc ) )
-                return false;
+            if( step >= (int)m_forecast.size() )
+                m_forecast.resize(step + 1);
 
-            //get DNI
-            double dni = m_weather.ms_outputs.m_beam;
-            if( m_weather.ms_outputs.m_solzen > 90. || dni < 0. )
-                dni = 0.;
+            s_forecast_step &fc = m_forecast[step];
+
+            if( !fc.is_set )
+            {
+                //jump to the current step
+                if(! m_weather.read_time_step( step, simloc ) )
+                    return false;
 
-            //get optical efficiency
-            double opt_eff = params.col_rec->calculate_optical_efficiency(m_weather.ms_outputs, simloc);
+                //get DNI
+                double dni = m_weather.ms_outputs.m_beam;
+                if( m_weather.ms_outputs.m_solzen > 90. || dni < 0. )
+                    dni = 0.;
 
-            double q_inc = Asf * opt_eff * dni * 1.e-3; //kW
+                //get optical efficiency
+                double opt_eff = params.col_rec->calculate_optical_efficiency(m_weather.ms_outputs, simloc);
 
-            //get thermal efficiency
-            double therm_eff = params.col_rec->calculate_thermal_efficiency_approx(m_weather.ms_outputs, q_inc*0.001);
+                fc.q_inc = Asf * opt_eff * dni * 1.e-3; //kW
+
+                //get thermal efficiency
+                fc.therm_eff = params.col_rec->calculate_thermal_efficiency_approx(m_weather.ms_outputs, fc.q_inc*0.001);
+
+                //get the power cycle efficiency
+                fc.cycle_eff = params.eff_table_Tdb.interpolate( m_weather.ms_outputs.m_tdry );
+
+                double m_dot_htf_max_local = std::numeric_limits<double>::quiet_NaN();
+                fc.f_pb_op_lim = std::numeric_limits<double>::quiet_NaN();
+                params.mpc_pc->get_max_power_output_operation_constraints(m_weather.ms_outputs.m_tdry, m_dot_htf_max_local, fc.f_pb_op_lim);
+
+                //get the condenser parasitic power fraction
+                fc.wcond_f = params.wcondcoef_table_Tdb.interpolate( m_weather.ms_outputs.m_tdry );
+
+                fc.is_set = true;
+                m_weather.converged();
+            }
+
+            double q_inc = fc.q_inc; //kW
+
+            //thermal efficiency
+            double therm_eff = fc.therm_eff;
             therm_eff *= params.sf_effadj;
             therm_eff_ave += therm_eff * ave_weight;
 
@@ -263,21 +394,14 @@ bool csp_dispatch_opt::predict_performance(int step_start, int ntimeints, int di
             q_inc_ave += q_inc * therm_eff * ave_weight;
 
             //store the power cycle efficiency
-            double cycle_eff = params.eff_table_Tdb.interpolate( m_weather.ms_outputs.m_tdry );
+            double cycle_eff = fc.cycle_eff;
             cycle_eff *= params.eta_cycle_ref;  
             cycle_eff_ave += cycle_eff * ave_weight;
 
-			double f_pb_op_lim_local = std::numeric_limits<double>::quiet_NaN();
-			double m_dot_htf_max_local = std::numeric_limits<double>::quiet_NaN();
-			params.mpc_pc->get_max_power_output_operation_constraints(m_weather.ms_outputs.m_tdry, m_dot_htf_max_local, f_pb_op_lim_local);
-			f_pb_op_lim_ave += f_pb_op_lim_local * ave_weight;	//[-]
+			f_pb_op_lim_ave += fc.f_pb_op_lim * ave_weight;	//[-]
 
             //store the condenser parasitic power fraction
-            double wcond_f = params.wcondcoef_table_Tdb.interpolate( m_weather.ms_outputs.m_tdry );
-            wcond_ave += wcond_f * ave_weight;
-
-		    simloc.ms_ts.m_time += simloc.ms_ts.m_step;
-            m_weather.converged();
+            wcond_ave += fc.wcond_f * ave_weight;
         }
 
         //-----report hourly averages
@@ -465,7 +589,7 @@ bool csp_dispatch_opt::optimize()
     ychsp           1 if cycle hot startup penalty is enforced at time t; 0 otherwise
     -------------------------------------------------------------
     */
-    lprec *lp;
+    lprec *lp = NULL;
     int ret = 0;
 
 
@@ -507,13 +631,28 @@ bool csp_dispatch_opt::optimize()
 
         int nvar = O.get_total_var_count(); //total number of variables in the problem
 
-        lp = make_lp(0, nvar);  //build the context
+        std::chrono::steady_clock::time_point setup_start = std::chrono::steady_clock::now();
 
-        if(lp == NULL)
-            throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
+        //the problem assembled for the previous horizon can be updated in place if it has the same dimensions
+        m_lp_is_update = m_lp_model != NULL && m_lp_model_nt == nt && get_Ncolumns(m_lp_model) == nvar;
+        m_lp_nrow = 0;
+
+        if( !m_lp_is_update )
+        {
+            release_lp_model();
+
+            m_lp_model = make_lp(0, nvar);  //build the context
+
+            if(m_lp_model == NULL)
+                throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
+
+            m_lp_model_nt = nt;
+        }
+
+        lp = m_lp_model;
 
         //set variable names and types for each column
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        for(int i=0; i<O.get_num_varobjs() && !m_lp_is_update; i++)
         {
             optimization_vars::opt_var *v = O.get_var(i);
 
@@ -631,14 +770,15 @@ bool csp_dispatch_opt::optimize()
         }
 
         //set the row mode
-        set_add_rowmode(lp, TRUE);
+        if( !m_lp_is_update )
+            set_add_rowmode(lp, TRUE);
 
         /* 
         --------------------------------------------------------------------------------
         set up the variable properties
         --------------------------------------------------------------------------------
         */
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        for(int i=0; i<O.get_num_varobjs() && !m_lp_is_update; i++)
         {
             optimization_vars::opt_var *v = O.get_var(i);
             if( v->var_type == optimization_vars::VAR_TYPE::BINARY_T )
@@ -678,11 +818,11 @@ bool csp_dispatch_opt::optimize()
                     col[2] = O.column("wdot", t-1);
                     row[2] = 1.;
                     
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    add_constraint(lp, 3, row, col, GE, 0.);
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, GE, -P["Wdot0"]);
+                    add_constraint(lp, 2, row, col, GE, -P["Wdot0"]);
                 }
             }
         }
@@ -710,7 +850,7 @@ bool csp_dispatch_opt::optimize()
                 //row[i  ] = -outputs.eta_pb_expected.at(t);
                 //col[i++] = O.column("x", t);
 
-                add_constraintex(lp, i, row, col, EQ, 0.);
+                add_constraint(lp, i, row, col, EQ, 0.);
 
             }
         }
@@ -756,11 +896,11 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("ursu", t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0);
+                    add_constraint(lp, 3, row, col, LE, 0);
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, LE, 0.);
+                    add_constraint(lp, 2, row, col, LE, 0.);
                 }
 
                 //-----
@@ -772,7 +912,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Er"];
                 col[1] = O.column("yrsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                add_constraint(lp, 2, row, col, LE, 0.);
 
                 //Receiver operation allowed when:
                 row[0] = 1.;
@@ -786,11 +926,11 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("yr", t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0.); 
+                    add_constraint(lp, 3, row, col, LE, 0.); 
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
+                    add_constraint(lp, 2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
                 }
 
                 //Receiver startup can't be enabled after a time step where the Receiver was operating
@@ -802,7 +942,7 @@ bool csp_dispatch_opt::optimize()
                     row[1] = 1.;
                     col[1] = O.column("yr", t-1);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
+                    add_constraint(lp, 2, row, col, LE, 1.);
                 }
 
                 //Receiver startup energy consumption
@@ -812,13 +952,13 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Qru"];
                 col[1] = O.column("yrsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                add_constraint(lp, 2, row, col, LE, 0.);
 
                 //Receiver startup only during solar positive periods
                 row[0] = 1.;
                 col[0] = O.column("yrsu", t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
+                add_constraint(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
 
                 //Receiver consumption limit
                 row[0] = 1.;
@@ -827,7 +967,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("xrsu", t);
                 
-                add_constraintex(lp, 2, row, col, LE, outputs.q_sfavail_expected.at(t));
+                add_constraint(lp, 2, row, col, LE, outputs.q_sfavail_expected.at(t));
 
                 //Receiver operation mode requirement
                 row[0] = 1.;
@@ -836,7 +976,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -outputs.q_sfavail_expected.at(t);
                 col[1] = O.column("yr", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                add_constraint(lp, 2, row, col, LE, 0.);
 
                 //Receiver minimum operation requirement
                 row[0] = 1.;
@@ -845,13 +985,13 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Qrl"];
                 col[1] = O.column("yr", t);
 
-                add_constraintex(lp, 2, row, col, GE, 0.);
+                add_constraint(lp, 2, row, col, GE, 0.);
 
                 //Receiver can't continue operating when no energy is available
                 row[0] = 1.;
                 col[0] = O.column("yr", t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
+                add_constraint(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
 
                 // --- new constraints ---
 
@@ -897,7 +1037,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = 1.;
                     col[2] = O.column("yrsu", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    add_constraint(lp, 3, row, col, GE, 0.);
 
                     //receiver hot startup penalty
                     /*row[0] = 1.;
@@ -957,7 +1097,7 @@ bool csp_dispatch_opt::optimize()
                     col[i++] = O.column("ucsu", t-1);
                 }
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+                add_constraint(lp, i, row, col, LE, 0.);
 
                 //Inventory nonzero
                 row[0] = 1.;
@@ -966,7 +1106,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["M"];
                 col[1] = O.column("ycsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                add_constraint(lp, 2, row, col, LE, 0.);
 
                 //Cycle operation allowed when:
                 i=0;
@@ -984,11 +1124,11 @@ bool csp_dispatch_opt::optimize()
                     row[i  ] = -1.;
                     col[i++] = O.column("ycsb", t-1);
 
-                    add_constraintex(lp, i, row, col, LE, 0.); 
+                    add_constraint(lp, i, row, col, LE, 0.); 
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
+                    add_constraint(lp, i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
                 }
 
                 //Cycle consumption limit
@@ -1003,7 +1143,7 @@ bool csp_dispatch_opt::optimize()
                 row[i  ] = -P["Qu"];
                 col[i++] = O.column("y", t);
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+                add_constraint(lp, i, row, col, LE, 0.);
 
                 //cycle operation mode requirement
                 row[0] = 1.;
@@ -1012,7 +1152,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = -P["Qu"];
                 col[1] = O.column("y", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                add_constraint(lp, 2, row, col, LE, 0.);
 
                 //Minimum cycle energy contribution
                 i=0;
@@ -1022,7 +1162,7 @@ bool csp_dispatch_opt::optimize()
                 row[i  ] = -P["Ql"];
                 col[i++] = O.column("y", t);
 
-                add_constraintex(lp, i, row, col, GE, 0);
+                add_constraint(lp, i, row, col, GE, 0);
 
                 //cycle startup can't be enabled after a time step where the cycle was operating
                 if(t>0)
@@ -1033,7 +1173,7 @@ bool csp_dispatch_opt::optimize()
                     row[1] = 1.;
                     col[1] = O.column("y", t-1);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
+                    add_constraint(lp, 2, row, col, LE, 1.);
                 }
 
 
@@ -1050,11 +1190,11 @@ bool csp_dispatch_opt::optimize()
                     row[i  ] = -1.;
                     col[i++] = O.column("ycsb", t-1);
 
-                    add_constraintex(lp, i, row, col, LE, 0);
+                    add_constraint(lp, i, row, col, LE, 0);
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
+                    add_constraint(lp, i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
                 }
 
                 //some modes can't coincide
@@ -1063,14 +1203,14 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("ycsb", t);    
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+                add_constraint(lp, 2, row, col, LE, 1);   
 
                 row[0] = 1.;
                 col[0] = O.column("y", t);
                 row[1] = 1.;
                 col[1] = O.column("ycsb", t);    
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+                add_constraint(lp, 2, row, col, LE, 1);   
 
                 if( t > 0 )
                 {
@@ -1084,7 +1224,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = 1.;
                     col[2] = O.column("ycsu", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    add_constraint(lp, 3, row, col, GE, 0.);
 
                     //cycle standby start penalty
                     row[0] = 1.;
@@ -1096,7 +1236,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("ycsb", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, -1.);
+                    add_constraint(lp, 3, row, col, GE, -1.);
 
 #ifdef MOD_CYCLE_SHUTDOWN
                     //cycle shutdown energy penalty
@@ -1115,7 +1255,7 @@ bool csp_dispatch_opt::optimize()
                     row[4] = 1.;
                     col[4] = O.column("ycsb", t);
 
-                    add_constraintex(lp, 5, row, col, GE, 0.);
+                    add_constraint(lp, 5, row, col, GE, 0.);
 #endif
 
                 }
@@ -1157,11 +1297,11 @@ bool csp_dispatch_opt::optimize()
                     row[i  ] = 1.;
                     col[i++] = O.column("s", t-1);
 
-                    add_constraintex(lp, i, row, col, EQ, 0.);
+                    add_constraint(lp, i, row, col, EQ, 0.);
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
+                    add_constraint(lp, i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
                 }
             }
         }
@@ -1177,7 +1317,7 @@ bool csp_dispatch_opt::optimize()
                 row[0] = 1.;
                 col[0] = O.column("s", t);
 
-                add_constraintex(lp, 1, row, col, LE, P["Eu"]);
+                add_constraint(lp, 1, row, col, LE, P["Eu"]);
 
 				//max cycle thermal input in time periods where cycle operates and receiver is starting up
                 //outputs.delta_rs.resize(nt);
@@ -1210,7 +1350,7 @@ bool csp_dispatch_opt::optimize()
 					row[i] = large;
 					col[i++] = O.column("ycsb", t);
 
-					add_constraintex(lp, i, row, col, LE, 3.0*large);
+					add_constraint(lp, i, row, col, LE, 3.0*large);
 				}
 
             }
@@ -1226,7 +1366,7 @@ bool csp_dispatch_opt::optimize()
                 row[0] = 1.;
                 col[0] = O.column("wdot", t);
 
-				add_constraintex(lp, 1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
+				add_constraint(lp, 1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
             }
         }
 
@@ -1277,13 +1417,13 @@ bool csp_dispatch_opt::optimize()
 					//row[i] - params.w_stow / params.dt;	//kWe
 					//col[i++] = O.column("yrsd", t);
 
-					add_constraintex(lp, 7, row, col, LE, w_lim.at(t));
+					add_constraint(lp, 7, row, col, LE, w_lim.at(t));
 				}
 				else // Power cycle operation is impossible at current constrained wlim
 				{
 					row[0] = 1.0;
 					col[0] = O.column("wdot", t);
-					add_constraintex(lp, 1, row, col, EQ, 0.);
+					add_constraint(lp, 1, row, col, EQ, 0.);
 				}
 			}
 		}
@@ -1293,7 +1433,22 @@ bool csp_dispatch_opt::optimize()
         set_maxim(lp);
 
         //reset the row mode
-        set_add_rowmode(lp, FALSE);
+        if( !m_lp_is_update )
+            set_add_rowmode(lp, FALSE);
+
+        if( m_lp_nrow != (int)m_lp_rows.size() )
+            throw C_csp_exception("CSP dispatch optimization problem structure changed between horizons.");
+
+        /* 
+        Presolve removes rows and columns from the problem it's applied to, so solve a copy and keep the assembled 
+        problem for the next horizon.
+        */
+        lp = copy_lp(m_lp_model);
+        if(lp == NULL)
+            throw C_csp_exception("Failed to copy the CSP dispatch optimization problem.");
+
+        outputs.is_model_reused = m_lp_is_update;
+        outputs.setup_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - setup_start).count();
 
         //set the log function
         solver_params.reset();
@@ -1367,6 +1522,33 @@ bool csp_dispatch_opt::optimize()
 		}
         
  
+        /* 
+        Warm start from the previous solution. Successive horizons overlap, so shift the previous solution forward to 
+        the new start time and hold the last value over the newly added time steps.
+        */
+        outputs.is_warm_start = false;
+        if( solver_params.is_warm_start && m_lp_is_update && (int)m_last_solution.size() == nvar + 1 )
+        {
+            int shift = (int)floor( (params.info_time - m_last_info_time) / 3600. / P["delta"] + 0.5 );
+
+            if( shift > 0 && shift < nt )
+            {
+                vector<REAL> guess(nvar + 1, 0.);
+                for(int i=0; i<O.get_num_varobjs(); i++)
+                {
+                    if( O.get_var(i)->var_dim != optimization_vars::VAR_DIM::DIM_T )
+                        continue;
+
+                    for(int t=0; t<nt; t++)
+                        guess.at( O.column(i, t) ) = m_last_solution.at( O.column(i, min(t + shift, nt - 1)) );
+                }
+
+                vector<int> basis(1 + get_Nrows(lp) + nvar);
+                if( guess_basis(lp, &guess[0], &basis[0]) )
+                    outputs.is_warm_start = set_basis(lp, &basis[0], TRUE) == TRUE;
+            }
+        }
+
        //Problem scaling loop
         int scaling_iter = 0;
         bool return_ok = false;
@@ -1470,6 +1652,9 @@ bool csp_dispatch_opt::optimize()
 
             int ncols = get_Ncolumns(lp);
 
+            m_last_solution.assign(nvar + 1, 0.);
+            m_last_info_time = params.info_time;
+
 //            char name[15];
             REAL *vars = new REAL[ncols];
             get_variables(lp, vars);
@@ -1518,6 +1703,8 @@ bool csp_dispatch_opt::optimize()
 
                 int t = atoi(ind);
 
+                m_last_solution.at( O.column(root, t) ) = vars[ c-1 ];
+
                 if(strcmp(root, "ycsb") == 0)  //Cycle standby
                 {
                     outputs.pb_standby.at(t) = vars[ c-1 ] == 1.;
@@ -1569,6 +1756,8 @@ bool csp_dispatch_opt::optimize()
             //if the optimization wasn't successful, just set the objective values to zero - otherwise they are NAN
             outputs.objective = 0.;
             outputs.objective_relaxed = 0.;
+
+            m_last_solution.clear();
         }
 
         //record the solve state
@@ -1654,8 +1843,9 @@ bool csp_dispatch_opt::optimize()
     catch(exception &e)
     {
         //clean up memory and pass on the exception
-        if( lp != NULL )
+        if( lp != NULL && lp != m_lp_model )
             delete_lp(lp);
+        release_lp_model();
         
         throw e;
 
@@ -1663,8 +1853,9 @@ bool csp_dispatch_opt::optimize()
     catch(...)
     {
         //clean up memory and pass on the exception
-        if( lp != NULL )
+        if( lp != NULL && lp != m_lp_model )
             delete_lp(lp);
+        release_lp_model();
 
         return false;
     }
@@ -66,10 +66,52 @@ using namespace std;
 
 class csp_dispatch_opt
 {
+private:
     int  m_nstep_opt;              //number of time steps in the optimized array
     bool m_is_weather_setup;  //bool indicating whether the weather has been copied
-    
+
+    struct s_lp_row
+    {
+        int type;
+        REAL rh;
+        vector<int> col;
+        vector<REAL> val;
+    };
+
+    lprec *m_lp_model;              //assembled (unsolved) problem retained between optimization horizons
+    int m_lp_model_nt;              //number of time steps in the retained problem
+    bool m_lp_is_update;            //constraints are being written into the retained problem
+    int m_lp_nrow;                  //number of constraint rows written during the current assembly
+    vector<s_lp_row> m_lp_rows;     //constraint rows currently held by the retained problem
+    vector<REAL> m_last_solution;   //[1..ncol] variable values from the last successful solution
+    double m_last_info_time;        //[s] start time of the last successful solution
+
+    struct s_forecast_step
+    {
+        bool is_set;
+        double q_inc;               //[kWt] Incident power on the receiver
+        double therm_eff;           //[-] Approximate receiver thermal efficiency, not adjusted
+        double cycle_eff;           //[-] Normalized power cycle efficiency
+        double f_pb_op_lim;         //[-] Maximum normalized cycle output
+        double wcond_f;             //[-] Condenser parasitic power fraction
+
+        s_forecast_step()
+        {
+            is_set = false;
+            q_inc = therm_eff = cycle_eff = f_pb_op_lim = wcond_f = 0.;
+        };
+    };
+
+    vector<s_forecast_step> m_forecast;                 //forecast for each weather step, filled as horizons are predicted
+    C_csp_collector_receiver *m_forecast_col_rec;       //collector/receiver the forecast was calculated for
+    double m_forecast_area;                             //[m2] collector area the forecast was calculated for
+
+    csp_dispatch_opt(const csp_dispatch_opt &);               //not copyable, owns m_lp_model
+    csp_dispatch_opt &operator=(const csp_dispatch_opt &);
+
     void clear_output_arrays();
+    void release_lp_model();
+    void add_constraint(lprec *lp, int count, REAL *row, int *col, int constr_type, REAL rh);
 
 public:
     bool m_last_opt_successful;   //last optimization run was successful?
@@ -93,6 +135,7 @@ public:
         int bb_type;  
         int disp_reporting;
         int scaling_type;
+        bool is_warm_start;         //start each horizon from the previous horizon's solution
 
         bool is_write_ampl_dat;     //write ampl data files?
         bool is_ampl_engine;        //run with external AMPL engine
@@ -105,6 +148,7 @@ public:
             disp_reporting = -1;
             presolve_type = -1;
             scaling_type = -1;
+            is_warm_start = false;
         };
 
         void reset()
@@ -276,6 +320,9 @@ public:
         int solve_iter;             //Number of iterations required to solve
         int solve_state;
         double solve_time;
+        double setup_time;          //[s] time spent assembling or updating the problem
+        bool is_model_reused;       //problem was updated in place rather than rebuilt
+        bool is_warm_start;         //solver was started from the previous horizon's solution
         int presolve_nconstr;
         int presolve_nvar;
     } outputs;
@@ -295,6 +342,7 @@ public:
     //----- public member functions ----
 
     csp_dispatch_opt();
+    ~csp_dispatch_opt();
 
     //check parameters and inputs to make sure everything has been set up correctly
     bool check_setup(int nstep);
@@ -308,6 +356,9 @@ public:
     //Predict performance out nstep values. 
     bool predict_performance(int step_start, int ntimeints, int divs_per_int);    
 
+    //Discard the stored performance forecast, e.g. after the collector or cycle performance has changed
+    void invalidate_forecast();
+
     //declare dispatch function in csp_dispatch.cpp
     bool optimize();
 
@@ -336,6 +336,9 @@ C_csp_solver::C_csp_solver(C_csp_weatherreader &weather,
 
 	m_op_mode_tracking.resize(0);
 
+	m_is_mono_eq_memo = false;
+	m_op_mode_memo = ENTRY_MODE;
+
 	error_msg = "";
 
 	mv_time_local.reserve(10);
@@ -347,6 +350,218 @@ C_csp_solver::C_csp_solver(C_csp_weatherreader &weather,
 	m_defocus = std::numeric_limits<double>::quiet_NaN();
 }
 
+C_monotonic_eq_memo * C_csp_solver::mono_eq_memo(const C_monotonic_equation & mono_eq)
+{
+	S_mono_eq_memo_key key(m_op_mode_memo, std::type_index(typeid(mono_eq)));
+
+	std::map<S_mono_eq_memo_key, C_monotonic_eq_memo>::iterator it = mm_mono_eq_memo.find(key);
+	if( it == mm_mono_eq_memo.end() )
+	{
+		it = mm_mono_eq_memo.insert(std::make_pair(key, C_monotonic_eq_memo())).first;
+		mv_mono_eq_memo_keys.push_back(key);
+	}
+
+	it->second.m_is_seed = m_is_mono_eq_memo;
+	it->second.m_is_timed = mc_instrumentation.m_is_on;
+
+	return &it->second;
+}
+
+void C_csp_solver::get_mono_eq_counters(util::matrix_t<double> & counters)
+{
+	// A single row of zeros if no equation was solved
+	counters.resize_fill(std::max((size_t)1, mv_mono_eq_memo_keys.size()), 7, 0.0);
+
+	std::map<int, int> n_eq_by_mode;
+	for( size_t i = 0; i < mv_mono_eq_memo_keys.size(); i++ )
+	{
+		const S_mono_eq_memo_key & key = mv_mono_eq_memo_keys[i];
+		const C_monotonic_eq_memo & memo = mm_mono_eq_memo.find(key)->second;
+
+		counters(i, 0) = key.m_op_mode;					//[-] Operating mode
+		counters(i, 1) = n_eq_by_mode[key.m_op_mode]++;	//[-] Equation number within operating mode
+		counters(i, 2) = (double)memo.m_n_solves;		//[-]
+		counters(i, 3) = (double)memo.m_n_calls;		//[-]
+		counters(i, 4) = (double)memo.m_n_seeded;		//[-]
+		counters(i, 5) = (double)memo.m_n_fallback;		//[-]
+		counters(i, 6) = memo.m_time_solve;				//[s]
+	}
+}
+
+C_csp_solver::C_instrumentation::C_instrumentation()
+{
+	m_is_on = false;
+
+	reset();
+}
+
+void C_csp_solver::C_instrumentation::reset()
+{
+	m_time_sim = 0.0;
+	for( int i = 0; i < N_COMPONENT_CALLS; i++ )
+		ms_component_calls[i] = S_calls();
+	mv_op_modes.clear();
+
+	m_n_component_calls = 0;
+	m_op_mode = -1;
+	m_op_mode_calls_start = 0;
+}
+
+void C_csp_solver::C_instrumentation::start_op_mode(int op_mode)
+{
+	if( !m_is_on )
+		return;
+
+	m_op_mode = op_mode;
+	m_op_mode_calls_start = m_n_component_calls;
+	m_op_mode_start = std::chrono::high_resolution_clock::now();
+}
+
+void C_csp_solver::C_instrumentation::end_op_mode()
+{
+	if( !m_is_on || m_op_mode < 0 )
+		return;
+
+	if( m_op_mode >= (int)mv_op_modes.size() )
+		mv_op_modes.resize(m_op_mode + 1);
+
+	S_op_mode & op_mode = mv_op_modes[m_op_mode];
+	long n_calls = m_n_component_calls - m_op_mode_calls_start;
+
+	op_mode.m_n_tries++;
+	op_mode.m_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_op_mode_start).count();
+	op_mode.m_n_component_calls += n_calls;
+
+	// Bins: 0, 1, 2, 3-4, 5-8, ..., 65-128, > 128
+	int i_bin = 0;
+	if( n_calls > 0 )
+	{
+		i_bin = 1;
+		for( long n_bin_upper = 1; n_calls > n_bin_upper && i_bin < N_HIST_BINS - 1; n_bin_upper *= 2 )
+			i_bin++;
+	}
+	op_mode.m_hist[i_bin]++;
+
+	m_op_mode = -1;
+}
+
+void C_csp_solver::C_instrumentation::get_op_mode_table(util::matrix_t<double> & op_modes)
+{
+	int n_rows = 0;
+	for( size_t i = 0; i < mv_op_modes.size(); i++ )
+	{
+		if( mv_op_modes[i].m_n_tries > 0 )
+			n_rows++;
+	}
+
+	// A single row of zeros if no operating mode was timed
+	op_modes.resize_fill(std::max(1, n_rows), 4 + N_HIST_BINS, 0.0);
+
+	int i_row = 0;
+	for( size_t i = 0; i < mv_op_modes.size(); i++ )
+	{
+		const S_op_mode & op_mode = mv_op_modes[i];
+		if( op_mode.m_n_tries == 0 )
+			continue;
+
+		op_modes(i_row, 0) = (double)i;							//[-]
+		op_modes(i_row, 1) = (double)op_mode.m_n_tries;			//[-]
+		op_modes(i_row, 2) = op_mode.m_time;					//[s]
+		op_modes(i_row, 3) = (double)op_mode.m_n_component_calls;	//[-]
+		for( int j = 0; j < N_HIST_BINS; j++ )
+			op_modes(i_row, 4 + j) = (double)op_mode.m_hist[j];	//[-]
+		i_row++;
+	}
+}
+
+void C_csp_solver::C_instrumentation::get_component_call_table(util::matrix_t<double> & component_calls)
+{
+	component_calls.resize_fill(N_COMPONENT_CALLS, 2, 0.0);
+
+	for( int i = 0; i < N_COMPONENT_CALLS; i++ )
+	{
+		component_calls(i, 0) = (double)ms_component_calls[i].m_n_calls;	//[-]
+		component_calls(i, 1) = ms_component_calls[i].m_time;			//[s]
+	}
+}
+
+void C_csp_solver::cr_off(const C_csp_weatherreader::S_outputs &weather,
+	const C_csp_solver_htf_1state &htf_state_in,
+	C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver,
+	const C_csp_solver_sim_info &sim_info)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::CR_OFF);
+
+	mc_collector_receiver.off(weather, htf_state_in, cr_out_solver, sim_info);
+}
+
+void C_csp_solver::cr_startup(const C_csp_weatherreader::S_outputs &weather,
+	const C_csp_solver_htf_1state &htf_state_in,
+	C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver,
+	const C_csp_solver_sim_info &sim_info)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::CR_STARTUP);
+
+	mc_collector_receiver.startup(weather, htf_state_in, cr_out_solver, sim_info);
+}
+
+void C_csp_solver::cr_on(const C_csp_weatherreader::S_outputs &weather,
+	const C_csp_solver_htf_1state &htf_state_in,
+	double field_control,
+	C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver,
+	const C_csp_solver_sim_info &sim_info)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::CR_ON);
+
+	mc_collector_receiver.on(weather, htf_state_in, field_control, cr_out_solver, sim_info);
+}
+
+void C_csp_solver::pc_call(const C_csp_weatherreader::S_outputs &weather,
+	C_csp_solver_htf_1state &htf_state_in,
+	const C_csp_power_cycle::S_control_inputs &inputs,
+	C_csp_power_cycle::S_csp_pc_out_solver &out_solver,
+	const C_csp_solver_sim_info &sim_info)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::PC_CALL);
+
+	mc_power_cycle.call(weather, htf_state_in, inputs, out_solver, sim_info);
+}
+
+bool C_csp_solver::tes_discharge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::TES_DISCHARGE);
+
+	return mc_tes.discharge(timestep, T_amb, m_dot_htf_in, T_htf_cold_in, T_htf_hot_out, outputs);
+}
+
+void C_csp_solver::tes_discharge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::TES_DISCHARGE_FULL);
+
+	mc_tes.discharge_full(timestep, T_amb, T_htf_cold_in, T_htf_hot_out, m_dot_htf_out, outputs);
+}
+
+bool C_csp_solver::tes_charge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_hot_in, double & T_htf_cold_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::TES_CHARGE);
+
+	return mc_tes.charge(timestep, T_amb, m_dot_htf_in, T_htf_hot_in, T_htf_cold_out, outputs);
+}
+
+void C_csp_solver::tes_charge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_hot_in /*K*/, double & T_htf_cold_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::TES_CHARGE_FULL);
+
+	mc_tes.charge_full(timestep, T_amb, T_htf_hot_in, T_htf_cold_out, m_dot_htf_out, outputs);
+}
+
+void C_csp_solver::tes_idle(double timestep, double T_amb, C_csp_tes::S_csp_tes_outputs &outputs)
+{
+	C_instrumentation::C_call_timer timer(mc_instrumentation, C_instrumentation::TES_IDLE);
+
+	mc_tes.idle(timestep, T_amb, outputs);
+}
+
 void C_csp_solver::send_callback(double percent)
 {
 	if (mpf_callback && mp_cmod_active)
@@ -585,6 +800,12 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 	
 	mc_kernel.init(sim_setup, wf_step, baseline_step, mc_csp_messages);
 
+	mm_mono_eq_memo.clear();
+	mv_mono_eq_memo_keys.clear();
+
+	mc_instrumentation.reset();
+	std::chrono::high_resolution_clock::time_point sim_start = std::chrono::high_resolution_clock::now();
+
     //instantiate dispatch optimization object
     csp_dispatch_opt dispatch;
     //load parameters used by dispatch algorithm
@@ -679,6 +900,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
     dispatch.solver_params.disp_reporting = mc_tou.mc_dispatch_params.m_disp_reporting;
     dispatch.solver_params.scaling_type = mc_tou.mc_dispatch_params.m_scaling_type;
     dispatch.solver_params.presolve_type = mc_tou.mc_dispatch_params.m_presolve_type;
+    dispatch.solver_params.is_warm_start = mc_tou.mc_dispatch_params.m_is_warm_start;
     dispatch.solver_params.is_write_ampl_dat = mc_tou.mc_dispatch_params.m_is_write_ampl_dat;
     dispatch.solver_params.is_ampl_engine = mc_tou.mc_dispatch_params.m_is_ampl_engine;
     dispatch.solver_params.ampl_data_dir = mc_tou.mc_dispatch_params.m_ampl_data_dir;
@@ -813,7 +1035,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		mc_pc_inputs.m_standby_control = C_csp_power_cycle::ON;
 		//mc_pc_inputs.m_tou = tou_timestep;
 		// Performance Call
-		mc_power_cycle.call(mc_weather.ms_outputs,
+		pc_call(mc_weather.ms_outputs,
 			mc_pc_htf_state_in,
 			mc_pc_inputs,
 			mc_pc_out_solver,
@@ -1134,7 +1356,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 			// Set startup conditions
 			mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-			mc_collector_receiver.startup(mc_weather.ms_outputs,
+			cr_startup(mc_weather.ms_outputs,
 				mc_cr_htf_state_in,
 				mc_cr_out_solver,
 				mc_kernel.mc_sim_info);
@@ -1695,6 +1917,9 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
             op_mode_str = "";
             
+			m_op_mode_memo = operating_mode;
+			mc_instrumentation.start_op_mode(operating_mode);
+
             switch( operating_mode )
 			{
 			case CR_DF__PC_SU__TES_OFF__AUX_OFF:
@@ -1727,6 +1952,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				//    when storage is fully charged				
 				C_MEQ_cr_on__pc_m_dot_max__tes_off__defocus c_df_m_dot(this, pc_mode);
 				C_monotonic_eq_solver c_df_m_dot_solver(c_df_m_dot);
+				c_df_m_dot_solver.set_memo(mono_eq_memo(c_df_m_dot));
 				
 				double defocus_guess = 1.0;
 				double m_dot_bal = std::numeric_limits<double>::quiet_NaN();
@@ -1852,6 +2078,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				{
 					C_MEQ_cr_on__pc_q_dot_max__tes_off__defocus c_eq(this, pc_mode, q_pc_max);
 					C_monotonic_eq_solver c_solver(c_eq);
+					c_solver.set_memo(mono_eq_memo(c_eq));
 
 					// Set up solver
 					c_solver.settings(1.E-3, 50, 0.0, defocus_guess, true);
@@ -1921,7 +2148,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// CR: ON
 						mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-						mc_collector_receiver.on(mc_weather.ms_outputs,
+						cr_on(mc_weather.ms_outputs,
 							mc_cr_htf_state_in,
 							m_defocus,
 							mc_cr_out_solver,
@@ -1943,7 +2170,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// Inputs
 						mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP;
 						// Performance Call
-						mc_power_cycle.call(mc_weather.ms_outputs,
+						pc_call(mc_weather.ms_outputs,
 							mc_pc_htf_state_in,
 							mc_pc_inputs,
 							mc_pc_out_solver,
@@ -1956,6 +2183,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 						C_mono_eq_cr_to_pc_to_cr c_eq(this, pc_mode, m_P_cold_des, -1, defocus_guess);
 						C_monotonic_eq_solver c_solver(c_eq);
+						c_solver.set_memo(mono_eq_memo(c_eq));
 
 						c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -2010,7 +2238,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Solve for idle storage
 				if (m_is_tes)
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
 					mc_tes_ch_htf_state.m_m_dot = 0.0;										//[kg/hr]
@@ -2147,7 +2375,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 					if(m_is_tes)
 					{
-						mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+						tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 					
 					
 						// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2197,7 +2425,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// First, solve the CR. Again, we're assuming HTF inlet temperature is always = m_T_htf_cold_des
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.on(mc_weather.ms_outputs,
+				cr_on(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					m_defocus,
 					mc_cr_out_solver,
@@ -2219,7 +2447,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::STANDBY;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2281,7 +2509,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
 					mc_tes_ch_htf_state.m_m_dot = 0.0;										//[kg/hr]
@@ -2319,7 +2547,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// CR: ON
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.on(mc_weather.ms_outputs,
+				cr_on(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					m_defocus,
 					mc_cr_out_solver,
@@ -2341,7 +2569,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2357,7 +2585,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2407,7 +2635,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_cr_htf_state_in.m_pres = m_P_cold_des;					//[kPa]
 				mc_cr_htf_state_in.m_qual = m_x_cold_des;					//[-]
 
-				mc_collector_receiver.startup(mc_weather.ms_outputs,
+				cr_startup(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -2438,7 +2666,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2446,7 +2674,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2476,7 +2704,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_cr_htf_state_in.m_pres = m_P_cold_des;					//[kPa]
 				mc_cr_htf_state_in.m_qual = m_x_cold_des;					//[-]
 
-				mc_collector_receiver.off(mc_weather.ms_outputs,
+				cr_off(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -2490,7 +2718,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Inputs
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2498,7 +2726,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				if( m_is_tes )
 				{
-					mc_tes.idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
+					tes_idle(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, mc_tes_outputs);
 
 
 					// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
@@ -2559,7 +2787,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Now run CR at 'OFF'
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 				
-				mc_collector_receiver.off(mc_weather.ms_outputs,
+				cr_off(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -2585,6 +2813,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold c_eq(this, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -2631,7 +2860,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_pc_inputs.m_m_dot = 0.0;		//[kg/hr] no mass flow rate to power cycle
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -2678,6 +2907,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_mono_eq_cr_on_pc_target_tes_ch__T_cold c_eq(this, power_cycle_mode, q_dot_pc_fixed, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -2792,6 +3022,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				
 				C_mono_eq_cr_on_pc_target_tes_dc c_eq(this, power_cycle_mode, q_dot_pc_fixed, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -2910,6 +3141,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_mono_eq_cr_on_pc_match_tes_empty c_eq(this, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -3027,6 +3259,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_MEQ_cr_df__pc_off__tes_full__defocus c_eq(this);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				double defocus_guess = 1.0;
 				double diff_m_dot = std::numeric_limits<double>::quiet_NaN();
@@ -3106,6 +3339,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Haven't actually converged solution yet, so need to basically call CR_ON__PC_OFF__TES_CH
 					C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold c_eq(this, m_defocus);
 					C_monotonic_eq_solver c_solver(c_eq);
+					c_solver.set_memo(mono_eq_memo(c_eq));
 
 					c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -3155,7 +3389,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				mc_pc_inputs.m_standby_control = C_csp_power_cycle::OFF;
 				mc_pc_inputs.m_m_dot = 0.0;		//[kg/hr] no mass flow rate to power cycle
 					// Performance Call
-				mc_power_cycle.call(mc_weather.ms_outputs,
+				pc_call(mc_weather.ms_outputs,
 					mc_pc_htf_state_in,
 					mc_pc_inputs,
 					mc_pc_out_solver,
@@ -3250,7 +3484,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Now run CR at 'OFF'
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.off(mc_weather.ms_outputs,
+				cr_off(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -3283,7 +3517,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Now run CR at 'OFF'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 					
-					mc_collector_receiver.off(mc_weather.ms_outputs,
+					cr_off(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3294,7 +3528,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Run CR at 'Start Up'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-					mc_collector_receiver.startup(mc_weather.ms_outputs,
+					cr_startup(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3320,6 +3554,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Set up solver to converge the cold HTF temperature between TES and PC
 				C_mono_eq_pc_match_tes_empty c_eq(this);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -3468,7 +3703,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// First, startup the collector-receiver and get the time required
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.startup(mc_weather.ms_outputs,
+				cr_startup(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -3495,6 +3730,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// Next, calculate the required TES empty time
 				C_mono_eq_pc_target_tes_empty__T_cold c_eq(this, q_pc_min);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -3554,7 +3790,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Rerun CR_SU
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-					mc_collector_receiver.startup(mc_weather.ms_outputs,
+					cr_startup(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3655,6 +3891,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_mono_eq_cr_on_pc_target_tes_dc c_eq(this, power_cycle_mode, q_dot_pc_fixed, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -3813,7 +4050,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Now run CR at 'OFF'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 					
-					mc_collector_receiver.off(mc_weather.ms_outputs,
+					cr_off(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3825,7 +4062,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 					// Run CR at 'Start Up'
 					mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-					mc_collector_receiver.startup(mc_weather.ms_outputs,
+					cr_startup(mc_weather.ms_outputs,
 						mc_cr_htf_state_in,
 						mc_cr_out_solver,
 						mc_kernel.mc_sim_info);
@@ -3854,6 +4091,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_mono_eq_pc_target_tes_dc__T_cold c_eq(this, power_cycle_mode, q_dot_pc_fixed);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, 0, std::numeric_limits<double>::quiet_NaN(), false);
@@ -3977,6 +4215,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				
 				C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full c_eq(this, power_cycle_mode, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -4064,6 +4303,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold c_eq(this, m_defocus, q_pc_min);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -4209,6 +4449,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				//   when storage is fully charged
 				C_mono_eq_cr_on__pc_m_dot_max__tes_full_defocus c_df_m_dot(this, pc_mode);
 				C_monotonic_eq_solver c_df_m_dot_solver(c_df_m_dot);
+				c_df_m_dot_solver.set_memo(mono_eq_memo(c_df_m_dot));
 
 				double defocus_guess = 1.0;
 				double m_dot_bal = std::numeric_limits<double>::quiet_NaN();
@@ -4343,6 +4584,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 					C_mono_eq_cr_on__pc_target__tes_full__defocus c_eq(this, pc_mode, q_pc_max);
 					C_monotonic_eq_solver c_solver(c_eq);
+					c_solver.set_memo(mono_eq_memo(c_eq));
 
 					// Set up solver
 					c_solver.settings(1.E-3, 50, 0.0, defocus_guess, true);
@@ -4401,6 +4643,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// Haven't actually converged solution yet, so need to basically call CR_ON__PC_SU__TES_CH
 						C_mono_eq_cr_on_pc_su_tes_ch c_eq(this);
 						C_monotonic_eq_solver c_solver(c_eq);
+						c_solver.set_memo(mono_eq_memo(c_eq));
 
 						// Get first htf cold temp guess
 						double T_htf_cold_guess = m_T_htf_pc_cold_est;	//[C]
@@ -4473,6 +4716,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// Haven't actually converged solution yet, so need to basically call CR_ON__PC_RM_HI__TES_FULL
 						C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full c_eq(this, pc_mode, defocus_guess);
 						C_monotonic_eq_solver c_solver(c_eq);
+						c_solver.set_memo(mono_eq_memo(c_eq));
 
 						// Set up solver
 						c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -4551,6 +4795,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full c_eq(this, power_cycle_mode, m_defocus);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Set up solver
 				c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -4637,7 +4882,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				// First, startup the collector-receiver and get the time required
 				mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-				mc_collector_receiver.startup(mc_weather.ms_outputs,
+				cr_startup(mc_weather.ms_outputs,
 					mc_cr_htf_state_in,
 					mc_cr_out_solver,
 					mc_kernel.mc_sim_info);
@@ -4695,7 +4940,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 						// Rerun CR_SU
 						mc_cr_htf_state_in.m_temp = m_T_htf_cold_des - 273.15;		//[C], convert from [K]
 
-						mc_collector_receiver.startup(mc_weather.ms_outputs,
+						cr_startup(mc_weather.ms_outputs,
 							mc_cr_htf_state_in,
 							mc_cr_out_solver,
 							mc_kernel.mc_sim_info);
@@ -4735,6 +4980,7 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
 				C_mono_eq_cr_on_pc_su_tes_ch c_eq(this);
 				C_monotonic_eq_solver c_solver(c_eq);
+				c_solver.set_memo(mono_eq_memo(c_eq));
 
 				// Get first htf cold temp guess
 				double T_htf_cold_guess = m_T_htf_pc_cold_est;	//[C]
@@ -4818,6 +5064,8 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 				throw(C_csp_exception("Operation mode not recognized",""));
 
 			}	// End switch() on receiver operating modes
+
+			mc_instrumentation.end_op_mode();
 		
 		}	
         
@@ -5130,6 +5378,11 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 		
 	}	// End timestep loop
 
+	if( mc_instrumentation.m_is_on )
+	{
+		mc_instrumentation.m_time_sim = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - sim_start).count();
+	}
+
 }	// End simulate() method
 
 
@@ -5147,6 +5400,7 @@ void C_csp_solver::solver_pc_su_controlled__tes_dc(double step_tol /*s*/,
 	
 	C_mono_eq_pc_su_cont_tes_dc c_eq(this);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mono_eq_memo(c_eq));
 
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -5199,7 +5453,7 @@ void C_csp_solver::solver_pc_su_controlled__tes_dc(double step_tol /*s*/,
 		// Get mass flow rate and temperature at a full discharge
 		double m_dot_pc = std::numeric_limits<double>::quiet_NaN();
 		double T_pc_in_calc = std::numeric_limits<double>::quiet_NaN();
-		mc_tes.discharge_full(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, m_T_htf_cold_des, T_pc_in_calc, m_dot_pc, mc_tes_outputs);
+		tes_discharge_full(mc_kernel.mc_sim_info.ms_ts.m_step, mc_weather.ms_outputs.m_tdry + 273.15, m_T_htf_cold_des, T_pc_in_calc, m_dot_pc, mc_tes_outputs);
 
 		// If not actually charging (i.e. mass flow rate = 0.0), what should the temperatures be?
 		mc_tes_ch_htf_state.m_m_dot = 0.0;										//[kg/hr]
@@ -5217,7 +5471,7 @@ void C_csp_solver::solver_pc_su_controlled__tes_dc(double step_tol /*s*/,
 			// Inputs
 		mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP;
 			// Performance Call
-		mc_power_cycle.call(mc_weather.ms_outputs,
+		pc_call(mc_weather.ms_outputs,
 			mc_pc_htf_state_in,
 			mc_pc_inputs,
 			mc_pc_out_solver,
@@ -5248,6 +5502,7 @@ int C_csp_solver::solver_cr_on__pc_match__tes_full(int pc_mode, double defocus_i
 {
 	C_mono_eq_cr_on__pc_match__tes_full c_eq(this, pc_mode, defocus_in);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mono_eq_memo(c_eq));
 
 	// Set up solver
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -5301,6 +5556,7 @@ int C_csp_solver::solver_pc_fixed__tes_empty(double q_dot_pc_fixed /*MWt*/,
 
 	C_mono_eq_pc_target_tes_empty__T_cold c_eq(this, q_dot_pc_fixed);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mono_eq_memo(c_eq));
 
 	// Set up solver
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -5359,6 +5615,7 @@ void C_csp_solver::solver_cr_to_pc_to_cr(int pc_mode, double field_control_in, d
 	
 	C_mono_eq_cr_to_pc_to_cr c_eq(this, pc_mode, m_P_cold_des, -1, field_control_in);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mono_eq_memo(c_eq));
 
 	c_solver.settings(tol, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -53,8 +53,12 @@
 #include <numeric>
 #include <limits>
 #include <memory>
+#include <map>
+#include <typeindex>
+#include <chrono>
 
 #include "lib_weatherfile.h"
+#include "lib_util.h"
 #include "csp_solver_util.h"
 
 #include "numeric_solvers.h"
@@ -281,6 +285,7 @@ public:
         int m_bb_type;
         int m_disp_reporting;
         int m_scaling_type;
+        bool m_is_warm_start;
         int m_max_iterations;
         double m_disp_time_weighting;
         double m_rsu_cost;
@@ -319,6 +324,7 @@ public:
             m_disp_reporting = -1;
             m_presolve_type = -1;
             m_scaling_type = -1;
+            m_is_warm_start = false;
 
             m_disp_time_weighting = 0.99;
             m_rsu_cost = 952.;
@@ -833,6 +839,113 @@ public:
 	
 	C_csp_reported_outputs mc_reported_outputs;
 
+	// Opt-in wall time and call counts of the operating mode branches and component performance calls in Ssimulate
+	class C_instrumentation
+	{
+	public:
+		enum E_component_calls
+		{
+			CR_OFF,
+			CR_STARTUP,
+			CR_ON,
+			PC_CALL,
+			TES_DISCHARGE,
+			TES_DISCHARGE_FULL,
+			TES_CHARGE,
+			TES_CHARGE_FULL,
+			TES_IDLE,
+
+			N_COMPONENT_CALLS
+		};
+
+		enum
+		{
+			N_HIST_BINS = 10	// Component calls per operating mode try: 0, 1, 2, 3-4, 5-8, ..., 65-128, > 128
+		};
+
+		struct S_calls
+		{
+			long m_n_calls;		//[-]
+			double m_time;		//[s] Wall time
+
+			S_calls()
+			{
+				m_n_calls = 0;
+				m_time = 0.0;
+			}
+		};
+
+		struct S_op_mode
+		{
+			long m_n_tries;				//[-] Number of times the operating mode was solved
+			double m_time;				//[s] Wall time solving the operating mode
+			long m_n_component_calls;	//[-]
+			long m_hist[N_HIST_BINS];	//[-] Number of tries by component calls per try
+
+			S_op_mode()
+			{
+				m_n_tries = m_n_component_calls = 0;
+				m_time = 0.0;
+				for( int i = 0; i < N_HIST_BINS; i++ )
+					m_hist[i] = 0;
+			}
+		};
+
+		bool m_is_on;			//[-] Nothing is recorded if false
+
+		double m_time_sim;		//[s] Wall time of the Ssimulate timestep loop
+		S_calls ms_component_calls[N_COMPONENT_CALLS];
+		std::vector<S_op_mode> mv_op_modes;		// Indexed by operating mode
+
+		C_instrumentation();
+
+		void reset();
+
+		void start_op_mode(int op_mode);
+
+		void end_op_mode();
+
+		// Rows: operating modes that were tried. Columns: operating mode, tries, wall time [s], component calls, histogram bins
+		void get_op_mode_table(util::matrix_t<double> & op_modes);
+
+		// Rows: E_component_calls. Columns: calls, wall time [s]
+		void get_component_call_table(util::matrix_t<double> & component_calls);
+
+		// Adds the wall time of its scope to one component call counter
+		class C_call_timer
+		{
+		public:
+			C_call_timer(C_instrumentation & instr, int i_call) : mc_instr(instr), m_i_call(i_call)
+			{
+				if( mc_instr.m_is_on )
+					m_start = std::chrono::high_resolution_clock::now();
+			}
+
+			~C_call_timer()
+			{
+				if( mc_instr.m_is_on )
+				{
+					mc_instr.ms_component_calls[m_i_call].m_n_calls++;
+					mc_instr.ms_component_calls[m_i_call].m_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_start).count();
+					mc_instr.m_n_component_calls++;
+				}
+			}
+
+		private:
+			C_instrumentation & mc_instr;
+			int m_i_call;
+			std::chrono::high_resolution_clock::time_point m_start;
+		};
+
+	private:
+		long m_n_component_calls;	//[-] All component calls
+		int m_op_mode;				//[-] Operating mode being timed
+		long m_op_mode_calls_start;	//[-]
+		std::chrono::high_resolution_clock::time_point m_op_mode_start;
+	};
+
+	C_instrumentation mc_instrumentation;
+
 	struct S_sim_setup
 	{
 		double m_sim_time_start;	//[s]
@@ -1035,6 +1148,60 @@ private:
 	
 	std::vector<double> mv_time_local;
 
+	// Monotonic equation solutions and solver counters, by operating mode and equation type
+	struct S_mono_eq_memo_key
+	{
+		int m_op_mode;				//[-]
+		std::type_index m_eq_type;
+
+		S_mono_eq_memo_key(int op_mode, std::type_index eq_type) : m_op_mode(op_mode), m_eq_type(eq_type)
+		{
+		}
+
+		bool operator<(const S_mono_eq_memo_key & rhs) const
+		{
+			return m_op_mode < rhs.m_op_mode || (m_op_mode == rhs.m_op_mode && m_eq_type < rhs.m_eq_type);
+		}
+	};
+	std::map<S_mono_eq_memo_key, C_monotonic_eq_memo> mm_mono_eq_memo;
+	std::vector<S_mono_eq_memo_key> mv_mono_eq_memo_keys;	// In order of first solve
+	int m_op_mode_memo;			//[-] Operating mode being solved, for the memo keys
+
+	C_monotonic_eq_memo * mono_eq_memo(const C_monotonic_equation & mono_eq);
+
+	// Component performance calls, counted and timed by mc_instrumentation
+	void cr_off(const C_csp_weatherreader::S_outputs &weather,
+		const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver,
+		const C_csp_solver_sim_info &sim_info);
+
+	void cr_startup(const C_csp_weatherreader::S_outputs &weather,
+		const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver,
+		const C_csp_solver_sim_info &sim_info);
+
+	void cr_on(const C_csp_weatherreader::S_outputs &weather,
+		const C_csp_solver_htf_1state &htf_state_in,
+		double field_control,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver,
+		const C_csp_solver_sim_info &sim_info);
+
+	void pc_call(const C_csp_weatherreader::S_outputs &weather,
+		C_csp_solver_htf_1state &htf_state_in,
+		const C_csp_power_cycle::S_control_inputs &inputs,
+		C_csp_power_cycle::S_csp_pc_out_solver &out_solver,
+		const C_csp_solver_sim_info &sim_info);
+
+	bool tes_discharge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs);
+
+	void tes_discharge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_cold_in, double & T_htf_hot_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs);
+
+	bool tes_charge(double timestep /*s*/, double T_amb /*K*/, double m_dot_htf_in /*kg/s*/, double T_htf_hot_in, double & T_htf_cold_out /*K*/, C_csp_tes::S_csp_tes_outputs &outputs);
+
+	void tes_charge_full(double timestep /*s*/, double T_amb /*K*/, double T_htf_hot_in /*K*/, double & T_htf_cold_out /*K*/, double & m_dot_htf_out /*kg/s*/, C_csp_tes::S_csp_tes_outputs &outputs);
+
+	void tes_idle(double timestep, double T_amb, C_csp_tes::S_csp_tes_outputs &outputs);
+
 	bool(*mpf_callback)(std::string &log_msg, std::string &progress_msg, void *data, double progress, int log_type);
 	void *mp_cmod_active;
 
@@ -1048,6 +1215,10 @@ public:
 	// Vector to track operating modes
 	std::vector<int> m_op_mode_tracking;
 
+	// Start each operating mode iteration from the solution of the same equation in the previous solve of that mode?
+	//    Solver counters are reported by get_mono_eq_counters either way
+	bool m_is_mono_eq_memo;
+
 	enum tech_operating_modes
 	{
 		ENTRY_MODE = 0,
@@ -1129,6 +1300,11 @@ public:
 
 	double get_cr_aperture_area();
 
+	// One row per operating mode and equation type: operating mode, equation number within the mode (in order of first solve),
+	//    number of solves, equation calls, solves started from the previous solution, seeded solves repeated from the default guesses,
+	//    and solve wall time [s] if mc_instrumentation is on
+	void get_mono_eq_counters(util::matrix_t<double> & counters);
+
 	// Output vectors
 	// Need to be sure these are always up-to-date as multiple operating modes are tested during one timestep
 	std::vector< std::vector< double > > mvv_outputs_temp;
@@ -59,6 +59,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_q_dot_max__tes_off__defocus::operator()(double
 {
 	C_mono_eq_cr_to_pc_to_cr c_eq(mpc_csp_solver, m_pc_mode, mpc_csp_solver->m_P_cold_des, -1, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
 
@@ -107,7 +108,7 @@ int C_csp_solver::C_mono_eq_cr_to_pc_to_cr::operator()(double T_htf_cold /*C*/,
 	mpc_csp_solver->mc_cr_htf_state_in.m_pres = m_P_field_in;	//[kPa]
 	mpc_csp_solver->mc_cr_htf_state_in.m_qual = m_x_field_in;	//[-]
 	
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 						mpc_csp_solver->mc_cr_htf_state_in,
 						m_field_control_in,
 						mpc_csp_solver->mc_cr_out_solver,
@@ -137,7 +138,7 @@ int C_csp_solver::C_mono_eq_cr_to_pc_to_cr::operator()(double T_htf_cold /*C*/,
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = mpc_csp_solver->mc_cr_out_solver.m_m_dot_salt_tot;	//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 						mpc_csp_solver->mc_pc_htf_state_in,
 						mpc_csp_solver->mc_pc_inputs,
 						mpc_csp_solver->mc_pc_out_solver,
@@ -161,7 +162,7 @@ int C_csp_solver::C_mono_eq_pc_su_cont_tes_dc::operator()(double T_htf_hot /*C*/
 	mpc_csp_solver->mc_pc_htf_state_in.m_temp = T_htf_hot;		//[C] convert from K
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP_CONTROLLED;
 
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 							mpc_csp_solver->mc_pc_htf_state_in,
 							mpc_csp_solver->mc_pc_inputs,
 							mpc_csp_solver->mc_pc_out_solver,
@@ -179,7 +180,7 @@ int C_csp_solver::C_mono_eq_pc_su_cont_tes_dc::operator()(double T_htf_hot /*C*/
 	// Solve TES discharge
 	double T_htf_hot_calc = std::numeric_limits<double>::quiet_NaN();
 	double T_htf_cold = mpc_csp_solver->mc_pc_out_solver.m_T_htf_cold;		//[C]
-	bool is_dc_solved = mpc_csp_solver->mc_tes.discharge(m_time_pc_su, 
+	bool is_dc_solved = mpc_csp_solver->tes_discharge(m_time_pc_su, 
 											mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15, 
 											m_dot_pc,
 											T_htf_cold + 273.15,
@@ -214,7 +215,7 @@ int C_csp_solver::C_mono_eq_pc_su_cont_tes_dc::operator()(double T_htf_hot /*C*/
 int C_csp_solver::C_mono_eq_pc_target_tes_dc__m_dot::operator()(double m_dot_htf /*kg/hr*/, double *q_dot_pc /*MWt*/)
 {
 	double T_htf_hot = std::numeric_limits<double>::quiet_NaN();
-	bool is_tes_success = mpc_csp_solver->mc_tes.discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	bool is_tes_success = mpc_csp_solver->tes_discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 												mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 												m_dot_htf / 3600.0,
 												m_T_htf_cold + 273.15,
@@ -245,7 +246,7 @@ int C_csp_solver::C_mono_eq_pc_target_tes_dc__m_dot::operator()(double m_dot_htf
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_htf;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 		// Performance
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 									mpc_csp_solver->mc_pc_htf_state_in,
 									mpc_csp_solver->mc_pc_inputs,
 									mpc_csp_solver->mc_pc_out_solver,
@@ -267,6 +268,7 @@ int C_csp_solver::C_mono_eq_pc_target_tes_dc__T_cold::operator()(double T_htf_co
 	// Expect mc_pc_out_solver to be set in inner mono eq loop that converges m_dot_htf
 	C_mono_eq_pc_target_tes_dc__m_dot c_eq(mpc_csp_solver, m_pc_mode, T_htf_cold);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	// Calculate the maximum mass flow rate available for discharge
 	double q_dot_tes_dc_max, m_dot_tes_dc_max, T_htf_hot_dc_max;
@@ -394,7 +396,7 @@ int C_csp_solver::C_mono_eq_pc_match_tes_empty::operator()(double T_htf_cold /*C
 	// First, get the maximum possible mass flow rate from a full TES discharge
 	double T_htf_tes_hot, m_dot_tes_dc;
 	T_htf_tes_hot = m_dot_tes_dc = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_cold + 273.15,
 							T_htf_tes_hot, 
@@ -420,7 +422,7 @@ int C_csp_solver::C_mono_eq_pc_match_tes_empty::operator()(double T_htf_cold /*C
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::ON;
 
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -436,7 +438,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C
 	// Solve the receiver model
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										mpc_csp_solver->m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -454,7 +456,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C
 	mpc_csp_solver->mc_pc_htf_state_in.m_temp = mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot;		//[C]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::STARTUP_CONTROLLED;
 
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 								mpc_csp_solver->mc_pc_htf_state_in,
 								mpc_csp_solver->mc_pc_inputs,
 								mpc_csp_solver->mc_pc_out_solver,
@@ -480,7 +482,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_su_tes_ch::operator()(double T_htf_cold /*C
 	}
 
 	double T_htf_tes_cold = std::numeric_limits<double>::quiet_NaN();
-	bool ch_solved = mpc_csp_solver->mc_tes.charge(m_step_pc_su, 
+	bool ch_solved = mpc_csp_solver->tes_charge(m_step_pc_su, 
 									mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 									m_dot_tes_ch / 3600.0,
 									mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot + 273.15,
@@ -522,7 +524,7 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot::operator()(double m_dot_htf_pc /*k
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;	//[-]
 
 	// Power cycle performance call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 								mpc_csp_solver->mc_pc_htf_state_in,
 								mpc_csp_solver->mc_pc_inputs,
 								mpc_csp_solver->mc_pc_out_solver,
@@ -545,7 +547,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_ch__T_cold::operator()(double T_
 	// Solve the CR
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -571,6 +573,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_ch__T_cold::operator()(double T_
 	// Try max sending max mass flow rate to power cycle and check calculated thermal power
 	C_mono_eq_pc_target__m_dot c_eq(mpc_csp_solver, m_pc_mode, mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	double q_dot_pc_calc = std::numeric_limits<double>::quiet_NaN();	//[MWt]
 	int q_dot_pc_code = c_solver.test_member_function(m_dot_pc_max, &q_dot_pc_calc);
@@ -662,7 +665,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_ch__T_cold::operator()(double T_
 	}
 
 	double T_tes_cold_out = std::numeric_limits<double>::quiet_NaN();	//[K]
-	bool is_tes_success = mpc_csp_solver->mc_tes.charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	bool is_tes_success = mpc_csp_solver->tes_charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 												mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 												m_dot_tes / 3600.0,
 												mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot + 273.15,
@@ -699,7 +702,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 	// Solve the CR model
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -714,7 +717,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 
 	// Now solve TES full discharge
 	double T_htf_tes_dc, m_dot_tes_dc;
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_cold + 273.15,
 							T_htf_tes_dc,
@@ -746,7 +749,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_pc;		//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = C_csp_power_cycle::ON;
 		// Performance
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 									mpc_csp_solver->mc_pc_htf_state_in,
 									mpc_csp_solver->mc_pc_inputs,
 									mpc_csp_solver->mc_pc_out_solver,
@@ -769,7 +772,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_match_tes_empty::operator()(double T_htf_co
 int C_csp_solver::C_mono_eq_pc_target__m_dot_fixed_plus_tes_dc::operator()(double m_dot_tes_dc /*kg/hr*/, double *q_dot_pc /*MWt*/)
 {
 	double T_htf_tes_hot = std::numeric_limits<double>::quiet_NaN();
-	bool is_tes_success = mpc_csp_solver->mc_tes.discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	bool is_tes_success = mpc_csp_solver->tes_discharge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 								mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 								m_dot_tes_dc / 3600.0,
 								m_T_htf_cold + 273.15,
@@ -804,7 +807,7 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot_fixed_plus_tes_dc::operator()(doubl
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_htf_pc;		//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;				//[-]
 	// Performance
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -824,7 +827,7 @@ int C_csp_solver::C_mono_eq_pc_target__m_dot_fixed_plus_tes_dc::operator()(doubl
 int C_csp_solver::C_mono_eq_pc_target_tes_empty__x_step::operator()(double step /*s*/, double *q_dot_pc /*MWt*/)
 {
 	double T_htf_tes_hot, m_dot_tes_dc = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(step,
+	mpc_csp_solver->tes_discharge_full(step,
 						mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 						m_T_htf_cold + 273.15,
 						T_htf_tes_hot,
@@ -859,7 +862,7 @@ int C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::operator()(double T_htf
 	//   ... using the guess value for the TES cold inlet temperature
 	double T_htf_tes_hot, m_dot_htf_full_ts;
 	T_htf_tes_hot = m_dot_htf_full_ts = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_cold + 273.15,
 							T_htf_tes_hot,
@@ -872,6 +875,7 @@ int C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::operator()(double T_htf
 	
 	C_mono_eq_pc_target_tes_empty__x_step c_eq(mpc_csp_solver, T_htf_cold);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	double time_max = mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step;		//[s]
 
@@ -975,7 +979,7 @@ void C_csp_solver::C_mono_eq_pc_target_tes_empty__T_cold::solve_pc(double step /
 		step;	//[s]
 
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -986,7 +990,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_dc::operator()(double T_htf_cold
 {
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 									mpc_csp_solver->mc_cr_htf_state_in,
 									m_defocus,
 									mpc_csp_solver->mc_cr_out_solver,
@@ -1007,6 +1011,7 @@ int C_csp_solver::C_mono_eq_cr_on_pc_target_tes_dc::operator()(double T_htf_cold
 										m_pc_mode, T_htf_cold,
 										T_htf_rec_hot, m_dot_rec);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	// Call the power cycle with the smallest possible mass flow rate: m_dot_rec
 	//if (m_dot_rec > mpc_csp_solver->m_m_dot_pc_max)
@@ -1111,7 +1116,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_c
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 										mpc_csp_solver->mc_cr_htf_state_in,
 										m_defocus,
 										mpc_csp_solver->mc_cr_out_solver,
@@ -1131,7 +1136,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_c
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 							mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 							T_htf_rec_hot + 273.15,
 							T_htf_tes_cold,
@@ -1172,7 +1177,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match__tes_full::operator()(double T_htf_c
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_pc;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 		// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 							mpc_csp_solver->mc_pc_htf_state_in,
 							mpc_csp_solver->mc_pc_inputs,
 							mpc_csp_solver->mc_pc_out_solver,
@@ -1202,7 +1207,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_h
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1235,7 +1240,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_h
 	}
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1265,7 +1270,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_max_m_dot__tes_full::operator()(double T_h
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(step_calc,
+	mpc_csp_solver->tes_charge_full(step_calc,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_rec_hot + 273.15,
 		T_htf_tes_cold,
@@ -1314,6 +1319,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_m_dot_max__tes_full_defocus::operator()(do
 {
 	C_mono_eq_cr_on__pc_max_m_dot__tes_full c_eq(mpc_csp_solver, m_pc_mode, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	// Set up solver
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -1367,7 +1373,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(dou
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1387,7 +1393,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(dou
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_rec_hot + 273.15, 
 		T_htf_tes_cold,
@@ -1416,7 +1422,7 @@ int C_csp_solver::C_mono_eq_cr_on__pc_match_m_dot_ceil__tes_full::operator()(dou
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = m_dot_pc;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1446,6 +1452,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_m_dot_max__tes_off__defocus::operator()(double
 {
 	C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold c_eq(mpc_csp_solver, m_pc_mode, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	// Set up solver
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
@@ -1499,7 +1506,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold::operator()(dou
 	// Solve the receiver model with T_htf_cold
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1524,7 +1531,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_max_m_dot__tes_off__T_htf_cold::operator()(dou
 	mpc_csp_solver->mc_pc_inputs.m_m_dot = mpc_csp_solver->m_m_dot_pc_max;				//[kg/hr]
 	mpc_csp_solver->mc_pc_inputs.m_standby_control = m_pc_mode;		//[-]
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1551,7 +1558,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold::operator()(double T_h
 	// Solve the collector-receiver
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1566,7 +1573,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_off__tes_ch__T_htf_cold::operator()(double T_h
 
 	// Now, solved TES charge with CR outputs
 	double T_htf_tes_cold_out = std::numeric_limits<double>::quiet_NaN();
-	bool tes_charge_success = mpc_csp_solver->mc_tes.charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step, 
+	bool tes_charge_success = mpc_csp_solver->tes_charge(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step, 
 								mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15, 
 								mpc_csp_solver->mc_cr_out_solver.m_m_dot_salt_tot / 3600.0, 
 								mpc_csp_solver->mc_cr_out_solver.m_T_salt_hot + 273.15,
@@ -1604,7 +1611,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::operator()(doub
 	// Solve CR at full timestep
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1625,7 +1632,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::operator()(doub
 	// ... using the guess value for the TES cold inlet temperature
 	double T_htf_tes_hot, m_dot_htf_full_ts;
 	T_htf_tes_hot = m_dot_htf_full_ts = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_discharge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_cold + 273.15,
 		T_htf_tes_hot,
@@ -1638,6 +1645,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::operator()(doub
 
 	C_MEQ_cr_on__pc_target__tes_empty__step c_eq(mpc_csp_solver, m_defocus, T_htf_cold);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	double time_max = mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step;		//[s]
 
@@ -1761,7 +1769,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__step::operator()(double ste
 
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = m_T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1780,7 +1788,7 @@ int C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__step::operator()(double ste
 	double q_dot_rec = mpc_csp_solver->mc_cr_out_solver.m_q_thermal;		//[MWt]
 
 	double T_htf_tes_hot, m_dot_tes_dc = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.discharge_full(step,
+	mpc_csp_solver->tes_discharge_full(step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		m_T_htf_cold + 273.15,
 		T_htf_tes_hot,
@@ -1826,7 +1834,7 @@ void C_csp_solver::C_MEQ_cr_on__pc_target__tes_empty__T_htf_cold::solve_pc(doubl
 		step;	//[s]
 
 	// Performance Call
-	mpc_csp_solver->mc_power_cycle.call(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->pc_call(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_pc_htf_state_in,
 		mpc_csp_solver->mc_pc_inputs,
 		mpc_csp_solver->mc_pc_out_solver,
@@ -1837,7 +1845,7 @@ int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__T_cold::operator()(double T_htf
 {
 	mpc_csp_solver->mc_cr_htf_state_in.m_temp = T_htf_cold;		//[C]
 
-	mpc_csp_solver->mc_collector_receiver.on(mpc_csp_solver->mc_weather.ms_outputs,
+	mpc_csp_solver->cr_on(mpc_csp_solver->mc_weather.ms_outputs,
 		mpc_csp_solver->mc_cr_htf_state_in,
 		m_defocus,
 		mpc_csp_solver->mc_cr_out_solver,
@@ -1856,7 +1864,7 @@ int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__T_cold::operator()(double T_htf
 	// Solve TES for *full* charge
 	double T_htf_tes_cold, m_dot_tes;
 	T_htf_tes_cold = m_dot_tes = std::numeric_limits<double>::quiet_NaN();
-	mpc_csp_solver->mc_tes.charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
+	mpc_csp_solver->tes_charge_full(mpc_csp_solver->mc_kernel.mc_sim_info.ms_ts.m_step,
 		mpc_csp_solver->mc_weather.ms_outputs.m_tdry + 273.15,
 		T_htf_rec_hot + 273.15,
 		T_htf_tes_cold,
@@ -1885,6 +1893,7 @@ int C_csp_solver::C_MEQ_cr_df__pc_off__tes_full__defocus::operator()(double defo
 {
 	C_MEQ_cr_df__pc_off__tes_full__T_cold c_eq(mpc_csp_solver, defocus);
 	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.set_memo(mpc_csp_solver->mono_eq_memo(c_eq));
 
 	// Set up solver
 	c_solver.settings(1.E-3, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), false);
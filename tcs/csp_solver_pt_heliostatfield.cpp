@@ -53,6 +53,7 @@
 
 #include "interpolation_routines.h"
 #include "AutoPilot_API.h"
+#include "API_cache.h"
 #include "IOUtil.h"
 #include "sort_method.h"
 #include "Heliostat.h"
@@ -60,6 +61,7 @@
 #include "lib_weatherfile.h"
 
 #include <sstream>
+#include <memory>
 
 #define az_scale 6.283125908 
 #define zen_scale 1.570781477 
@@ -335,7 +337,18 @@ void C_pt_heliostatfield::init()
 		case RUN_TYPE::AUTO:
 		case RUN_TYPE::USER_FIELD:
 		{
-			AutoPilot_S sapi;
+			// simulate sun positions on separate threads when more than one thread is requested
+			std::unique_ptr<AutoPilot> p_sapi;
+			if( ms_params.m_n_threads != 1 )
+			{
+				AutoPilot_MT *sapi_mt = new AutoPilot_MT();
+				sapi_mt->SetMaxThreadCount(ms_params.m_n_threads);
+				p_sapi.reset(sapi_mt);
+			}
+			else
+				p_sapi.reset(new AutoPilot_S());
+			AutoPilot &sapi = *p_sapi;
+			sapi.SetSimulationThreads(ms_params.m_n_threads);
 
 			sp_optimize opt;
 			sp_layout layout;
@@ -437,6 +450,7 @@ void C_pt_heliostatfield::init()
 			V.opt.algorithm.combo_select_by_mapval(1);
 			V.opt.flux_penalty.val = 0.25;
 
+			vector<string> wfdata;
 			if(run_type == RUN_TYPE::AUTO)
 			{
 				V.recs.front().peak_flux.val = 1000.0;
@@ -446,10 +460,6 @@ void C_pt_heliostatfield::init()
 				V.opt.algorithm.combo_select_by_mapval(1);
 				V.opt.flux_penalty.val = 0.25;
 
-				/* 
-				Generate the heliostat field layout using the settings provided by the user				
-				*/
-				vector<string> wfdata;
 				wfdata.reserve( 8760 );
 				for( int i=0;i<8760;i++ )
 				{
@@ -464,21 +474,66 @@ void C_pt_heliostatfield::init()
 						rec.day, rec.hour, rec.month, rec.dn, rec.tdry, rec.pres / 1000., rec.wspd);
 					wfdata.push_back(error_msg);
 				}
+			}
+			else
+			{
 
-				if( mf_callback && m_cdata )
+				/* 
+				Load in the heliostat field positions that are provided by the user.
+				*/
+				string format = "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;";
+                V.sf.layout_data.val.clear();
+
+                char row[200];
+				for( int i=0; i<m_N_hel; i++)
 				{
-					sapi.SetSummaryCallback(mf_callback, m_cdata);
+                    sprintf(row, format.c_str(), helio_positions(i,0), helio_positions(i,1), pos_dim == 3 ? helio_positions(i,2) : 0. );
+
+                    V.sf.layout_data.val.append( row );
+
 				}
-				sapi.SetSummaryCallbackStatus(false);
 
+                //set the template name 
+                V.sf.temp_which.set_from_string( "Template 1" );
+			}
 
+			//check for results saved by an earlier run with the same inputs
+			sp_field_cache cache;
+			cache.SetDirectory(ms_params.m_cache_dir);
 
-				sapi.GenerateDesignPointSimulations( V, wfdata );
-	
-				sapi.Setup(V);
+			sp_flux_table fluxtab;
+			bool is_cached = false;
+			if( cache.IsEnabled() )
+			{
+				cache.StartKey(V);
+				cache.AddToKey( util::format("%d,%d,%d,%d,%d", run_type, m_n_flux_x, m_n_flux_y, n_flux_days, delta_flux_hrs) );
+				for( size_t i=0; i<wfdata.size(); i++ )
+					cache.AddToKey( wfdata[i] );
+
+				vector<double> cache_values;
+				is_cached = cache.Load(V, layout, fluxtab, cache_values);
+				mc_csp_messages.add_message(C_csp_messages::NOTICE, (is_cached ? "Loaded SolarPILOT results from cache: " : "No cached SolarPILOT results found, running simulation: ") + cache.GetFilePath());
+			}
 
-				sapi.CreateLayout(layout);
+			if(run_type == RUN_TYPE::AUTO)
+			{
+				/* 
+				Generate the heliostat field layout using the settings provided by the user				
+				*/
+				if(! is_cached)
+				{
+					if( mf_callback && m_cdata )
+					{
+						sapi.SetSummaryCallback(mf_callback, m_cdata);
+					}
+					sapi.SetSummaryCallbackStatus(false);
 
+					sapi.GenerateDesignPointSimulations( V, wfdata );
+	
+					sapi.Setup(V);
+
+					sapi.CreateLayout(layout);
+				}
 
 				//Copy the heliostat field positions into the 'helio_positions' data structure
 				m_N_hel = (int)layout.heliostat_positions.size();
@@ -498,56 +553,45 @@ void C_pt_heliostatfield::init()
 				sapi.SetDetailCallbackStatus(false);
 				
 			}
-			else{
-
-				/* 
-				Load in the heliostat field positions that are provided by the user.
-				*/
-				string format = "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;";
-                V.sf.layout_data.val.clear();
-
-                char row[200];
-				for( int i=0; i<m_N_hel; i++)
-				{
-                    sprintf(row, format.c_str(), helio_positions(i,0), helio_positions(i,1), pos_dim == 3 ? helio_positions(i,2) : 0. );
-
-                    V.sf.layout_data.val.append( row );
-
-				}
-
-                //set the template name 
-                V.sf.temp_which.set_from_string( "Template 1" ); 
-
+			else if(! is_cached)
+			{
                 sapi.Setup(V);
-								
 			}
+
             //land area update
 			ms_params.m_land_area = V.land.land_area.Val();		//value(P_land_area, layout.land_area);
 
-			if(!mf_callback || !m_cdata)
-				sapi.SetSummaryCallbackStatus(false);
-			else
+			if(! is_cached)
 			{
-				sapi.SetSummaryCallbackStatus(true);
-				sapi.SetSummaryCallback(mf_callback, m_cdata);
-			}
+				if(!mf_callback || !m_cdata)
+					sapi.SetSummaryCallbackStatus(false);
+				else
+				{
+					sapi.SetSummaryCallbackStatus(true);
+					sapi.SetSummaryCallback(mf_callback, m_cdata);
+				}
 
-			
+				// set up flux map resolution
+				fluxtab.is_user_spacing = true;
+				fluxtab.n_flux_days = n_flux_days;
+				fluxtab.delta_flux_hrs = delta_flux_hrs;
 
-			// set up flux map resolution
-			sp_flux_table fluxtab;
-			fluxtab.is_user_spacing = true;
-			fluxtab.n_flux_days = n_flux_days;
-			fluxtab.delta_flux_hrs = delta_flux_hrs;
+				//run the flux maps
+				if( m_n_flux_y == 1 )
+					V.flux.aim_method.combo_select_by_mapval( var_fluxsim::AIM_METHOD::SIMPLE_AIM_POINTS );
 
-			//run the flux maps
-            if( m_n_flux_y == 1 )
-                V.flux.aim_method.combo_select_by_mapval( var_fluxsim::AIM_METHOD::SIMPLE_AIM_POINTS );
+				if(! sapi.CalculateFluxMaps(fluxtab, m_n_flux_x, m_n_flux_y, true) )
+				{
+					throw(C_csp_exception("Simulation cancelled during fluxmap preparation","heliostat field initialization"));
+				}
 
-			if(! sapi.CalculateFluxMaps(fluxtab, m_n_flux_x, m_n_flux_y, true) )
-			{
-				throw(C_csp_exception("Simulation cancelled during fluxmap preparation","heliostat field initialization"));
-            }
+				if( cache.IsEnabled() )
+				{
+					vector<double> cache_values;
+					if(! cache.Store(V, layout, fluxtab, cache_values) )
+						mc_csp_messages.add_message(C_csp_messages::WARNING, "Could not save SolarPILOT results to cache: " + cache.GetFilePath());
+				}
+			}
 
 			//collect efficiencies
 			sunpos.clear();
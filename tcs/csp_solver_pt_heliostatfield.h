@@ -185,6 +185,9 @@ public:
 		double m_dni_des;
 		double m_land_area;
 
+		int m_n_threads;	//[-] Number of threads for SolarPILOT simulations, 0 = number of hardware threads
+		std::string m_cache_dir;	//[-] Directory for saving and reusing SolarPILOT results, empty to disable
+
 		double m_A_sf;		//[m2]
 
 		S_params()
@@ -194,6 +197,8 @@ public:
 				/*m_nrows_helio_aim_points = m_ncols_helio_aim_points =*/ /*m_nrows_eta_map = m_ncols_eta_map =*/ /*m_nfluxpos = m_nfposdim = */
 				/*m_nfluxmap = m_nfluxcol =*/ m_n_facet_x = m_n_facet_y = m_cant_type = m_focus_type = m_n_flux_days = m_delta_flux_hrs = -1;
 
+			m_n_threads = 1;
+
 			// Doubles
 			m_helio_width = m_helio_height = m_helio_optical_error = m_helio_active_fraction = m_dens_mirror = m_helio_reflectance = m_rec_absorptance = m_rec_height = m_rec_aspect =
 				m_rec_hl_perm2 = m_q_design = m_h_tower = m_land_max = m_land_min = m_p_start = m_p_track = m_hel_stow_deploy = m_v_wind_max = m_interp_nug =
@@ -204,6 +209,7 @@ public:
 
 			// strings
 			m_weather_file = "";
+			m_cache_dir = "";
 		}		
 	};
 
@@ -50,6 +50,7 @@
 #include "htf_props.h"
 #include "csp_solver_util.h"
 #include <cmath>
+#include <algorithm>
 
 HTFProperties::HTFProperties()
 {
@@ -57,6 +58,13 @@ HTFProperties::HTFProperties()
 	uf_err_msg = "The user-defined htf property table is invalid (rows=%d cols=%d)";
 
 	m_is_temp_enth_avail = false;
+
+	m_is_prop_table_avail = false;
+	m_is_prop_table_dens = false;
+	m_prop_table_T_low = m_prop_table_T_high = std::numeric_limits<double>::quiet_NaN();
+	m_prop_table_dT_target = -1.0;
+	m_prop_table_dT_inv = std::numeric_limits<double>::quiet_NaN();
+	m_prop_table_n_int = 0;
 }
 
 bool HTFProperties::SetUserDefinedFluid(const util::matrix_t<double> &table, bool calc_temp_enth_table)
@@ -75,6 +83,9 @@ bool HTFProperties::SetUserDefinedFluid( const util::matrix_t<double> &table )
 	m_userTable = table;	
 	m_fluid = User_defined;
 
+	// User defined fluids are interpolated from their own table
+	m_is_prop_table_avail = false;
+
 	// Specific which columns are used as the independent variable; these must be monotonically increasing
 	int ind_var_index[2] = {0, 6};	
 	int n_ind_var = 2;
@@ -193,6 +204,11 @@ bool HTFProperties::SetFluid( int fluid )
 	// If using stored fluid properties, set member fluid number
 	m_fluid = fluid;
 
+	if( m_prop_table_dT_target > 0.0 )
+	{
+		set_prop_table();
+	}
+
 	if( m_is_temp_enth_avail )
 	{
 		set_temp_enth_lookup();
@@ -201,6 +217,186 @@ bool HTFProperties::SetFluid( int fluid )
 	return true;
 }
 
+bool HTFProperties::SetPropertyTable(double T_low_K, double T_high_K, double delta_T_target /*K*/)
+{
+	if( !(T_low_K > 0.0) || !(T_high_K > T_low_K) || !(delta_T_target > 0.0) )
+	{
+		throw(C_csp_exception("The property table requires 0 < T_low < T_high and a positive temperature step",
+			"HTFProperties::SetPropertyTable"));
+	}
+
+	m_prop_table_T_low = T_low_K;
+	m_prop_table_T_high = T_high_K;
+	m_prop_table_dT_target = delta_T_target;
+
+	set_prop_table();
+
+	return m_is_prop_table_avail;
+}
+
+void HTFProperties::ClearPropertyTable()
+{
+	m_is_prop_table_avail = false;
+	m_prop_table_dT_target = -1.0;
+	m_prop_table_n_int = 0;
+	m_prop_table_coefs.clear();
+}
+
+void HTFProperties::set_prop_table()
+{
+	// Evaluate the correlations below, not the table being replaced
+	m_is_prop_table_avail = false;
+
+	if( m_fluid < Air || m_fluid >= End_Library_Fluids )
+		return;
+
+	// Density of the gases depends on pressure and stays on the correlations
+	m_is_prop_table_dens = !(m_fluid == Air || m_fluid == Argon_ideal || m_fluid == Hydrogen_ideal);
+
+	int n_int = (int)ceil((m_prop_table_T_high - m_prop_table_T_low) / m_prop_table_dT_target);
+	double delta_T = (m_prop_table_T_high - m_prop_table_T_low) / double(n_int);
+
+	// Cubic Hermite segments with node slopes from central differences of the correlations.
+	//   Coefficients are in terms of the normalized position t = [0,1] in each interval
+	double h = 1.E-3*delta_T;		//[K] finite difference step
+
+	m_prop_table_coefs.assign(E_table_n_props*n_int*4, std::numeric_limits<double>::quiet_NaN());
+
+	std::vector<double> f(n_int + 1), df(n_int + 1);
+
+	for( int i_prop = 0; i_prop < E_table_n_props; i_prop++ )
+	{
+		if( i_prop == E_table_dens && !m_is_prop_table_dens )
+			continue;
+
+		for( int j = 0; j <= n_int; j++ )
+		{
+			double T_j = m_prop_table_T_low + delta_T*j;
+			double f_low, f_high;
+			switch( i_prop )
+			{
+			case E_table_Cp:
+				f[j] = Cp(T_j); f_low = Cp(T_j - h); f_high = Cp(T_j + h);
+				break;
+			case E_table_dens:
+				f[j] = dens(T_j, 1.0); f_low = dens(T_j - h, 1.0); f_high = dens(T_j + h, 1.0);
+				break;
+			case E_table_visc:
+				f[j] = visc(T_j); f_low = visc(T_j - h); f_high = visc(T_j + h);
+				break;
+			case E_table_cond:
+				f[j] = cond(T_j); f_low = cond(T_j - h); f_high = cond(T_j + h);
+				break;
+			default:
+				f[j] = enth(T_j); f_low = enth(T_j - h); f_high = enth(T_j + h);
+				break;
+			}
+			df[j] = (f_high - f_low) / (2.0*h)*delta_T;		// slope per normalized interval
+		}
+
+		double *c = &m_prop_table_coefs[i_prop*n_int*4];
+		for( int j = 0; j < n_int; j++ )
+		{
+			c[4*j] = f[j];
+			c[4*j+1] = df[j];
+			c[4*j+2] = 3.0*(f[j+1] - f[j]) - 2.0*df[j] - df[j+1];
+			c[4*j+3] = 2.0*(f[j] - f[j+1]) + df[j] + df[j+1];
+		}
+	}
+
+	m_prop_table_n_int = n_int;
+	m_prop_table_dT_inv = 1.0 / delta_T;
+	m_is_prop_table_avail = true;
+}
+
+double HTFProperties::prop_table_interp(int i_prop, double T_K)
+{
+	prop_table_interp(i_prop, &T_K, 1, &T_K);
+	return T_K;
+}
+
+void HTFProperties::prop_table_interp(int i_prop, const double *T_K, int n, double *out)
+{
+	// Temperatures must be inside the table. Out of range values are clamped to the end intervals,
+	//   so callers handle them separately
+	const double *c = &m_prop_table_coefs[i_prop*m_prop_table_n_int*4];
+	double T_low = m_prop_table_T_low;
+	double dT_inv = m_prop_table_dT_inv;
+	double x_max = (double)m_prop_table_n_int;
+	int j_max = m_prop_table_n_int - 1;
+
+	for( int i = 0; i < n; i++ )
+	{
+		double x = std::min(std::max(0.0, (T_K[i] - T_low)*dT_inv), x_max);	// NaN maps to 0
+		int j = std::min((int)x, j_max);
+		double t = x - j;
+		const double *cj = c + 4*j;
+		out[i] = cj[0] + t*(cj[1] + t*(cj[2] + t*cj[3]));
+	}
+}
+
+void HTFProperties::Cp(const double *T_K, int n, double *Cp_out)
+{
+	if( m_is_prop_table_avail )
+		prop_table_interp(E_table_Cp, T_K, n, Cp_out);
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( !m_is_prop_table_avail || !(T_K[i] >= m_prop_table_T_low && T_K[i] <= m_prop_table_T_high) )
+			Cp_out[i] = Cp(T_K[i]);
+	}
+}
+
+void HTFProperties::dens(const double *T_K, double P, int n, double *dens_out)
+{
+	bool is_table = m_is_prop_table_avail && m_is_prop_table_dens;
+
+	if( is_table )
+		prop_table_interp(E_table_dens, T_K, n, dens_out);
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( !is_table || !(T_K[i] >= m_prop_table_T_low && T_K[i] <= m_prop_table_T_high) )
+			dens_out[i] = dens(T_K[i], P);
+	}
+}
+
+void HTFProperties::visc(const double *T_K, int n, double *visc_out)
+{
+	if( m_is_prop_table_avail )
+		prop_table_interp(E_table_visc, T_K, n, visc_out);
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( !m_is_prop_table_avail || !(T_K[i] >= m_prop_table_T_low && T_K[i] <= m_prop_table_T_high) )
+			visc_out[i] = visc(T_K[i]);
+	}
+}
+
+void HTFProperties::cond(const double *T_K, int n, double *cond_out)
+{
+	if( m_is_prop_table_avail )
+		prop_table_interp(E_table_cond, T_K, n, cond_out);
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( !m_is_prop_table_avail || !(T_K[i] >= m_prop_table_T_low && T_K[i] <= m_prop_table_T_high) )
+			cond_out[i] = cond(T_K[i]);
+	}
+}
+
+void HTFProperties::enth(const double *T_K, int n, double *enth_out)
+{
+	if( m_is_prop_table_avail )
+		prop_table_interp(E_table_enth, T_K, n, enth_out);
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( !m_is_prop_table_avail || !(T_K[i] >= m_prop_table_T_low && T_K[i] <= m_prop_table_T_high) )
+			enth_out[i] = enth(T_K[i]);
+	}
+}
+
 const util::matrix_t<double> *HTFProperties::get_prop_table()
 {
 	return &m_userTable;
@@ -251,6 +447,9 @@ double HTFProperties::Cp( double T_K )
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( m_is_prop_table_avail && T_K >= m_prop_table_T_low && T_K <= m_prop_table_T_high )
+		return prop_table_interp(E_table_Cp, T_K);
+
 	double T_C = T_K - 273.15;		// Also provide temperature in C
 
 	switch(m_fluid)
@@ -330,6 +529,9 @@ double HTFProperties::dens(double T_K, double P)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( m_is_prop_table_avail && m_is_prop_table_dens && T_K >= m_prop_table_T_low && T_K <= m_prop_table_T_high )
+		return prop_table_interp(E_table_dens, T_K);
+
 	double T_C = T_K - 273.15;		// This function accepts as inputs temperature[K]. Convert to [C] for correlations
 
 	switch(m_fluid)
@@ -408,6 +610,9 @@ double HTFProperties::visc(double T_K)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( m_is_prop_table_avail && T_K >= m_prop_table_T_low && T_K <= m_prop_table_T_high )
+		return prop_table_interp(E_table_visc, T_K);
+
 	double T_C = T_K - 273.15;		// This function accepts as inputs temperature[K]. Convert to [C] for correlations
 
 	switch(m_fluid)
@@ -495,6 +700,9 @@ double HTFProperties::cond(double T_K)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( m_is_prop_table_avail && T_K >= m_prop_table_T_low && T_K <= m_prop_table_T_high )
+		return prop_table_interp(E_table_cond, T_K);
+
 	double T_C = T_K - 273.15;
 
 	switch(m_fluid)
@@ -613,6 +821,9 @@ double HTFProperties::enth(double T_K)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( m_is_prop_table_avail && T_K >= m_prop_table_T_low && T_K <= m_prop_table_T_high )
+		return prop_table_interp(E_table_enth, T_K);
+
 	double T_C = T_K - 273.15;
 
 	switch(m_fluid)
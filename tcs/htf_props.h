@@ -53,6 +53,7 @@
 
 #include "interpolation_routines.h"
 #include <limits>
+#include <vector>
 
 class HTFProperties
 {
@@ -131,6 +132,21 @@ public:
 	//               rather than at the range's midpoint
 	double Cp_ave(double T_cold_K, double T_hot_K, int n_points);
 
+	// Optional precomputed property table on a uniform temperature grid. When set, Cp, visc, cond, enth,
+	//   and dens (for pressure-independent fluids) are evaluated by cubic interpolation for temperatures
+	//   inside [T_low_K, T_high_K] and by the correlations outside of it. Only library fluids are tabulated.
+	//   The table is rebuilt when SetFluid is called and removed by ClearPropertyTable
+	bool SetPropertyTable(double T_low_K, double T_high_K, double delta_T_target /*K*/);
+	void ClearPropertyTable();
+	bool IsPropertyTableAvail() { return m_is_prop_table_avail; }
+
+	// Evaluate an array of temperatures at once [K]. Use the property table when available
+	void Cp(const double *T_K, int n, double *Cp_out);
+	void dens(const double *T_K, double P, int n, double *dens_out);
+	void visc(const double *T_K, int n, double *visc_out);
+	void cond(const double *T_K, int n, double *cond_out);
+	void enth(const double *T_K, int n, double *enth_out);
+
 	const util::matrix_t<double> *get_prop_table();
 	//bool equals(const util::matrix_t<double> *comp_table);
 	bool equals(HTFProperties *comp_class);
@@ -144,6 +160,29 @@ private:
 	void set_temp_enth_lookup();
 	bool m_is_temp_enth_avail;
 
+	enum
+	{
+		E_table_Cp,
+		E_table_dens,
+		E_table_visc,
+		E_table_cond,
+		E_table_enth,
+
+		E_table_n_props
+	};
+
+	void set_prop_table();
+	double prop_table_interp(int i_prop, double T_K);
+	void prop_table_interp(int i_prop, const double *T_K, int n, double *out);
+	bool m_is_prop_table_avail;		// Table is built for the current fluid
+	bool m_is_prop_table_dens;		// Density is tabulated, i.e. it does not depend on pressure
+	double m_prop_table_T_low;		//[K]
+	double m_prop_table_T_high;		//[K]
+	double m_prop_table_dT_target;	//[K] Requested grid spacing, <= 0 if no table is requested
+	double m_prop_table_dT_inv;		//[1/K] Inverse of the actual grid spacing
+	int m_prop_table_n_int;			//[-] Number of grid intervals
+	std::vector<double> m_prop_table_coefs;	// Cubic coefficients, 4 per interval, m_prop_table_n_int intervals per property
+
 	int m_fluid;	// Store fluid number as member integer
 	util::matrix_t<double> m_userTable;	// User table of properties
 
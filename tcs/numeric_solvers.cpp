@@ -57,6 +57,31 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <chrono>
+
+namespace
+{
+	// Adds the wall time of its scope to a timed memo
+	class C_memo_solve_timer
+	{
+	public:
+		C_memo_solve_timer(C_monotonic_eq_memo *p_memo) : mp_memo(p_memo)
+		{
+			if( mp_memo != 0 && mp_memo->m_is_timed )
+				m_start = std::chrono::high_resolution_clock::now();
+		}
+
+		~C_memo_solve_timer()
+		{
+			if( mp_memo != 0 && mp_memo->m_is_timed )
+				mp_memo->m_time_solve += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_start).count();
+		}
+
+	private:
+		C_monotonic_eq_memo *mp_memo;
+		std::chrono::high_resolution_clock::time_point m_start;
+	};
+}
 
 int C_import_mono_eq::operator()(double x, double *y)
 {
@@ -76,6 +101,8 @@ C_monotonic_eq_solver::C_monotonic_eq_solver(C_monotonic_equation & f): mf_mono_
 
 	m_iter = -1;
 
+	mp_memo = 0;	// NULL
+
 	// Set default settings:
 	m_tol = 0.001;
 	m_is_err_rel = true;
@@ -93,6 +120,11 @@ void C_monotonic_eq_solver::settings( double tol, int iter_limit, double x_lower
 	m_iter_max = std::max(1, iter_limit);
 }
 
+void C_monotonic_eq_solver::set_memo(C_monotonic_eq_memo *p_memo)
+{
+	mp_memo = p_memo;
+}
+
 double C_monotonic_eq_solver::check_against_limits(double x)
 {
 	if( !std::isfinite(m_func_x_lower) && !std::isfinite(m_func_x_upper) )
@@ -120,6 +152,62 @@ double C_monotonic_eq_solver::calc_x_intercept(double x1, double y1, double x2,
 
 int C_monotonic_eq_solver::solve(double x_guess_1, double x_guess_2, double y_target,
 	double &x_solved, double &tol_solved, int &iter_solved)
+{
+	if( mp_memo == 0 )
+	{
+		return solve_from_guesses(x_guess_1, x_guess_2, y_target, x_solved, tol_solved, iter_solved);
+	}
+
+	C_memo_solve_timer memo_timer(mp_memo);
+
+	mp_memo->m_n_solves++;
+
+	int solver_code = NO_SOLUTION;
+
+	if( mp_memo->m_is_seed && mp_memo->m_is_solved && x_guess_1 != x_guess_2 )
+	{
+		// Start at the previous solution, with a smaller step than the caller's guesses in the same direction
+		double dx = mp_memo->m_dx_frac*(x_guess_2 - x_guess_1);
+		double x_seed_1 = check_against_limits(mp_memo->m_x_solved);
+		double x_seed_2 = check_against_limits(x_seed_1 + dx);
+		if( x_seed_2 == x_seed_1 )
+		{
+			x_seed_2 = check_against_limits(x_seed_1 - dx);
+		}
+
+		mp_memo->m_n_seeded++;
+
+		try
+		{
+			solver_code = solve_from_guesses(x_seed_1, x_seed_2, y_target, x_solved, tol_solved, iter_solved);
+		}
+		catch( C_csp_exception & )
+		{
+			solver_code = NO_SOLUTION;
+		}
+
+		if( solver_code != CONVERGED )
+		{
+			mp_memo->m_n_fallback++;
+		}
+	}
+
+	if( solver_code != CONVERGED )
+	{
+		solver_code = solve_from_guesses(x_guess_1, x_guess_2, y_target, x_solved, tol_solved, iter_solved);
+	}
+
+	if( solver_code == CONVERGED )
+	{
+		mp_memo->m_is_solved = true;
+		mp_memo->m_x_solved = x_solved;
+	}
+
+	return solver_code;
+}
+
+int C_monotonic_eq_solver::solve_from_guesses(double x_guess_1, double x_guess_2, double y_target,
+	double &x_solved, double &tol_solved, int &iter_solved)
 {
 	// Set / reset vector that tracks calls to equation
 	ms_eq_call_tracker.resize(0);
@@ -161,6 +249,13 @@ int C_monotonic_eq_solver::solve(S_xy_pair solved_pair_1, S_xy_pair solved_pair_
 	//    allows us to pass in exactly 2 x-y pairs
 	// .... could improve this in future to accept a variable number of x-y pairs
 
+	C_memo_solve_timer memo_timer(mp_memo);
+
+	if( mp_memo != 0 )
+	{
+		mp_memo->m_n_solves++;
+	}
+
 	// Set / reset vector that tracks calls to equation
 	ms_eq_call_tracker.resize(0);
 	ms_eq_call_tracker.reserve(m_iter_max);
@@ -813,6 +908,11 @@ int C_monotonic_eq_solver::solver_core(double x_guess_1, double y1, double x_gue
 
 int C_monotonic_eq_solver::call_mono_eq(double x, double *y)
 {
+	if( mp_memo != 0 )
+	{
+		mp_memo->m_n_calls++;
+	}
+
 	ms_eq_tracker_temp.err_code = mf_mono_eq(x, y);
 
 	ms_eq_tracker_temp.x = x;
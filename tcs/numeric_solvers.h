@@ -87,6 +87,44 @@ public:
 };
 
 
+// Solution of one monotonic equation kept between solver calls (e.g. from one timestep to the next)
+//   so the next solve can start from the previous solution, plus counters of solver effort
+class C_monotonic_eq_memo
+{
+public:
+	bool m_is_seed;			//[-] Start solves from the previous solution? If false, only counters are updated
+	double m_dx_frac;		//[-] Second seed guess step as fraction of the step between the caller's guesses
+
+	bool m_is_solved;		//[-] Is there a converged solution to start from?
+	double m_x_solved;		//[...] Last converged independent variable
+
+	long m_n_solves;		//[-] Number of solves
+	long m_n_calls;			//[-] Number of equation calls over all solves
+	long m_n_seeded;		//[-] Number of solves started from the previous solution
+	long m_n_fallback;		//[-] Number of seeded solves that did not converge and were repeated from the caller's guesses
+
+	bool m_is_timed;		//[-] Add solve wall time to m_time_solve?
+	double m_time_solve;	//[s] Wall time over all solves, including nested solves
+
+	C_monotonic_eq_memo()
+	{
+		m_is_seed = true;
+		m_dx_frac = 0.25;
+		m_is_timed = false;
+
+		reset();
+	}
+
+	void reset()
+	{
+		m_is_solved = false;
+		m_x_solved = std::numeric_limits<double>::quiet_NaN();
+
+		m_n_solves = m_n_calls = m_n_seeded = m_n_fallback = 0;
+		m_time_solve = 0.0;
+	}
+};
+
 class C_monotonic_eq_solver
 {
 public:
@@ -119,6 +157,8 @@ private:
 
 	C_monotonic_equation &mf_mono_eq;
 
+	C_monotonic_eq_memo *mp_memo;
+
 	// Values set in solver
 	bool m_is_pos_bound;
 	bool m_is_neg_bound;
@@ -143,6 +183,9 @@ private:
 	int solver_core(double x_guess_1, double y1, double x_guess_2, double y2, double y_target,
 		double &x_solved, double &tol_solved, int &iter_solved);
 
+	int solve_from_guesses(double x_guess_1, double x_guess_2, double y_target,
+		double &x_solved, double &tol_solved, int &iter_solved);
+
 	// Save x, y, and int_return of for each mono_eq call
 	std::vector<S_eq_chars> ms_eq_call_tracker;
 
@@ -192,6 +235,10 @@ public:
 
 	virtual void settings(double tol, int iter_limit, double x_lower, double x_upper, bool is_err_rel);
 
+	// Optional: count equation calls in 'memo' and, if memo.m_is_seed, start 'solve(x_guess_1, x_guess_2, ...)'
+	//   from the solution saved by the previous solve. A seeded solve that does not converge is repeated from the caller's guesses
+	void set_memo(C_monotonic_eq_memo *p_memo);
+
 	int solve(double x_guess_1, double x_guess_2, double y_target,
 		double &x_solved, double &tol_solved, int &iter_solved);
 		
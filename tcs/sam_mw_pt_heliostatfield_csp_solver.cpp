@@ -264,6 +264,8 @@ enum{	//Parameters
 		P_delta_flux_hrs,
 		P_dni_des,
 		P_land_area,
+		P_n_threads,
+		P_cache_dir,
         P_ADJUST,
 
 		//Inputs
@@ -327,6 +329,8 @@ tcsvarinfo sam_mw_pt_heliostatfield_variables[] = {
     { TCS_PARAM,    TCS_NUMBER,   P_delta_flux_hrs,          "delta_flux_hrs",        "Hourly frequency in flux map lookup",                  "hrs",    "",                              "", "1"         },
     { TCS_PARAM,    TCS_NUMBER,   P_dni_des,                 "dni_des",               "Design-point DNI",                                     "W/m2",   "",                              "", ""          },
 	{ TCS_PARAM,    TCS_NUMBER,   P_land_area,               "land_area",             "CALCULATED land area",                                 "acre",   "",                              "", ""          },
+	{ TCS_PARAM,    TCS_NUMBER,   P_n_threads,               "n_threads",             "Number of SolarPILOT threads, 0 = all hardware threads","-",     "",                              "", "1"         },
+	{ TCS_PARAM,    TCS_STRING,   P_cache_dir,               "sp_cache_dir",          "Directory for reusing SolarPILOT results, empty to disable","-", "",                              "", ""          },
 	{ TCS_PARAM,     TCS_ARRAY,   P_ADJUST,                  "sf_adjust",             "Time series solar field production adjustment",        "none",   "",                              "", "" },
     
 	{ TCS_INPUT,    TCS_NUMBER,   I_v_wind,                  "vwind",                 "Wind velocity",                                        "m/s",    "",                              "", ""          },
@@ -497,6 +501,8 @@ public:
 		mc_heliostatfield.ms_params.m_dni_des = value(P_dni_des);
 
 		mc_heliostatfield.ms_params.m_land_area = value(P_land_area);
+		mc_heliostatfield.ms_params.m_n_threads = (int)value(P_n_threads);
+		mc_heliostatfield.ms_params.m_cache_dir = value_str(P_cache_dir);
 
         //construct array for sf_adjust to pass to heliostat module
         int nval_sf_adjust;
@@ -57,6 +57,9 @@
 #include "CO2_properties.h"
 #include <cmath>
 #include <string>
+#include <algorithm>
+#include <thread>
+#include <exception>
 
 #include "nlopt.hpp"
 
@@ -1206,6 +1209,8 @@ int C_sco2_recomp_csp::C_sco2_csp_od::operator()(S_f_inputs inputs, S_f_outputs
 
 	int off_design_code = -1;	//[-]
 
+	N_co2_props::C_table_lookup_scope co2_table_scope(m_is_co2_table_lookup);
+
 	try
 	{
 		off_design_code = mpc_sco2_rc->optimize_off_design(sco2_od_par, od_strategy);
@@ -1239,7 +1244,8 @@ int C_sco2_recomp_csp::C_sco2_csp_od::operator()(S_f_inputs inputs, S_f_outputs
 int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 	double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 	double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind)
+	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+	int n_threads /*-*/)
 {
 	C_sco2_csp_od c_sco2_csp(this);
 	C_ud_pc_table_generator c_sco2_ud_pc(c_sco2_csp);
@@ -1247,6 +1253,54 @@ int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_ht
 	c_sco2_ud_pc.mf_callback = mf_callback_update;
 	c_sco2_ud_pc.mp_mf_active = mp_mf_update;
 
+	if( n_threads <= 0 )
+		n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+	// The off-design solution modifies the cycle model, so each thread gets its own copy of this design
+	//    Copies are silent: design logs and run progress are reported once, through this instance
+	//    optimize_off_design sets each case up again from the design, so the tables match the serial tables exactly
+	std::vector<C_sco2_recomp_csp> v_sco2_rc(n_threads > 1 ? n_threads : 0);
+	std::vector<C_sco2_csp_od> v_sco2_csp;
+	std::vector<C_od_pc_function*> v_pc_eq;
+	if( n_threads > 1 )
+	{
+		std::vector<std::exception_ptr> v_des_exception(n_threads);
+		std::vector<std::thread> threads;
+		bool is_co2_table_lookup = CO2_is_table_lookup();
+		for( int t = 0; t < n_threads; t++ )
+		{
+			v_sco2_rc[t].m_off_design_turbo_operation = m_off_design_turbo_operation;
+
+			threads.push_back(std::thread([&, t]()
+			{
+				N_co2_props::C_table_lookup_scope co2_table_scope(is_co2_table_lookup);
+				try
+				{
+					v_sco2_rc[t].design(ms_des_par);
+				}
+				catch(...)
+				{
+					v_des_exception[t] = std::current_exception();
+				}
+			}));
+		}
+		for( int t = 0; t < n_threads; t++ )
+			threads[t].join();
+		for( int t = 0; t < n_threads; t++ )
+		{
+			if( v_des_exception[t] )
+				std::rethrow_exception(v_des_exception[t]);
+		}
+
+		v_sco2_csp.reserve(n_threads);
+		for( int t = 0; t < n_threads; t++ )
+		{
+			v_sco2_csp.push_back(C_sco2_csp_od(&v_sco2_rc[t]));
+			v_pc_eq.push_back(&v_sco2_csp[t]);
+		}
+		c_sco2_ud_pc.set_parallel_functions(v_pc_eq);
+	}
+
 	double T_htf_ref = ms_des_par.m_T_htf_hot_in - 273.15;	//[C] convert from K
 	double T_amb_ref = ms_des_par.m_T_amb_des - 273.15;		//[C] convert from K
 	double m_dot_htf_ND_ref = 1.0;							//[-]
@@ -290,11 +290,13 @@ public:
 	{
 	private:
 		C_sco2_recomp_csp *mpc_sco2_rc;
+		bool m_is_co2_table_lookup;		// CO2 property setting of the constructing thread, applied to each call
 
 	public:
 		C_sco2_csp_od(C_sco2_recomp_csp *pc_sco2_rc)
 		{
 			mpc_sco2_rc = pc_sco2_rc;
+			m_is_co2_table_lookup = CO2_is_table_lookup();
 		}
 	
 		virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs);
@@ -303,7 +305,8 @@ public:
 	int generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 		double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 		double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind);
+		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+		int n_threads = 1 /*-*/);	// n_threads > 1 runs the off-design cases on copies of this design; 0 = hardware concurrency
 
 	void design(S_des_par des_par);
 
@@ -59,6 +59,9 @@
 #include <limits>
 #include <iostream>
 #include <algorithm>
+#include <thread>
+#include <condition_variable>
+#include <exception>
 
 #include "tcskernel.h"
 
@@ -444,7 +447,7 @@ static void _message( struct _tcscontext *t, int msgtype, const char *message )
 static bool _progress( struct _tcscontext *t, float percent, const char *message )
 {
 	tcskernel *k = (tcskernel*)t->kernel_internal;
-	return k->progress( percent, message ? std::string(message) : std::string("") );
+	return k->unit_progress( percent, message );
 }
 
 static tcsvalue *_get_value( struct _tcscontext *t, int idx )
@@ -467,6 +470,9 @@ tcskernel::tcskernel( tcstypeprovider *prov )
 	m_provider = prov;
 	m_proceedAnyway = true;
 	m_maxIterations = 100;
+	m_maxThreads = 1;
+	m_linksCompiled = false;
+	m_pool = 0;
 	m_currentTime = 0;
 	m_timeStep = 0;
 	m_startTime = 0;
@@ -491,6 +497,11 @@ void tcskernel::set_max_iterations( int iter, bool proceed )
 	m_proceedAnyway = proceed;
 }
 
+void tcskernel::set_max_threads( int nthreads )
+{
+	m_maxThreads = nthreads;
+}
+
 double tcskernel::current_time()
 {
 	return m_currentTime;
@@ -503,6 +514,9 @@ double tcskernel::time_step()
 
 void tcskernel::message( int unit, int msgtype, const char *text )
 {
+	// units may report from solver threads
+	std::lock_guard<std::mutex> lock( m_messageMutex );
+
 #define TBUFLEN 128
 	char tbuf[TBUFLEN];
 	if (unit >= 0 && unit < (int) m_units.size())
@@ -534,6 +548,14 @@ bool tcskernel::progress( float percent, const std::string &status )
 	return true;
 }
 
+bool tcskernel::unit_progress( float percent, const char *message )
+{
+	// units may report from solver threads, serialize with the messages
+	std::lock_guard<std::mutex> lock( m_messageMutex );
+
+	return progress( percent, message ? std::string(message) : std::string("") );
+}
+
 bool tcskernel::converged( double )
 {
 	/* by default, nothing to do - simply a notification mechanism for decendent classes */
@@ -756,6 +778,7 @@ int tcskernel::add_unit( const std::string &type, const std::string &name )
 	}
 	
 	// push an empty unit, obtain a reference to it
+	m_linksCompiled = false;
 	m_units.push_back( unit() );
 	int id = (int)m_units.size() - 1;
 	unit &u = m_units[ id ];
@@ -830,6 +853,7 @@ int tcskernel::add_unit( const std::string &type, const std::string &name )
 
 void tcskernel::clear_units()
 {	
+	m_linksCompiled = false;
 	m_units.clear();
 }
 
@@ -858,6 +882,7 @@ bool tcskernel::connect( int unit1, int output,
 			return true; // already exists, so return success
 	
 	// add a new connection
+	m_linksCompiled = false;
 	connection c;
 	c.target_unit = unit2;
 	c.target_index = input;
@@ -871,15 +896,26 @@ bool tcskernel::connect( int unit1, int output,
 int tcskernel::find_var( int unit, const char *name )
 {
 	if ( unit < 0 || unit >= (int)m_units.size() ) return -1;
-	tcsvarinfo *varlist = m_units[unit].type->variables;
-	int idx = 0;
-	while ( varlist[idx].var_type != TCS_INVALID
-		&& varlist[idx].name != 0)
+
+	// index the variable names of each type on first use
+	tcstypeinfo *type = m_units[unit].type;
+	unordered_map<std::string, int> &index = m_varIndex[ type ];
+	if ( index.empty() )
 	{
-		if (strcmp(varlist[idx].name, name) == 0)
-			return idx;
-		idx++;
+		tcsvarinfo *varlist = type->variables;
+		int idx = 0;
+		while ( varlist[idx].var_type != TCS_INVALID
+			&& varlist[idx].name != 0)
+		{
+			index.insert( std::make_pair( std::string(varlist[idx].name), idx ) );
+			idx++;
+		}
 	}
+
+	unordered_map<std::string, int>::iterator it = index.find( name );
+	if ( it != index.end() )
+		return it->second;
+
 	message( TCS_NOTICE, "could not locate variable '%s' in unit %d (%s), type %s",
 		name, unit, m_units[unit].name.c_str(), m_units[unit].type->name );
 	return -1;
@@ -932,30 +968,20 @@ void tcskernel::free_instances()
 	}
 }
 
-int tcskernel::solve( double time, double step )
+int tcskernel::solve_units( const std::vector<int> &units, double time, double step, int *iterations )
 {
-	// must call each unit at least once each timestep
-	for (size_t i=0;i<m_units.size();i++)
-	{
-		m_units[i].ncall = 0;
-		m_units[i].mustcall = true;
-	}
-	
-	int iterations = 0;
+	// units are called in the order listed, which must be ascending so that
+	// each group reproduces the call sequence of a solve over all units
+	*iterations = 0;
 	bool converged = false;		
 	while( !converged )
 	{
-		if (iterations++ >= m_maxIterations )
-		{
-			message( TCS_NOTICE, "kernel exceeded maximum iterations of %d, at time %lf", m_maxIterations, time);
-			if ( m_proceedAnyway )
-				return iterations;
-			else
-				return -1;
-		}
+		if ( (*iterations)++ >= m_maxIterations )
+			return -1;
 		
-		for (size_t i=0;i<m_units.size();i++)
+		for (size_t n=0;n<units.size();n++)
 		{
+			size_t i = units[n];
 			if ( !m_units[i].mustcall )
 				continue;
 
@@ -976,88 +1002,84 @@ int tcskernel::solve( double time, double step )
 			m_units[i].mustcall = false;
 			m_units[i].ncall++;
 			
-			// check all values of the current unit
-			// for connections to other units to see if their 
-			// inputs need to be updated
-			for (size_t j=0;j<m_units[i].values.size();j++)
+			// check the outputs of the current unit that are connected
+			// to other units to see if their inputs need to be updated
+			std::vector<link> &links = m_units[i].links;
+			for (size_t k=0;k<links.size();k++)
 			{
-				// reference current output value
-				tcsvalue *val1 = &m_units[i].values[j];
+				link &c = links[k];
+				tcsvalue *val1 = c.source;
+				tcsvalue *val2 = c.target;
+				
+				// check that 'val2' and 'val1' are
+				// within tolerances of one another
 				
-				// go through each connection attached to this output
-				for (size_t k=0;k<m_units[i].conn[j].size();k++)
+				if ( val1->type == TCS_NUMBER 
+					&& val2->type == TCS_NUMBER)
 				{
-					connection &c = m_units[i].conn[j][k];
-					tcsvalue *val2 = &m_units[c.target_unit].values[c.target_index];
-					
-					// check that 'val2' and 'val1' are
-					// within tolerances of one another
-					
-					if ( val1->type == TCS_NUMBER 
-						&& val2->type == TCS_NUMBER)
+					if ( !check_tolerance( val1->data.value, val2->data.value, c.ftol ) )
 					{
-						if ( !check_tolerance( val1->data.value, val2->data.value, c.ftol ) )
-						{
-							// mark units for recalculation and propagate new output value to input									
-							val2->data.value = val1->data.value;									
-							m_units[c.target_unit].mustcall = true;
-						}
+						// mark units for recalculation and propagate new output value to input									
+						val2->data.value = val1->data.value;									
+						c.target_unit->mustcall = true;
 					}
-					else if ( val1->type == TCS_ARRAY
-						&& val2->type == TCS_NUMBER
-						&& c.arridx >= 0 && c.arridx < (int)val1->data.array.length )
+				}
+				else if ( val1->type == TCS_ARRAY
+					&& val2->type == TCS_NUMBER
+					&& c.arridx >= 0 && c.arridx < (int)val1->data.array.length )
+				{
+					if ( !check_tolerance( val1->data.array.values[c.arridx], val2->data.value, c.ftol ))
 					{
-						if ( !check_tolerance( val1->data.array.values[c.arridx], val2->data.value, c.ftol ))
-						{
-							val2->data.value = val1->data.array.values[c.arridx];
-							m_units[c.target_unit].mustcall = true;
-						}
+						val2->data.value = val1->data.array.values[c.arridx];
+						c.target_unit->mustcall = true;
 					}
-					else if ( val1->type == TCS_ARRAY && val2->type == TCS_ARRAY
-						 && val1->data.array.length == val2->data.array.length )
-					{
-						int len = val1->data.array.length;
-						bool pass = true;
-						for ( int m=0;m<len;m++ )
-							pass = pass && check_tolerance( val1->data.array.values[m],
-								val2->data.array.values[m], c.ftol );
-						
-						if ( !pass )
-						{
-							// propagate values and mark for recalculation
-							for ( int m=0;m<len;m++ )
-								val2->data.array.values[m] = val1->data.array.values[m];
-							m_units[c.target_unit].mustcall = true;									
-						}
-					}
-					else if ( val1->type == TCS_MATRIX && val2->type == TCS_MATRIX
-						&& val1->data.matrix.nrows == val2->data.matrix.nrows
-						&& val1->data.matrix.ncols == val2->data.matrix.ncols )
+				}
+				else if ( val1->type == TCS_ARRAY && val2->type == TCS_ARRAY
+					 && val1->data.array.length == val2->data.array.length )
+				{
+					int len = val1->data.array.length;
+					double *v1 = val1->data.array.values;
+					double *v2 = val2->data.array.values;
+					int m = 0;
+					while ( m < len && check_tolerance( v1[m], v2[m], c.ftol ) )
+						m++;
+					
+					if ( m < len )
 					{
-						int len = val1->data.matrix.nrows * val1->data.matrix.ncols;
-						bool pass = true;
-						for ( int m=0;m<len;m++ )
-							pass = pass && check_tolerance( val1->data.matrix.values[m],
-								val2->data.matrix.values[m], c.ftol );
-						
-						if ( !pass )
-						{
-							// propagate values and mark for recalculation
-							for ( int m=0;m<len;m++ )
-								val2->data.matrix.values[m] = val1->data.matrix.values[m];
-							m_units[c.target_unit].mustcall = true;	
-						}
+						// propagate values and mark for recalculation
+						for ( m=0;m<len;m++ )
+							v2[m] = v1[m];
+						c.target_unit->mustcall = true;									
 					}
-					else
+				}
+				else if ( val1->type == TCS_MATRIX && val2->type == TCS_MATRIX
+					&& val1->data.matrix.nrows == val2->data.matrix.nrows
+					&& val1->data.matrix.ncols == val2->data.matrix.ncols )
+				{
+					int len = val1->data.matrix.nrows * val1->data.matrix.ncols;
+					double *v1 = val1->data.matrix.values;
+					double *v2 = val2->data.matrix.values;
+					int m = 0;
+					while ( m < len && check_tolerance( v1[m], v2[m], c.ftol ) )
+						m++;
+					
+					if ( m < len )
 					{
-						// type mismatch,
-						// dimension mismatch,
-						// or cannot compare strings for convergence
-						message( TCS_ERROR, "kernel could not check connection between [%d,%d] and [%d,%d]: type mismatch, dimension mismatch, or invalid type connection",
-							i, j, c.target_unit, c.target_index);
-						return -3;						
+						// propagate values and mark for recalculation
+						for ( m=0;m<len;m++ )
+							v2[m] = v1[m];
+						c.target_unit->mustcall = true;	
 					}
 				}
+				else
+				{
+					// type mismatch,
+					// dimension mismatch,
+					// or cannot compare strings for convergence
+					message( TCS_ERROR, "kernel could not check connection between [%d,%d] and [%d,%d]: type mismatch, dimension mismatch, or invalid type connection",
+						i, c.output, c.target_unit->id, c.target_index);
+					return -3;						
+				}
 			} // loop over all output connections, checking for output->input propagations
 			
 		} // loop over all units, invoke each if needed, check outputs etc
@@ -1065,12 +1087,288 @@ int tcskernel::solve( double time, double step )
 		// check if any units still need to be called
 		// if not, then all of them have converged
 		converged = true;
-		for (size_t i=0;i<m_units.size();i++)
-			if (m_units[i].mustcall)
+		for (size_t n=0;n<units.size();n++)
+			if (m_units[units[n]].mustcall)
 				converged = false;			
 				
 	} // while loop for convergence at this timestep
 	
+	return 0; // success
+}
+
+
+class tcskernel::solve_pool
+{
+public:
+	solve_pool( tcskernel *kernel, int nthreads )
+		: m_kernel(kernel), m_generation(0), m_busy(0), m_quit(false), m_time(0), m_step(0)
+	{
+		size_t ngroups = m_kernel->m_unitGroups.size();
+		codes.resize( ngroups, 0 );
+		iterations.resize( ngroups, 0 );
+
+		// assign the largest groups first, each to the thread with the fewest units so far
+		std::vector<size_t> order( ngroups );
+		for ( size_t g=0;g<ngroups;g++ ) order[g] = g;
+		std::stable_sort( order.begin(), order.end(), group_size_greater( m_kernel->m_unitGroups ) );
+
+		m_assigned.resize( nthreads );
+		std::vector<size_t> load( nthreads, 0 );
+		for ( size_t n=0;n<ngroups;n++ )
+		{
+			size_t t = std::min_element( load.begin(), load.end() ) - load.begin();
+			m_assigned[t].push_back( order[n] );
+			load[t] += m_kernel->m_unitGroups[ order[n] ].size();
+		}
+		m_errors.resize( nthreads );
+
+		// the calling thread works on the first set of groups
+		for ( int t=1;t<nthreads;t++ )
+			m_threads.push_back( std::thread( &solve_pool::worker, this, t ) );
+	}
+
+	~solve_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_quit = true;
+		}
+		m_start.notify_all();
+		for ( size_t t=0;t<m_threads.size();t++ )
+			m_threads[t].join();
+	}
+
+	// solve every group at this timestep, returns when all groups are done
+	void run( double time, double step )
+	{
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_time = time;
+			m_step = step;
+			m_busy = (int)m_threads.size();
+			m_generation++;
+		}
+		m_start.notify_all();
+
+		work( 0 );
+
+		std::unique_lock<std::mutex> lock( m_mutex );
+		m_done.wait( lock, [this]{ return m_busy == 0; } );
+		lock.unlock();
+
+		for ( size_t t=0;t<m_errors.size();t++ )
+		{
+			if ( m_errors[t] )
+			{
+				std::exception_ptr e = m_errors[t];
+				m_errors[t] = std::exception_ptr();
+				std::rethrow_exception( e );
+			}
+		}
+	}
+
+	std::vector<int> codes;
+	std::vector<int> iterations;
+
+private:
+	struct group_size_greater {
+		group_size_greater( const std::vector< std::vector<int> > &groups ) : m_groups(groups) { }
+		bool operator()( size_t a, size_t b ) const { return m_groups[a].size() > m_groups[b].size(); }
+		const std::vector< std::vector<int> > &m_groups;
+	};
+
+	void work( int t )
+	{
+		try
+		{
+			for ( size_t n=0;n<m_assigned[t].size();n++ )
+			{
+				size_t g = m_assigned[t][n];
+				codes[g] = m_kernel->solve_units( m_kernel->m_unitGroups[g], m_time, m_step, &iterations[g] );
+			}
+		}
+		catch( ... )
+		{
+			m_errors[t] = std::current_exception();
+		}
+	}
+
+	void worker( int t )
+	{
+		size_t generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock( m_mutex );
+				m_start.wait( lock, [&]{ return m_quit || m_generation != generation; } );
+				if ( m_quit ) return;
+				generation = m_generation;
+			}
+
+			work( t );
+
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+				m_busy--;
+			}
+			m_done.notify_one();
+		}
+	}
+
+	tcskernel *m_kernel;
+	std::vector< std::vector<size_t> > m_assigned;
+	std::vector<std::exception_ptr> m_errors;
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_start, m_done;
+	size_t m_generation;
+	int m_busy;
+	bool m_quit;
+	double m_time, m_step;
+};
+
+void tcskernel::compile_connections()
+{
+	for (size_t i=0;i<m_units.size();i++)
+	{
+		unit &u = m_units[i];
+		u.links.clear();
+		for (size_t j=0;j<u.conn.size();j++)
+		{
+			for (size_t k=0;k<u.conn[j].size();k++)
+			{
+				connection &c = u.conn[j][k];
+				link l;
+				l.source = &u.values[j];
+				l.target = &m_units[c.target_unit].values[c.target_index];
+				l.target_unit = &m_units[c.target_unit];
+				l.output = (int)j;
+				l.target_index = c.target_index;
+				l.ftol = c.ftol;
+				l.arridx = c.arridx;
+				u.links.push_back( l );
+			}
+		}
+	}
+
+	m_linksCompiled = true;
+}
+
+void tcskernel::partition_units()
+{
+	m_leadUnits.clear();
+	m_unitGroups.clear();
+
+	size_t nunits = m_units.size();
+	std::vector< std::vector<int> > inputs( nunits ), links( nunits );
+	for (size_t i=0;i<nunits;i++)
+	{
+		for (size_t j=0;j<m_units[i].conn.size();j++)
+		{
+			for (size_t k=0;k<m_units[i].conn[j].size();k++)
+			{
+				int target = m_units[i].conn[j][k].target_unit;
+				inputs[target].push_back( (int)i );
+				links[i].push_back( target );
+				links[target].push_back( (int)i );
+			}
+		}
+	}
+
+	// leading units are fed only by units listed before them, so each is called
+	// exactly once per timestep and before any other unit, as in a serial solve
+	size_t nlead = 0;
+	while ( nlead < nunits )
+	{
+		bool lead = true;
+		for (size_t n=0;n<inputs[nlead].size();n++)
+			if ( inputs[nlead][n] >= (int)nlead )
+				lead = false;
+
+		if ( !lead ) break;
+		m_leadUnits.push_back( (int)nlead++ );
+	}
+
+	// remaining units connected to each other in either direction share a group
+	std::vector<int> group( nunits, -1 );
+	for (size_t i=nlead;i<nunits;i++)
+	{
+		if ( group[i] >= 0 ) continue;
+
+		int g = (int)m_unitGroups.size();
+		m_unitGroups.push_back( std::vector<int>() );
+		std::vector<int> &members = m_unitGroups.back();
+
+		group[i] = g;
+		members.push_back( (int)i );
+		for (size_t n=0;n<members.size();n++)
+		{
+			std::vector<int> &l = links[ members[n] ];
+			for (size_t m=0;m<l.size();m++)
+			{
+				if ( l[m] >= (int)nlead && group[ l[m] ] < 0 )
+				{
+					group[ l[m] ] = g;
+					members.push_back( l[m] );
+				}
+			}
+		}
+
+		std::sort( members.begin(), members.end() );
+	}
+}
+
+int tcskernel::solve( double time, double step )
+{
+	if ( !m_linksCompiled )
+		compile_connections();
+
+	// must call each unit at least once each timestep
+	for (size_t i=0;i<m_units.size();i++)
+	{
+		m_units[i].ncall = 0;
+		m_units[i].mustcall = true;
+	}
+
+	int iterations = 0;
+	int code = 0;
+	if ( m_pool == 0 )
+	{
+		std::vector<int> all( m_units.size() );
+		for (size_t i=0;i<m_units.size();i++)
+			all[i] = (int)i;
+
+		code = solve_units( all, time, step, &iterations );
+	}
+	else
+	{
+		// leading units converge in a single pass and only feed the groups,
+		// which then iterate independently of one another
+		code = solve_units( m_leadUnits, time, step, &iterations );
+		if ( code == 0 )
+		{
+			m_pool->run( time, step );
+
+			for (size_t g=0;g<m_unitGroups.size();g++)
+			{
+				iterations = std::max( iterations, m_pool->iterations[g] );
+				if ( code == 0 || ( code == -1 && m_pool->codes[g] < -1 ) )
+					code = m_pool->codes[g];
+			}
+		}
+	}
+
+	if ( code == -1 )
+	{
+		message( TCS_NOTICE, "kernel exceeded maximum iterations of %d, at time %lf", m_maxIterations, time);
+		if ( m_proceedAnyway )
+			return iterations;
+		else
+			return -1;
+	}
+	else if ( code < 0 )
+		return code;
+
 	return iterations; // success
 }
 
@@ -1088,6 +1386,7 @@ void tcskernel::message( int msgtype, const char *fmt, ... )
 
 	buf[2047] = 0;
 	
+	std::lock_guard<std::mutex> lock( m_messageMutex );
 	message( std::string( buf ), msgtype );
 }
 
@@ -1213,6 +1512,22 @@ int tcskernel::simulate( double start, double end, double step )
 		} // loop over all output connections, checking for output->input propagations
 	}
 
+	// solve groups of units that are not connected to each other on separate threads
+	struct pool_scope {
+		pool_scope( tcskernel *k ) : kernel(k) { }
+		~pool_scope() { delete kernel->m_pool; kernel->m_pool = 0; }
+		tcskernel *kernel;
+	} scope( this );
+
+	if ( m_maxThreads != 1 )
+	{
+		partition_units();
+		int nthreads = m_maxThreads > 0 ? m_maxThreads : (int)std::thread::hardware_concurrency();
+		nthreads = std::min( nthreads, (int)m_unitGroups.size() );
+		if ( nthreads > 1 )
+			m_pool = new solve_pool( this, nthreads );
+	}
+
 	for( m_currentTime = m_startTime;
 		m_currentTime <= m_endTime;
 		m_currentTime += m_timeStep )
@@ -59,6 +59,7 @@
    
 #include <string>
 #include <vector>
+#include <mutex>
 
 #include <unordered_map>
 using std::unordered_map;
@@ -123,6 +124,7 @@ public:
 
 	int version();
 	void set_max_iterations( int iter, bool proceed_anyway );
+	void set_max_threads( int nthreads ); // 1 = serial (default), 0 = hardware concurrency
 
 	double current_time();
 	double time_step();
@@ -161,12 +163,20 @@ public:
 	
 	void message( int msgtype, const char *fmt, ... );
 	void message( int unit, int msgtype, const char *message );
+	bool unit_progress( float percent, const char *message );
 	
 	static bool check_tolerance( double val1, double val2, double ftol );
 
 			
 	int solve( double time, double step );
 	
+	// divide units into leading units that run once per timestep and
+	// groups with no connections between them that can be solved concurrently
+	void partition_units();
+
+	// flatten the connections of each unit into links between value pointers
+	void compile_connections();
+	
 	void create_instances();
 	void free_instances();
 	
@@ -177,12 +187,26 @@ public:
 		int arridx;
 	};
 	
+	struct unit;
+
+	// connection resolved to the values it joins, see compile_connections()
+	struct link {
+		tcsvalue *source;
+		tcsvalue *target;
+		unit *target_unit;
+		int output;
+		int target_index;
+		double ftol;
+		int arridx;
+	};
+	
 	struct unit {
 		int id;
 		std::string name;
 		tcstypeinfo *type;
 		std::vector<tcsvalue> values;
 		std::vector< std::vector<connection> > conn;
+		std::vector<link> links;
 		int ncall;
 		bool mustcall;
 		void *instance;
@@ -192,13 +216,24 @@ public:
 			
 protected:
 	int find_var( int unit, const char *name );
+	int solve_units( const std::vector<int> &units, double time, double step, int *iterations );
+
+	class solve_pool;
+
 	bool m_proceedAnyway;
 	int m_maxIterations;
+	int m_maxThreads;
+	bool m_linksCompiled;
 	double m_currentTime;
 	double m_timeStep;
 	double m_startTime;
 	double m_endTime;
 	std::vector<unit> m_units;
+	std::vector<int> m_leadUnits;
+	std::vector< std::vector<int> > m_unitGroups;
+	solve_pool *m_pool;
+	std::mutex m_messageMutex;
+	unordered_map< tcstypeinfo*, unordered_map<std::string, int> > m_varIndex;
 	
 	tcstypeprovider *m_provider;
 };
@@ -50,6 +50,10 @@
 #include "ud_power_cycle.h"
 #include "csp_solver_util.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 void C_ud_power_cycle::init(const util::matrix_t<double> & T_htf_ind, double T_htf_ref /*C*/, double T_htf_low /*C*/, double T_htf_high /*C*/,
 	const util::matrix_t<double> & T_amb_ind, double T_amb_ref /*C*/, double T_amb_low /*C*/, double T_amb_high /*C*/,
 	const util::matrix_t<double> & m_dot_htf_ind, double m_dot_htf_ref /*-*/, double m_dot_htf_low /*-*/, double m_dot_htf_high /*-*/)
@@ -460,11 +464,8 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		throw(C_csp_exception(msg, "User defined power cycle, generate tables"));
 	}
 
-	C_od_pc_function::S_f_inputs pc_inputs;
-	C_od_pc_function::S_f_outputs pc_outputs;
-
 	// ******************************************
-	// Setup T_HTF parameteric runs
+	// Check number of levels
 	if(n_T_htf < 3)
 	{
 		std::string msg = util::format("The input argument for number of indepedent HTF temperatures is %d."
@@ -472,201 +473,245 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		mc_messages.add_notice(msg);
 		n_T_htf = 3;
 	}
+	if(n_T_amb < 3)
+	{
+		std::string msg = util::format("The input argument for number of independent ambient temperatures"
+						" is %d. It was reset to the minimum value of 3.", n_T_amb);
+		mc_messages.add_notice(msg);
+		n_T_amb = 3;
+	}
+	if(n_m_dot_htf_ND < 3)
+	{
+		std::string msg = util::format("The input argument for number of independent normalized HTF mass flow rates"
+						" is %d. It was reset to the minimum value of 3.", n_m_dot_htf_ND);
+		mc_messages.add_notice(msg);
+		n_m_dot_htf_ND = 3;
+	}
+	// ******************************************
 
 	T_htf_ind.clear();
 	T_htf_ind.resize(n_T_htf, 13);		// Set matrix size
 	double delta_T_htf = (T_htf_high - T_htf_low)/double(n_T_htf-1);
 
-	double n_runs_total = 3.0*(n_T_htf + n_T_amb + n_m_dot_htf_ND);
+	T_amb_ind.clear();
+	T_amb_ind.resize(n_T_amb, 13);		// Set matrix size
+	double delta_T_amb = (T_amb_high - T_amb_low)/double(n_T_amb-1);
+
+	m_dot_htf_ind.clear();
+	m_dot_htf_ind.resize(n_m_dot_htf_ND,13);		// Set matrix size
+	double delta_m_dot = (m_dot_htf_ND_high-m_dot_htf_ND_low)/double(n_m_dot_htf_ND-1);
+
+	util::matrix_t<double> *p_tables[3] = {&T_htf_ind, &T_amb_ind, &m_dot_htf_ind};
+
+	std::vector<S_run> runs(3*(n_T_htf + n_T_amb + n_m_dot_htf_ND));
+	int n_runs_total = (int)runs.size();
+	int k = 0;
 
-	// Set ambient temperature because it is constant for the HTF temperature parametrics
-	pc_inputs.m_T_amb = T_amb_ref;	//[C]
+	// ******************************************
+	// Setup T_HTF parameteric runs
+	// Ambient temperature is constant for the HTF temperature parametrics
+	// Call at low, ref, and high ND mass flow rate levels
+	double m_dot_htf_ND_levels[3] = {m_dot_htf_ND_low, m_dot_htf_ND_ref, m_dot_htf_ND_high};
 	for(int i = 0; i < n_T_htf; i++)
 	{
 		T_htf_ind(i,0) = T_htf_low + delta_T_htf*i;	//[C]
-		pc_inputs.m_T_htf_hot = T_htf_ind(i,0);
-
-		// Call at low, ref, and high ND mass flow rate levels
-		std::vector<double> m_dot_htf_ND_levels(3);
-		m_dot_htf_ND_levels[0] = m_dot_htf_ND_low;
-		m_dot_htf_ND_levels[1] = m_dot_htf_ND_ref;
-		m_dot_htf_ND_levels[2] = m_dot_htf_ND_high;
-		for(int j = 0; j < 3; j++)
+		for(int j = 0; j < 3; j++, k++)
 		{
-			bool is_od_model_error = false;
-
-			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
-
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				T_htf_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
-
-				is_od_model_error = true;
-			}
-			else
-			{
-				std::string err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
-
-			double run_number = i*3 + j;
-
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				T_htf_ind(i, 1 + j), T_htf_ind(i, 4 + j),
-				T_htf_ind(i, 7 + j), T_htf_ind(i, 10 + j));
-
+			runs[k].m_i_table = 0;
+			runs[k].m_i_row = i;
+			runs[k].m_j_level = j;
+			runs[k].ms_inputs.m_T_htf_hot = T_htf_ind(i,0);				//[C]
+			runs[k].ms_inputs.m_T_amb = T_amb_ref;						//[C]
+			runs[k].ms_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];	//[-]
 		}
-
 	}
 	// ******************************************
 
 	// ******************************************
 	// Setup T_amb parametric runs
-	if(n_T_amb < 3)
+	// ND htf mass flow rate is constant for the ambient temperature parametrics
+	// Call at low, ref, and high HTF temperature levels
+	double T_htf_levels[3] = {T_htf_low, T_htf_ref, T_htf_high};	//[C]
+	for(int i = 0; i < n_T_amb; i++)
 	{
-		std::string msg = util::format("The input argument for number of independent ambient temperatures"
-						" is %d. It was reset to the minimum value of 3.", n_T_amb);
-		mc_messages.add_notice(msg);
-		n_T_amb = 3;
+		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
+		for(int j = 0; j < 3; j++, k++)
+		{
+			runs[k].m_i_table = 1;
+			runs[k].m_i_row = i;
+			runs[k].m_j_level = j;
+			runs[k].ms_inputs.m_T_htf_hot = T_htf_levels[j];		//[C]
+			runs[k].ms_inputs.m_T_amb = T_amb_ind(i,0);			//[C]
+			runs[k].ms_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;	//[-]
+		}
 	}
+	// ******************************************
 
-	T_amb_ind.clear();
-	T_amb_ind.resize(n_T_amb, 13);		// Set matrix size
-	double delta_T_amb = (T_amb_high - T_amb_low)/double(n_T_amb-1);
+	// ******************************************
+	// Setup ND m_dot parametric runs
+	// HTF temperature is constant for the ND m_dot parametrics
+	// Call at low, ref, and high ambient temperatures
+	double T_amb_levels[3] = {T_amb_low, T_amb_ref, T_amb_high};	//[C]
+	for(int i = 0; i < n_m_dot_htf_ND; i++)
+	{
+		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
+		for(int j = 0; j < 3; j++, k++)
+		{
+			runs[k].m_i_table = 2;
+			runs[k].m_i_row = i;
+			runs[k].m_j_level = j;
+			runs[k].ms_inputs.m_T_htf_hot = T_htf_ref;				//[C]
+			runs[k].ms_inputs.m_T_amb = T_amb_levels[j];			//[C]
+			runs[k].ms_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);	//[-]
+		}
+	}
+	// ******************************************
 
-	// Set ND htf mass flow rate because it is constant for the ambient temperature parametrics
-	pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;
-	for(int i = 0; i < n_T_amb; i++)
+	if( mv_pc_eq_parallel.size() > 1 )
 	{
-		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
-		pc_inputs.m_T_amb = T_amb_ind(i,0);				//[C]
-
-		// Call at low, ref, and high HTF temperature levels
-		std::vector<double> T_htf_levels(3);
-		T_htf_levels[0] = T_htf_low;   //[C]
-		T_htf_levels[1] = T_htf_ref;   //[C]
-		T_htf_levels[2] = T_htf_high;  //[C]
-		for(int j = 0; j < 3; j++)
+		run_cases_parallel(runs, p_tables);
+	}
+	else
+	{
+		for(int k_run = 0; k_run < n_runs_total; k_run++)
 		{
-			bool is_od_model_error = false;
+			run_case(mf_pc_eq, runs[k_run]);
+			save_case(runs[k_run], k_run, n_runs_total, p_tables);
+		}
+	}
+	
+	return 0;
+}
 
-			pc_inputs.m_T_htf_hot = T_htf_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
+void C_ud_pc_table_generator::set_parallel_functions(const std::vector<C_od_pc_function*> & v_pc_eq)
+{
+	mv_pc_eq_parallel = v_pc_eq;
+}
 
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_amb_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_amb_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_amb_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_amb_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
+void C_ud_pc_table_generator::run_case(C_od_pc_function & f_pc_eq, S_run & run)
+{
+	try
+	{
+		run.m_off_design_code = f_pc_eq(run.ms_inputs, run.ms_outputs);
+	}
+	catch(...)
+	{
+		run.mp_exception = std::current_exception();
+	}
+}
+
+void C_ud_pc_table_generator::run_cases_parallel(std::vector<S_run> & runs, util::matrix_t<double> *p_tables[3])
+{
+	int n_runs_total = (int)runs.size();
+	int n_threads = (int)mv_pc_eq_parallel.size();
+
+	std::mutex run_mutex;
+	std::condition_variable run_done;
+	std::vector<bool> is_done(n_runs_total, false);
+	bool is_abort = false;
+
+	// Each thread works through a fixed interleaved set of runs with its own function instance,
+	//   so the results do not depend on thread timing
+	std::vector<std::thread> threads;
+	for(int t = 0; t < n_threads; t++)
+	{
+		threads.push_back(std::thread([&, t]()
+		{
+			for(int k = t; k < n_runs_total; k += n_threads)
 			{
-				// Save 'generic' off design model response
-				T_amb_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
+				{
+					std::lock_guard<std::mutex> lock(run_mutex);
+					if( is_abort )
+						return;
+				}
 
-				is_od_model_error = true;
+				run_case(*mv_pc_eq_parallel[t], runs[k]);
+
+				std::lock_guard<std::mutex> lock(run_mutex);
+				is_done[k] = true;
+				run_done.notify_all();
 			}
-			else
+		}));
+	}
+
+	// Save results and send callbacks in run order from this thread
+	try
+	{
+		for(int k = 0; k < n_runs_total; k++)
+		{
 			{
-				std::string err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", pc_inputs.m_T_amb, pc_inputs.m_T_htf_hot);
-				throw(C_csp_exception(err_msg, "UDPC"));
+				std::unique_lock<std::mutex> lock(run_mutex);
+				while( !is_done[k] )
+					run_done.wait(lock);
 			}
 
-			double run_number = 3.0*n_T_htf + i*3 + j;
-
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				T_amb_ind(i, 1 + j), T_amb_ind(i, 4 + j),
-				T_amb_ind(i, 7 + j), T_amb_ind(i, 10 + j));
+			save_case(runs[k], k, n_runs_total, p_tables);
 		}
 	}
-	// ******************************************
-
-	// ******************************************
-	// Setup ND m_dot parametric runs
-	if(n_m_dot_htf_ND < 3)
+	catch(...)
 	{
-		std::string msg = util::format("The input argument for number of independent normalized HTF mass flow rates"
-						" is %d. It was reset to the minimum value of 3.", n_m_dot_htf_ND);
-		mc_messages.add_notice(msg);
-		n_m_dot_htf_ND = 3;
+		{
+			std::lock_guard<std::mutex> lock(run_mutex);
+			is_abort = true;
+		}
+		for(size_t t = 0; t < threads.size(); t++)
+			threads[t].join();
+		throw;
 	}
 
-	m_dot_htf_ind.clear();
-	m_dot_htf_ind.resize(n_m_dot_htf_ND,13);		// Set matrix size
-	double delta_m_dot = (m_dot_htf_ND_high-m_dot_htf_ND_low)/double(n_m_dot_htf_ND-1);
+	for(size_t t = 0; t < threads.size(); t++)
+		threads[t].join();
+}
 
-	// Set HTF temperature because it is constant for the ambient temperature parametrics
-	pc_inputs.m_T_htf_hot = T_htf_ref;
-	for(int i = 0; i < n_m_dot_htf_ND; i++)
-	{
-		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
-		pc_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);				//[-]
-
-		// Call at low, ref, and high ambient temperatures
-		std::vector<double> T_amb_levels(3);
-		T_amb_levels[0] = T_amb_low;    //[C]
-		T_amb_levels[1] = T_amb_ref;	//[C]
-		T_amb_levels[2] = T_amb_high;	//[C]
-		for(int j = 0; j < 3; j++)
-		{
-			bool is_od_model_error = false;
+void C_ud_pc_table_generator::save_case(const S_run & run, int run_number, int n_runs_total, util::matrix_t<double> *p_tables[3])
+{
+	if( run.mp_exception )
+		std::rethrow_exception(run.mp_exception);
 
-			pc_inputs.m_T_amb = T_amb_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs, pc_outputs);
-		
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				m_dot_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				m_dot_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				m_dot_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				m_dot_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				m_dot_htf_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
+	util::matrix_t<double> & table = *p_tables[run.m_i_table];
+	int i = run.m_i_row;
+	int j = run.m_j_level;
 
-				is_od_model_error = true;
-			}
-			else
-			{
-				std::string err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_amb, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
+	bool is_od_model_error = false;
 
-			double run_number = 3.0*n_T_htf + 3.0*n_T_amb  + i*3 + j;
+	if( run.m_off_design_code == 0 )
+	{
+		// Save outputs
+		table(i,1+j) = run.ms_outputs.m_W_dot_gross_ND;		//[-]
+		table(i,4+j) = run.ms_outputs.m_Q_dot_in_ND;		//[-]
+		table(i,7+j) = run.ms_outputs.m_W_dot_cooling_ND;	//[-]
+		table(i,10+j) = run.ms_outputs.m_m_dot_water_ND;	//[-]
+	}
+	else if (run.m_off_design_code == -1)
+	{
+		// Save 'generic' off design model response
+		table(i, 1 + j) = run.ms_inputs.m_m_dot_htf_ND;		//[-]
+		table(i, 4 + j) = run.ms_inputs.m_m_dot_htf_ND;		//[-]
+		table(i, 7 + j) = run.ms_inputs.m_m_dot_htf_ND;		//[-]
+		table(i, 10 + j) = run.ms_inputs.m_m_dot_htf_ND;	//[-]
 
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				m_dot_htf_ind(i, 1 + j), m_dot_htf_ind(i, 4 + j),
-				m_dot_htf_ind(i, 7 + j), m_dot_htf_ind(i, 10 + j));
+		is_od_model_error = true;
+	}
+	else
+	{
+		std::string err_msg;
+		switch( run.m_i_table )
+		{
+		case 0:
+			err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", run.ms_inputs.m_T_htf_hot, run.ms_inputs.m_m_dot_htf_ND);
+			break;
+		case 1:
+			err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", run.ms_inputs.m_T_amb, run.ms_inputs.m_T_htf_hot);
+			break;
+		default:
+			err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", run.ms_inputs.m_T_amb, run.ms_inputs.m_m_dot_htf_ND);
+			break;
 		}
+		throw(C_csp_exception(err_msg, "UDPC"));
 	}
-	// ******************************************
-	
-	return 0;
+
+	send_callback(is_od_model_error, run_number + 1, n_runs_total,
+		run.ms_inputs.m_T_htf_hot, run.ms_inputs.m_m_dot_htf_ND, run.ms_inputs.m_T_amb,
+		table(i, 1 + j), table(i, 4 + j),
+		table(i, 7 + j), table(i, 10 + j));
 }
\ No newline at end of file
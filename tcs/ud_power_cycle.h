@@ -51,6 +51,8 @@
 #define __UD_POWER_CYCLE_
 
 #include <limits>
+#include <vector>
+#include <exception>
 #include "interpolation_routines.h"
 #include "csp_solver_util.h"
 
@@ -187,9 +189,34 @@ class C_ud_pc_table_generator
 
 private:
 	C_od_pc_function &mf_pc_eq;
+	std::vector<C_od_pc_function*> mv_pc_eq_parallel;
 	std::string m_log_msg;
 	std::string m_progress_msg;	
 
+	// One off-design call: table (0: T_htf, 1: T_amb, 2: m_dot_htf_ND), row, and level of the interaction variable
+	struct S_run
+	{
+		int m_i_table;
+		int m_i_row;
+		int m_j_level;
+		C_od_pc_function::S_f_inputs ms_inputs;
+		C_od_pc_function::S_f_outputs ms_outputs;
+		int m_off_design_code;
+		std::exception_ptr mp_exception;	// Exception thrown by the off-design function, if any
+
+		S_run()
+		{
+			m_i_table = m_i_row = m_j_level = -1;
+			m_off_design_code = -99;
+		}
+	};
+
+	void run_case(C_od_pc_function & f_pc_eq, S_run & run);
+
+	void run_cases_parallel(std::vector<S_run> & runs, util::matrix_t<double> *p_tables[3]);
+
+	void save_case(const S_run & run, int run_number, int n_runs_total, util::matrix_t<double> *p_tables[3]);
+
 	void send_callback(bool is_od_model_error, int run_number, int n_runs_total,
 		double T_htf_hot, double m_dot_htf_ND, double T_amb,
 		double W_dot_gross_ND, double Q_dot_in_ND,
@@ -208,6 +235,13 @@ public:
 		double m_dot_htf_ND_ref /*-*/, double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
 		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ind);
 
+	// Optional independent instances of the off-design function, e.g. each with its own cycle model.
+	//   When set, the runs are distributed across one thread per instance, and results and callbacks
+	//   are still reported in run order from the calling thread
+	//   Run k goes to instance k % n, so each instance must give the same result for a run regardless
+	//   of the runs it evaluated before, or the tables would depend on the number of instances
+	void set_parallel_functions(const std::vector<C_od_pc_function*> & v_pc_eq);
+
 	// Callback funtion
 	bool(*mf_callback)(std::string &log_msg, std::string &progress_msg, void *data, double progress, int out_type);
 	void *mp_mf_active;
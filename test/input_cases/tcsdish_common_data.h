@@ -0,0 +1,122 @@
+#ifndef _TCSDISH_COMMON_DATA_H_
+#define _TCSDISH_COMMON_DATA_H_
+
+#include <stdio.h>
+
+#include "code_generator_utilities.h"
+
+/**
+*  Default data for a tcsdish run of a 25 dish field in Daggett, CA that can be further modified
+*/
+void tcsdish_default(ssc_data_t &data)
+{
+	char solar_resource_path[200];
+	int n1 = sprintf(solar_resource_path, "%s/test/input_cases/moltensalt_data/daggett_ca_34.865371_-116.783023_psmv3_60_tmy.csv", std::getenv("SSCDIR"));
+
+    ssc_data_set_string(data, "file_name", solar_resource_path);
+    ssc_data_set_number(data, "track_mode", 0);
+    ssc_data_set_number(data, "tilt", 0);
+    ssc_data_set_number(data, "azimuth", 0);
+    ssc_data_set_number(data, "system_capacity", 625);
+    ssc_data_set_number(data, "d_ap", 0.184);
+    ssc_data_set_number(data, "rho", 0.938);
+    ssc_data_set_number(data, "n_ns", 5);
+    ssc_data_set_number(data, "n_ew", 5);
+    ssc_data_set_number(data, "ns_dish_sep", 15);
+    ssc_data_set_number(data, "ew_dish_sep", 15);
+    ssc_data_set_number(data, "slope_ns", 0);
+    ssc_data_set_number(data, "slope_ew", 0);
+    ssc_data_set_number(data, "w_slot_gap", 0.3);
+    ssc_data_set_number(data, "h_slot_gap", 0.8);
+    ssc_data_set_number(data, "manufacturer", 5);
+    ssc_data_set_number(data, "wind_stow_speed", 16);
+    ssc_data_set_number(data, "A_proj", 87.7);
+    ssc_data_set_number(data, "I_cut_in", 200);
+    ssc_data_set_number(data, "d_ap_test", 0.184);
+    ssc_data_set_number(data, "test_if", 0.995);
+    ssc_data_set_number(data, "test_L_focal", 7.45);
+    ssc_data_set_number(data, "A_total", 91.01);
+    ssc_data_set_number(data, "I_beam", 0);
+    ssc_data_set_number(data, "T_amb", 288.15);
+    ssc_data_set_number(data, "wind_speed", 0);
+    ssc_data_set_number(data, "zenith", 0);
+    ssc_data_set_number(data, "P_atm", 101325);
+    ssc_data_set_number(data, "rec_type", 1);
+    ssc_data_set_number(data, "transmittance_cover", 1);
+    ssc_data_set_number(data, "alpha_absorber", 0.9);
+    ssc_data_set_number(data, "A_absorber", 0.6);
+    ssc_data_set_number(data, "alpha_wall", 0.6);
+    ssc_data_set_number(data, "A_wall", 0.6);
+    ssc_data_set_number(data, "L_insulation", 0.075);
+    ssc_data_set_number(data, "k_insulation", 0.06);
+    ssc_data_set_number(data, "d_cav", 0.46);
+    ssc_data_set_number(data, "P_cav", 101.325);
+    ssc_data_set_number(data, "L_cav", 0.229);
+    ssc_data_set_number(data, "DELTA_T_DIR", 90);
+    ssc_data_set_number(data, "DELTA_T_REFLUX", 40);
+    ssc_data_set_number(data, "T_heater_head_high", 993);
+    ssc_data_set_number(data, "T_heater_head_low", 973);
+    ssc_data_set_number(data, "Power_in_rec", 0);
+    ssc_data_set_number(data, "sun_angle", 0);
+    ssc_data_set_number(data, "n_collectors", 0);
+    ssc_data_set_number(data, "DNI", 0);
+    ssc_data_set_number(data, "Beale_const_coef", 0.04247);
+    ssc_data_set_number(data, "Beale_first_coef", 1.682e-05);
+    ssc_data_set_number(data, "Beale_square_coef", -5.105e-10);
+    ssc_data_set_number(data, "Beale_third_coef", 7.07e-15);
+    ssc_data_set_number(data, "Beale_fourth_coef", -3.586e-20);
+    ssc_data_set_number(data, "Pressure_coef", 0.658769);
+    ssc_data_set_number(data, "Pressure_first", 0.000234963);
+    ssc_data_set_number(data, "engine_speed", 1800);
+    ssc_data_set_number(data, "V_displaced", 0.00038);
+    ssc_data_set_number(data, "P_SE", 0);
+    ssc_data_set_number(data, "N_cols", 0);
+    ssc_data_set_number(data, "T_compression_in", 0);
+    ssc_data_set_number(data, "T_heater_head_operate", 0);
+    ssc_data_set_number(data, "P_in_collector", 0);
+    ssc_data_set_number(data, "cooling_tower_on", 0);
+    ssc_data_set_number(data, "tower_mode", 1);
+    ssc_data_set_number(data, "d_pipe_tower", 0.4);
+    ssc_data_set_number(data, "tower_m_dot_water", 37.22);
+    ssc_data_set_number(data, "tower_m_dot_water_test", 37.22);
+    ssc_data_set_number(data, "tower_pipe_material", 1);
+    ssc_data_set_number(data, "eta_tower_pump", 0.6);
+    ssc_data_set_number(data, "fan_control_signal", 1);
+    ssc_data_set_number(data, "epsilon_power_test", 0.7);
+    ssc_data_set_number(data, "system_availability", 1);
+    ssc_data_set_number(data, "pump_speed", 1800);
+    ssc_data_set_number(data, "fan_speed1", 1100);
+    ssc_data_set_number(data, "fan_speed2", 1800);
+    ssc_data_set_number(data, "fan_speed3", 2300);
+    ssc_data_set_number(data, "T_cool_speed2", 25);
+    ssc_data_set_number(data, "T_cool_speed3", 30);
+    ssc_data_set_number(data, "epsilon_cooler_test", 0.7);
+    ssc_data_set_number(data, "epsilon_radiator_test", 0.6);
+    ssc_data_set_number(data, "cooling_fluid", 2);
+    ssc_data_set_number(data, "P_controls", 150);
+    ssc_data_set_number(data, "test_P_pump", 100);
+    ssc_data_set_number(data, "test_pump_speed", 1800);
+    ssc_data_set_number(data, "test_cooling_fluid", 2);
+    ssc_data_set_number(data, "test_T_fluid", 288);
+    ssc_data_set_number(data, "test_V_dot_fluid", 7.5);
+    ssc_data_set_number(data, "test_P_fan", 1000);
+    ssc_data_set_number(data, "test_fan_speed", 1800);
+    ssc_data_set_number(data, "test_fan_rho_air", 1.2);
+    ssc_data_set_number(data, "test_fan_cfm", 6000);
+    ssc_data_set_number(data, "b_radiator", 0.7);
+    ssc_data_set_number(data, "b_cooler", 0.7);
+    ssc_data_set_number(data, "gross_power", 0);
+    ssc_data_set_number(data, "V_swept", 380);
+    ssc_data_set_number(data, "frequency", 30);
+    ssc_data_set_number(data, "engine_pressure", 1000000.0);
+    ssc_data_set_number(data, "Q_reject", 0);
+    ssc_data_set_number(data, "Tower_water_outlet_temp", 20);
+    ssc_data_set_number(data, "P_amb_Pa", 101325);
+    ssc_data_set_number(data, "ns_dish_separation", 15);
+    ssc_data_set_number(data, "ew_dish_separation", 15);
+    ssc_data_set_number(data, "P_tower_fan", 0);
+    ssc_data_set_number(data, "power_in_collector", 0);
+    ssc_data_set_number(data, "adjust:constant", 4);
+}
+
+#endif
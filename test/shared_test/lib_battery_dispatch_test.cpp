@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
 
 #include "lib_battery_dispatch_test.h"
 
@@ -53,6 +56,68 @@ TEST_F(BatteryDispatchTest, DispatchAutoBTM)
 	EXPECT_LT(batteryPower->powerBatteryDC, 0);
 }
 
+/// Peak shaving target should not depend on the time step when the profile is constant within each hour, also reports the cost of a dispatch update
+// Year of PV and load at n steps per hour with an evening load peak
+static void btm_profiles(size_t n, std::vector<double> &pv, std::vector<double> &load)
+{
+	for (size_t d = 0; d < 365; d++) {
+		for (size_t h = 0; h < 24; h++) {
+			for (size_t i = 0; i < n; i++) {
+				pv.push_back((h > 6 && h < 18) ? (6 - fabs(12. - h)) * 100 : 0);
+				load.push_back((h > 15 && h < 21) ? 700. + (d % 7) * 10 : 500.);
+			}
+		}
+	}
+}
+
+TEST_F(BatteryDispatchTest, DispatchAutoBTMSubhourly)
+{
+	std::vector<size_t> steps_per_hour = { 1, 4, 12, 60 };
+	double target_hourly = 0;
+
+	for (size_t s = 0; s < steps_per_hour.size(); s++)
+	{
+		size_t n = steps_per_hour[s];
+		std::vector<double> pv, load;
+		btm_profiles(n, pv, load);
+
+		dispatch_automatic_behind_the_meter_t dispatch(batteryModel, 1.0 / n, SOC_min, SOC_max, currentChoice, currentChargeMax,
+			currentDischargeMax, powerChargeMax, powerDischargeMax, 0, 0, 0, 1, 24, 1, true, true, false, false);
+		dispatch.update_load_data(load);
+		dispatch.update_pv_data(pv);
+
+		dispatch.update_dispatch(0, 0, 0);
+		if (s == 0)
+			target_hourly = dispatch.power_grid_target();
+		else
+			EXPECT_NEAR(dispatch.power_grid_target(), target_hourly, 1e-6 * fabs(target_hourly)) << 60 / n << " minute steps";
+	}
+}
+
+// Prints the cost of a daily dispatch update at each time step. Run with --gtest_also_run_disabled_tests
+TEST_F(BatteryDispatchTest, DISABLED_BenchmarkDispatchAutoBTMSubhourly)
+{
+	std::vector<size_t> steps_per_hour = { 1, 4, 12, 60 };
+
+	for (size_t s = 0; s < steps_per_hour.size(); s++)
+	{
+		size_t n = steps_per_hour[s];
+		std::vector<double> pv, load;
+		btm_profiles(n, pv, load);
+
+		dispatch_automatic_behind_the_meter_t dispatch(batteryModel, 1.0 / n, SOC_min, SOC_max, currentChoice, currentChargeMax,
+			currentDischargeMax, powerChargeMax, powerDischargeMax, 0, 0, 0, 1, 24, 1, true, true, false, false);
+		dispatch.update_load_data(load);
+		dispatch.update_pv_data(pv);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (size_t d = 0; d < 365; d++)
+			dispatch.update_dispatch(d * 24, 0, d * 24 * n);
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << 60 / n << " minute steps: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 365 << " us per dispatch update\n";
+	}
+}
+
 TEST_F(BatteryDispatchTest, DispatchFOMInput)
 {
 	std::vector<double> P_batt;
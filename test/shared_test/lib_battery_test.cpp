@@ -71,3 +71,28 @@ TEST_F(BatteryTest, LossesModel)
 	EXPECT_EQ(lossModel->getLoss(idx), 1);
 
 }
+
+/// Restoring a battery from a saved copy should reproduce the same step, the copy only carries the model state
+TEST_F(BatteryTest, CopyRestoresState)
+{
+	battery_t * saved = new battery_t(*batteryModel);
+
+	batteryModel->run(0, 10);
+	double SOC = batteryModel->battery_soc();
+	double V = batteryModel->battery_voltage();
+	double T = batteryModel->thermal_model()->T_battery();
+	double q = batteryModel->lifetime_model()->capacity_percent();
+
+	// advance, then roll back and repeat the first step
+	batteryModel->run(1, -20);
+	batteryModel->copy(saved);
+	batteryModel->run(0, 10);
+
+	EXPECT_EQ(batteryModel->battery_soc(), SOC);
+	EXPECT_EQ(batteryModel->battery_voltage(), V);
+	EXPECT_EQ(batteryModel->thermal_model()->T_battery(), T);
+	EXPECT_EQ(batteryModel->lifetime_model()->capacity_percent(), q);
+
+	saved->delete_clone();
+	delete saved;
+}
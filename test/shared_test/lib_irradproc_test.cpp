@@ -1,4 +1,6 @@
 #include <stdlib.h>
+#include <chrono>
+#include <iostream>
 
 #include "lib_irradproc_test.h"
 
@@ -602,4 +604,117 @@ TEST_F(BifacialIrradTest, TestRearSurfaceIrradiance)
 			ASSERT_NEAR(rearIrradiance[i], expectedRearIrradiance[i], e) << "Failed at t = " << t << " i = " << i;
 		}
 	}
-}
\ No newline at end of file
+}
+
+/**
+*   Test that reusing a bifacial_workspace gives the same rear-side irradiance as fresh buffers
+*/
+TEST_F(BifacialIrradTest, TestRearSideWorkspace)
+{
+	bifacial_workspace workspace;
+	size_t n_sunup = 0;
+	for (size_t s = 0; s < numberOfSamples; s++)
+	{
+		size_t t = samples[s];
+		runIrradCalc(t);
+		irr->calc_rear_side(transmissionFactor, bifaciality, clearanceGround, slopeLength);
+		double rearWithoutWorkspace = irr->get_poa_rear();
+
+		runIrradCalc(t);
+		irr->calc_rear_side(transmissionFactor, bifaciality, clearanceGround, slopeLength, &workspace);
+		EXPECT_EQ(irr->get_poa_rear(), rearWithoutWorkspace) << "Failed at t = " << t;
+
+		if (irr->get_sun_component(2) > 0)
+			n_sunup++;
+	}
+
+	// fixed tilt geometry does not change, so the sky configuration factors are computed once
+	if (n_sunup > 0) {
+		EXPECT_EQ(workspace.sky_config_count(), 1);
+	}
+}
+
+/**
+*   Prints the per-timestep cost of the rear-side calculation at noon with and without a bifacial_workspace. Run with --gtest_also_run_disabled_tests
+*/
+TEST_F(BifacialIrradTest, DISABLED_BenchmarkRearSideWorkspace)
+{
+	bifacial_workspace workspace;
+	size_t n_steps = 500;
+	irr->set_time(year, 6, 21, 12, 0, 1);
+	irr->set_beam_diffuse(800, 100);
+	double rear[2] = { 0, 0 };
+	double elapsed[2] = { 0, 0 };
+	for (size_t k = 0; k < 2; k++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < n_steps; i++)
+		{
+			irr->calc();
+			irr->calc_rear_side(transmissionFactor, bifaciality, clearanceGround, slopeLength, k == 0 ? 0 : &workspace);
+			rear[k] += irr->get_poa_rear();
+		}
+		elapsed[k] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / n_steps;
+	}
+	EXPECT_EQ(rear[0], rear[1]);
+	std::cout << "calc_rear_side per timestep: " << elapsed[0] << " us without workspace, " << elapsed[1] << " us with workspace" << std::endl;
+}
+
+/**
+*   Test that precomputed sun positions and surface angles give the same results as calculating them in irrad::calc()
+*/
+TEST_F(IrradTest, SolarposTableMatchesCalc_lib_irradproc)
+{
+	double delt = 0.25;
+	std::vector<int> years, months, days, hours;
+	std::vector<double> minutes;
+	for (int d = day; d < day + 2; d++) {
+		for (int h = 0; h < 24; h++) {
+			for (int m = 0; m < 60; m += 15) {
+				years.push_back(year);
+				months.push_back(month);
+				days.push_back(d);
+				hours.push_back(h);
+				minutes.push_back(m + 7.5);
+			}
+		}
+	}
+
+	std::shared_ptr<const solarpos_table> sun_table = solarpos_table::shared(lat, lon, tz, delt, years, months, days, hours, minutes);
+	size_t n_computed = solarpos_table::compute_count();
+	EXPECT_EQ(sun_table->size(), years.size());
+	EXPECT_EQ(solarpos_table::shared(lat, lon, tz, delt, years, months, days, hours, minutes), sun_table);
+	EXPECT_EQ(solarpos_table::compute_count(), n_computed);
+
+	int single_axis = 1;
+	incidence_table surface_table(*sun_table, single_axis, tilt, azim, 45, true, 0.4);
+
+	int n_sunup = 0;
+	for (size_t i = 0; i < years.size(); i++) {
+		irrad irr_calc, irr_table;
+		irrad *irrs[2] = { &irr_calc, &irr_table };
+		for (size_t k = 0; k < 2; k++) {
+			irrs[k]->set_time(years[i], months[i], days[i], hours[i], minutes[i], delt);
+			irrs[k]->set_location(lat, lon, tz);
+			irrs[k]->set_sky_model(skymodel, alb);
+			irrs[k]->set_beam_diffuse(500, 100);
+			irrs[k]->set_surface(single_axis, tilt, azim, 45, true, 0.4);
+		}
+		irr_table.set_angle_tables(sun_table.get(), &surface_table, i);
+		irr_calc.calc();
+		irr_table.calc();
+
+		for (size_t k = 0; k < 9; k++)
+			EXPECT_EQ(irr_calc.get_sun_component(k), irr_table.get_sun_component(k)) << "index " << i << " component " << k;
+		EXPECT_EQ(irr_calc.get_sunpos_calc_hour(), irr_table.get_sunpos_calc_hour()) << "index " << i;
+
+		double angles_calc[5], angles_table[5];
+		irr_calc.get_angles(&angles_calc[0], &angles_calc[1], &angles_calc[2], &angles_calc[3], &angles_calc[4]);
+		irr_table.get_angles(&angles_table[0], &angles_table[1], &angles_table[2], &angles_table[3], &angles_table[4]);
+		for (size_t k = 0; k < 5; k++)
+			EXPECT_EQ(angles_calc[k], angles_table[k]) << "index " << i << " angle " << k;
+
+		if (sun_table->sunup[i] > 0) n_sunup++;
+	}
+	EXPECT_GT(n_sunup, 0);
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include <lib_pv_shade_loss_mpp.h>
+#include <vector>
+
+/// The decompressed database should be inflated once per process and shared by all instances
+TEST(libPVShadeLossMppTests, sharedDatabaseDecompressedOnce)
+{
+	ShadeDB8_mpp db1;
+	db1.init();
+	size_t n_decompress = ShadeDB8_mpp::decompress_count();
+	EXPECT_EQ(n_decompress, 1);
+
+	long n_users = ShadeDB8_mpp::use_count();
+	{
+		ShadeDB8_mpp db2;
+		db2.init();
+		EXPECT_EQ(ShadeDB8_mpp::decompress_count(), n_decompress);
+		EXPECT_EQ(ShadeDB8_mpp::use_count(), n_users + 1);
+
+		for (size_t i = 0; i < 1000; i++)
+		{
+			EXPECT_EQ(db1.vmpp(i), db2.vmpp(i));
+			EXPECT_EQ(db1.impp(i), db2.impp(i));
+		}
+	}
+	EXPECT_EQ(ShadeDB8_mpp::use_count(), n_users);
+
+	double gpoa = 800, dpoa = 200;
+	std::vector<double> shade_frac = { 50, 20 };
+	double loss = db1.get_shade_loss(gpoa, dpoa, shade_frac);
+	EXPECT_GT(loss, 0);
+	EXPECT_LT(loss, 1);
+}
@@ -13,4 +13,59 @@ TEST(libUtilTests, testFormat)
 	str = "query point (301.3, 10.4) is too far out of convex hull of data (dist=4.3)... estimating value from 5 parameter modele at (2.2, 2.1)=2.4";
 	ASSERT_EQ(util::format("query point (%lg, %lg) is too far out of convex hull of data (dist=%lg)... estimating value from 5 parameter modele at (%lg, %lg)=%lg",
 		301.3, 10.4, 4.3, 2.2, 2.1, 2.4), str);
-}
\ No newline at end of file
+}
+
+TEST(libUtilTests, testMatrixReferenceAndRelease)
+{
+	double buf[6] = { 5, 2, 3, 9, 1, 4 };
+
+	// a referenced buffer is read and written in place
+	util::matrix_t<double> mat;
+	mat.assign_ref(buf, 2, 3);
+	EXPECT_FALSE(mat.owns_data());
+	EXPECT_EQ(mat.data(), buf);
+	EXPECT_EQ(mat.at(1, 0), 9);
+	mat.at(1, 1) = 7;
+	EXPECT_EQ(buf[4], 7);
+
+	// copying or assigning new values detaches from the external buffer
+	util::matrix_t<double> cp(mat);
+	EXPECT_TRUE(cp.owns_data());
+	EXPECT_NE(cp.data(), buf);
+	double vals[6] = { 0, 0, 0, 0, 0, 0 };
+	mat.assign(vals, 2, 3);
+	EXPECT_TRUE(mat.owns_data());
+	EXPECT_EQ(buf[0], 5);
+
+	// releasing hands over the owned buffer as is, and copies a referenced one
+	double *p = cp.data();
+	double *released = cp.release();
+	EXPECT_EQ(released, p);
+	EXPECT_EQ(cp.nrows(), 1);
+	EXPECT_EQ(cp.ncols(), 1);
+	delete[] released;
+
+	mat.assign_ref(buf, 1, 6);
+	released = mat.release();
+	EXPECT_NE(released, buf);
+	EXPECT_EQ(released[4], 7);
+	delete[] released;
+}
+
+TEST(libUtilTests, testMatrixMove)
+{
+	util::matrix_t<double> src(8760, 1, 1.5);
+	double *p = src.data();
+
+	util::matrix_t<double> dst(std::move(src));
+	EXPECT_EQ(dst.data(), p);
+	EXPECT_EQ(dst.nrows(), 8760);
+	EXPECT_EQ(src.nrows(), 1);
+	EXPECT_EQ(src.ncols(), 1);
+
+	util::matrix_t<double> other;
+	other = std::move(dst);
+	EXPECT_EQ(other.data(), p);
+	EXPECT_EQ(other.at(8759, 0), 1.5);
+	EXPECT_EQ(dst.nrows(), 1);
+}
@@ -1,6 +1,7 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <fstream>
  
 #include <gtest/gtest.h>
 #include "lib_weatherfile.h"
@@ -147,6 +148,147 @@ TEST_F(weatherfileTest, EPWNoLineEndingsTest) {
 	EXPECT_TRUE(wf.nrecords() == 8760 );
 }
 
+/// Folder for cache test files, outside of the source tree
+static std::string weather_cache_test_dir()
+{
+	const char *tmp = std::getenv("TMPDIR");
+	if (!tmp) tmp = std::getenv("TEMP");
+	std::string dir = std::string(tmp ? tmp : "/tmp") + "/ssc_weather_cache_test";
+	if (!util::dir_exists(dir.c_str()))
+		util::mkdir(dir.c_str());
+	return dir;
+}
+
+/// A second open of the same file should load the binary cache and return identical records
+TEST_F(weatherfileTest, BinaryCacheTest) {
+	e = 0.001;
+	char filepath[150];
+	sprintf(filepath, "%s/test/input_docs/weather_30m.epw", std::getenv("SSCDIR"));
+	file = std::string(filepath);
+	std::string dir = weather_cache_test_dir();
+	std::string cache_file = weatherfile::cache_file_name(file, dir);
+	util::remove_file(cache_file.c_str());
+
+	weatherfile::set_cache_dir(dir);
+	EXPECT_TRUE(wf.open(file));
+	EXPECT_FALSE(wf.from_cache());
+	EXPECT_TRUE(util::file_exists(cache_file.c_str()));
+
+	weatherfile cached;
+	EXPECT_TRUE(cached.open(file));
+	EXPECT_TRUE(cached.from_cache());
+	weatherfile::set_cache_dir("");
+
+	EXPECT_EQ(cached.nrecords(), wf.nrecords());
+	EXPECT_EQ(cached.step_sec(), wf.step_sec());
+	EXPECT_EQ(cached.start_sec(), wf.start_sec());
+	EXPECT_EQ(cached.type(), wf.type());
+	EXPECT_EQ(cached.header().city, wf.header().city);
+	EXPECT_NEAR(cached.lat(), wf.lat(), e);
+	for (size_t id = 0; id < weather_data_provider::_MAXCOL_; id++)
+		EXPECT_EQ(cached.has_data_column(id), wf.has_data_column(id));
+
+	weather_record r, rc;
+	for (size_t i = 0; i < wf.nrecords(); i++)
+	{
+		ASSERT_TRUE(wf.read(&r));
+		ASSERT_TRUE(cached.read(&rc));
+		EXPECT_EQ(rc.hour, r.hour);
+		EXPECT_EQ(rc.minute, r.minute);
+		EXPECT_EQ(rc.gh, r.gh);
+		EXPECT_EQ(rc.dn, r.dn);
+		EXPECT_EQ(rc.tdry, r.tdry);
+		EXPECT_EQ(rc.wspd, r.wspd);
+	}
+	util::remove_file(cache_file.c_str());
+}
+
+/// Rewriting the source with different contents of the same size must not load the old cache
+TEST_F(weatherfileTest, BinaryCacheSameSizeRewriteTest) {
+	e = 0.001;
+	char filepath[150];
+	sprintf(filepath, "%s/test/input_docs/weather.csv", std::getenv("SSCDIR"));
+	std::string text = util::read_file(filepath);
+	std::string dir = weather_cache_test_dir();
+	file = dir + "/weather_rewrite.csv";
+	std::string cache_file = weatherfile::cache_file_name(file, dir);
+	util::remove_file(cache_file.c_str());
+	{
+		std::ofstream ofs(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		ofs << text;
+	}
+
+	weatherfile::set_cache_dir(dir);
+	ASSERT_TRUE(wf.open(file));
+	EXPECT_FALSE(wf.from_cache());
+	{
+		weatherfile cached;
+		ASSERT_TRUE(cached.open(file));
+		EXPECT_TRUE(cached.from_cache());
+	}
+
+	// the same contents written again only change the time stamp, so the cache is still used
+	{
+		std::ofstream ofs(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		ofs << text;
+	}
+	{
+		weatherfile touched;
+		ASSERT_TRUE(touched.open(file));
+		EXPECT_TRUE(touched.from_cache());
+	}
+
+	// change the first dry bulb temperature from 20.9 to 21.9
+	size_t pos = text.find("\n1988,1,1,0,0,0,20.9,");
+	ASSERT_NE(pos, std::string::npos);
+	text[pos + 17] = '1';
+	{
+		std::ofstream ofs(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		ofs << text;
+	}
+
+	weatherfile rewritten;
+	ASSERT_TRUE(rewritten.open(file));
+	weatherfile::set_cache_dir("");
+	EXPECT_FALSE(rewritten.from_cache());
+	weather_record r;
+	ASSERT_TRUE(rewritten.read(&r));
+	EXPECT_NEAR(r.tdry, 21.9, e);
+
+	util::remove_file(cache_file.c_str());
+	util::remove_file(file.c_str());
+}
+
+/// Reopening a weather file that was loaded from a cache, with caching off, must read the parsed data
+TEST_F(weatherfileTest, BinaryCacheReopenTest) {
+	char filepath[150];
+	sprintf(filepath, "%s/test/input_docs/weather_30m.epw", std::getenv("SSCDIR"));
+	std::string cached_file = std::string(filepath);
+	sprintf(filepath, "%s/test/input_docs/weather.csv", std::getenv("SSCDIR"));
+	file = std::string(filepath);
+	std::string dir = weather_cache_test_dir();
+	std::string cache_file = weatherfile::cache_file_name(cached_file, dir);
+
+	ASSERT_TRUE(wf.open(cached_file, false, dir));
+	ASSERT_TRUE(wf.open(cached_file, false, dir));
+	ASSERT_TRUE(wf.from_cache());
+
+	ASSERT_TRUE(wf.open(file, false, ""));
+	EXPECT_FALSE(wf.from_cache());
+	weatherfile parsed;
+	ASSERT_TRUE(parsed.open(file, false, ""));
+	ASSERT_EQ(wf.nrecords(), parsed.nrecords());
+	weather_record r, rp;
+	for (size_t i = 0; i < parsed.nrecords(); i++)
+	{
+		ASSERT_TRUE(wf.read(&r));
+		ASSERT_TRUE(parsed.read(&rp));
+		EXPECT_EQ(r.dn, rp.dn) << "Record " << i;
+		EXPECT_EQ(r.tdry, rp.tdry) << "Record " << i;
+	}
+	util::remove_file(cache_file.c_str());
+}
+
 /**
 * \class weatherdataTest
 *
@@ -0,0 +1,256 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../shared/lib_util.h"
+#include "../solarpilot/API_cache.h"
+#include "../solarpilot/definitions.h"
+#include "../solarpilot/Toolbox.h"
+
+/**
+ * Tests the SolarPILOT results cache: entries read back bit for bit, keys depend on every input and on nothing
+ * else, and truncated or damaged files are treated as missing. Also covers the block_t fixes the flux maps
+ * depend on.
+ */
+
+class SPFieldCacheTest : public ::testing::Test{
+protected:
+	std::string m_dir;
+	var_map V;
+	sp_layout layout;
+	sp_flux_table fluxtab;
+	std::vector<double> values;
+
+	virtual void SetUp(){
+		const char *tmp = std::getenv("TMPDIR");
+		if (!tmp) tmp = std::getenv("TEMP");
+		m_dir = std::string(tmp ? tmp : "/tmp") + "/ssc_sp_field_cache_test";
+		if (!util::dir_exists(m_dir.c_str()))
+			util::mkdir(m_dir.c_str());
+
+		setup_vars(V);
+
+		// values that do not print exactly in a few digits
+		layout.heliostat_positions.resize(5);
+		for (int i = 0; i < 5; i++)
+		{
+			sp_layout::h_position &p = layout.heliostat_positions[i];
+			p.location.x = 100. / 3. * (i + 1);
+			p.location.y = -2. / 7. * i;
+			p.location.z = 0.1 * i;
+			p.aimpoint.x = p.aimpoint.y = 0.;
+			p.aimpoint.z = 150. + 1. / 9. * i;
+			p.template_number = i % 2;
+			p.cant_vector.i = p.cant_vector.j = 0.;
+			p.cant_vector.k = 1. / 3.;
+			p.focal_length = 200. + 1. / 11. * i;
+		}
+
+		fluxtab.is_user_spacing = true;
+		fluxtab.n_flux_days = 8;
+		fluxtab.delta_flux_hrs = 1.5;
+		for (int i = 0; i < 4; i++)
+		{
+			fluxtab.azimuths.push_back(0.1 * i - 1.);
+			fluxtab.zeniths.push_back(0.2 / 3. * i);
+			fluxtab.efficiency.push_back(0.6 + 1. / 7. * 0.1 * i);
+		}
+		fluxtab.flux_surfaces.resize(1);
+		sp_flux_map::sp_flux_stack &s = fluxtab.flux_surfaces[0];
+		s.map_name = "Receiver 1 surface 1";
+		for (int i = 0; i < 3; i++)
+			s.xpos.push_back(-1. + 2. / 3. * i);
+		for (int i = 0; i < 2; i++)
+			s.ypos.push_back(0.25 + 0.5 * i);
+		s.flux_data.resize(2, 3, 4);
+		for (int i = 0; i < 24; i++)
+			s.flux_data.data()[i] = 1. / (i + 3.);
+
+		values.assign(1, 1234.5678901234567);
+	}
+
+	virtual void TearDown(){
+		sp_field_cache cache;
+		cache.SetDirectory(m_dir);
+		cache.StartKey(V);
+		util::remove_file(cache.GetFilePath().c_str());
+	}
+
+	void setup_vars(var_map &vm){
+		vm.sf.temp_which.combo_clear();
+		std::string name = "Template 1", val = "0";
+		vm.sf.temp_which.combo_add_choice(name, val);
+		vm.sf.temp_which.combo_select_by_choice_index(0);
+		vm.sf.q_des.val = 100. / 3.;
+	}
+
+	std::string read_file(const std::string &path){
+		std::ifstream f(path.c_str(), std::ios::binary);
+		std::stringstream S;
+		S << f.rdbuf();
+		return S.str();
+	}
+
+	void write_file(const std::string &path, const std::string &contents){
+		std::ofstream f(path.c_str(), std::ios::binary);
+		f << contents;
+	}
+
+	// stores the test results and returns the file contents
+	std::string store(sp_field_cache &cache){
+		cache.SetDirectory(m_dir);
+		cache.StartKey(V);
+		EXPECT_TRUE(cache.Store(V, layout, fluxtab, values));
+		return read_file(cache.GetFilePath());
+	}
+
+	// a load that fails must leave the outputs as they were
+	void expect_miss(sp_field_cache &cache, const std::string &what){
+		var_map V2;
+		setup_vars(V2);
+		sp_layout lay;
+		sp_flux_table ftab;
+		std::vector<double> vals(1, -1.);
+		EXPECT_FALSE(cache.Load(V2, lay, ftab, vals)) << what;
+		EXPECT_EQ(lay.heliostat_positions.size(), 0) << what;
+		EXPECT_EQ(ftab.flux_surfaces.size(), 0) << what;
+		EXPECT_EQ(vals, std::vector<double>(1, -1.)) << what;
+	}
+};
+
+TEST_F(SPFieldCacheTest, StoreAndLoadRoundTrip_sp_api_cache){
+	sp_field_cache cache;
+	store(cache);
+
+	var_map V2;
+	setup_vars(V2);
+	V2.sf.q_des.val = 1.;		// restored from the entry
+	sp_layout lay;
+	sp_flux_table ftab;
+	std::vector<double> vals;
+	ASSERT_TRUE(cache.Load(V2, lay, ftab, vals));
+
+	EXPECT_EQ(V2.sf.q_des.val, V.sf.q_des.val);
+	ASSERT_EQ(lay.heliostat_positions.size(), layout.heliostat_positions.size());
+	for (size_t i = 0; i < lay.heliostat_positions.size(); i++)
+	{
+		sp_layout::h_position &a = lay.heliostat_positions[i], &b = layout.heliostat_positions[i];
+		EXPECT_EQ(a.location.x, b.location.x) << "Heliostat " << i;
+		EXPECT_EQ(a.location.y, b.location.y) << "Heliostat " << i;
+		EXPECT_EQ(a.location.z, b.location.z) << "Heliostat " << i;
+		EXPECT_EQ(a.aimpoint.z, b.aimpoint.z) << "Heliostat " << i;
+		EXPECT_EQ(a.template_number, b.template_number) << "Heliostat " << i;
+		EXPECT_EQ(a.cant_vector.k, b.cant_vector.k) << "Heliostat " << i;
+		EXPECT_EQ(a.focal_length, b.focal_length) << "Heliostat " << i;
+	}
+
+	EXPECT_EQ(ftab.is_user_spacing, fluxtab.is_user_spacing);
+	EXPECT_EQ(ftab.n_flux_days, fluxtab.n_flux_days);
+	EXPECT_EQ(ftab.delta_flux_hrs, fluxtab.delta_flux_hrs);
+	EXPECT_EQ(ftab.azimuths, fluxtab.azimuths);
+	EXPECT_EQ(ftab.zeniths, fluxtab.zeniths);
+	EXPECT_EQ(ftab.efficiency, fluxtab.efficiency);
+	ASSERT_EQ(ftab.flux_surfaces.size(), 1);
+	sp_flux_map::sp_flux_stack &s = ftab.flux_surfaces[0], &s0 = fluxtab.flux_surfaces[0];
+	EXPECT_EQ(s.map_name, s0.map_name);
+	EXPECT_EQ(s.xpos, s0.xpos);
+	EXPECT_EQ(s.ypos, s0.ypos);
+	EXPECT_TRUE(s.flux_data.equals(s0.flux_data));
+	EXPECT_EQ(vals, values);
+}
+
+TEST_F(SPFieldCacheTest, KeyDependsOnInputsOnly_sp_api_cache){
+	sp_field_cache a, b;
+	var_map V2;
+	setup_vars(V2);
+	a.StartKey(V);
+	b.StartKey(V2);
+	EXPECT_EQ(a.GetKey().size(), 16);
+	EXPECT_EQ(a.GetKey(), b.GetKey());
+
+	a.AddToKey("weather 1");
+	b.AddToKey("weather 1");
+	EXPECT_EQ(a.GetKey(), b.GetKey());
+	b.AddToKey("weather 2");
+	EXPECT_NE(a.GetKey(), b.GetKey());
+
+	// a change past the sixth significant digit is a different input
+	V2.sf.q_des.val = V.sf.q_des.val * (1. + 1.E-12);
+	b.StartKey(V2);
+	a.StartKey(V);
+	EXPECT_NE(a.GetKey(), b.GetKey());
+
+	// ... but the values in the variable map are still written with the usual precision
+	EXPECT_EQ(V2.sf.q_des.as_string(), V.sf.q_des.as_string());
+}
+
+TEST_F(SPFieldCacheTest, DamagedEntriesAreMisses_sp_api_cache){
+	sp_field_cache cache;
+	std::string contents = store(cache);
+	std::string path = cache.GetFilePath();
+	ASSERT_GT(contents.size(), 100);
+
+	write_file(path, contents.substr(0, contents.size() - 10));
+	expect_miss(cache, "Truncated");
+
+	write_file(path, contents + "1 2 3\n");
+	expect_miss(cache, "Extra data");
+
+	// a digit of a heliostat position, so that the contents still parse
+	std::string changed = contents;
+	size_t pos = changed.find("33.33333");
+	ASSERT_NE(pos, std::string::npos);
+	changed[pos + 3] = '4';
+	write_file(path, changed);
+	expect_miss(cache, "Changed value");
+
+	write_file(path, "");
+	expect_miss(cache, "Empty");
+
+	// the original entry still loads
+	write_file(path, contents);
+	sp_layout lay;
+	sp_flux_table ftab;
+	std::vector<double> vals;
+	EXPECT_TRUE(cache.Load(V, lay, ftab, vals));
+}
+
+TEST_F(SPFieldCacheTest, StoreReplacesExistingEntry_sp_api_cache){
+	sp_field_cache cache;
+	store(cache);
+	values[0] = 2.;
+	store(cache);
+
+	sp_layout lay;
+	sp_flux_table ftab;
+	std::vector<double> vals;
+	ASSERT_TRUE(cache.Load(V, lay, ftab, vals));
+	EXPECT_EQ(vals, std::vector<double>(1, 2.));
+}
+
+TEST(SPBlockTest, ResizeChangesLayers_sp_api_cache){
+	block_t<double> b(2, 3, 4);
+	b.resize(2, 3, 5);
+	EXPECT_EQ(b.nrows(), 2);
+	EXPECT_EQ(b.ncols(), 3);
+	EXPECT_EQ(b.nlayers(), 5);
+	b.fill(1.);
+	EXPECT_EQ(b.at(1, 2, 4), 1.);
+}
+
+TEST(SPBlockTest, CopyKeepsDimensions_sp_api_cache){
+	block_t<double> a(2, 3, 4), b;
+	for (int i = 0; i < 24; i++)
+		a.data()[i] = i;
+	b = a;
+	EXPECT_EQ(b.nrows(), 2);
+	EXPECT_EQ(b.ncols(), 3);
+	EXPECT_EQ(b.nlayers(), 4);
+	EXPECT_TRUE(b.equals(a));
+	EXPECT_EQ(b.at(1, 2, 3), a.at(1, 2, 3));
+}
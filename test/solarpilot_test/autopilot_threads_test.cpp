@@ -0,0 +1,93 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../solarpilot/AutoPilot_API.h"
+#include "../solarpilot/API_structures.h"
+#include "../solarpilot/SolarField.h"
+
+/**
+ * Checks that AutoPilot_MT, which simulates sun positions on separate threads, gives the same layout,
+ * optical efficiency table and flux maps, bit for bit, as AutoPilot_S.
+ */
+
+struct autopilot_results
+{
+	sp_layout layout;
+	sp_optical_table opt;
+	sp_flux_table flux;
+};
+
+static bool run_autopilot( AutoPilot &sapi, autopilot_results &R )
+{
+	var_map V;
+	V.sf.temp_which.combo_clear();
+	std::string name = "Template 1", val = "0";
+	V.sf.temp_which.combo_add_choice( name, val );
+	V.sf.temp_which.combo_select_by_choice_index( 0 );
+	V.sf.q_des.val = 5.;
+
+	// clear sky days with a sine shaped DNI profile
+	std::vector<std::string> wf;
+	char row[200];
+	for ( int i=0; i<8760; i++ )
+	{
+		int day = (i/24)%28 + 1, month = i/730 + 1, hour = i%24;
+		double dni = std::fmax( 0., 900.*std::sin( (hour - 6)/12.*3.14159 ) );
+		sprintf( row, "%d,%d,%d,%.2f,%.1f,%.1f,%.1f", day, hour, month > 12 ? 12 : month, dni, 20., 1., 3. );
+		wf.push_back( row );
+	}
+
+	sapi.GenerateDesignPointSimulations( V, wf );
+	sapi.Setup( V );
+	if ( !sapi.CreateLayout( R.layout ) )
+		return false;
+	R.opt.is_user_positions = true;
+	double az[] = { 0., 90., 200., 290. }, zen[] = { 7., 45., 80. };
+	R.opt.azimuths.assign( az, az + 4 );
+	R.opt.zeniths.assign( zen, zen + 3 );
+	if ( !sapi.CalculateOpticalEfficiencyTable( R.opt ) )
+		return false;
+	R.flux.is_user_spacing = true;
+	R.flux.n_flux_days = 2;
+	R.flux.delta_flux_hrs = 4;
+	return sapi.CalculateFluxMaps( R.flux, 12, 10, true );
+}
+
+TEST(AutoPilotThreadsTest, MultiThreadedMatchesSingleThreaded){
+	AutoPilot_S sapi_s;
+	autopilot_results S;
+	ASSERT_TRUE(run_autopilot( sapi_s, S ));
+
+	AutoPilot_MT sapi_mt;
+	sapi_mt.SetMaxThreadCount( 4 );
+	autopilot_results M;
+	ASSERT_TRUE(run_autopilot( sapi_mt, M ));
+
+	ASSERT_GT(S.layout.heliostat_positions.size(), 100);
+	ASSERT_EQ(M.layout.heliostat_positions.size(), S.layout.heliostat_positions.size());
+	for ( size_t i=0; i<S.layout.heliostat_positions.size(); i++ )
+	{
+		EXPECT_EQ(M.layout.heliostat_positions[i].location.x, S.layout.heliostat_positions[i].location.x) << "Heliostat " << i;
+		EXPECT_EQ(M.layout.heliostat_positions[i].location.y, S.layout.heliostat_positions[i].location.y) << "Heliostat " << i;
+		EXPECT_EQ(M.layout.heliostat_positions[i].location.z, S.layout.heliostat_positions[i].location.z) << "Heliostat " << i;
+	}
+
+	ASSERT_EQ(M.opt.eff_data.size(), S.opt.eff_data.size());
+	for ( size_t i=0; i<S.opt.eff_data.size(); i++ )
+		EXPECT_EQ(M.opt.eff_data[i], S.opt.eff_data[i]) << "Optical table row " << i;
+
+	ASSERT_EQ(M.flux.efficiency.size(), S.flux.efficiency.size());
+	for ( size_t i=0; i<S.flux.efficiency.size(); i++ )
+		EXPECT_EQ(M.flux.efficiency[i], S.flux.efficiency[i]) << "Flux position " << i;
+
+	block_t<double> &fs = S.flux.flux_surfaces.front().flux_data, &fm = M.flux.flux_surfaces.front().flux_data;
+	ASSERT_EQ(fm.nlayers(), fs.nlayers());
+	for ( size_t r=0; r<fs.nrows(); r++ )
+		for ( size_t c=0; c<fs.ncols(); c++ )
+			for ( size_t l=0; l<fs.nlayers(); l++ )
+				EXPECT_EQ(fm.at(r, c, l), fs.at(r, c, l)) << "Flux map " << l << ", node " << r << "," << c;
+}
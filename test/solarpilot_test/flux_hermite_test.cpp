@@ -0,0 +1,134 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../solarpilot/SolarField.h"
+#include "../solarpilot/Heliostat.h"
+#include "../solarpilot/Flux.h"
+
+// The scalar evaluation as it was written before Flux::hermitePoly, where HX[i+1] holds the Hermite polynomial of
+// order i and the coefficients are walked with the JMN/JMX bounds. JMX(0) is the number of terms.
+static double delsol_flux_eval( Flux *flux, Heliostat *H, double xs, double ys )
+{
+	int n_terms = flux->JMX(0);
+	matrix_t<double> *hc = H->getHermiteCoefObject();
+
+	double HX[12], HY[12];
+	HX[0] = 1.;
+	HX[1] = 0.;
+	HY[0] = 1.;
+	HY[1] = 0.;
+
+	double FX = -2.;
+	for ( int i=1; i<n_terms+1; i++ )
+	{
+		FX ++;
+		HX[i+1] = xs*HX[i] - FX*HX[i-1];
+		HY[i+1] = ys*HY[i] - FX*HY[i-1];
+	}
+	int ipak = 0;
+	double f = 0.;
+	for ( int i=1; i<n_terms+1; i++ )
+	{
+		for ( int j=flux->JMN(i-1); j<flux->JMX(i-1)+1; j+=2 )
+		{
+			f += hc->at(ipak)*HX[i+1]*HY[j+1];
+			ipak++;
+		}
+	}
+	if ( f < 0. ) f = 0.;
+	return f;
+}
+
+/**
+ * Checks that the batch Flux::hermiteFluxEval, which fluxDensity uses to evaluate all flux map nodes in view of
+ * a heliostat at once, gives the same flux, bit for bit, as the scalar evaluation with the gaussian weight applied,
+ * and that both match the original DELSOL form of the evaluation.
+ */
+class FluxHermiteTest : public ::testing::Test{
+protected:
+	var_map V;
+	SolarField SF;
+
+	// small rectangular field north of the tower, simulated at one sun position to set the Hermite coefficients
+	virtual void SetUp(){
+		V.sf.temp_which.combo_clear();
+		std::string name = "Template 1", val = "0";
+		V.sf.temp_which.combo_add_choice( name, val );
+		V.sf.temp_which.combo_select_by_choice_index( 0 );
+
+		std::string layout;
+		char row[200];
+		for ( int i=0; i<30; i++ )
+		{
+			sprintf( row, "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;", (i%6 - 3)*16. + (i/6 % 2)*8., 100. + (i/6)*40., 0. );
+			layout.append( row );
+		}
+		V.sf.layout_data.val = layout;
+
+		SF.Create( V );
+		SolarField::PrepareFieldLayout( SF, 0, true );
+		sim_params P;
+		P.dni = 950.;
+		SF.Simulate( 150.*D2R, 35.*D2R, P );
+	}
+
+	// image plane points across and beyond the image, including the center and points on the axes
+	void points( std::vector<double> &xs, std::vector<double> &ys ){
+		for ( int i=0; i<13; i++ )
+		{
+			for ( int j=0; j<11; j++ )
+			{
+				xs.push_back( -3.7 + 7.4/12.*i );
+				ys.push_back( -4.1 + 8.2/10.*j );
+			}
+		}
+		xs.push_back( 0. );
+		ys.push_back( 0. );
+	}
+};
+
+TEST_F(FluxHermiteTest, BatchMatchesScalar_sp_flux_hermite){
+	Flux *flux = SF.getFluxObject();
+	std::vector<Heliostat> *helios = SF.getHeliostatObjects();
+	ASSERT_EQ(helios->size(), 30);
+
+	std::vector<double> xs, ys;
+	points( xs, ys );
+	int npt = (int)xs.size();
+
+	int hels[] = { 0, 7, 17, 29 };
+	for ( int h=0; h<4; h++ )
+	{
+		Heliostat *H = &helios->at( hels[h] );
+
+		// work space for the largest expansion, 9 terms
+		std::vector<double> batch( npt, -1. ), batch_work( npt, -1. ), work( 2*9*npt, -1. );
+		flux->hermiteFluxEval( H, npt, &xs[0], &ys[0], &batch[0] );
+		flux->hermiteFluxEval( H, npt, &xs[0], &ys[0], &batch_work[0], &work[0] );
+
+		double fsum = 0.;
+		for ( int p=0; p<npt; p++ )
+		{
+			double weight = std::exp( -0.5 *( xs[p]*xs[p] + ys[p]*ys[p]) );
+			double scalar = flux->hermiteFluxEval( H, xs[p], ys[p] ) * weight;
+			EXPECT_EQ(scalar, delsol_flux_eval( flux, H, xs[p], ys[p] ) * weight) << "Heliostat " << hels[h] << ", point " << p;
+			EXPECT_EQ(batch[p], scalar) << "Heliostat " << hels[h] << ", point " << p;
+			EXPECT_EQ(batch_work[p], scalar) << "Heliostat " << hels[h] << ", point " << p;
+			fsum += scalar;
+		}
+		EXPECT_GT(fsum, 0.) << "Heliostat " << hels[h];
+	}
+}
+
+TEST_F(FluxHermiteTest, SinglePointBatch_sp_flux_hermite){
+	Flux *flux = SF.getFluxObject();
+	Heliostat *H = &SF.getHeliostatObjects()->at( 3 );
+
+	double x = 0.37, y = -1.21, f = -1.;
+	flux->hermiteFluxEval( H, 1, &x, &y, &f );
+	EXPECT_EQ(f, flux->hermiteFluxEval( H, x, y ) * std::exp( -0.5 *( x*x + y*y ) ));
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../solarpilot/SolarField.h"
+#include "../solarpilot/Heliostat.h"
+#include "../solarpilot/Ambient.h"
+
+/**
+ * Checks the shadowing and blocking efficiencies from the solar field neighbor mesh against a direct search
+ * over all heliostats, and times shadowing and blocking for fields of 1k to 50k heliostats.
+ */
+
+class test_field
+{
+public:
+	var_map V;
+	SolarField SF;
+
+	// Rectangular staggered field of n heliostats north of the tower
+	void build( int n )
+	{
+		V.sf.temp_which.combo_clear();
+		std::string name = "Template 1", val = "0";
+		V.sf.temp_which.combo_add_choice( name, val );
+		V.sf.temp_which.combo_select_by_choice_index( 0 );
+
+		int ncol = (int)std::ceil( std::sqrt( (double)n ) );
+		std::string layout;
+		char row[200];
+		for ( int i=0; i<n; i++ )
+		{
+			int r = i / ncol, c = i % ncol;
+			double x = (c - ncol/2)*16. + (r % 2)*8.;
+			double y = 100. + r*14.;
+			sprintf( row, "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;", x, y, 0. );
+			layout.append( row );
+		}
+		V.sf.layout_data.val = layout;
+
+		SF.Create( V );
+		SolarField::PrepareFieldLayout( SF, 0, true );
+	}
+
+	void simulate( double az, double zen )
+	{
+		sim_params P;
+		P.dni = 950.;
+		P.is_layout = false;
+		SF.Simulate( az*D2R, zen*D2R, P );
+	}
+};
+
+TEST(SolarFieldNeighborsTest, MatchesSearchOverAllHeliostats){
+	test_field T;
+	T.build( 600 );
+	var_map &V = T.V;
+	SolarField &SF = T.SF;
+
+	double suns[][2] = { { 180., 30. }, { 100., 75. }, { 260., 60. } };
+	for ( int s=0; s<3; s++ )
+	{
+		T.simulate( suns[s][0], suns[s][1] );
+		Vect sun = Ambient::calcSunVectorFromAzZen( suns[s][0]*D2R, suns[s][1]*D2R );
+		double interaction_limit = V.sf.interaction_limit.val;
+
+		std::vector<Heliostat> *helios = SF.getHeliostatObjects();
+		int nrow = 0, ncol = 0;
+		for ( size_t i=0; i<helios->size(); i++ )
+		{
+			nrow = std::max( nrow, helios->at(i).getGroupId()[0] + 1 );
+			ncol = std::max( ncol, helios->at(i).getGroupId()[1] + 1 );
+		}
+		ASSERT_GT(nrow*ncol, 1);
+
+		int nblocked = 0;
+
+		for ( size_t i=0; i<helios->size(); i++ )
+		{
+			Heliostat *H = &helios->at(i);
+			int *g = H->getGroupId();
+
+			// visit the 9 surrounding cells in row and column order, as the mesh does
+			double shad = 1., block = 1.;
+			for ( int k=g[0]-1; k<=g[0]+1; k++ )
+				for ( int l=g[1]-1; l<=g[1]+1; l++ )
+					for ( size_t j=0; j<helios->size(); j++ )
+					{
+						Heliostat *HI = &helios->at(j);
+						if ( HI == H || HI->getGroupId()[0] != k || HI->getGroupId()[1] != l )
+							continue;
+						shad -= SF.calcShadowBlock( H, HI, 0, sun, interaction_limit );
+						block -= SF.calcShadowBlock( H, HI, 1, sun, interaction_limit );
+					}
+			shad = std::min( std::max( shad, 0. ), 1. );
+			block = std::min( std::max( block, 0. ), 1. );
+
+			if ( block < 1. ) nblocked++;
+
+			EXPECT_EQ(H->getEfficiencyShading(), shad) << "Sun position " << s << ", heliostat " << i;
+			EXPECT_EQ(H->getEfficiencyBlock(), block) << "Sun position " << s << ", heliostat " << i;
+		}
+		EXPECT_GT(nblocked, 0) << "Sun position " << s;
+	}
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST(SolarFieldNeighborsTest, DISABLED_ShadowBlockTimeVsFieldSize){
+	int sizes[] = { 1000, 5000, 10000, 25000, 50000 };
+	for ( int n=0; n<5; n++ )
+	{
+		test_field T;
+		T.build( sizes[n] );
+		T.simulate( 180., 30. );
+
+		Hvector *helios = T.SF.getHeliostats();
+		double *extents = T.SF.getHeliostatExtents();
+		int nsun = 10;
+		double t_mesh = 0., t_calc = 0.;
+		for ( int s=0; s<nsun; s++ )
+		{
+			Vect sun = Ambient::calcSunVectorFromAzZen( (90. + 18.*s)*D2R, (20. + 5.*s)*D2R );
+			auto t0 = std::chrono::steady_clock::now();
+			T.SF.UpdateNeighborList( extents, (20. + 5.*s)*D2R );
+			auto t1 = std::chrono::steady_clock::now();
+			for ( size_t i=0; i<helios->size(); i++ )
+				T.SF.calcNeighborShadowBlock( helios->at(i), sun, true );
+			auto t2 = std::chrono::steady_clock::now();
+			t_mesh += std::chrono::duration<double>( t1 - t0 ).count();
+			t_calc += std::chrono::duration<double>( t2 - t1 ).count();
+		}
+		printf( "%6d heliostats: neighbor update %8.3f ms, shadowing and blocking %8.2f ms per sun position\n", 
+			(int)helios->size(), 1000.*t_mesh/nsun, 1000.*t_calc/nsun );
+	}
+}
@@ -0,0 +1,115 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define protected public
+#include "../solarpilot/SolarField.h"
+#undef protected
+#include "../solarpilot/Heliostat.h"
+
+/**
+ * Checks that evaluating heliostat efficiencies in SolarField::Simulate on several threads gives the same
+ * efficiencies and aim points, bit for bit, as the single threaded evaluation.
+ */
+
+class threaded_field
+{
+public:
+	var_map V;
+	SolarField SF;
+
+	// Rectangular staggered field of n heliostats north of the tower
+	void build( int n, int nthreads )
+	{
+		V.sf.temp_which.combo_clear();
+		std::string name = "Template 1", val = "0";
+		V.sf.temp_which.combo_add_choice( name, val );
+		V.sf.temp_which.combo_select_by_choice_index( 0 );
+
+		int ncol = (int)std::ceil( std::sqrt( (double)n ) );
+		std::string layout;
+		char row[200];
+		for ( int i=0; i<n; i++ )
+		{
+			int r = i / ncol, c = i % ncol;
+			double x = (c - ncol/2)*16. + (r % 2)*8.;
+			double y = 100. + r*14.;
+			sprintf( row, "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;", x, y, 0. );
+			layout.append( row );
+		}
+		V.sf.layout_data.val = layout;
+
+		SF.Create( V );
+		SolarField::PrepareFieldLayout( SF, 0, true );
+		SF.setSimulationThreads( nthreads );
+	}
+
+	void simulate( double az, double zen, bool is_layout )
+	{
+		sim_params P;
+		P.dni = 950.;
+		P.is_layout = is_layout;
+		SF.Simulate( az*D2R, zen*D2R, P );
+	}
+};
+
+static void expect_same_field( SolarField &serial, SolarField &threaded, const std::string &where )
+{
+	std::vector<Heliostat> *hs = serial.getHeliostatObjects();
+	std::vector<Heliostat> *ht = threaded.getHeliostatObjects();
+	ASSERT_EQ(hs->size(), ht->size());
+
+	for ( size_t i=0; i<hs->size(); i++ )
+	{
+		Heliostat &s = hs->at(i), &t = ht->at(i);
+		EXPECT_EQ(t.getEfficiencyTotal(), s.getEfficiencyTotal()) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getEfficiencyCosine(), s.getEfficiencyCosine()) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getEfficiencyAtten(), s.getEfficiencyAtten()) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getEfficiencyIntercept(), s.getEfficiencyIntercept()) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getEfficiencyBlock(), s.getEfficiencyBlock()) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getEfficiencyShading(), s.getEfficiencyShading()) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getImageSize()[0], s.getImageSize()[0]) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getImageSize()[1], s.getImageSize()[1]) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getAimPoint()->x, s.getAimPoint()->x) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getAimPoint()->y, s.getAimPoint()->y) << where << ", heliostat " << i;
+		EXPECT_EQ(t.getAimPoint()->z, s.getAimPoint()->z) << where << ", heliostat " << i;
+	}
+}
+
+TEST(SolarFieldThreadsTest, ThreadedSimulationMatchesSerial){
+	threaded_field serial, threaded;
+	serial.build( 1500, 1 );
+	threaded.build( 1500, 4 );
+
+	// layout simulations evaluate the intercept factor once per optical zone
+	ASSERT_TRUE(serial.V.sf.is_opt_zoning.val);
+	ASSERT_GT(serial.SF._layout_groups.size(), 4);
+	ASSERT_EQ(threaded.SF._layout_groups.size(), serial.SF._layout_groups.size());
+
+	double suns[][2] = { { 180., 30. }, { 100., 75. }, { 260., 60. } };
+	for ( int layout=0; layout<2; layout++ )
+	{
+		for ( int s=0; s<3; s++ )
+		{
+			serial.simulate( suns[s][0], suns[s][1], layout == 1 );
+			threaded.simulate( suns[s][0], suns[s][1], layout == 1 );
+
+			char where[100];
+			sprintf( where, "Layout %d, sun position %d", layout, s );
+			expect_same_field( serial.SF, threaded.SF, where );
+		}
+	}
+}
+
+TEST(SolarFieldThreadsTest, HardwareThreadCountMatchesSerial){
+	threaded_field serial, threaded;
+	serial.build( 400, 1 );
+	threaded.build( 400, 0 );
+
+	serial.simulate( 150., 40., false );
+	threaded.simulate( 150., 40., false );
+	expect_same_field( serial.SF, threaded.SF, "Hardware threads" );
+}
@@ -653,4 +653,57 @@ TEST_F(CMPvsamv1PowerIntegration, SnowModel)
 	ssc_data_get_number(data, "annual_energy", &annual_energy);
 	EXPECT_NEAR(annual_energy, 11354.7, m_error_tolerance_hi) << "Annual energy.";
 
-}
\ No newline at end of file
+}
+
+/// Array outputs that are not on the requested output list are not returned and do not change results
+TEST_F(CMPvsamv1PowerIntegration, NoFinancialModelRequestedOutputs)
+{
+	ssc_data_set_requested_outputs(data, "gen, subarray1_poa_eff");
+	int pvsam_errors = run_module(data, "pvsamv1");
+
+	EXPECT_FALSE(pvsam_errors);
+	if (!pvsam_errors)
+	{
+		ssc_number_t annual_energy;
+		ssc_data_get_number(data, "annual_energy", &annual_energy);
+		EXPECT_NEAR(annual_energy, 8714, m_error_tolerance_hi) << "Annual energy.";
+
+		int n = 0;
+		EXPECT_NE(ssc_data_get_array(data, "gen", &n), nullptr);
+		EXPECT_EQ(n, 8760);
+		EXPECT_NE(ssc_data_get_array(data, "subarray1_poa_eff", &n), nullptr);
+		EXPECT_EQ(ssc_data_get_array(data, "subarray1_celltemp", &n), nullptr);
+		EXPECT_EQ(ssc_data_get_array(data, "dc_net", &n), nullptr);
+	}
+}
+
+/// Lifetime results reusing the first year DC power match results recomputing every year
+TEST_F(CMPvsamv1PowerIntegration, LifetimeReuseFirstYearDC)
+{
+	std::map<std::string, double> pairs;
+	pairs["system_use_lifetime_output"] = 1;
+	pairs["analysis_period"] = 3;
+	pairs["en_lifetime_dc_reuse"] = 0;
+
+	ssc_number_t dc_degradation[3] = { 0.5, 0.5, 0.5 };
+	ssc_data_set_array(data, "dc_degradation", dc_degradation, 3);
+
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_recompute = 0;
+	ssc_number_t *gen = ssc_data_get_array(data, "gen", &n_recompute);
+	ASSERT_NE(gen, nullptr);
+	std::vector<ssc_number_t> gen_recompute(gen, gen + n_recompute);
+
+	pairs["en_lifetime_dc_reuse"] = 1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_reuse = 0;
+	gen = ssc_data_get_array(data, "gen", &n_reuse);
+	ASSERT_EQ(n_reuse, n_recompute);
+	EXPECT_EQ(n_reuse, 3 * 8760);
+	for (int i = 0; i < n_reuse; i++)
+		EXPECT_NEAR(gen[i], gen_recompute[i], 1e-6) << "index " << i;
+}
@@ -37,4 +37,37 @@ TEST_F(CMPvwattsV5Integration, DefaultNoFinancialModel){
 	ssc_data_get_number(data, "capacity_factor", &capacity_factor);
 	EXPECT_NEAR(capacity_factor, 19.7197, error_tolerance) << "Capacity factor";
 
-}
\ No newline at end of file
+}
+
+/// Independent cases run concurrently through the batch API should match a serial run
+TEST_F(CMPvwattsV5Integration, BatchRunMatchesSerial){
+	const int ncases = 4;
+	ssc_data_t cases[ncases];
+	ssc_batch_t batch = ssc_batch_create();
+	for (int i = 0; i < ncases; i++)
+	{
+		cases[i] = ssc_data_create();
+		EXPECT_FALSE(pvwattsv5_nofinancial_testfile(cases[i]));
+		EXPECT_EQ(ssc_batch_add(batch, "pvwattsv5", cases[i]), i);
+	}
+	EXPECT_EQ(ssc_batch_add(batch, "not_a_module", cases[0]), -1);
+
+	EXPECT_EQ(ssc_batch_run(batch, 2, NULL, NULL), ncases);
+	EXPECT_NEAR(ssc_batch_progress(batch), 100.0, error_tolerance);
+
+	for (int i = 0; i < ncases; i++)
+	{
+		EXPECT_EQ(ssc_batch_status(batch, i), SSC_BATCH_SUCCESS);
+
+		int count;
+		double tmp = 0;
+		ssc_number_t* monthly_energy = ssc_data_get_array(cases[i], "monthly_energy", &count);
+		for (size_t m = 0; m < 12; m++)
+			tmp += (double)monthly_energy[m];
+		EXPECT_NEAR(tmp, 6909.79, error_tolerance) << "Annual energy of case " << i;
+	}
+
+	ssc_batch_free(batch);
+	for (int i = 0; i < ncases; i++)
+		ssc_data_free(cases[i]);
+}
@@ -0,0 +1,89 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core.h"
+#include "sscapi.h"
+
+#include "../input_cases/code_generator_utilities.h"
+
+/**
+ * CMSco2UdpcTables generates small user-defined power cycle tables for a 50 MWe recompression cycle
+ * with a fixed recuperator conductance
+ */
+class CMSco2UdpcTables : public ::testing::Test {
+
+public:
+
+	ssc_data_t data;
+
+	void SetUp()
+	{
+		data = ssc_data_create();
+		set_inputs();
+	}
+	void TearDown() {
+		if (data) {
+			ssc_data_free(data);
+		}
+	}
+
+	void set_inputs()
+	{
+		ssc_data_set_number(data, "htf", 17);
+		ssc_data_set_number(data, "T_htf_hot_des", 574);
+		ssc_data_set_number(data, "dT_PHX_hot_approach", 20);
+		ssc_data_set_number(data, "T_amb_des", 35);
+		ssc_data_set_number(data, "dT_mc_approach", 6);
+		ssc_data_set_number(data, "site_elevation", 588);
+		ssc_data_set_number(data, "W_dot_net_des", 50);
+		ssc_data_set_number(data, "design_method", 2);
+		ssc_data_set_number(data, "UA_recup_tot_des", 10000);
+		ssc_data_set_number(data, "eta_isen_mc", 0.89);
+		ssc_data_set_number(data, "eta_isen_rc", 0.89);
+		ssc_data_set_number(data, "eta_isen_t", 0.9);
+		ssc_data_set_number(data, "LT_recup_eff_max", 1);
+		ssc_data_set_number(data, "HT_recup_eff_max", 1);
+		ssc_data_set_number(data, "P_high_limit", 25);
+		ssc_data_set_number(data, "dT_PHX_cold_approach", 20);
+		ssc_data_set_number(data, "fan_power_frac", 0.01);
+		ssc_data_set_number(data, "deltaP_cooler_frac", 0.002);
+		ssc_data_set_number(data, "n_T_htf_hot", 3);
+		ssc_data_set_number(data, "n_T_amb", 3);
+		ssc_data_set_number(data, "n_m_dot_htf_ND", 3);
+	}
+};
+
+/// Each thread runs every n_threads-th case on its own copy of the design, so a case can follow different
+///   cases than in a serial run. Each off-design case is set up again from the design, so the tables must
+///   match the serial tables exactly, with no tolerance.
+TEST_F(CMSco2UdpcTables, ThreadedMatchesSerial) {
+	const char *names[3] = { "T_htf_ind", "T_amb_ind", "m_dot_htf_ND_ind" };
+
+	ssc_data_set_number(data, "n_threads", 1);
+	ASSERT_FALSE(run_module(data, "sco2_csp_ud_pc_tables"));
+	util::matrix_t<ssc_number_t> serial[3];
+	for (int k = 0; k < 3; k++)
+	{
+		int nr, nc;
+		ssc_number_t *table = ssc_data_get_matrix(data, names[k], &nr, &nc);
+		ASSERT_TRUE(table != 0) << names[k];
+		serial[k].assign(table, nr, nc);
+	}
+
+	// the table ranges are also outputs, so start again from the inputs
+	ssc_data_clear(data);
+	set_inputs();
+	ssc_data_set_number(data, "n_threads", 2);
+	ASSERT_FALSE(run_module(data, "sco2_csp_ud_pc_tables"));
+	for (int k = 0; k < 3; k++)
+	{
+		int nr, nc;
+		ssc_number_t *table = ssc_data_get_matrix(data, names[k], &nr, &nc);
+		ASSERT_TRUE(table != 0) << names[k];
+		ASSERT_EQ(nr, (int)serial[k].nrows()) << names[k];
+		ASSERT_EQ(nc, (int)serial[k].ncols()) << names[k];
+		for (int i = 0; i < nr*nc; i++)
+			EXPECT_EQ(table[i], serial[k].data()[i]) << names[k] << " row " << i / nc << ", column " << i % nc;
+	}
+}
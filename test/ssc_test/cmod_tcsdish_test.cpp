@@ -0,0 +1,50 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "core.h"
+#include "sscapi.h"
+
+#include "../input_cases/tcsdish_common_data.h"
+
+/**
+ * CMTcsDish runs tcsdish for a 25 dish field in Daggett, CA
+ */
+class CMTcsDish : public ::testing::Test {
+
+public:
+
+	ssc_data_t data;
+	double m_error_tolerance_lo = 0.001;    // 0.1%
+
+	void SetUp()
+	{
+		data = ssc_data_create();
+		tcsdish_default(data);
+	}
+	void TearDown() {
+		if (data) {
+			ssc_data_clear(data);
+		}
+	}
+};
+
+/// Test tcsdish with the default inputs
+TEST_F(CMTcsDish, DefaultDaggett) {
+	ASSERT_FALSE(run_module(data, "tcsdish"));
+
+	ssc_number_t annual_energy;
+	ssc_data_get_number(data, "annual_energy", &annual_energy);
+	EXPECT_NEAR(annual_energy, 1.25376e6, 1.25376e6 * m_error_tolerance_lo) << "Annual Energy";
+}
+
+// Prints the time of an annual run. Run with --gtest_also_run_disabled_tests
+TEST_F(CMTcsDish, DISABLED_Benchmark) {
+	const int n_runs = 5;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < n_runs; i++)
+		ASSERT_FALSE(run_module(data, "tcsdish"));
+	double s_per_run = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / n_runs;
+	std::cout << "tcsdish s per annual run: " << s_per_run << "\n";
+}
@@ -71,6 +71,84 @@ TEST_F(CMTcsMoltenSalt, DefaultSingleOwnerFinancialModel) {
     }
 }
 
+/// Test that the CSP solver counters are reported and consistent for a short run with instrumentation
+TEST_F(CMTcsMoltenSalt, SolverCountersShortRun) {
+
+    ssc_data_set_number(data, "time_stop", 3 * 24 * 3600);
+    ssc_data_set_number(data, "is_mono_eq_memo", 1);
+    ssc_data_set_number(data, "is_csp_instrumentation", 1);
+    ASSERT_FALSE(run_module(data, "tcsmolten_salt"));
+
+    ssc_number_t sim_time;
+    ASSERT_TRUE(ssc_data_get_number(data, "instr_sim_time", &sim_time));
+    EXPECT_GT(sim_time, 0.0) << "Solver Wall Time";
+
+    // op mode, equation, solves, equation calls, seeded solves, seeded solves repeated, solve time
+    int n_rows, n_cols;
+    ssc_number_t *p_mono = ssc_data_get_matrix(data, "mono_eq_counters", &n_rows, &n_cols);
+    ASSERT_TRUE(p_mono != 0);
+    ASSERT_EQ(n_cols, 7);
+    double n_solves = 0.0, n_seeded = 0.0;
+    for (int i = 0; i < n_rows; i++)
+    {
+        ssc_number_t *row = p_mono + i * n_cols;
+        EXPECT_GE(row[3], row[2]) << "Equation calls, row " << i;
+        EXPECT_LE(row[4], row[2]) << "Seeded solves, row " << i;
+        EXPECT_LE(row[5], row[4]) << "Repeated seeded solves, row " << i;
+        EXPECT_GE(row[6], 0.0) << "Solve time, row " << i;
+        n_solves += row[2];
+        n_seeded += row[4];
+    }
+    EXPECT_GT(n_solves, 0.0) << "Operating mode equation solves";
+    EXPECT_GT(n_seeded, 0.0) << "Seeded solves";
+
+    // op mode, tries, wall time, component calls, tries by component calls per try
+    ssc_number_t *p_modes = ssc_data_get_matrix(data, "instr_op_modes", &n_rows, &n_cols);
+    ASSERT_TRUE(p_modes != 0);
+    ASSERT_GT(n_cols, 4);
+    double n_tries = 0.0, op_mode_calls = 0.0, op_mode_time = 0.0;
+    for (int i = 0; i < n_rows; i++)
+    {
+        ssc_number_t *row = p_modes + i * n_cols;
+        double n_hist = 0.0;
+        for (int j = 4; j < n_cols; j++)
+            n_hist += row[j];
+        EXPECT_EQ(n_hist, row[1]) << "Histogram of tries for op mode " << row[0];
+        n_tries += row[1];
+        op_mode_time += row[2];
+        op_mode_calls += row[3];
+    }
+    EXPECT_GT(n_tries, 0.0) << "Operating mode tries";
+    EXPECT_LE(op_mode_time, sim_time) << "Operating mode wall time";
+
+    // calls, wall time
+    ssc_number_t *p_calls = ssc_data_get_matrix(data, "instr_component_calls", &n_rows, &n_cols);
+    ASSERT_TRUE(p_calls != 0);
+    ASSERT_EQ(n_cols, 2);
+    double n_calls = 0.0, call_time = 0.0;
+    for (int i = 0; i < n_rows; i++)
+    {
+        n_calls += p_calls[i * n_cols];
+        call_time += p_calls[i * n_cols + 1];
+    }
+    EXPECT_GE(n_calls, op_mode_calls) << "Component calls";
+    EXPECT_GT(op_mode_calls, 0.0) << "Component calls in operating modes";
+    EXPECT_LE(call_time, sim_time) << "Component call wall time";
+}
+
+/// Test that instrumentation outputs are only reported when requested
+TEST_F(CMTcsMoltenSalt, SolverCountersOffByDefault) {
+
+    ssc_data_set_number(data, "time_stop", 24 * 3600);
+    ASSERT_FALSE(run_module(data, "tcsmolten_salt"));
+
+    int n_rows, n_cols;
+    EXPECT_TRUE(ssc_data_get_matrix(data, "mono_eq_counters", &n_rows, &n_cols) != 0);
+    ssc_number_t sim_time;
+    EXPECT_FALSE(ssc_data_get_number(data, "instr_sim_time", &sim_time));
+    EXPECT_TRUE(ssc_data_get_matrix(data, "instr_op_modes", &n_rows, &n_cols) == 0);
+}
+
 //TestResult tcsmoltenSaltSingleOwnerDefaultResult[] = {
 //    /*  SSC Var Name                            Test Type           Test Result             Error Bound % */
 //    { "annual_energy",                          NR,                 5.77916e8,              0.1 },  // Annual total electric power to grid
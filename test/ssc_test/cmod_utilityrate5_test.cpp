@@ -0,0 +1,138 @@
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core.h"
+#include "sscapi.h"
+
+#include "../input_cases/code_generator_utilities.h"
+
+/**
+ * CMUtilityRate5 runs utilityrate5 on a synthetic load and generation profile with a two period tiered
+ * energy rate and TOU and flat demand charges.
+ */
+class CMUtilityRate5 : public ::testing::Test {
+
+public:
+
+	ssc_data_t data;
+
+	void SetUp()
+	{
+		data = ssc_data_create();
+
+		std::vector<ssc_number_t> gen(8760), load(8760);
+		for (int i = 0; i < 8760; i++)
+		{
+			int h = i % 24;
+			gen[i] = (h > 6 && h < 18) ? (ssc_number_t)(5 * sin((h - 6)*M_PI / 12)*(1 + 0.3*sin(i*0.01))) : 0;
+			load[i] = (ssc_number_t)(1.5 + sin(i*0.3) + 0.5*((i / 24) % 7 < 5));
+		}
+		ssc_data_set_array(data, "gen", &gen[0], 8760);
+		ssc_data_set_array(data, "load", &load[0], 8760);
+
+		ssc_data_set_number(data, "analysis_period", 3);
+		ssc_data_set_number(data, "system_use_lifetime_output", 0);
+		ssc_number_t zero = 0;
+		ssc_data_set_array(data, "degradation", &zero, 1);
+		ssc_data_set_array(data, "load_escalation", &zero, 1);
+		ssc_data_set_number(data, "inflation_rate", 2.5);
+		ssc_data_set_number(data, "ur_metering_option", 0);
+		ssc_data_set_number(data, "ur_nm_yearend_sell_rate", 0.0279);
+		ssc_data_set_number(data, "ur_monthly_fixed_charge", 8.55);
+		ssc_data_set_number(data, "ur_monthly_min_charge", 20);
+		ssc_data_set_number(data, "ur_annual_min_charge", 100);
+		ssc_data_set_number(data, "ur_en_ts_sell_rate", 0);
+		ssc_data_set_number(data, "ur_dc_enable", 1);
+
+		std::vector<ssc_number_t> weekday(288), weekend(288, 1);
+		for (int i = 0; i < 288; i++)
+			weekday[i] = (i % 24 >= 12 && i % 24 < 19) ? 2 : 1;
+		ssc_data_set_matrix(data, "ur_ec_sched_weekday", &weekday[0], 12, 24);
+		ssc_data_set_matrix(data, "ur_ec_sched_weekend", &weekend[0], 12, 24);
+		ssc_data_set_matrix(data, "ur_dc_sched_weekday", &weekday[0], 12, 24);
+		ssc_data_set_matrix(data, "ur_dc_sched_weekend", &weekend[0], 12, 24);
+
+		// period, tier, max usage, units, buy, sell
+		ssc_number_t ec_tou_mat[24] = { 1, 1, 200, 0, 0.09f, 0.05f,  1, 2, 1e38f, 0, 0.11f, 0.05f,
+										2, 1, 100, 0, 0.15f, 0.06f,  2, 2, 1e38f, 0, 0.2f, 0.06f };
+		ssc_data_set_matrix(data, "ur_ec_tou_mat", ec_tou_mat, 4, 6);
+		ssc_number_t dc_tou_mat[8] = { 1, 1, 1e38f, 5,  2, 1, 1e38f, 12 };
+		ssc_data_set_matrix(data, "ur_dc_tou_mat", dc_tou_mat, 2, 4);
+		ssc_number_t dc_flat_mat[48];
+		for (int m = 0; m < 12; m++)
+		{
+			dc_flat_mat[4 * m] = (ssc_number_t)m;
+			dc_flat_mat[4 * m + 1] = 1;
+			dc_flat_mat[4 * m + 2] = 1e38f;
+			dc_flat_mat[4 * m + 3] = 3;
+		}
+		ssc_data_set_matrix(data, "ur_dc_flat_mat", dc_flat_mat, 12, 4);
+	}
+	void TearDown() {
+		if (data) {
+			ssc_data_clear(data);
+		}
+	}
+
+	// Annual bills with and without the system for years 1..analysis_period
+	void run_bills(std::vector<ssc_number_t> &w_sys, std::vector<ssc_number_t> &wo_sys)
+	{
+		ASSERT_FALSE(run_module(data, "utilityrate5"));
+		int n_w = 0, n_wo = 0;
+		ssc_number_t *p_w = ssc_data_get_array(data, "utility_bill_w_sys", &n_w);
+		ssc_number_t *p_wo = ssc_data_get_array(data, "utility_bill_wo_sys", &n_wo);
+		ASSERT_NE(p_w, nullptr);
+		ASSERT_NE(p_wo, nullptr);
+		w_sys.assign(p_w + 1, p_w + n_w);
+		wo_sys.assign(p_wo + 1, p_wo + n_wo);
+	}
+};
+
+/// Bills for later years with unchanged energy match billing each year's escalated rates from scratch
+TEST_F(CMUtilityRate5, EscalatedBillsMatchFullBilling) {
+	for (int metering = 0; metering < 5; metering++)
+	{
+		ssc_data_set_number(data, "ur_metering_option", metering);
+
+		// escalation multipliers of 1.0, 1.1 and 1.2 in years 1 to 3
+		ssc_number_t escalation[3] = { 0, 10, 20 };
+		ssc_data_set_array(data, "rate_escalation", escalation, 3);
+		std::vector<ssc_number_t> w_sys, wo_sys;
+		run_bills(w_sys, wo_sys);
+		ASSERT_EQ(w_sys.size(), 3);
+
+		// the first year of a run is always billed in full
+		for (int year = 1; year < 3; year++)
+		{
+			ssc_number_t first_year[2] = { escalation[year], escalation[year] };
+			ssc_data_set_array(data, "rate_escalation", first_year, 2);
+			ssc_data_set_number(data, "analysis_period", 2);
+			std::vector<ssc_number_t> w_full, wo_full;
+			run_bills(w_full, wo_full);
+			ssc_data_set_number(data, "analysis_period", 3);
+
+			EXPECT_NEAR(w_sys[year], w_full[0], 1e-3 * std::abs(w_full[0]) + 1e-3) << "metering " << metering << " year " << year + 1;
+			EXPECT_NEAR(wo_sys[year], wo_full[0], 1e-3 * std::abs(wo_full[0]) + 1e-3) << "metering " << metering << " year " << year + 1;
+		}
+	}
+}
+
+/// Degraded system output is billed every year, so bills with the system change while bills without it only escalate
+TEST_F(CMUtilityRate5, DegradedBillsAreRecalculated) {
+	ssc_number_t degradation = 5;
+	ssc_data_set_array(data, "degradation", &degradation, 1);
+	ssc_number_t escalation = 0;
+	ssc_data_set_array(data, "rate_escalation", &escalation, 1);
+	ssc_data_set_number(data, "inflation_rate", 0);
+
+	std::vector<ssc_number_t> w_sys, wo_sys;
+	run_bills(w_sys, wo_sys);
+	ASSERT_EQ(w_sys.size(), 3);
+
+	EXPECT_EQ(wo_sys[1], wo_sys[0]);
+	EXPECT_EQ(wo_sys[2], wo_sys[0]);
+	EXPECT_GT(w_sys[1], w_sys[0]);
+	EXPECT_GT(w_sys[2], w_sys[1]);
+}
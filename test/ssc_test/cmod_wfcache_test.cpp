@@ -0,0 +1,92 @@
+#include <cstdlib>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core.h"
+#include "sscapi.h"
+#include "lib_weatherfile.h"
+
+/**
+ * CMWfcache builds the binary cache of a weather file with the wfcache module and checks that weatherfile
+ * loads it from the same folder.
+ */
+class CMWfcache : public ::testing::Test {
+
+public:
+
+	ssc_data_t data;
+	std::string input;
+	std::string dir;
+
+	void SetUp()
+	{
+		input = std::string(std::getenv("SSCDIR")) + "/test/input_docs/weather_30m.epw";
+		const char *tmp = std::getenv("TMPDIR");
+		if (!tmp) tmp = std::getenv("TEMP");
+		dir = std::string(tmp ? tmp : "/tmp") + "/ssc_wfcache_test";
+		util::remove_file(weatherfile::cache_file_name(input, dir).c_str());
+
+		data = ssc_data_create();
+		ssc_data_set_string(data, "input_file", input.c_str());
+	}
+	void TearDown() {
+		util::remove_file(weatherfile::cache_file_name(input, dir).c_str());
+		if (data) {
+			ssc_data_free(data);
+		}
+	}
+
+	bool exec()
+	{
+		ssc_module_exec_set_print(0);
+		ssc_module_t module = ssc_module_create("wfcache");
+		if (!module) return false;
+		bool ok = ssc_module_exec(module, data) != 0;
+		ssc_module_free(module);
+		return ok;
+	}
+};
+
+/// The cache written to cache_dir is the one weatherfile reads from that folder
+TEST_F(CMWfcache, WriteAndReadBack) {
+	ssc_data_set_string(data, "cache_dir", dir.c_str());
+	ASSERT_TRUE(exec());
+
+	std::string cache_file = ssc_data_get_string(data, "cache_file");
+	EXPECT_EQ(cache_file, weatherfile::cache_file_name(input, dir));
+	EXPECT_TRUE(util::file_exists(cache_file.c_str()));
+	ssc_number_t nrecords;
+	ssc_data_get_number(data, "nrecords", &nrecords);
+	EXPECT_EQ(nrecords, 8760 * 2);
+
+	weatherfile cached, parsed;
+	ASSERT_TRUE(cached.open(input, false, dir));
+	EXPECT_TRUE(cached.from_cache());
+	ASSERT_TRUE(parsed.open(input, false, ""));
+	EXPECT_FALSE(parsed.from_cache());
+	ASSERT_EQ(cached.nrecords(), parsed.nrecords());
+
+	weather_record r, rc;
+	for (size_t i = 0; i < parsed.nrecords(); i++)
+	{
+		ASSERT_TRUE(parsed.read(&r));
+		ASSERT_TRUE(cached.read(&rc));
+		EXPECT_EQ(rc.hour, r.hour) << "Record " << i;
+		EXPECT_EQ(rc.gh, r.gh) << "Record " << i;
+		EXPECT_EQ(rc.dn, r.dn) << "Record " << i;
+		EXPECT_EQ(rc.tdry, r.tdry) << "Record " << i;
+	}
+
+	// a second run finds the cache up to date
+	ASSERT_TRUE(exec());
+	EXPECT_EQ(std::string(ssc_data_get_string(data, "cache_file")), cache_file);
+}
+
+/// Without a cache folder there is nowhere for weatherfile to find the cache, so the module fails
+TEST_F(CMWfcache, NoCacheFolder) {
+	std::string global = weatherfile::cache_dir();
+	weatherfile::set_cache_dir("");
+	EXPECT_FALSE(exec());
+	weatherfile::set_cache_dir(global);
+}
@@ -0,0 +1,203 @@
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/CO2_properties.h"
+
+/**
+ * Tests the optional CO2_TP, CO2_PH, and CO2_PS table lookups against the FIT routines at states along the
+ * high and low pressure sides of a recompression cycle, and checks that the setting is scoped to a thread.
+ */
+
+class CO2TableLookupTest : public ::testing::Test{
+protected:
+	std::vector<double> T, P, H, S;		//[K], [kPa], [kJ/kg], [kJ/kg-K]
+
+	virtual void SetUp(){
+		CO2_set_table_lookup(false);
+
+		// Compressor inlet to turbine inlet in small steps, as the cycle and component solvers evaluate them
+		for (int i_P = 0; i_P < 20; i_P++)
+		{
+			double P_i = 7400.0 + i_P * 900.0;
+			for (int i_T = 0; i_T < 250; i_T++)
+			{
+				double T_i = 306.0 + i_T * 2.8 + 0.013 * i_P;
+				CO2_state co2_props;
+				if (CO2_TP(T_i, P_i, &co2_props) != 0)
+					continue;
+				T.push_back(T_i);
+				P.push_back(P_i);
+				H.push_back(co2_props.enth);
+				S.push_back(co2_props.entr);
+			}
+		}
+	}
+
+	virtual void TearDown(){
+		CO2_set_table_lookup(false);
+	}
+
+	// States in cells that fall back to the FIT routines are identical to them
+	bool is_fit_state(const CO2_state &table, const CO2_state &fit){
+		return memcmp(&table, &fit, sizeof(CO2_state)) == 0;
+	}
+};
+
+TEST_F(CO2TableLookupTest, TP_matches_FIT_tcs_co2_properties){
+	double dens_err = 0.0, enth_err = 0.0, cp_err = 0.0;
+	int n_table = 0;
+	for (size_t i = 0; i < T.size(); i++)
+	{
+		CO2_state fit, table;
+		CO2_set_table_lookup(false);
+		ASSERT_EQ(CO2_TP(T[i], P[i], &fit), 0);
+		CO2_set_table_lookup(true);
+		ASSERT_EQ(CO2_TP(T[i], P[i], &table), 0);
+
+		if (is_fit_state(table, fit))
+			continue;
+		n_table++;
+
+		// Interpolated states return the inputs as given
+		EXPECT_EQ(table.temp, T[i]);
+		EXPECT_EQ(table.pres, P[i]);
+		dens_err = fmax(dens_err, fabs(table.dens / fit.dens - 1.0));
+		enth_err = fmax(enth_err, fabs(table.enth - fit.enth));
+		cp_err = fmax(cp_err, fabs(table.cp / fit.cp - 1.0));
+	}
+	EXPECT_GT(n_table, (int)T.size() / 2);
+	EXPECT_LT(dens_err, 2.E-4);
+	EXPECT_LT(enth_err, 0.05);		//[kJ/kg]
+	EXPECT_LT(cp_err, 2.E-4);
+}
+
+TEST_F(CO2TableLookupTest, PH_matches_FIT_tcs_co2_properties){
+	double T_err = 0.0, dens_err = 0.0, entr_err = 0.0;
+	int n_table = 0;
+	for (size_t i = 0; i < T.size(); i++)
+	{
+		CO2_state fit, table;
+		CO2_set_table_lookup(false);
+		ASSERT_EQ(CO2_PH(P[i], H[i], &fit), 0);
+		CO2_set_table_lookup(true);
+		ASSERT_EQ(CO2_PH(P[i], H[i], &table), 0);
+
+		if (is_fit_state(table, fit))
+			continue;
+		n_table++;
+
+		EXPECT_EQ(table.pres, P[i]);
+		EXPECT_EQ(table.enth, H[i]);
+		T_err = fmax(T_err, fabs(table.temp - fit.temp));
+		dens_err = fmax(dens_err, fabs(table.dens / fit.dens - 1.0));
+		entr_err = fmax(entr_err, fabs(table.entr - fit.entr));
+	}
+	EXPECT_GT(n_table, (int)T.size() / 2);
+	EXPECT_LT(T_err, 0.05);			//[K]
+	EXPECT_LT(dens_err, 2.E-4);
+	EXPECT_LT(entr_err, 2.E-4);		//[kJ/kg-K]
+}
+
+TEST_F(CO2TableLookupTest, PS_matches_FIT_tcs_co2_properties){
+	double T_err = 0.0, dens_err = 0.0, enth_err = 0.0;
+	int n_table = 0;
+	for (size_t i = 0; i < T.size(); i++)
+	{
+		CO2_state fit, table;
+		CO2_set_table_lookup(false);
+		ASSERT_EQ(CO2_PS(P[i], S[i], &fit), 0);
+		CO2_set_table_lookup(true);
+		ASSERT_EQ(CO2_PS(P[i], S[i], &table), 0);
+
+		if (is_fit_state(table, fit))
+			continue;
+		n_table++;
+
+		EXPECT_EQ(table.pres, P[i]);
+		EXPECT_EQ(table.entr, S[i]);
+		T_err = fmax(T_err, fabs(table.temp - fit.temp));
+		dens_err = fmax(dens_err, fabs(table.dens / fit.dens - 1.0));
+		enth_err = fmax(enth_err, fabs(table.enth - fit.enth));
+	}
+	EXPECT_GT(n_table, (int)T.size() / 2);
+	EXPECT_LT(T_err, 0.05);			//[K]
+	EXPECT_LT(dens_err, 2.E-4);
+	EXPECT_LT(enth_err, 0.05);		//[kJ/kg]
+}
+
+TEST_F(CO2TableLookupTest, Off_grid_states_use_FIT_tcs_co2_properties){
+	// Above the grid pressure, below the grid temperature, and at the critical point
+	double T_off[3] = { 700.0, 260.0, N_co2_props::T_crit + 0.05 };
+	double P_off[3] = { 40000.0, 5000.0, 7380.0 };
+
+	for (int i = 0; i < 3; i++)
+	{
+		CO2_state fit, table;
+		CO2_set_table_lookup(false);
+		int err_fit = CO2_TP(T_off[i], P_off[i], &fit);
+		CO2_set_table_lookup(true);
+		int err_table = CO2_TP(T_off[i], P_off[i], &table);
+
+		ASSERT_EQ(err_fit, err_table) << "state " << i;
+		if (err_fit != 0)
+			continue;
+		EXPECT_EQ(table.dens, fit.dens) << "state " << i;
+		EXPECT_EQ(table.enth, fit.enth) << "state " << i;
+		EXPECT_EQ(table.entr, fit.entr) << "state " << i;
+	}
+}
+
+TEST_F(CO2TableLookupTest, Setting_is_per_thread_tcs_co2_properties){
+	CO2_set_table_lookup(true);
+	bool is_table_other_thread = true;
+	std::thread other([&is_table_other_thread]() { is_table_other_thread = CO2_is_table_lookup(); });
+	other.join();
+	EXPECT_FALSE(is_table_other_thread);
+	EXPECT_TRUE(CO2_is_table_lookup());
+
+	{
+		N_co2_props::C_table_lookup_scope table_scope(false);
+		EXPECT_FALSE(CO2_is_table_lookup());
+	}
+	EXPECT_TRUE(CO2_is_table_lookup());
+}
+
+// Prints the time per call of the FIT routines and the tables. Run with --gtest_also_run_disabled_tests
+TEST_F(CO2TableLookupTest, DISABLED_Benchmark_tcs_co2_properties){
+	const char *names[3] = { "CO2_TP", "CO2_PH", "CO2_PS" };
+
+	for (int i_func = 0; i_func < 3; i_func++)
+	{
+		double ns_per_call[2];
+		for (int is_table = 0; is_table < 2; is_table++)
+		{
+			N_co2_props::C_table_lookup_scope table_scope(is_table == 1);
+			CO2_state co2_props;
+			CO2_TP(T[0], P[0], &co2_props);		// build the tables outside of the timed loop
+			CO2_PH(P[0], H[0], &co2_props);
+			CO2_PS(P[0], S[0], &co2_props);
+
+			double dens_sum = 0.0;
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < T.size(); i++)
+			{
+				if (i_func == 0)
+					CO2_TP(T[i], P[i], &co2_props);
+				else if (i_func == 1)
+					CO2_PH(P[i], H[i], &co2_props);
+				else
+					CO2_PS(P[i], S[i], &co2_props);
+				dens_sum += co2_props.dens;
+			}
+			ns_per_call[is_table] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / T.size();
+			EXPECT_GT(dens_sum, 0.0);
+		}
+		std::cout << names[i_func] << " ns per call: FIT " << ns_per_call[0] << ", table " << ns_per_call[1] << "\n";
+	}
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define private public              // for setting the horizon length and reading the retained problem
+#include "../tcs/csp_dispatch.h"
+#undef private
+
+/**
+ * CspDispatchTest runs the dispatch optimization over a sequence of rolling horizons with a synthetic
+ * solar resource and price signal, carrying the storage and cycle state from one horizon to the next.
+ */
+class CspDispatchTest : public ::testing::Test {
+protected:
+	C_csp_messages msg;
+	int nt;			// time steps per horizon
+	int shift;		// time steps between the starts of consecutive horizons
+
+	void SetUp() {
+		nt = 12;
+		shift = 6;
+	}
+
+	void set_params(csp_dispatch_opt &d) {
+		d.params.messages = &msg;
+		d.params.dt = 1.;
+		d.params.e_tes_min = 0;
+		d.params.e_tes_max = 1500e3;
+		d.params.e_tes_init = 500e3;
+		d.params.e_pb_startup_cold = 50e3;
+		d.params.e_pb_startup_hot = 10e3;
+		d.params.e_rec_startup = 30e3;
+		d.params.dt_pb_startup_cold = 0.5;
+		d.params.dt_pb_startup_hot = 0.25;
+		d.params.dt_rec_startup = 0.2;
+		d.params.tes_degrade_rate = 0;
+		d.params.q_pb_standby = 30e3;
+		d.params.q_pb_des = 270e3;
+		d.params.q_pb_max = 290e3;
+		d.params.q_pb_min = 70e3;
+		d.params.q_rec_min = 60e3;
+		d.params.w_rec_pump = 0.015;
+		d.params.eta_cycle_ref = 0.41;
+		d.params.disp_time_weighting = 0.99;
+		d.params.rsu_cost = 950;
+		d.params.csu_cost = 10000;
+		d.params.pen_delta_w = 0.1;
+		d.params.q_rec_standby = 0;
+		d.params.w_rec_ht = 0;
+		d.params.w_track = 300;
+		d.params.w_stow = 500;
+		d.params.w_cycle_standby = 100;
+		d.params.w_cycle_pump = 0.01;
+		d.params.q_pb0 = 0;
+		d.params.is_rec_operating0 = false;
+		d.params.is_pb_operating0 = false;
+		d.params.is_pb_standby0 = false;
+		for (int i = 0; i <= 10; i++) {
+			double f = 0.1 + 0.1*i;
+			d.params.eff_table_load.add_point(f*d.params.q_pb_des, 0.41*(1 - 0.3*(1 - f)*(1 - f)));
+		}
+		d.solver_params.max_bb_iter = 100000;
+		d.solver_params.mip_gap = 0.02;
+		d.solver_params.solution_timeout = 10;
+		d.solver_params.is_warm_start = false;
+		d.solver_params.is_write_ampl_dat = false;
+		d.solver_params.is_ampl_engine = false;
+	}
+
+	// fill the forecast and price arrays for the horizon starting at the given hour
+	void set_horizon(csp_dispatch_opt &d, int h0) {
+		d.m_nstep_opt = nt;
+		d.params.info_time = h0*3600.;
+		d.price_signal.clear();
+		d.w_lim.assign(nt, 1.e99);
+		d.outputs.q_sfavail_expected.clear();
+		d.outputs.eta_pb_expected.clear();
+		d.outputs.f_pb_op_limit.clear();
+		d.outputs.w_condf_expected.clear();
+		for (int t = 0; t < nt; t++) {
+			int h = (h0 + t) % 24;
+			double day = (h0 + t) / 24;
+			double sun = std::max(0., sin((h - 6) / 12.*M_PI)) * (0.6 + 0.4*cos(day*1.7));
+			d.outputs.q_sfavail_expected.push_back(sun*600e3);
+			d.outputs.eta_pb_expected.push_back(1.0 - 0.05*sun);
+			d.outputs.f_pb_op_limit.push_back(1.0);
+			d.outputs.w_condf_expected.push_back(0.02 + 0.01*sun);
+			d.price_signal.push_back((h >= 16 && h < 21) ? 2.0 : (h < 6 ? 0.6 : 1.0));
+		}
+	}
+
+	// compare the objective, constraints and variable bounds of two assembled problems
+	void expect_same_problem(lprec *a, lprec *b, int horizon) {
+		ASSERT_EQ(get_Nrows(a), get_Nrows(b)) << "horizon " << horizon;
+		ASSERT_EQ(get_Ncolumns(a), get_Ncolumns(b)) << "horizon " << horizon;
+		int ncol = get_Ncolumns(a);
+		std::vector<REAL> row_a(ncol + 1), row_b(ncol + 1);
+		for (int r = 0; r <= get_Nrows(a); r++) {
+			ASSERT_TRUE(get_row(a, r, &row_a[0]));
+			ASSERT_TRUE(get_row(b, r, &row_b[0]));
+			for (int c = 1; c <= ncol; c++)
+				EXPECT_EQ(row_a[c], row_b[c]) << "horizon " << horizon << " row " << r << " column " << c;
+			if (r > 0) {
+				EXPECT_EQ(get_constr_type(a, r), get_constr_type(b, r)) << "horizon " << horizon << " row " << r;
+				EXPECT_EQ(get_rh(a, r), get_rh(b, r)) << "horizon " << horizon << " row " << r;
+			}
+		}
+		for (int c = 1; c <= ncol; c++) {
+			EXPECT_EQ(get_lowbo(a, c), get_lowbo(b, c)) << "horizon " << horizon << " column " << c;
+			EXPECT_EQ(get_upbo(a, c), get_upbo(b, c)) << "horizon " << horizon << " column " << c;
+			EXPECT_EQ(is_int(a, c), is_int(b, c)) << "horizon " << horizon << " column " << c;
+		}
+	}
+
+	// carry the state at the start of the next horizon into the dispatch parameters
+	void carry_state(csp_dispatch_opt &d) {
+		d.params.e_tes_init = d.outputs.tes_charge_expected.at(shift - 1);
+		d.params.is_pb_operating0 = d.outputs.pb_operation.at(shift - 1);
+		d.params.is_rec_operating0 = d.outputs.rec_operation.at(shift - 1);
+		d.params.q_pb0 = d.outputs.q_pb_target.at(shift - 1);
+	}
+};
+
+/// Updating the retained problem in place gives the same problem as assembling it again for every horizon
+TEST_F(CspDispatchTest, RetainedModelMatchesRebuild) {
+	csp_dispatch_opt retained;
+	set_params(retained);
+
+	for (int w = 0; w < 6; w++) {
+		// a newly assembled problem for the same horizon and initial state
+		std::unique_ptr<csp_dispatch_opt> rebuilt(new csp_dispatch_opt());
+		set_params(*rebuilt);
+		rebuilt->params.e_tes_init = retained.params.e_tes_init;
+		rebuilt->params.is_pb_operating0 = retained.params.is_pb_operating0;
+		rebuilt->params.is_rec_operating0 = retained.params.is_rec_operating0;
+		rebuilt->params.q_pb0 = retained.params.q_pb0;
+
+		set_horizon(retained, w*shift);
+		set_horizon(*rebuilt, w*shift);
+		ASSERT_TRUE(retained.optimize()) << "horizon " << w;
+		ASSERT_TRUE(rebuilt->optimize()) << "horizon " << w;
+
+		EXPECT_EQ(retained.outputs.is_model_reused, w > 0) << "horizon " << w;
+		EXPECT_FALSE(rebuilt->outputs.is_model_reused) << "horizon " << w;
+		EXPECT_FALSE(retained.outputs.is_warm_start) << "horizon " << w;
+
+		expect_same_problem(retained.m_lp_model, rebuilt->m_lp_model, w);
+
+		// both solutions are within the MIP gap of the same optimum
+		EXPECT_NEAR(retained.outputs.objective, rebuilt->outputs.objective, 
+			retained.solver_params.mip_gap*std::abs(rebuilt->outputs.objective)) << "horizon " << w;
+
+		carry_state(retained);
+	}
+}
+
+/// A change in the horizon length assembles a new problem, which is then reused for horizons of the new length
+TEST_F(CspDispatchTest, HorizonLengthChangeRebuildsModel) {
+	csp_dispatch_opt d;
+	set_params(d);
+
+	set_horizon(d, 0);
+	ASSERT_TRUE(d.optimize());
+	EXPECT_FALSE(d.outputs.is_model_reused);
+
+	nt = 18;
+	set_horizon(d, shift);
+	ASSERT_TRUE(d.optimize());
+	EXPECT_FALSE(d.outputs.is_model_reused);
+	EXPECT_EQ(d.outputs.q_pb_target.size(), nt);
+
+	set_horizon(d, 2 * shift);
+	ASSERT_TRUE(d.optimize());
+	EXPECT_TRUE(d.outputs.is_model_reused);
+}
@@ -0,0 +1,219 @@
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/htf_props.h"
+#include "../tcs/csp_solver_util.h"
+
+/**
+ * Tests the optional temperature table of HTFProperties: the interpolated properties against the correlations
+ * they replace, the array overloads against the scalar calls, and the fallback to the correlations outside
+ * of the table and for fluids that are not tabulated.
+ */
+
+namespace
+{
+	const double T_low = 270.0 + 273.15;	//[K]
+	const double T_high = 600.0 + 273.15;	//[K]
+	const double P_amb = 1.E5;				//[Pa]
+
+	// Temperatures between the 1 K grid nodes, starting 20 K below and ending 20 K above the table
+	std::vector<double> off_node_temperatures(int n)
+	{
+		std::vector<double> T(n);
+		for (int i = 0; i < n; i++)
+			T[i] = T_low - 20.0 + (T_high - T_low + 40.0)*(i + 0.37) / n;
+		return T;
+	}
+
+	bool same_value(double a, double b)
+	{
+		return a == b || (std::isnan(a) && std::isnan(b));
+	}
+}
+
+TEST(HTFPropertiesTable, InterpolationMatchesCorrelations_tcs_htf_props)
+{
+	std::vector<double> T = off_node_temperatures(5000);
+	const char *names[5] = { "Cp", "dens", "visc", "cond", "enth" };
+
+	for (int fluid = HTFProperties::Air; fluid < HTFProperties::End_Library_Fluids; fluid++)
+	{
+		HTFProperties htf_corr, htf_table;
+		htf_corr.SetFluid(fluid);
+		htf_table.SetFluid(fluid);
+		ASSERT_TRUE(htf_table.SetPropertyTable(T_low, T_high, 1.0));
+
+		double err_max[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+		for (size_t i = 0; i < T.size(); i++)
+		{
+			double table[5] = { htf_table.Cp(T[i]), htf_table.dens(T[i], P_amb), htf_table.visc(T[i]),
+								htf_table.cond(T[i]), htf_table.enth(T[i]) };
+			double corr[5] = { htf_corr.Cp(T[i]), htf_corr.dens(T[i], P_amb), htf_corr.visc(T[i]),
+								htf_corr.cond(T[i]), htf_corr.enth(T[i]) };
+			for (int j = 0; j < 5; j++)
+			{
+				if (std::isnan(corr[j]))
+					EXPECT_TRUE(std::isnan(table[j])) << "fluid " << fluid << " " << names[j] << " at " << T[i] << " K";
+				else
+					err_max[j] = fmax(err_max[j], fabs(table[j] - corr[j]) / fmax(fabs(corr[j]), 1.E-3));
+			}
+		}
+		for (int j = 0; j < 5; j++)
+			EXPECT_LT(err_max[j], 1.E-4) << "fluid " << fluid << " " << names[j];
+	}
+}
+
+TEST(HTFPropertiesTable, ArrayOverloadsMatchScalarCalls_tcs_htf_props)
+{
+	std::vector<double> T = off_node_temperatures(1000);
+	int n = (int)T.size();
+	std::vector<double> cp(n), rho(n), mu(n), k(n), h(n);
+
+	for (int is_table = 0; is_table < 2; is_table++)
+	{
+		for (int fluid = HTFProperties::Air; fluid < HTFProperties::End_Library_Fluids; fluid++)
+		{
+			HTFProperties htf;
+			htf.SetFluid(fluid);
+			if (is_table)
+				htf.SetPropertyTable(T_low, T_high, 1.0);
+
+			htf.Cp(&T[0], n, &cp[0]);
+			htf.dens(&T[0], P_amb, n, &rho[0]);
+			htf.visc(&T[0], n, &mu[0]);
+			htf.cond(&T[0], n, &k[0]);
+			htf.enth(&T[0], n, &h[0]);
+
+			for (int i = 0; i < n; i++)
+			{
+				EXPECT_TRUE(same_value(cp[i], htf.Cp(T[i]))) << "fluid " << fluid << " table " << is_table << " at " << T[i] << " K";
+				EXPECT_TRUE(same_value(rho[i], htf.dens(T[i], P_amb))) << "fluid " << fluid << " table " << is_table << " at " << T[i] << " K";
+				EXPECT_TRUE(same_value(mu[i], htf.visc(T[i]))) << "fluid " << fluid << " table " << is_table << " at " << T[i] << " K";
+				EXPECT_TRUE(same_value(k[i], htf.cond(T[i]))) << "fluid " << fluid << " table " << is_table << " at " << T[i] << " K";
+				EXPECT_TRUE(same_value(h[i], htf.enth(T[i]))) << "fluid " << fluid << " table " << is_table << " at " << T[i] << " K";
+			}
+		}
+	}
+}
+
+TEST(HTFPropertiesTable, CorrelationsOutsideOfTable_tcs_htf_props)
+{
+	HTFProperties htf_corr, htf_table;
+	htf_corr.SetFluid(HTFProperties::Salt_60_NaNO3_40_KNO3);
+	htf_table.SetFluid(HTFProperties::Salt_60_NaNO3_40_KNO3);
+	ASSERT_TRUE(htf_table.SetPropertyTable(T_low, T_high, 1.0));
+
+	double T_out[4] = { T_low - 10.0, T_low - 1.E-6, T_high + 1.E-6, T_high + 10.0 };
+	for (int i = 0; i < 4; i++)
+	{
+		EXPECT_TRUE(same_value(htf_table.Cp(T_out[i]), htf_corr.Cp(T_out[i]))) << T_out[i] << " K";
+		EXPECT_TRUE(same_value(htf_table.dens(T_out[i], P_amb), htf_corr.dens(T_out[i], P_amb))) << T_out[i] << " K";
+		EXPECT_TRUE(same_value(htf_table.visc(T_out[i]), htf_corr.visc(T_out[i]))) << T_out[i] << " K";
+		EXPECT_TRUE(same_value(htf_table.cond(T_out[i]), htf_corr.cond(T_out[i]))) << T_out[i] << " K";
+		EXPECT_TRUE(same_value(htf_table.enth(T_out[i]), htf_corr.enth(T_out[i]))) << T_out[i] << " K";
+	}
+}
+
+TEST(HTFPropertiesTable, TableFollowsFluidAndIsCleared_tcs_htf_props)
+{
+	double T = 0.5*(T_low + T_high) + 0.37;		//[K] off of the grid nodes
+
+	HTFProperties htf, htf_corr;
+	htf.SetFluid(HTFProperties::Salt_60_NaNO3_40_KNO3);
+	ASSERT_TRUE(htf.SetPropertyTable(T_low, T_high, 1.0));
+
+	// SetFluid rebuilds the table for the new fluid
+	htf.SetFluid(HTFProperties::Therminol_VP1);
+	htf_corr.SetFluid(HTFProperties::Therminol_VP1);
+	EXPECT_TRUE(htf.IsPropertyTableAvail());
+	EXPECT_NEAR(htf.Cp(T), htf_corr.Cp(T), 1.E-4*htf_corr.Cp(T));
+	EXPECT_NE(htf.Cp(T), htf_corr.Cp(T));
+
+	// Without the table the correlations are returned exactly
+	htf.ClearPropertyTable();
+	EXPECT_FALSE(htf.IsPropertyTableAvail());
+	EXPECT_EQ(htf.Cp(T), htf_corr.Cp(T));
+	EXPECT_EQ(htf.enth(T), htf_corr.enth(T));
+
+	// ... and changing the fluid does not bring it back
+	htf.SetFluid(HTFProperties::Salt_60_NaNO3_40_KNO3);
+	EXPECT_FALSE(htf.IsPropertyTableAvail());
+}
+
+TEST(HTFPropertiesTable, UserDefinedFluidIsNotTabulated_tcs_htf_props)
+{
+	util::matrix_t<double> table(3, 7);
+	double rows[3][7] = { { 250.0, 1.5, 1900.0, 3.E-3, 1.6E-6, 0.5, 0.0 },
+						  { 400.0, 1.55, 1800.0, 1.5E-3, 8.3E-7, 0.52, 2.3E5 },
+						  { 600.0, 1.6, 1700.0, 1.E-3, 5.9E-7, 0.55, 5.5E5 } };
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 7; c++)
+			table(r, c) = rows[r][c];
+
+	HTFProperties htf, htf_user;
+	ASSERT_TRUE(htf.SetUserDefinedFluid(table));
+	ASSERT_TRUE(htf_user.SetUserDefinedFluid(table));
+	EXPECT_FALSE(htf.SetPropertyTable(T_low, T_high, 1.0));
+	EXPECT_FALSE(htf.IsPropertyTableAvail());
+
+	double T = 450.0 + 273.15;	//[K]
+	EXPECT_EQ(htf.Cp(T), htf_user.Cp(T));
+	EXPECT_EQ(htf.visc(T), htf_user.visc(T));
+}
+
+TEST(HTFPropertiesTable, InvalidRangeThrows_tcs_htf_props)
+{
+	HTFProperties htf;
+	htf.SetFluid(HTFProperties::Salt_60_NaNO3_40_KNO3);
+	EXPECT_THROW(htf.SetPropertyTable(T_high, T_low, 1.0), C_csp_exception);
+	EXPECT_THROW(htf.SetPropertyTable(T_low, T_high, 0.0), C_csp_exception);
+	EXPECT_FALSE(htf.IsPropertyTableAvail());
+}
+
+// Prints the time per temperature of the five properties from the correlations, the table, and the table array
+//   overloads. Run with --gtest_also_run_disabled_tests
+TEST(HTFPropertiesTable, DISABLED_Benchmark_tcs_htf_props)
+{
+	std::vector<double> T = off_node_temperatures(100000);
+	int n = (int)T.size();
+	std::vector<double> cp(n), rho(n), mu(n), k(n), h(n);
+	int fluids[3] = { HTFProperties::Salt_60_NaNO3_40_KNO3, HTFProperties::Therminol_VP1, HTFProperties::Air };
+
+	for (int i_fluid = 0; i_fluid < 3; i_fluid++)
+	{
+		double ns_per_T[3];
+		for (int mode = 0; mode < 3; mode++)
+		{
+			HTFProperties htf;
+			htf.SetFluid(fluids[i_fluid]);
+			if (mode > 0)
+				htf.SetPropertyTable(T_low, T_high, 1.0);		// built outside of the timed loop
+
+			double sum = 0.0;
+			auto start = std::chrono::steady_clock::now();
+			if (mode < 2)
+			{
+				for (int i = 0; i < n; i++)
+					sum += htf.Cp(T[i]) + htf.dens(T[i], P_amb) + htf.visc(T[i]) + htf.cond(T[i]) + htf.enth(T[i]);
+			}
+			else
+			{
+				htf.Cp(&T[0], n, &cp[0]);
+				htf.dens(&T[0], P_amb, n, &rho[0]);
+				htf.visc(&T[0], n, &mu[0]);
+				htf.cond(&T[0], n, &k[0]);
+				htf.enth(&T[0], n, &h[0]);
+				for (int i = 0; i < n; i++)
+					sum += cp[i] + rho[i] + mu[i] + k[i] + h[i];
+			}
+			ns_per_T[mode] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+			EXPECT_NE(sum, 0.0);
+		}
+		std::cout << "fluid " << fluids[i_fluid] << " ns per temperature: correlations " << ns_per_T[0]
+			<< ", table " << ns_per_T[1] << ", table arrays " << ns_per_T[2] << "\n";
+	}
+}
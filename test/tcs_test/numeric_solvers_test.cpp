@@ -0,0 +1,106 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/numeric_solvers.h"
+
+/**
+ * Solves a slowly changing monotonic equation in sequence, as the CSP solver does from one timestep to
+ * the next, and checks that starting from the previous solution finds the same solutions with fewer calls.
+ */
+
+class C_drifting_eq : public C_monotonic_equation
+{
+public:
+	double m_a;			// Changes between solves
+	double m_x_max;		// Equation fails above this value
+
+	C_drifting_eq()
+	{
+		m_a = 1.0;
+		m_x_max = std::numeric_limits<double>::quiet_NaN();
+	}
+
+	virtual int operator()(double x, double *y)
+	{
+		if (x > m_x_max)
+		{
+			*y = std::numeric_limits<double>::quiet_NaN();
+			return -1;
+		}
+		*y = m_a*std::exp(0.02*x) + 0.5*x;
+		return 0;
+	}
+};
+
+class MonotonicEqMemoTest : public ::testing::Test{
+protected:
+	// Solves the sequence from fixed default guesses and returns the total equation calls
+	long solve_sequence(C_monotonic_eq_memo *p_memo, std::vector<double> & x_solved)
+	{
+		C_drifting_eq c_eq;
+		C_monotonic_eq_memo memo_count;
+		memo_count.m_is_seed = false;
+
+		int n_solves = 200;
+		x_solved.resize(n_solves);
+		for (int i = 0; i < n_solves; i++)
+		{
+			c_eq.m_a = 1.0 + 0.5*std::sin(0.05*i);
+
+			C_monotonic_eq_solver c_solver(c_eq);
+			c_solver.settings(1.E-6, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), true);
+			c_solver.set_memo(p_memo != 0 ? p_memo : &memo_count);
+
+			double tol_solved = std::numeric_limits<double>::quiet_NaN();
+			int iter_solved = -1;
+			int code = c_solver.solve(0.0, 10.0, 50.0, x_solved[i], tol_solved, iter_solved);
+			EXPECT_EQ(code, C_monotonic_eq_solver::CONVERGED) << "Solve " << i;
+		}
+
+		return p_memo != 0 ? p_memo->m_n_calls : memo_count.m_n_calls;
+	}
+};
+
+TEST_F(MonotonicEqMemoTest, SeededSolvesMatchAndUseFewerCalls){
+	std::vector<double> x_default, x_seeded;
+	long n_calls_default = solve_sequence(0, x_default);
+
+	C_monotonic_eq_memo memo;
+	long n_calls_seeded = solve_sequence(&memo, x_seeded);
+
+	for (size_t i = 0; i < x_default.size(); i++)
+	{
+		EXPECT_NEAR(x_seeded[i], x_default[i], 1.E-4*std::abs(x_default[i])) << "Solve " << i;
+	}
+
+	EXPECT_EQ(memo.m_n_solves, (long)x_default.size());
+	EXPECT_EQ(memo.m_n_seeded, (long)x_default.size() - 1);
+	EXPECT_EQ(memo.m_n_fallback, 0);
+	EXPECT_LT(n_calls_seeded, n_calls_default);
+}
+
+TEST_F(MonotonicEqMemoTest, FailedSeedFallsBackToGuesses){
+	C_drifting_eq c_eq;
+	c_eq.m_x_max = 40.0;
+
+	C_monotonic_eq_memo memo;
+	memo.m_is_solved = true;
+	memo.m_x_solved = 1000.0;	// Previous solution where the equation now fails
+
+	C_monotonic_eq_solver c_solver(c_eq);
+	c_solver.settings(1.E-6, 50, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), true);
+	c_solver.set_memo(&memo);
+
+	double x_solved, tol_solved;
+	int iter_solved = -1;
+	int code = c_solver.solve(0.0, 10.0, 20.0, x_solved, tol_solved, iter_solved);
+
+	EXPECT_EQ(code, C_monotonic_eq_solver::CONVERGED);
+	EXPECT_EQ(memo.m_n_seeded, 1);
+	EXPECT_EQ(memo.m_n_fallback, 1);
+	EXPECT_NEAR(memo.m_x_solved, x_solved, 1.E-12);
+	double y;
+	c_eq(x_solved, &y);
+	EXPECT_NEAR(y, 20.0, 1.E-4);
+}
@@ -0,0 +1,262 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define _TCSTYPEINTERFACE_
+#include "../tcs/tcstype.h"
+#include "../tcs/tcskernel.h"
+
+/**
+ * Builds a small network with a source unit feeding two groups of iterating units that are not
+ * connected to each other, and checks that solving the groups on separate threads gives the same
+ * unit calls and values as the serial solve.
+ */
+
+enum { I_SRC_X, N_SRC };
+
+tcsvarinfo test_source_variables[] = {
+	{ TCS_OUTPUT, TCS_NUMBER, I_SRC_X, "x", "Source value", "", "", "", "" },
+	{ TCS_INVALID, TCS_INVALID, N_SRC, 0, 0, 0, 0, 0, 0 }
+};
+
+class test_source : public tcstypeinterface
+{
+public:
+	test_source( tcscontext *cxt, tcstypeinfo *ti ) : tcstypeinterface(cxt, ti) { }
+	virtual int init() { return 0; }
+	virtual int call( double time, double, int )
+	{
+		value( I_SRC_X, 2.0 + std::sin( time/7200.0 ) );
+		return 0;
+	}
+};
+
+TCS_IMPLEMENT_TYPE( test_source, "Test source", "", 1, test_source_variables, NULL, 0 );
+
+enum { P_RELAX_K, I_RELAX_U, I_RELAX_V, O_RELAX_Y, O_RELAX_NCALL, N_RELAX };
+
+tcsvarinfo test_relax_variables[] = {
+	{ TCS_PARAM,  TCS_NUMBER, P_RELAX_K,     "k",     "Feedback gain",         "", "", "", "0.5" },
+	{ TCS_INPUT,  TCS_NUMBER, I_RELAX_U,     "u",     "Driving input",         "", "", "", "0" },
+	{ TCS_INPUT,  TCS_NUMBER, I_RELAX_V,     "v",     "Feedback input",        "", "", "", "0" },
+	{ TCS_OUTPUT, TCS_NUMBER, O_RELAX_Y,     "y",     "Output",                "", "", "", "0" },
+	{ TCS_OUTPUT, TCS_NUMBER, O_RELAX_NCALL, "ncall", "Calls this timestep",   "", "", "", "0" },
+	{ TCS_INVALID, TCS_INVALID, N_RELAX, 0, 0, 0, 0, 0, 0 }
+};
+
+class test_relax : public tcstypeinterface
+{
+public:
+	test_relax( tcscontext *cxt, tcstypeinfo *ti ) : tcstypeinterface(cxt, ti) { }
+	virtual int init() { return 0; }
+	virtual int call( double, double, int ncall )
+	{
+		// depends on the call count so that any change in call sequence shows in the results
+		value( O_RELAX_Y, value(I_RELAX_U) + value(P_RELAX_K)*value(I_RELAX_V) + 1.E-3*ncall );
+		value( O_RELAX_NCALL, ncall + 1 );
+		return 0;
+	}
+};
+
+TCS_IMPLEMENT_TYPE( test_relax, "Test relaxation unit", "", 1, test_relax_variables, NULL, 0 );
+
+// relaxation unit that also reports progress on every call
+class test_report : public test_relax
+{
+public:
+	test_report( tcscontext *cxt, tcstypeinfo *ti ) : test_relax(cxt, ti) { }
+	virtual int call( double time, double step, int ncall )
+	{
+		progress( 0.0f, "test_report" );
+		return test_relax::call( time, step, ncall );
+	}
+};
+
+TCS_IMPLEMENT_TYPE( test_report, "Test relaxation unit with progress", "", 1, test_relax_variables, NULL, 0 );
+
+class TestKernel : public tcskernel
+{
+public:
+	std::vector<double> m_history;
+
+	TestKernel( tcstypeprovider *prov ) : tcskernel(prov) { }
+
+	virtual void message( const std::string &, int ) { }
+
+	virtual bool converged( double )
+	{
+		for ( size_t i=0;i<m_units.size();i++ )
+			for ( size_t j=0;j<m_units[i].values.size();j++ )
+				m_history.push_back( m_units[i].values[j].data.value );
+		return true;
+	}
+
+	// returns inputs and outputs to their defaults, which are all zero for the test types
+	void reset_values()
+	{
+		for ( size_t i=0;i<m_units.size();i++ )
+			for ( size_t j=0;j<m_units[i].values.size();j++ )
+				if ( m_units[i].type->variables[j].var_type != TCS_PARAM )
+					m_units[i].values[j].data.value = 0.0;
+		m_history.clear();
+	}
+
+	const std::vector<int> &lead_units() { return m_leadUnits; }
+	const std::vector< std::vector<int> > &unit_groups() { return m_unitGroups; }
+};
+
+// counts progress reports, and reports that start while another one is still running
+class ProgressKernel : public TestKernel
+{
+public:
+	std::atomic<int> m_nActive;
+	std::atomic<int> m_nOverlap;
+	int m_nReports;
+
+	ProgressKernel( tcstypeprovider *prov ) : TestKernel(prov), m_nActive(0), m_nOverlap(0), m_nReports(0) { }
+
+	virtual bool progress( float, const std::string & )
+	{
+		if ( m_nActive++ > 0 )
+			m_nOverlap++;
+		std::this_thread::sleep_for( std::chrono::microseconds(50) );
+		m_nReports++;
+		m_nActive--;
+		return true;
+	}
+};
+
+class TcsKernelTest : public ::testing::Test{
+protected:
+	tcstypeprovider m_provider;
+
+	virtual void SetUp(){
+		m_provider.register_type( "test_source", &__ti_test_source );
+		m_provider.register_type( "test_relax", &__ti_test_relax );
+		m_provider.register_type( "test_report", &__ti_test_report );
+	}
+
+	// the two groups are listed in interleaved order, and the second has a unit fed by both of its loop units
+	void build( TestKernel &k )
+	{
+		int src = k.add_unit( "test_source" );
+		int a1 = k.add_unit( "test_relax" );
+		int a2 = k.add_unit( "test_relax" );
+		int b1 = k.add_unit( "test_relax" );
+		int b2 = k.add_unit( "test_relax" );
+		int c2 = k.add_unit( "test_relax" );
+		k.set_unit_value( b2, "k", 0.8 );
+
+		k.connect( src, "x", a1, "u" );
+		k.connect( src, "x", b1, "u" );
+		k.connect( a1, "y", b1, "v" );
+		k.connect( b1, "y", a1, "v" );
+
+		k.connect( src, "x", a2, "u" );
+		k.connect( src, "x", b2, "u" );
+		k.connect( a2, "y", b2, "v" );
+		k.connect( b2, "y", a2, "v" );
+		k.connect( b2, "y", c2, "u" );
+		k.connect( a2, "y", c2, "v" );
+	}
+};
+
+TEST_F(TcsKernelTest, PartitionsIndependentGroups){
+	TestKernel k( &m_provider );
+	build( k );
+	k.partition_units();
+
+	ASSERT_EQ(k.lead_units().size(), 1);
+	EXPECT_EQ(k.lead_units()[0], 0);
+	ASSERT_EQ(k.unit_groups().size(), 2);
+	EXPECT_EQ(k.unit_groups()[0], std::vector<int>({ 1, 3 }));
+	EXPECT_EQ(k.unit_groups()[1], std::vector<int>({ 2, 4, 5 }));
+}
+
+TEST_F(TcsKernelTest, ThreadedSolveMatchesSerial){
+	TestKernel serial( &m_provider );
+	build( serial );
+	ASSERT_EQ(serial.simulate( 3600.0, 200*3600.0, 3600.0 ), 0);
+
+	TestKernel threaded( &m_provider );
+	build( threaded );
+	threaded.set_max_threads( 2 );
+	ASSERT_EQ(threaded.simulate( 3600.0, 200*3600.0, 3600.0 ), 0);
+
+	ASSERT_EQ(threaded.m_history.size(), serial.m_history.size());
+	for ( size_t i=0;i<serial.m_history.size();i++ )
+		EXPECT_EQ(threaded.m_history[i], serial.m_history[i]) << "Value " << i;
+}
+
+TEST_F(TcsKernelTest, ChangesAfterSolveRecompileLinks){
+	for ( int nthreads=1;nthreads<=2;nthreads++ )
+	{
+		// all units and connections in place before the first solve
+		TestKernel full( &m_provider );
+		int src = full.add_unit( "test_source" );
+		int a1 = full.add_unit( "test_relax" );
+		int b1 = full.add_unit( "test_relax" );
+		full.connect( src, "x", a1, "u" );
+		full.connect( a1, "y", b1, "v" );
+		full.connect( b1, "y", a1, "v" );
+		int a2 = full.add_unit( "test_relax" );
+		int b2 = full.add_unit( "test_relax" );
+		full.set_unit_value( b2, "k", 0.8 );
+		full.connect( src, "x", b1, "u" );
+		full.connect( src, "x", a2, "u" );
+		full.connect( a2, "y", b2, "v" );
+		full.connect( b2, "y", a2, "v" );
+		full.set_max_threads( nthreads );
+		ASSERT_EQ(full.simulate( 3600.0, 100*3600.0, 3600.0 ), 0);
+
+		// the same network, with a connection and units added after the links were compiled by a first solve.
+		// adding units reallocates the unit list, so links kept from the first solve would be left dangling
+		TestKernel changed( &m_provider );
+		src = changed.add_unit( "test_source" );
+		a1 = changed.add_unit( "test_relax" );
+		b1 = changed.add_unit( "test_relax" );
+		changed.connect( src, "x", a1, "u" );
+		changed.connect( a1, "y", b1, "v" );
+		changed.connect( b1, "y", a1, "v" );
+		changed.set_max_threads( nthreads );
+		ASSERT_EQ(changed.simulate( 3600.0, 100*3600.0, 3600.0 ), 0);
+
+		changed.connect( src, "x", b1, "u" );
+		a2 = changed.add_unit( "test_relax" );
+		b2 = changed.add_unit( "test_relax" );
+		changed.set_unit_value( b2, "k", 0.8 );
+		changed.connect( src, "x", a2, "u" );
+		changed.connect( a2, "y", b2, "v" );
+		changed.connect( b2, "y", a2, "v" );
+		changed.reset_values();
+		ASSERT_EQ(changed.simulate( 3600.0, 100*3600.0, 3600.0 ), 0);
+
+		ASSERT_EQ(changed.m_history.size(), full.m_history.size()) << "Threads " << nthreads;
+		for ( size_t i=0;i<full.m_history.size();i++ )
+			EXPECT_EQ(changed.m_history[i], full.m_history[i]) << "Threads " << nthreads << ", value " << i;
+	}
+}
+
+TEST_F(TcsKernelTest, ThreadedProgressIsSerialized){
+	ProgressKernel k( &m_provider );
+	int src = k.add_unit( "test_source" );
+	for ( int g=0;g<2;g++ )
+	{
+		int a = k.add_unit( "test_report" );
+		int b = k.add_unit( "test_report" );
+		k.connect( src, "x", a, "u" );
+		k.connect( src, "x", b, "u" );
+		k.connect( a, "y", b, "v" );
+		k.connect( b, "y", a, "v" );
+	}
+	k.set_max_threads( 2 );
+	ASSERT_EQ(k.simulate( 3600.0, 50*3600.0, 3600.0 ), 0);
+
+	ASSERT_EQ(k.unit_groups().size(), 2);
+	EXPECT_GT(k.m_nReports, 0);
+	EXPECT_EQ(k.m_nOverlap, 0);
+}